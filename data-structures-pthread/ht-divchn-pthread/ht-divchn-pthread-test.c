@@ -47,17 +47,31 @@ const char *C_USAGE =
   "> 0 : c\n"
   "> 0 : d\n"
   "> 0 : e log base 2\n"
-  "> 0 : f s.t. c / 2**e <= alpha <= d / 2**e, in f steps\n"
-  "[0, 1] : on/off insert search uint test\n"
-  "[0, 1] : on/off remove delete uint test\n"
-  "[0, 1] : on/off insert search uint_ptr test\n"
-  "[0, 1] : on/off remove delete uint_ptr test\n"
-  "[0, 1] : on/off corner cases test\n";
-const int C_ARGC_MAX = 13;
-const size_t C_ARGS_DEF[12] = {14, 0, 2, 1024, 30720u, 11, 10, 1, 1, 1, 1, 1};
+  "> 0 : f s.t. c / 2**e <= alpha <= d / 2**e, in f steps\n";
+const char *C_USAGE_FLAGS =
+  "[0, 1] : insert search uint\n"
+  "[0, 1] : remove delete uint\n"
+  "[0, 1] : insert search uint_ptr\n"
+  "[0, 1] : remove delete uint_ptr\n"
+  "[0, 1] : corner cases\n"
+  "[0, 1] : cursor export uint\n"
+  "[0, 1] : concurrent search uint\n"
+  "[0, 1] : incremental growth uint\n"
+  "[0, 1] : grouped batch uint\n"
+  "[0, 1] : lock kinds uint\n"
+  "[0, 1] : node pools uint\n"
+  "[0, 1] : gate shards uint\n"
+  "[0, 1] : delegation uint\n"
+  "[0, 1] : stats uint (HT_DIVCHN_PTHREAD_STATS)\n";
+const int C_ARGC_MAX = 22;
+const size_t C_ARGS_DEF[21] = {14, 0, 2, 1024, 30720u, 11, 10,
+			       1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
 const size_t C_SIZE_MAX = (size_t)-1;
 const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 
+/* lock kinds test */
+const size_t C_LOCKS_LOG_MAX_NUM_LOCKS = 15;
+
 /* corner cases test */
 const size_t C_CORNER_LOG_KEY_START = 0;
 const size_t C_CORNER_LOG_KEY_END = 8;
@@ -94,6 +108,120 @@ void remove_delete(size_t num_ins,
 		   void (*new_elt)(void *, size_t),
 		   size_t (*val_elt)(const void *),
 		   void (*free_elt)(void *));
+void iter(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  size_t num_threads,
+	  size_t log_num_locks,
+	  size_t num_grow_threads,
+	  size_t batch_count,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void search_batch(size_t num_ins,
+		  size_t key_size,
+		  size_t elt_size,
+		  size_t elt_alignment,
+		  size_t alpha_n,
+		  size_t log_alpha_d,
+		  size_t num_threads,
+		  size_t log_num_locks,
+		  size_t num_grow_threads,
+		  size_t batch_count,
+		  void (*new_elt)(void *, size_t),
+		  size_t (*val_elt)(const void *),
+		  void (*free_elt)(void *));
+void incr(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  size_t num_threads,
+	  size_t log_num_locks,
+	  size_t num_grow_threads,
+	  size_t batch_count,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void grouped(size_t num_ins,
+	     size_t key_size,
+	     size_t elt_size,
+	     size_t elt_alignment,
+	     size_t alpha_n,
+	     size_t log_alpha_d,
+	     size_t num_threads,
+	     size_t log_num_locks,
+	     size_t num_grow_threads,
+	     size_t batch_count,
+	     void (*new_elt)(void *, size_t),
+	     size_t (*val_elt)(const void *),
+	     void (*free_elt)(void *));
+void locks(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+void pools(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+void gate(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  size_t num_threads,
+	  size_t log_num_locks,
+	  size_t num_grow_threads,
+	  size_t batch_count,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void deleg(size_t num_ins,
+	   size_t key_size,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count);
+#ifdef HT_DIVCHN_PTHREAD_STATS
+void stats(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+#endif
 void *ptr(const void *block, size_t i, size_t size);
 void print_test_result(int res);
 double timer();
@@ -434,7 +562,7 @@ void insert_keys_elts(ht_divchn_pthread_t *ht,
 		      size_t batch_count,
 		      int *res){
   size_t i;
-  size_t n = ht->num_elts;
+  size_t n = ht_divchn_pthread_num_elts(ht);
   size_t init_count = ht->count;
   size_t seg_count, rem_count;
   size_t start = 0;
@@ -470,7 +598,7 @@ void insert_keys_elts(ht_divchn_pthread_t *ht,
     printf("\t\tinsert w/o growth time              "
 	   "%.4f seconds\n", t);
   }
-  *res *= (ht->num_elts == n + count);
+  *res *= (ht_divchn_pthread_num_elts(ht) == n + count);
   free(iids);
   free(ias);
   iids = NULL;
@@ -579,12 +707,12 @@ void search_in_ht(const ht_divchn_pthread_t *ht,
 		  size_t num_threads,
 		  size_t (*val_elt)(const void *),
 		  int *res){
-  size_t n = ht->num_elts;
+  size_t n = ht_divchn_pthread_num_elts(ht);
   double t;
   *res *=
     (search_ht_helper(ht, keys, elts, count, num_threads, val_elt, &t) ==
-     ht->num_elts);
-  *res *= (n == ht->num_elts);
+     ht_divchn_pthread_num_elts(ht));
+  *res *= (n == ht_divchn_pthread_num_elts(ht));
   if (num_threads == 1){
     printf("\t\tin ht search time (nt = 1):         "
 	   "%.4f seconds\n", t);
@@ -601,11 +729,11 @@ void search_nin_ht(const ht_divchn_pthread_t *ht,
 		   size_t num_threads,
 		   size_t (*val_elt)(const void *),
 		   int *res){
-  size_t n = ht->num_elts;
+  size_t n = ht_divchn_pthread_num_elts(ht);
   double t;
   *res *=
     (search_ht_helper(ht, keys, elts, count, num_threads, val_elt, &t) == 0);
-  *res *= (n == ht->num_elts);
+  *res *= (n == ht_divchn_pthread_num_elts(ht));
   if (num_threads == 1){
     printf("\t\tnot in ht search time (nt = 1):     " 
 	   "%.4f seconds\n", t);
@@ -785,7 +913,7 @@ void remove_key_elts(ht_divchn_pthread_t *ht,
     thread_join_perror(rids[i], NULL);
   }
   t = timer() - t;
-  *res *= (ht->num_elts == 0);
+  *res *= (ht_divchn_pthread_num_elts(ht) == 0);
   for (i = 0; i < count; i++){
     *res *=
       (ht_divchn_pthread_search(ht, ptr(keys, i, ht->key_size)) == NULL);
@@ -859,7 +987,7 @@ void delete_key_elts(ht_divchn_pthread_t *ht,
     thread_join_perror(dids[i], NULL);
   }
   t = timer() - t;
-  *res *= (ht->num_elts == 0);
+  *res *= (ht_divchn_pthread_num_elts(ht) == 0);
   for (i = 0; i < count; i++){
     *res *=
       (ht_divchn_pthread_search(ht, ptr(keys, i, ht->key_size)) == NULL);
@@ -941,126 +1069,1894 @@ void remove_delete(size_t num_ins,
   elts = NULL;
 }
 
+/* Cursor, foreach, export */
+
 /**
-   Runs a corner cases test.
+   Runs a ht_divchn_pthread_{next, foreach, export} test on distinct keys
+   and size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds.
 */
-void run_corner_cases_test(size_t log_ins){
-  int res = 1;
+void run_iter_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps,
+			size_t num_threads,
+			size_t log_num_locks,
+			size_t num_grow_threads,
+			size_t batch_count){
   size_t i, j;
-  size_t elt;
+  size_t num_ins;
+  size_t key_size;
   size_t elt_size = sizeof(size_t);
   size_t elt_alignment = sizeof(size_t);
-  size_t key_size;
-  size_t num_ins;
-  unsigned char *key = NULL;
-  ht_divchn_pthread_t ht;
+  size_t step, rem;
+  size_t alpha_n;
   num_ins = pow_two_perror(log_ins);
-  key = malloc_perror(1, pow_two_perror(C_CORNER_LOG_KEY_END));
-  for (i = 0; i < pow_two_perror(C_CORNER_LOG_KEY_END); i++){
-    key[i] = RANDOM();
-  }
-  printf("Run corner cases test --> ");
-  for (i = C_CORNER_LOG_KEY_START; i <= C_CORNER_LOG_KEY_END; i++){
-    key_size = pow_two_perror(i);
-    ht_divchn_pthread_init(&ht,
-			   key_size,
-			   elt_size,
-			   C_CORNER_MIN_NUM,
-			   C_CORNER_ALPHA_N,
-			   C_CORNER_LOG_ALPHA_D,
-			   C_CORNER_NUM_LOCKS,
-			   C_CORNER_NUM_GROW_THREADS,
-			   NULL,
-			   NULL,
-			   NULL,
-			   NULL);
-    ht_divchn_pthread_align_elt(&ht, elt_alignment);
-    for (j = 0; j < num_ins; j++){
-      elt = j;
-      ht_divchn_pthread_insert(&ht, key, &elt, 1);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_{next, foreach, export} test on "
+	   "distinct %lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      iter(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   num_threads,
+	   log_num_locks,
+	   num_grow_threads,
+	   batch_count,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
     }
-    res *= (ht.count_ix == 0 &&
-	    ht.count == C_CORNER_HT_COUNT &&
-	    ht.num_elts == 1 &&
-	    *(size_t *)ht_divchn_pthread_search(&ht, key) == elt);
-    ht_divchn_pthread_delete(&ht, key, 1);
-    res *= (ht.count == C_CORNER_HT_COUNT &&
-	    ht.num_elts == 0 &&
-	    ht_divchn_pthread_search(&ht, key) == NULL);
-    ht_divchn_pthread_free(&ht);
   }
-  print_test_result(res);
-  free(key);
-  key = NULL;
 }
 
-/**
-   Helper functions.
-*/
+typedef struct{
+  size_t sum;
+  size_t num;
+  size_t (*val_elt)(const void *);
+} visit_acc_t;
+
+void visit_acc(const void *key, void *elt, void *arg){
+  visit_acc_t *acc = arg;
+  acc->sum += acc->val_elt(elt);
+  acc->num++;
+  (void)key;
+}
 
 /**
-   Computes a pointer to the ith element in the block of elements.
+   Each key is required to be enumerated exactly once with its associated
+   element, and the multithreaded export is required to produce the keys
+   in the order of enumeration with a cursor.
 */
-void *ptr(const void *block, size_t i, size_t size){
-  return (void *)((char *)block + i * size);
+void iter(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  size_t num_threads,
+	  size_t log_num_locks,
+	  size_t num_grow_threads,
+	  size_t batch_count,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j, id, num, sum = 0;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *exp_keys = NULL;
+  unsigned char *seen = NULL;
+  size_t *ids = NULL;
+  void *elts = NULL;
+  void *exp_elts = NULL;
+  void *elt = NULL;
+  const void *cur_key = NULL;
+  double t;
+  visit_acc_t acc;
+  ht_divchn_pthread_cursor_t cur;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  exp_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  exp_elts = malloc_perror(num_ins, elt_size);
+  seen = calloc_perror(num_ins, 1);
+  ids = malloc_perror(num_ins, sizeof(size_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+    sum += i;
+  }
+  ht_divchn_pthread_init(&ht,
+			 key_size,
+			 elt_size,
+			 0,
+			 alpha_n,
+			 log_alpha_d,
+			 log_num_locks,
+			 num_grow_threads,
+			 NULL,
+			 NULL,
+			 NULL,
+			 free_elt);
+  ht_divchn_pthread_align_elt(&ht, elt_alignment);
+  insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count, &res);
+  num = 0;
+  t = timer();
+  ht_divchn_pthread_cursor_init(&cur);
+  while ((elt = ht_divchn_pthread_next(&ht, &cur, &cur_key)) != NULL){
+    memcpy(&id,
+	   (const char *)cur_key + key_size - sizeof(size_t),
+	   sizeof(size_t));
+    res *= (num < num_ins && id < num_ins && !seen[id] &&
+	    val_elt(elt) == id);
+    if (num < num_ins) ids[num] = id;
+    if (id < num_ins) seen[id] = 1;
+    num++;
+  }
+  t = timer() - t;
+  printf("\t\tcursor time:                        "
+	 "%.4f seconds\n", t);
+  res *= (num == num_ins);
+  acc.sum = 0;
+  acc.num = 0;
+  acc.val_elt = val_elt;
+  ht_divchn_pthread_foreach(&ht, visit_acc, &acc);
+  res *= (acc.num == num_ins && acc.sum == sum);
+  t = timer();
+  num = ht_divchn_pthread_export(&ht, exp_keys, exp_elts);
+  t = timer() - t;
+  printf("\t\texport time:                        "
+	 "%.4f seconds\n", t);
+  res *= (num == num_ins);
+  for (i = 0; i < num_ins; i++){
+    memcpy(&id,
+	   (char *)ptr(exp_keys, i, key_size) + key_size - sizeof(size_t),
+	   sizeof(size_t));
+    res *= (id == ids[i] &&
+	    val_elt(ptr(exp_elts, i, elt_size)) == id &&
+	    memcmp(ptr(exp_keys, i, key_size),
+		   ptr(keys, id, key_size),
+		   key_size) == 0);
+  }
+  res *= (ht_divchn_pthread_export(&ht, NULL, NULL) == num_ins);
+  free_ht(&ht, 0);
+  printf("\t\tcursor export correctness:          ");
+  print_test_result(res);
+  free(keys);
+  free(exp_keys);
+  free(elts);
+  free(exp_elts);
+  free(seen);
+  free(ids);
+  keys = NULL;
+  exp_keys = NULL;
+  elts = NULL;
+  exp_elts = NULL;
+  seen = NULL;
+  ids = NULL;
 }
 
+/* Concurrent search */
+
 /**
-   Prints a test result.
+   Runs a ht_divchn_pthread_search_batch test on distinct keys and size_t
+   elements across key sizes >= sizeof(size_t) and load factor upper
+   bounds, concurrently with insert and delete operations.
 */
-void print_test_result(int res){
-  if (res){
-    printf("SUCCESS\n");
-  }else{
-    printf("FAILURE\n");
+void run_search_batch_uint_test(size_t log_ins,
+				size_t log_key_start,
+				size_t log_key_end,
+				size_t alpha_n_start,
+				size_t alpha_n_end,
+				size_t log_alpha_d,
+				size_t num_alpha_steps,
+				size_t num_threads,
+				size_t log_num_locks,
+				size_t num_grow_threads,
+				size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_search_batch test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      search_batch(num_ins,
+		   key_size,
+		   elt_size,
+		   elt_alignment,
+		   alpha_n,
+		   log_alpha_d,
+		   num_threads,
+		   log_num_locks,
+		   num_grow_threads,
+		   batch_count,
+		   new_uint,
+		   val_uint,
+		   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
   }
 }
 
+typedef struct{
+  size_t count;
+  size_t batch_count;
+  size_t num_found;
+  int res;
+  double max_time; /* maximal time of a batch */
+  const unsigned char *keys;
+  void *elts; /* elt_size blocks owned by the thread */
+  ht_divchn_pthread_t *ht;
+  size_t (*val_elt)(const void *);
+} search_batch_arg_t;
+
 /**
-   Times execution.
+   Searches all keys in batches while other threads insert or delete them.
+   Each found element is required to be the element inserted with its key.
 */
-double timer(){
-  struct timeval tm;
-  gettimeofday(&tm, NULL);
-  return tm.tv_sec + tm.tv_usec / 1e6;
+void *search_batch_thread(void *arg){
+  size_t i, j, n;
+  size_t id;
+  double t;
+  const unsigned char *k = NULL;
+  search_batch_arg_t *sa = arg;
+  sa->num_found = 0;
+  sa->max_time = 0.0;
+  for (i = 0; i < sa->count; i += sa->batch_count){
+    n = sa->count - i;
+    if (n > sa->batch_count) n = sa->batch_count;
+    k = ptr(sa->keys, i, sa->ht->key_size);
+    for (j = 0; j < n; j++){
+      new_uint(ptr(sa->elts, j, sa->ht->elt_size), sa->count);
+    }
+    t = timer();
+    sa->num_found +=
+      ht_divchn_pthread_search_batch(sa->ht, k, sa->elts, n);
+    t = timer() - t;
+    if (t > sa->max_time) sa->max_time = t;
+    for (j = 0; j < n; j++){
+      id = sa->val_elt(ptr(sa->elts, j, sa->ht->elt_size));
+      sa->res *= (id == sa->count || id == i + j);
+    }
+  }
+  return NULL;
 }
 
-int main(int argc, char *argv[]){
-  int i;
-  size_t *args = NULL;
-  RGENS_SEED();
-  if (argc > C_ARGC_MAX){
-    fprintf(stderr, "USAGE:\n%s", C_USAGE);
-    exit(EXIT_FAILURE);
+/**
+   Searches all keys with num_threads threads while num_threads threads
+   insert the keys, and while num_threads threads delete the keys. The
+   in-table elements are required to be found after the insertions
+   and not found after the deletions.
+*/
+void search_batch(size_t num_ins,
+		  size_t key_size,
+		  size_t elt_size,
+		  size_t elt_alignment,
+		  size_t alpha_n,
+		  size_t log_alpha_d,
+		  size_t num_threads,
+		  size_t log_num_locks,
+		  size_t num_grow_threads,
+		  size_t batch_count,
+		  void (*new_elt)(void *, size_t),
+		  size_t (*val_elt)(const void *),
+		  void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  double t;
+  pthread_t *sids = NULL;
+  search_batch_arg_t *sas = NULL;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  sids = malloc_perror(num_threads, sizeof(pthread_t));
+  sas = malloc_perror(num_threads, sizeof(search_batch_arg_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
   }
-  args = malloc_perror(C_ARGC_MAX - 1, sizeof(size_t));
-  memcpy(args, C_ARGS_DEF, (C_ARGC_MAX - 1) * sizeof(size_t));
-  for (i = 1; i < argc; i++){
-    args[i - 1] = atoi(argv[i]);
+  ht_divchn_pthread_init(&ht,
+			 key_size,
+			 elt_size,
+			 0,
+			 alpha_n,
+			 log_alpha_d,
+			 log_num_locks,
+			 num_grow_threads,
+			 NULL,
+			 NULL,
+			 NULL,
+			 free_elt);
+  ht_divchn_pthread_align_elt(&ht, elt_alignment);
+  for (i = 0; i < num_threads; i++){
+    sas[i].count = num_ins;
+    sas[i].batch_count = batch_count;
+    sas[i].res = 1;
+    sas[i].keys = keys;
+    sas[i].elts = malloc_perror(batch_count, elt_size);
+    sas[i].ht = &ht;
+    sas[i].val_elt = val_elt;
   }
-  if (args[0] > C_FULL_BIT - 2 || 
-      args[1] > C_FULL_BIT - 1 ||
-      args[2] > C_FULL_BIT - 1 ||
-      args[1] > args[2] ||
-      args[3] < 1 ||
-      args[4] < 1 ||
-      args[5] > C_FULL_BIT - 1 ||
-      args[3] > args[4] ||
-      args[6] < 1 ||
-      args[7] > 1 ||
-      args[8] > 1 ||
-      args[9] > 1 ||
-      args[10] > 1 ||
-      args[11] > 1){
-    fprintf(stderr, "USAGE:\n%s", C_USAGE);
-    exit(EXIT_FAILURE);
+  /* search during insertions with growth */
+  t = timer();
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&sids[i], search_batch_thread, &sas[i]);
   }
-  if (args[7]) run_insert_search_free_uint_test(args[0],
-						args[1],
-						args[2],
-						args[3],
-						args[4],
-						args[5],
+  insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count, &res);
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(sids[i], NULL);
+    res *= sas[i].res;
+  }
+  t = timer() - t;
+  printf("\t\tsearch during insert time:          "
+	 "%.4f seconds\n", t);
+  /* all keys found after insertions */
+  search_batch_thread(&sas[0]);
+  res *= (sas[0].res && sas[0].num_found == num_ins);
+  /* search during deletions */
+  t = timer();
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&sids[i], search_batch_thread, &sas[i]);
+  }
+  delete_key_elts(&ht, keys, num_ins, num_threads, batch_count, &res);
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(sids[i], NULL);
+    res *= sas[i].res;
+  }
+  t = timer() - t;
+  printf("\t\tsearch during delete time:          "
+	 "%.4f seconds\n", t);
+  /* no key found after deletions */
+  search_batch_thread(&sas[0]);
+  res *= (sas[0].res && sas[0].num_found == 0);
+  free_ht(&ht, 0);
+  printf("\t\tconcurrent search correctness:      ");
+  print_test_result(res);
+  for (i = 0; i < num_threads; i++){
+    free(sas[i].elts);
+    sas[i].elts = NULL;
+  }
+  free(keys);
+  free(elts);
+  free(sids);
+  free(sas);
+  keys = NULL;
+  elts = NULL;
+  sids = NULL;
+  sas = NULL;
+}
+
+/* Incremental growth */
+
+/**
+   Runs a test of the incremental mode of a hash table on distinct keys
+   and size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds, where the maximal latency of a batch search concurrent
+   with insertions is reported with and without the incremental mode.
+*/
+void run_incr_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps,
+			size_t num_threads,
+			size_t log_num_locks,
+			size_t num_grow_threads,
+			size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_incr test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      incr(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   num_threads,
+	   log_num_locks,
+	   num_grow_threads,
+	   batch_count,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Inserts keys with num_threads threads while num_threads threads search
+   the keys in batches, with and without the incremental mode. Then
+   searches, enumerates, exports, and deletes the keys, which may be
+   in the middle of a migration in the incremental mode.
+*/
+void incr(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  size_t num_threads,
+	  size_t log_num_locks,
+	  size_t num_grow_threads,
+	  size_t batch_count,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  int is_incr;
+  size_t i, j;
+  size_t num;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  const void *cur_key = NULL;
+  double max_time;
+  pthread_t *sids = NULL;
+  search_batch_arg_t *sas = NULL;
+  ht_divchn_pthread_cursor_t cur;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  sids = malloc_perror(num_threads, sizeof(pthread_t));
+  sas = malloc_perror(num_threads, sizeof(search_batch_arg_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (i = 0; i < num_threads; i++){
+    sas[i].count = num_ins;
+    sas[i].batch_count = batch_count;
+    sas[i].keys = keys;
+    sas[i].elts = malloc_perror(batch_count, elt_size);
+    sas[i].val_elt = val_elt;
+  }
+  for (is_incr = 0; is_incr <= 1; is_incr++){
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   0,
+			   alpha_n,
+			   log_alpha_d,
+			   log_num_locks,
+			   num_grow_threads,
+			   NULL,
+			   NULL,
+			   NULL,
+			   free_elt);
+    ht_divchn_pthread_align_elt(&ht, elt_alignment);
+    ht_divchn_pthread_incr(&ht, is_incr);
+    printf("\t\t%s\n", is_incr ? "incremental mode:" : "default mode:");
+    for (i = 0; i < num_threads; i++){
+      sas[i].res = 1;
+      sas[i].ht = &ht;
+      thread_create_perror(&sids[i], search_batch_thread, &sas[i]);
+    }
+    insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		     &res);
+    max_time = 0.0;
+    for (i = 0; i < num_threads; i++){
+      thread_join_perror(sids[i], NULL);
+      res *= sas[i].res;
+      if (sas[i].max_time > max_time) max_time = sas[i].max_time;
+    }
+    printf("\t\tmax batch search time:              "
+	   "%.4f seconds\n", max_time);
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    num = 0;
+    ht_divchn_pthread_cursor_init(&cur);
+    while (ht_divchn_pthread_next(&ht, &cur, &cur_key) != NULL) num++;
+    res *= (num == num_ins);
+    res *= (ht_divchn_pthread_export(&ht, NULL, NULL) == num_ins);
+    delete_key_elts(&ht, keys, num_ins, num_threads, batch_count, &res);
+    search_nin_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    res *= (ht_divchn_pthread_num_elts(&ht) == 0);
+    free_ht(&ht, 0);
+  }
+  printf("\t\tincremental growth correctness:     ");
+  print_test_result(res);
+  for (i = 0; i < num_threads; i++){
+    free(sas[i].elts);
+    sas[i].elts = NULL;
+  }
+  free(keys);
+  free(elts);
+  free(sids);
+  free(sas);
+  keys = NULL;
+  elts = NULL;
+  sids = NULL;
+  sas = NULL;
+}
+
+/* Grouped batch processing */
+
+/**
+   Runs a test of the grouped mode of batch processing on distinct keys
+   and size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds, with and without the grouped mode.
+*/
+void run_grouped_uint_test(size_t log_ins,
+			   size_t log_key_start,
+			   size_t log_key_end,
+			   size_t alpha_n_start,
+			   size_t alpha_n_end,
+			   size_t log_alpha_d,
+			   size_t num_alpha_steps,
+			   size_t num_threads,
+			   size_t log_num_locks,
+			   size_t num_grow_threads,
+			   size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_grouped test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      grouped(num_ins,
+	      key_size,
+	      elt_size,
+	      elt_alignment,
+	      alpha_n,
+	      log_alpha_d,
+	      num_threads,
+	      log_num_locks,
+	      num_grow_threads,
+	      batch_count,
+	      new_uint,
+	      val_uint,
+	      NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Inserts, searches in batches, removes, and deletes keys with
+   num_threads threads, with and without the grouped mode. A key that
+   is inserted twice in a batch is required to be associated with the
+   element of its second insertion.
+*/
+void grouped(size_t num_ins,
+	     size_t key_size,
+	     size_t elt_size,
+	     size_t elt_alignment,
+	     size_t alpha_n,
+	     size_t log_alpha_d,
+	     size_t num_threads,
+	     size_t log_num_locks,
+	     size_t num_grow_threads,
+	     size_t batch_count,
+	     void (*new_elt)(void *, size_t),
+	     size_t (*val_elt)(const void *),
+	     void (*free_elt)(void *)){
+  int res = 1;
+  int is_grouped;
+  size_t i, j, n;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *dup_keys = NULL;
+  void *elts = NULL;
+  void *dup_elts = NULL;
+  double t;
+  search_batch_arg_t sa;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  dup_keys = malloc_perror(2 * batch_count, key_size);
+  dup_elts = malloc_perror(2 * batch_count, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  sa.count = num_ins;
+  sa.batch_count = batch_count;
+  sa.keys = keys;
+  sa.elts = malloc_perror(batch_count, elt_size);
+  sa.ht = &ht;
+  sa.val_elt = val_elt;
+  for (is_grouped = 0; is_grouped <= 1; is_grouped++){
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   0,
+			   alpha_n,
+			   log_alpha_d,
+			   log_num_locks,
+			   num_grow_threads,
+			   NULL,
+			   NULL,
+			   NULL,
+			   free_elt);
+    ht_divchn_pthread_align_elt(&ht, elt_alignment);
+    ht_divchn_pthread_grouped(&ht, is_grouped);
+    printf("\t\t%s\n", is_grouped ? "grouped mode:" : "default mode:");
+    insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		     &res);
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    sa.res = 1;
+    t = timer();
+    search_batch_thread(&sa);
+    t = timer() - t;
+    res *= (sa.res && sa.num_found == num_ins);
+    printf("\t\tsearch batch time (nt = 1):         "
+	   "%.4f seconds\n", t);
+    remove_key_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		    &res);
+    for (i = 0; i < num_ins; i++){
+      res *= (val_elt(ptr(elts, i, elt_size)) == i);
+    }
+    /* insert each key twice in a batch */
+    for (i = 0; i < num_ins; i += batch_count){
+      n = (num_ins - i < batch_count) ? num_ins - i : batch_count;
+      memcpy(dup_keys, ptr(keys, i, key_size), n * key_size);
+      memcpy(ptr(dup_keys, n, key_size), ptr(keys, i, key_size),
+	     n * key_size);
+      for (j = 0; j < n; j++){
+	new_elt(ptr(dup_elts, j, elt_size), num_ins);
+	new_elt(ptr(dup_elts, n + j, elt_size), i + j);
+      }
+      ht_divchn_pthread_insert(&ht, dup_keys, dup_elts, 2 * n);
+    }
+    res *= (ht_divchn_pthread_num_elts(&ht) == num_ins);
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    delete_key_elts(&ht, keys, num_ins, num_threads, batch_count, &res);
+    search_nin_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    free_ht(&ht, 0);
+  }
+  printf("\t\tgrouped batch correctness:          ");
+  print_test_result(res);
+  free(sa.elts);
+  free(keys);
+  free(elts);
+  free(dup_keys);
+  free(dup_elts);
+  sa.elts = NULL;
+  keys = NULL;
+  elts = NULL;
+  dup_keys = NULL;
+  dup_elts = NULL;
+}
+
+/* Lock kinds */
+
+/**
+   Runs a test of the kinds of locks and the scaling of lock stripes on
+   distinct keys and size_t elements across key sizes >= sizeof(size_t)
+   and load factor upper bounds.
+*/
+void run_locks_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps,
+			 size_t num_threads,
+			 size_t log_num_locks,
+			 size_t num_grow_threads,
+			 size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_locks test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks, max:     %lu, %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(pow_two_perror(C_LOCKS_LOG_MAX_NUM_LOCKS)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      locks(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    num_threads,
+	    log_num_locks,
+	    num_grow_threads,
+	    batch_count,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Inserts keys with num_threads threads while num_threads threads search
+   the keys in batches, and then searches, removes, inserts, and deletes
+   the keys, with each kind of locks and a number of lock stripes that
+   scales with the count of slots.
+*/
+void locks(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t num_locks;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  pthread_t *sids = NULL;
+  search_batch_arg_t *sas = NULL;
+  ht_divchn_pthread_lock_kind_t kind;
+  ht_divchn_pthread_t ht;
+  const char *kind_names[3] = {"mutex:", "spinlock:", "ticket lock:"};
+  const ht_divchn_pthread_lock_kind_t kinds[3] = {HT_DIVCHN_PTHREAD_MUTEX,
+						  HT_DIVCHN_PTHREAD_SPIN,
+						  HT_DIVCHN_PTHREAD_TICKET};
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  sids = malloc_perror(num_threads, sizeof(pthread_t));
+  sas = malloc_perror(num_threads, sizeof(search_batch_arg_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (i = 0; i < num_threads; i++){
+    sas[i].count = num_ins;
+    sas[i].batch_count = batch_count;
+    sas[i].keys = keys;
+    sas[i].elts = malloc_perror(batch_count, elt_size);
+    sas[i].val_elt = val_elt;
+  }
+  for (j = 0; j < 3; j++){
+    kind = kinds[j];
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   0,
+			   alpha_n,
+			   log_alpha_d,
+			   log_num_locks,
+			   num_grow_threads,
+			   NULL,
+			   NULL,
+			   NULL,
+			   free_elt);
+    ht_divchn_pthread_align_elt(&ht, elt_alignment);
+    ht_divchn_pthread_locks(&ht, kind, C_LOCKS_LOG_MAX_NUM_LOCKS);
+    printf("\t\t%s\n", kind_names[j]);
+    for (i = 0; i < num_threads; i++){
+      sas[i].res = 1;
+      sas[i].ht = &ht;
+      thread_create_perror(&sids[i], search_batch_thread, &sas[i]);
+    }
+    insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		     &res);
+    for (i = 0; i < num_threads; i++){
+      thread_join_perror(sids[i], NULL);
+      res *= sas[i].res;
+    }
+    num_locks = ht.key_locks_mask + 1;
+    printf("\t\t# locks after growth:               %lu\n",
+	   TOLU(num_locks));
+    res *= (num_locks <= pow_two_perror(C_LOCKS_LOG_MAX_NUM_LOCKS) &&
+	    (num_locks == pow_two_perror(log_num_locks) ||
+	     num_locks <= ht.count));
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    remove_key_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		    &res);
+    for (i = 0; i < num_ins; i++){
+      res *= (val_elt(ptr(elts, i, elt_size)) == i);
+    }
+    insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		     &res);
+    delete_key_elts(&ht, keys, num_ins, num_threads, batch_count, &res);
+    search_nin_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    free_ht(&ht, 0);
+  }
+  printf("\t\tlock kinds correctness:             ");
+  print_test_result(res);
+  for (i = 0; i < num_threads; i++){
+    free(sas[i].elts);
+    sas[i].elts = NULL;
+  }
+  free(keys);
+  free(elts);
+  free(sids);
+  free(sas);
+  keys = NULL;
+  elts = NULL;
+  sids = NULL;
+  sas = NULL;
+}
+
+/* Node pools */
+
+/**
+   Runs a test of node pools on distinct keys and size_t elements across
+   key sizes >= sizeof(size_t) and load factor upper bounds.
+*/
+void run_pools_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps,
+			 size_t num_threads,
+			 size_t log_num_locks,
+			 size_t num_grow_threads,
+			 size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_pool_init test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      pools(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    num_threads,
+	    log_num_locks,
+	    num_grow_threads,
+	    batch_count,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+typedef enum{POOL_INSERT, POOL_REMOVE, POOL_DELETE} pool_op_t;
+
+typedef struct{
+  size_t start;
+  size_t count;
+  size_t batch_count;
+  pool_op_t op;
+  const unsigned char *keys;
+  void *elts;
+  ht_divchn_pthread_t *ht;
+  ht_divchn_pthread_pool_t *pool; /* NULL if the stripe allocators are used */
+} pool_arg_t;
+
+void *pool_thread(void *arg){
+  size_t i, n;
+  const unsigned char *k = NULL;
+  void *e = NULL;
+  const pool_arg_t *pa = arg;
+  for (i = 0; i < pa->count; i += pa->batch_count){
+    k = ptr(pa->keys, pa->start + i, pa->ht->key_size);
+    e = ptr(pa->elts, pa->start + i, pa->ht->elt_size);
+    n = (pa->count - i < pa->batch_count) ? pa->count - i : pa->batch_count;
+    if (pa->op == POOL_INSERT){
+      ht_divchn_pthread_insert_pool(pa->ht, pa->pool, k, e, n);
+    }else if (pa->op == POOL_REMOVE){
+      ht_divchn_pthread_remove_pool(pa->ht, pa->pool, k, e, n);
+    }else{
+      ht_divchn_pthread_delete_pool(pa->ht, pa->pool, k, n);
+    }
+  }
+  return NULL;
+}
+
+/**
+   Runs an operation of num_threads threads, each on a segment of keys
+   with its own pool or without a pool, and returns the wall time.
+*/
+double pool_op_keys(pool_arg_t *pas,
+		    void *elts,
+		    size_t num_threads,
+		    pool_op_t op){
+  size_t i;
+  double t;
+  pthread_t *ids = NULL;
+  ids = malloc_perror(num_threads, sizeof(pthread_t));
+  for (i = 0; i < num_threads; i++){
+    pas[i].op = op;
+    pas[i].elts = elts;
+  }
+  t = timer();
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&ids[i], pool_thread, &pas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(ids[i], NULL);
+  }
+  t = timer() - t;
+  free(ids);
+  ids = NULL;
+  return t;
+}
+
+/**
+   Inserts, removes, inserts, and deletes keys with num_threads threads,
+   first without pools and then with a pool per thread.
+*/
+void pools(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  int use_pool;
+  size_t i, j;
+  size_t seg_count, rem_count;
+  size_t start;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  void *rem_elts = NULL;
+  double t;
+  pool_arg_t *pas = NULL;
+  ht_divchn_pthread_pool_t *ps = NULL;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rem_elts = malloc_perror(num_ins, elt_size);
+  pas = malloc_perror(num_threads, sizeof(pool_arg_t));
+  ps = malloc_perror(num_threads, sizeof(ht_divchn_pthread_pool_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  seg_count = num_ins / num_threads;
+  for (use_pool = 0; use_pool <= 1; use_pool++){
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   0,
+			   alpha_n,
+			   log_alpha_d,
+			   log_num_locks,
+			   num_grow_threads,
+			   NULL,
+			   NULL,
+			   NULL,
+			   free_elt);
+    ht_divchn_pthread_align_elt(&ht, elt_alignment);
+    start = 0;
+    rem_count = num_ins % num_threads; /* distribute among threads */
+    for (i = 0; i < num_threads; i++){
+      pas[i].start = start;
+      pas[i].count = seg_count;
+      pas[i].count += (rem_count > 0 && rem_count--);
+      pas[i].batch_count = batch_count;
+      pas[i].keys = keys;
+      pas[i].ht = &ht;
+      pas[i].pool = NULL;
+      if (use_pool){
+	ht_divchn_pthread_pool_init(&ht, &ps[i]);
+	pas[i].pool = &ps[i];
+      }
+      start += pas[i].count;
+    }
+    printf("\t\t%s\n", use_pool ? "w/ pools:" : "w/o pools:");
+    t = pool_op_keys(pas, elts, num_threads, POOL_INSERT);
+    printf("\t\tinsert w/ growth time               "
+	   "%.4f seconds\n", t);
+    res *= (ht_divchn_pthread_num_elts(&ht) == num_ins);
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    t = pool_op_keys(pas, rem_elts, num_threads, POOL_REMOVE);
+    printf("\t\tremove time:                        "
+	   "%.4f seconds\n", t);
+    res *= (ht_divchn_pthread_num_elts(&ht) == 0);
+    for (i = 0; i < num_ins; i++){
+      res *= (val_elt(ptr(rem_elts, i, elt_size)) == i);
+    }
+    t = pool_op_keys(pas, elts, num_threads, POOL_INSERT);
+    printf("\t\tinsert w/o growth time              "
+	   "%.4f seconds\n", t);
+    res *= (ht_divchn_pthread_num_elts(&ht) == num_ins);
+    /* reinsert a batch of present keys with unused pool nodes */
+    pool_op_keys(pas, elts, num_threads, POOL_INSERT);
+    res *= (ht_divchn_pthread_num_elts(&ht) == num_ins);
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    t = pool_op_keys(pas, elts, num_threads, POOL_DELETE);
+    printf("\t\tdelete time:                        "
+	   "%.4f seconds\n", t);
+    res *= (ht_divchn_pthread_num_elts(&ht) == 0);
+    search_nin_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    free_ht(&ht, 0);
+  }
+  printf("\t\tnode pools correctness:             ");
+  print_test_result(res);
+  free(keys);
+  free(elts);
+  free(rem_elts);
+  free(pas);
+  free(ps);
+  keys = NULL;
+  elts = NULL;
+  rem_elts = NULL;
+  pas = NULL;
+  ps = NULL;
+}
+
+/* Gate shards */
+
+/**
+   Runs a test of the entry and exit of batches through the gate shards
+   on distinct keys and size_t elements across key sizes >= sizeof(size_t)
+   and load factor upper bounds.
+*/
+void run_gate_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps,
+			size_t num_threads,
+			size_t log_num_locks,
+			size_t num_grow_threads,
+			size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a gate shards test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      gate(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   num_threads,
+	   log_num_locks,
+	   num_grow_threads,
+	   batch_count,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Inserts keys in small batches with num_threads threads while
+   num_threads threads search the keys in batches, and then searches,
+   removes, inserts, and deletes the keys, in the default and incremental
+   modes of growth. Tests that the number of keys is exact after the
+   threads completed, and that the number of keys exceeds the number of
+   keys at the load factor upper bound at most by the keys counted in the
+   gate shards and the keys of the batches in the hash table.
+*/
+void gate(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  size_t num_threads,
+	  size_t log_num_locks,
+	  size_t num_grow_threads,
+	  size_t batch_count,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  int is_incr;
+  size_t i, j;
+  size_t max_num_elts;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  pthread_t *sids = NULL;
+  search_batch_arg_t *sas = NULL;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  sids = malloc_perror(num_threads, sizeof(pthread_t));
+  sas = malloc_perror(num_threads, sizeof(search_batch_arg_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (i = 0; i < num_threads; i++){
+    sas[i].count = num_ins;
+    sas[i].batch_count = batch_count;
+    sas[i].keys = keys;
+    sas[i].elts = malloc_perror(batch_count, elt_size);
+    sas[i].val_elt = val_elt;
+  }
+  for (is_incr = 0; is_incr <= 1; is_incr++){
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   0,
+			   alpha_n,
+			   log_alpha_d,
+			   log_num_locks,
+			   num_grow_threads,
+			   NULL,
+			   NULL,
+			   NULL,
+			   free_elt);
+    ht_divchn_pthread_align_elt(&ht, elt_alignment);
+    ht_divchn_pthread_incr(&ht, is_incr);
+    printf("\t\t%s\n", is_incr ? "incremental mode:" : "default mode:");
+    for (i = 0; i < num_threads; i++){
+      sas[i].res = 1;
+      sas[i].ht = &ht;
+      thread_create_perror(&sids[i], search_batch_thread, &sas[i]);
+    }
+    insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		     &res);
+    for (i = 0; i < num_threads; i++){
+      thread_join_perror(sids[i], NULL);
+      res *= sas[i].res;
+    }
+    max_num_elts = ht.max_num_elts;
+    res *= (ht_divchn_pthread_num_elts(&ht) <=
+	    max_num_elts + max_num_elts / 8 + 2 * num_threads * batch_count);
+    search_in_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    remove_key_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		    &res);
+    for (i = 0; i < num_ins; i++){
+      res *= (val_elt(ptr(elts, i, elt_size)) == i);
+    }
+    insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count,
+		     &res);
+    delete_key_elts(&ht, keys, num_ins, num_threads, batch_count, &res);
+    search_nin_ht(&ht, keys, elts, num_ins, num_threads, val_elt, &res);
+    free_ht(&ht, 0);
+  }
+  printf("\t\tgate shards correctness:            ");
+  print_test_result(res);
+  for (i = 0; i < num_threads; i++){
+    free(sas[i].elts);
+    sas[i].elts = NULL;
+  }
+  free(keys);
+  free(elts);
+  free(sids);
+  free(sas);
+  keys = NULL;
+  elts = NULL;
+  sids = NULL;
+  sas = NULL;
+}
+
+/* Delegation */
+
+/**
+   Runs a test of the delegation mode on distinct keys and size_t elements
+   across key sizes >= sizeof(size_t) and load factor upper bounds.
+*/
+void run_deleg_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps,
+			 size_t num_threads,
+			 size_t log_num_locks,
+			 size_t num_grow_threads,
+			 size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a delegation test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# owners:         %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      deleg(num_ins,
+	    key_size,
+	    alpha_n,
+	    log_alpha_d,
+	    num_threads,
+	    log_num_locks,
+	    num_grow_threads,
+	    batch_count);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+void add_uint(void *elt, const void *ins_elt, size_t elt_size){
+  size_t *s = elt;
+  const size_t *t = ins_elt;
+  *s += *t;
+  (void)elt_size;
+}
+
+typedef struct{
+  size_t count;
+  size_t batch_count;
+  int is_deleg;
+  const unsigned char *keys;
+  const void *elts;
+  ht_divchn_pthread_t *ht;
+} deleg_arg_t;
+
+void *deleg_thread(void *arg){
+  size_t i, n;
+  const unsigned char *k = NULL;
+  const void *e = NULL;
+  const deleg_arg_t *da = arg;
+  for (i = 0; i < da->count; i += da->batch_count){
+    k = ptr(da->keys, i, da->ht->key_size);
+    e = ptr(da->elts, i, da->ht->elt_size);
+    n = (da->count - i < da->batch_count) ? da->count - i : da->batch_count;
+    if (da->is_deleg){
+      ht_divchn_pthread_deleg_insert(da->ht, k, e, n);
+    }else{
+      ht_divchn_pthread_insert(da->ht, k, e, n);
+    }
+  }
+  return NULL;
+}
+
+/**
+   Runs num_threads threads, each inserting all keys, with the
+   ht_divchn_pthread_insert operation or in the delegation mode with
+   num_threads owners, and returns the wall time until all keys are
+   inserted.
+*/
+double deleg_insert_keys(ht_divchn_pthread_t *ht,
+			 const unsigned char *keys,
+			 const void *elts,
+			 size_t count,
+			 size_t num_threads,
+			 size_t batch_count,
+			 int is_deleg){
+  size_t i;
+  double t;
+  pthread_t *ids = NULL;
+  deleg_arg_t da;
+  ids = malloc_perror(num_threads, sizeof(pthread_t));
+  da.count = count;
+  da.batch_count = batch_count;
+  da.is_deleg = is_deleg;
+  da.keys = keys;
+  da.elts = elts;
+  da.ht = ht;
+  t = timer();
+  if (is_deleg) ht_divchn_pthread_deleg_start(ht, num_threads);
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&ids[i], deleg_thread, &da);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(ids[i], NULL);
+  }
+  if (is_deleg) ht_divchn_pthread_deleg_stop(ht);
+  t = timer() - t;
+  free(ids);
+  ids = NULL;
+  return t;
+}
+
+/**
+   Inserts all keys with an add reduction by num_threads threads, with
+   the ht_divchn_pthread_insert operation and in two sessions of the
+   delegation mode, which grow the hash table and then update its keys.
+   Tests that each element is the sum of the inserted elements of its key
+   and that the hash table is searched and its keys are removed after the
+   delegation mode is stopped.
+*/
+void deleg(size_t num_ins,
+	   size_t key_size,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count){
+  int res = 1;
+  int is_deleg;
+  size_t i, j;
+  size_t init_count;
+  size_t elt_size = sizeof(size_t);
+  size_t *elt = NULL;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  size_t *elts = NULL;
+  double t;
+  ht_divchn_pthread_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    elts[i] = 1;
+  }
+  for (is_deleg = 0; is_deleg <= 1; is_deleg++){
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   0,
+			   alpha_n,
+			   log_alpha_d,
+			   log_num_locks,
+			   num_grow_threads,
+			   NULL,
+			   NULL,
+			   add_uint,
+			   NULL);
+    ht_divchn_pthread_align_elt(&ht, sizeof(size_t));
+    init_count = ht.count;
+    t = deleg_insert_keys(&ht, keys, elts, num_ins, num_threads,
+			  batch_count, is_deleg);
+    if (is_deleg){
+      res *= (init_count < ht.count || num_ins <= ht.max_num_elts);
+      t += deleg_insert_keys(&ht, keys, elts, num_ins, num_threads,
+			     batch_count, is_deleg);
+      printf("\t\tdelegation add time (x2):           "
+	     "%.4f seconds\n", t);
+    }else{
+      t += deleg_insert_keys(&ht, keys, elts, num_ins, num_threads,
+			     batch_count, is_deleg);
+      printf("\t\tlocked add time (x2):               "
+	     "%.4f seconds\n", t);
+    }
+    res *= (ht_divchn_pthread_num_elts(&ht) == num_ins);
+    for (i = 0; i < num_ins; i++){
+      elt = ht_divchn_pthread_search(&ht, ptr(keys, i, key_size));
+      res *= (elt != NULL && *elt == 2 * num_threads);
+    }
+    ht_divchn_pthread_delete(&ht, keys, num_ins);
+    res *= (ht_divchn_pthread_num_elts(&ht) == 0);
+    for (i = 0; i < num_ins; i++){
+      res *= (ht_divchn_pthread_search(&ht, ptr(keys, i, key_size)) ==
+	      NULL);
+    }
+    free_ht(&ht, 0);
+  }
+  printf("\t\tdelegation correctness:             ");
+  print_test_result(res);
+  free(keys);
+  free(elts);
+  keys = NULL;
+  elts = NULL;
+}
+
+/* Stats */
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+/**
+   Runs a ht_divchn_pthread_stats test on distinct keys and size_t
+   elements across key sizes >= sizeof(size_t) and load factor upper
+   bounds. The test is compiled if HT_DIVCHN_PTHREAD_STATS is defined.
+*/
+void run_stats_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps,
+			 size_t num_threads,
+			 size_t log_num_locks,
+			 size_t num_grow_threads,
+			 size_t batch_count){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_pthread_stats test on distinct %lu-byte "
+	   "keys and size_t elements\n", TOLU(key_size));
+    printf("\t# threads (nt):   %lu\n"
+	   "\t# locks:          %lu\n"
+	   "\t# grow threads:   %lu\n"
+	   "\tbatch count:      %lu\n",
+	   TOLU(num_threads),
+	   TOLU(pow_two_perror(log_num_locks)),
+	   TOLU(num_grow_threads),
+	   TOLU(batch_count));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\t# inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      stats(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    num_threads,
+	    log_num_locks,
+	    num_grow_threads,
+	    batch_count,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Inserts num_ins keys with num_threads threads, removes half of the keys,
+   and compares the statistics with the hash table.
+*/
+void stats(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   size_t num_threads,
+	   size_t log_num_locks,
+	   size_t num_grow_threads,
+	   size_t batch_count,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t num_rem = num_ins / 2;
+  size_t num_slots = 0, num_keys = 0;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  void *rem_elts = NULL;
+  ht_divchn_pthread_t ht;
+  ht_divchn_pthread_stats_t st;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rem_elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      /* set random bytes in a key, each to RANDOM mod 2**CHAR_BIT */
+      *(unsigned char *)ptr(key, j, 1) = RANDOM();
+    }
+    /* set non-random bytes in a key, and create element */
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  ht_divchn_pthread_init(&ht,
+			 key_size,
+			 elt_size,
+			 0,
+			 alpha_n,
+			 log_alpha_d,
+			 log_num_locks,
+			 num_grow_threads,
+			 NULL,
+			 NULL,
+			 NULL,
+			 free_elt);
+  ht_divchn_pthread_align_elt(&ht, elt_alignment);
+  insert_keys_elts(&ht, keys, elts, num_ins, num_threads, batch_count, &res);
+  ht_divchn_pthread_remove(&ht, keys, rem_elts, num_rem);
+  for (i = 0; i < num_rem; i++){
+    res *= (val_elt(ptr(rem_elts, i, elt_size)) == i);
+  }
+  ht_divchn_pthread_stats(&ht, &st);
+  printf("\t\tchain length histogram:             ");
+  for (i = 0; i < HT_DIVCHN_PTHREAD_STATS_BINS; i++){
+    printf("%lu ", TOLU(st.chain_hist[i]));
+    num_slots += st.chain_hist[i];
+    num_keys += i * st.chain_hist[i];
+  }
+  printf("\n");
+  printf("\t\tmax chain length:                   %lu\n",
+	 TOLU(st.max_chain_len));
+  printf("\t\tgrows:                              %lu\n",
+	 TOLU(st.num_grows));
+  printf("\t\tgrow time, max:                     %.4f, %.4f seconds\n",
+	 (float)st.grow_time / CLOCKS_PER_SEC,
+	 (float)st.max_grow_time / CLOCKS_PER_SEC);
+  printf("\t\tallocated bytes:                    %lu\n",
+	 TOLU(st.num_bytes));
+  printf("\t\tlocks, acquisitions:                %lu, %lu\n",
+	 TOLU(st.num_locks), TOLU(st.num_lock_acqs));
+  printf("\t\tlock waits, max per lock:           %lu, %lu\n",
+	 TOLU(st.num_lock_waits), TOLU(st.max_lock_waits));
+  printf("\t\tlock wait time:                     %.4f seconds\n",
+	 st.lock_wait_time);
+  res *= (num_slots == ht.count);
+  res *= (st.max_chain_len >= HT_DIVCHN_PTHREAD_STATS_BINS - 1 ?
+	  num_keys <= ht_divchn_pthread_num_elts(&ht) :
+	  num_keys == ht_divchn_pthread_num_elts(&ht));
+  res *= (st.num_elts == num_ins - num_rem && st.count == ht.count);
+  res *= (st.num_grows > 0 || ht.count_ix == 0);
+  res *= (st.num_bytes >= ht.count * sizeof(void *));
+  res *= (st.num_locks == ht.key_locks_mask + 1);
+  res *= (st.num_lock_acqs >= num_ins + num_rem);
+  res *= (st.max_lock_waits <= st.num_lock_waits &&
+	  st.num_lock_waits <= st.num_lock_acqs);
+  free_ht(&ht, 0);
+  printf("\t\tstats correctness:                  ");
+  print_test_result(res);
+  free(keys);
+  free(elts);
+  free(rem_elts);
+  keys = NULL;
+  elts = NULL;
+  rem_elts = NULL;
+}
+#endif
+
+/**
+   Runs a corner cases test.
+*/
+void run_corner_cases_test(size_t log_ins){
+  int res = 1;
+  size_t i, j;
+  size_t elt;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t key_size;
+  size_t num_ins;
+  unsigned char *key = NULL;
+  ht_divchn_pthread_t ht;
+  num_ins = pow_two_perror(log_ins);
+  key = malloc_perror(1, pow_two_perror(C_CORNER_LOG_KEY_END));
+  for (i = 0; i < pow_two_perror(C_CORNER_LOG_KEY_END); i++){
+    key[i] = RANDOM();
+  }
+  printf("Run corner cases test --> ");
+  for (i = C_CORNER_LOG_KEY_START; i <= C_CORNER_LOG_KEY_END; i++){
+    key_size = pow_two_perror(i);
+    ht_divchn_pthread_init(&ht,
+			   key_size,
+			   elt_size,
+			   C_CORNER_MIN_NUM,
+			   C_CORNER_ALPHA_N,
+			   C_CORNER_LOG_ALPHA_D,
+			   C_CORNER_NUM_LOCKS,
+			   C_CORNER_NUM_GROW_THREADS,
+			   NULL,
+			   NULL,
+			   NULL,
+			   NULL);
+    ht_divchn_pthread_align_elt(&ht, elt_alignment);
+    for (j = 0; j < num_ins; j++){
+      elt = j;
+      ht_divchn_pthread_insert(&ht, key, &elt, 1);
+    }
+    res *= (ht.count_ix == 0 &&
+	    ht.count == C_CORNER_HT_COUNT &&
+	    ht_divchn_pthread_num_elts(&ht) == 1 &&
+	    *(size_t *)ht_divchn_pthread_search(&ht, key) == elt);
+    ht_divchn_pthread_delete(&ht, key, 1);
+    res *= (ht.count == C_CORNER_HT_COUNT &&
+	    ht_divchn_pthread_num_elts(&ht) == 0 &&
+	    ht_divchn_pthread_search(&ht, key) == NULL);
+    ht_divchn_pthread_free(&ht);
+  }
+  print_test_result(res);
+  free(key);
+  key = NULL;
+}
+
+/**
+   Helper functions.
+*/
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
+
+/**
+   Prints a test result.
+*/
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+/**
+   Times execution.
+*/
+double timer(){
+  struct timeval tm;
+  gettimeofday(&tm, NULL);
+  return tm.tv_sec + tm.tv_usec / 1e6;
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_MAX){
+    fprintf(stderr, "USAGE:\n%s%s", C_USAGE, C_USAGE_FLAGS);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_MAX - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_MAX - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_FULL_BIT - 2 || 
+      args[1] > C_FULL_BIT - 1 ||
+      args[2] > C_FULL_BIT - 1 ||
+      args[1] > args[2] ||
+      args[3] < 1 ||
+      args[4] < 1 ||
+      args[5] > C_FULL_BIT - 1 ||
+      args[3] > args[4] ||
+      args[6] < 1 ||
+      args[7] > 1 ||
+      args[8] > 1 ||
+      args[9] > 1 ||
+      args[10] > 1 ||
+      args[11] > 1 ||
+      args[12] > 1 ||
+      args[13] > 1 ||
+      args[14] > 1 ||
+      args[15] > 1 ||
+      args[16] > 1 ||
+      args[17] > 1 ||
+      args[18] > 1 ||
+      args[19] > 1 ||
+      args[20] > 1){
+    fprintf(stderr, "USAGE:\n%s%s", C_USAGE, C_USAGE_FLAGS);
+    exit(EXIT_FAILURE);
+  }
+  if (args[7]) run_insert_search_free_uint_test(args[0],
+						args[1],
+						args[2],
+						args[3],
+						args[4],
+						args[5],
 						args[6],
 						4,
 						15,
@@ -1100,6 +2996,107 @@ int main(int argc, char *argv[]){
 						4,
 						1000);
   if (args[11]) run_corner_cases_test(args[0]); 
+  if (args[12]) run_iter_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6],
+				   4,
+				   15,
+				   4,
+				   1000);
+  if (args[13]) run_search_batch_uint_test(args[0],
+					   args[1],
+					   args[2],
+					   args[3],
+					   args[4],
+					   args[5],
+					   args[6],
+					   4,
+					   15,
+					   4,
+					   1000);
+  if (args[14]) run_incr_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6],
+				   4,
+				   15,
+				   4,
+				   1000);
+  if (args[15]) run_grouped_uint_test(args[0],
+				      args[1],
+				      args[2],
+				      args[3],
+				      args[4],
+				      args[5],
+				      args[6],
+				      4,
+				      6,
+				      4,
+				      1000);
+  if (args[16]) run_locks_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6],
+				    4,
+				    0,
+				    4,
+				    1000);
+  if (args[17]) run_pools_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6],
+				    4,
+				    15,
+				    4,
+				    1000);
+  if (args[18]) run_gate_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6],
+				   4,
+				   15,
+				   4,
+				   10);
+  if (args[19]) run_deleg_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6],
+				    4,
+				    15,
+				    4,
+				    100);
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  if (args[20]) run_stats_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6],
+				    4,
+				    15,
+				    4,
+				    1000);
+#endif
   free(args);
   args = NULL;
   return 0;
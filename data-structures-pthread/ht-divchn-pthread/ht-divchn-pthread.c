@@ -19,6 +19,124 @@
    after the maximum representable count of slots in a hash table is
    reached.
 
+   The keys of a hash table are enumerated with a cursor, with a foreach
+   operation, or are copied with their elements into contiguous arrays
+   with a multithreaded export operation, before/after all threads
+   started/completed insert, remove, and delete operations.
+
+   A hash table grows in a single step by default, in which the threads
+   wait at the gate while num_grow_threads threads move all keys. In the
+   optional incremental mode of growth, a growth step only allocates the
+   new slots and keeps the previous slots, and each subsequent insert,
+   remove, delete, and search_batch operation claims a bounded range of
+   previous slots and moves their keys, concurrently with the operations
+   of other threads, until all keys are moved. During the migration of
+   keys, an operation on a key locks the slot and the previous slot of the
+   key in the order of lock indices, and consults the slot and then the
+   previous slot. The previous slots are freed by the thread that
+   completes the migration, after it closes the gate and no thread is in
+   the hash table.
+
+   The keys of a growth step are moved by the closing thread and by
+   num_grow_threads - 1 worker threads that are created at the first
+   growth step that moves the keys of at least C_GROW_MIN_COUNT slots, and
+   are kept until the hash table is freed. Each worker is assigned a range
+   of previous slots and claims chunks of C_GROW_CHUNK slots from its
+   range, and a worker without slots steals the back half of the remaining
+   range of another worker, so that long chains do not leave the workers
+   idle. The keys of fewer slots are moved by the closing thread.
+
+   A thread enters and exits a hash table through one of a fixed number
+   of gate shards, each beginning at a cache line boundary, which is
+   selected by the pool of the thread or by the first key of a batch. A
+   shard counts the threads that are in the hash table and the net change
+   of the number of keys by the threads that exited, which is added to
+   the number of keys of the hash table when its magnitude exceeds a
+   threshold. The thread whose addition exceeds alpha closes the gate by
+   closing each shard and waiting until no thread is in the shard, and
+   grows the hash table in the resulting quiescent state. If the gate is
+   closed by another thread, the thread waits until the gate is opened
+   and grows the hash table if alpha is still exceeded, so that a growth
+   step due to a batch is completed when the batch returns. As a result,
+   the entry and exit of a batch lock only its shard, and the threads
+   share gate_lock only when they add the counts of a shard, claim and
+   record the migration of keys, or register a pool. The number of keys
+   is read with ht_divchn_pthread_num_elts.
+
+   In the optional grouped mode, an insert, remove, delete, and
+   search_batch operation hashes its batch and partitions the keys by
+   their locks with a stable radix sort, taking each lock once for all
+   keys of the batch that are covered by the lock, instead of once for
+   each key. The relative order of the keys covered by a lock is kept,
+   so that the keys that are inserted more than once in a batch are
+   reduced or updated in the order of the batch. The grouped mode is not
+   applied to the batches that enter a hash table during the migration
+   of keys.
+
+   A batch of keys is searched with ht_divchn_pthread_search_batch
+   concurrently with insert, remove, and delete operations, including
+   growth steps. A search batch is not lock-free: it enters a hash table
+   through a gate shard as a modifying batch, waits while the gate is
+   closed, and copies the element of each found key under the stripe lock
+   of the key's slot, because a pointer to an in-table element may be
+   invalidated by another thread.
+
+   The slots are synchronized with lock stripes, each beginning at a cache
+   line boundary and padded to a multiple of the cache line size, so that
+   the locks of different stripes do not share a cache line. A stripe
+   holds a mutex, a spinlock, or a ticket lock, selected with
+   ht_divchn_pthread_locks. A ticket lock grants the lock in the order of
+   arrival and is built from a mutex and a condition variable, because
+   C89/C90 provides no atomic operations. Optionally, the number of
+   stripes is doubled at growth steps, upto a set maximum and at most one
+   stripe per slot.
+
+   The nodes of the chains are allocated from slab allocators, one per
+   lock stripe, and each allocator is accessed by a thread that holds the
+   lock of its stripe. A node is returned for reuse to the allocator of
+   the lock of its current slot, and the slabs of all allocators are
+   released in bulk when the hash table is freed, without visiting the
+   nodes if the elements do not require free_elt.
+
+   Optionally, a thread registers its own node pool with a hash table
+   with ht_divchn_pthread_pool_init and calls the *_pool variants of
+   insert, remove, and delete operations. The nodes of a batch of an
+   insert operation are then allocated from the slab allocator of the
+   pool and constructed before the thread enters a hash table, so that
+   neither an allocation nor a copy of a key or an element is made
+   under a lock, the unused nodes are returned to the pool after the
+   batch, and the nodes of the keys removed or deleted by the thread are
+   returned to its pool for reuse. The slabs of all registered pools are
+   released in bulk when the hash table is freed.
+
+   In the optional delegation mode, started with
+   ht_divchn_pthread_deleg_start and stopped with
+   ht_divchn_pthread_deleg_stop, the slots are partitioned into
+   contiguous ranges, each owned by an owner thread. A thread calling
+   ht_divchn_pthread_deleg_insert copies its batch into a parcel for each
+   owner whose range contains the slot of a key, and queues the parcels.
+   An owner inserts the keys of its parcels, and reduces or updates the
+   elements, without locking a slot, and forwards a key to the owner of
+   its slot if the key was routed before a growth step. A growth step is
+   completed by the last owner that pauses, after the owner that exceeded
+   alpha requests the growth. The queues of owners share a single lock
+   that is taken once per parcel, instead of the lock of a slot taken
+   once per key, which removes the contention on the slots of frequent
+   keys, e.g. in aggregations with rdc_elts.
+
+   The slot of a key is computed without a division instruction, with a
+   reciprocal of the count of slots that is precomputed with mod_rcp_init
+   when the count changes during a growth step.
+
+   If HT_DIVCHN_PTHREAD_STATS is defined at compile time, a hash table
+   maintains statistics that are read with ht_divchn_pthread_stats before/
+   after all threads started/completed insert, remove, and delete
+   operations, including the distribution of chain lengths, the growth
+   events and their processor times, the number of allocated bytes, and
+   the lock acquisitions, waits, and wall times of waits, which are
+   counted per stripe by the thread that holds the lock of the stripe.
+   Otherwise, the statistics and their instrumentation are not compiled.
+
    A hash table is modified by threads calling insert, remove, and/or delete
    operations concurrently. The design provides the following guarantees
    with respect to the final state of a hash table, defined as a pair of
@@ -49,7 +167,8 @@
    growth step, in which case alpha no longer bounds the load factor
 
    ** to the extent dependent on the number of threads that passed the
-   first critical section and their batch sizes
+   first critical section and their batch sizes, and the keys counted in
+   the shards and not yet added, at most max_num_elts / 8 keys
 */
 
 #define _XOPEN_SOURCE 600
@@ -59,7 +178,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <errno.h>
 #include <pthread.h>
+#ifdef HT_DIVCHN_PTHREAD_STATS
+#include <sys/time.h>
+#endif
 #include "ht-divchn-pthread.h"
 #include "dll.h"
 #include "utilities-mem.h"
@@ -137,13 +260,195 @@ static const size_t C_BUILD_SHIFT = 16;
 static const size_t C_BYTE_BIT = CHAR_BIT;
 static const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 static const size_t C_SIZE_MAX = (size_t)-1;
+static const size_t C_SLAB_MAX_NUM_NODES = 4096;
+static const size_t C_CACHE_LINE_SIZE = 64; /* typical, a multiple is ok */
+static const size_t C_NUM_SHARDS = 31; /* prime, spreads batch first keys */
+static const size_t C_FOLD_DIV = 8; /* unadded keys <= max_num_elts / 8 */
+static const size_t C_GROW_CHUNK = 256; /* slots claimed at once */
+static const size_t C_GROW_MIN_COUNT = 4096; /* slots for grow workers */
+
+/* range of previous slots of a grow worker, [start, end) not claimed */
+typedef struct{
+  pthread_mutex_t lock;
+  size_t start;
+  size_t end;
+} grow_range_t;
+
+/* persistent grow workers; worker 0 is the thread that grows the table */
+typedef struct{
+  pthread_mutex_t lock;
+  pthread_cond_t start_cond;
+  pthread_cond_t done_cond;
+  size_t epoch; /* number of started reinsertions */
+  size_t num_active; /* workers that did not complete the epoch */
+  int is_exit;
+  size_t num_workers;
+  dll_node_t **prev_key_elts;
+  ht_divchn_pthread_t *ht;
+  pthread_t *ids; /* workers 1, ..., num_workers - 1 */
+  grow_range_t *ranges;
+} grow_workers_t;
+
+typedef struct{
+  grow_workers_t *gw;
+  size_t ix;
+} grow_worker_arg_t;
+
+/* keys and elements queued to an owner in the delegation mode */
+typedef struct deleg_parcel{
+  struct deleg_parcel *next;
+  size_t num;
+  size_t cap; /* >= num, number of keys with room */
+  void *keys;
+  void *elts;
+} deleg_parcel_t;
+
+typedef struct{
+  pthread_cond_t cond; /* parcels queued, growth requested, or stop */
+  deleg_parcel_t *head;
+  deleg_parcel_t *tail;
+  ht_divchn_pthread_pool_t pool; /* registered, slabs released at free */
+  pthread_t id;
+} deleg_owner_t;
+
+/* delegation state; kept until free, because the pools are registered */
+typedef struct deleg{
+  struct deleg *next;
+  ht_divchn_pthread_t *ht;
+  pthread_mutex_t lock; /* queues, routing, and the growth barrier */
+  pthread_cond_t grow_cond;
+  pthread_cond_t idle_cond;
+  size_t num_owners;
+  size_t range; /* >= 1, slots of an owner, the last may own fewer */
+  mod_rcp_t count_rcp; /* count of slots used by callers in routing */
+  size_t num_pending; /* parcels queued or being inserted */
+  size_t num_paused;
+  size_t grow_gen; /* number of completed growth barriers */
+  int is_grow;
+  int is_stop;
+  deleg_owner_t *owners;
+} deleg_t;
 
+typedef struct{
+  deleg_t *d;
+  size_t ix;
+} deleg_owner_arg_t;
+
+static size_t convert_std_key(const ht_divchn_pthread_t *ht,
+			      const void *key);
 static size_t hash(const ht_divchn_pthread_t *ht, const void *key);
+static void spin_init_perror(pthread_spinlock_t *spin);
+static void spin_lock_perror(pthread_spinlock_t *spin);
+#ifdef HT_DIVCHN_PTHREAD_STATS
+static int spin_trylock_perror(pthread_spinlock_t *spin);
+#endif
+static void spin_unlock_perror(pthread_spinlock_t *spin);
+static ht_divchn_pthread_stripe_t *stripe(const ht_divchn_pthread_t *ht,
+					  size_t lock_ix);
+static void *stripes_alloc(const ht_divchn_pthread_t *ht, size_t num_locks);
+static void stripe_lock(const ht_divchn_pthread_t *ht, size_t lock_ix);
+static void stripe_unlock(const ht_divchn_pthread_t *ht, size_t lock_ix);
+static void scale_locks(ht_divchn_pthread_t *ht);
+static ht_divchn_pthread_shard_t *shard(const ht_divchn_pthread_t *ht,
+					size_t shard_ix);
+static void *shards_alloc(const ht_divchn_pthread_t *ht);
+static size_t select_shard(const ht_divchn_pthread_t *ht,
+			   const ht_divchn_pthread_pool_t *pool,
+			   const void *batch_keys,
+			   size_t batch_count);
+static void gate_enter(ht_divchn_pthread_t *ht,
+		       size_t shard_ix,
+		       size_t batch_count,
+		       size_t *mig_start,
+		       size_t *mig_count);
+static void gate_exit(ht_divchn_pthread_t *ht,
+		      size_t shard_ix,
+		      size_t mig_count,
+		      size_t added,
+		      size_t removed);
+static int is_grow_due(const ht_divchn_pthread_t *ht);
+static void gate_quiesce(ht_divchn_pthread_t *ht, int is_grow);
+static dll_node_t *lock_search(ht_divchn_pthread_t *ht,
+			       const void *key,
+			       dll_node_t ***head,
+			       size_t *lock_ix,
+			       size_t *prev_lock_ix);
+static void unlock_slots(ht_divchn_pthread_t *ht,
+			 size_t lock_ix,
+			 size_t prev_lock_ix);
+static void mig_claim(ht_divchn_pthread_t *ht,
+		      size_t batch_count,
+		      size_t *start,
+		      size_t *count);
+static int mig_finish(ht_divchn_pthread_t *ht, size_t count);
+static void migrate(ht_divchn_pthread_t *ht, size_t start, size_t count);
+static size_t *group_batch(const ht_divchn_pthread_t *ht,
+			   const void *batch_keys,
+			   size_t batch_count);
+static dll_node_t *batch_search(ht_divchn_pthread_t *ht,
+				const size_t *grp,
+				const void *batch_keys,
+				size_t j,
+				size_t *i,
+				dll_node_t ***head,
+				size_t *lock_ix,
+				size_t *prev_lock_ix);
+static void batch_unlock(ht_divchn_pthread_t *ht,
+			 const size_t *grp,
+			 size_t j,
+			 size_t batch_count,
+			 size_t lock_ix,
+			 size_t prev_lock_ix);
+static void reinsert(ht_divchn_pthread_t *ht,
+		     dll_node_t **prev_key_elts,
+		     size_t start,
+		     size_t count);
+static void reinsert_slots(ht_divchn_pthread_t *ht,
+			   dll_node_t **prev_key_elts,
+			   size_t start,
+			   size_t end);
+static grow_workers_t *workers_create(ht_divchn_pthread_t *ht);
+static void *worker_thread(void *arg);
+static void worker_run(grow_workers_t *gw, size_t ix);
+static int worker_claim(grow_workers_t *gw,
+			size_t ix,
+			size_t *start,
+			size_t *end);
+static void workers_free(grow_workers_t *gw);
+static void mig_complete(ht_divchn_pthread_t *ht);
+static void deleg_route(deleg_t *d);
+static deleg_parcel_t *parcel_new(const ht_divchn_pthread_t *ht,
+				  size_t count);
+static void parcel_push(const ht_divchn_pthread_t *ht,
+			deleg_parcel_t *p,
+			const void *key,
+			const void *elt);
+static void parcel_free(deleg_parcel_t *p);
+static void deleg_enqueue(deleg_t *d, deleg_parcel_t **ps);
+static void *deleg_owner_thread(void *arg);
+static size_t deleg_apply(deleg_t *d,
+			  size_t ix,
+			  const deleg_parcel_t *p,
+			  deleg_parcel_t **fwd);
+static void deleg_pause(deleg_t *d);
+static const dll_node_t *cursor_head(const ht_divchn_pthread_t *ht,
+				     size_t ix);
+static size_t num_slots(const ht_divchn_pthread_t *ht);
 static size_t mul_alpha_sz_max(size_t n, size_t alpha_n, size_t log_alpha_d);
 static void ht_grow(ht_divchn_pthread_t *ht);
+static size_t export_slots(const ht_divchn_pthread_t *ht,
+			   size_t start,
+			   size_t count,
+			   char *keys,
+			   char *elts,
+			   size_t num);
 static int incr_count(ht_divchn_pthread_t *ht);
 static int is_overflow(size_t start, size_t count);
 static size_t build_prime(size_t start, size_t count);
+#ifdef HT_DIVCHN_PTHREAD_STATS
+static double wall_time(void);
+static void stats_chain(ht_divchn_pthread_stats_t *stats, size_t len);
+#endif
 static void *ptr(const void *block, size_t i, size_t size);
 
 /**
@@ -164,16 +469,20 @@ static void *ptr(const void *block, size_t i, size_t size);
                       resulting in a speedup by avoiding unnecessary growth
                       steps of a hash table; 0 if a positive value is not
                       specified and all growth steps are to be completed
-   alpha_n           : > 0 numerator of load factor upper bound
+   alpha_n          : > 0 numerator of load factor upper bound
    log_alpha_d      : < CHAR_BIT * sizeof(size_t) log base 2 of denominator
                       of load factor upper bound; denominator is a power of
                       two
-   log_num_locks    : log base 2 number of mutex locks for synchronizing
-                      insert, remove, and delete operations; a larger number
-                      reduces the size of a set of slots that maps to a lock
-                      and may reduce the time threads are blocked, depending
-                      on the scheduler and at the expense of space
-   num_grow_threads : >= 1, number of threads used in growing the hash table
+   log_num_locks    : log base 2 number of stripe locks of the kind
+                      selected with ht_divchn_pthread_locks, for
+                      synchronizing insert, remove, delete, and search_batch
+                      operations; a larger number reduces the size of a set
+                      of slots that maps to a lock and may reduce the time
+                      threads are blocked, depending on the scheduler and at
+                      the expense of space
+   num_grow_threads : >= 1, number of threads used in growing the hash
+                      table, including the thread that grows the hash
+                      table; the other threads are kept until free
    cmp_key          : - if NULL then a default memcmp-based comparison of 
                       keys is performed
                       - otherwise comparison function is applied which
@@ -229,6 +538,7 @@ void ht_divchn_pthread_init(ht_divchn_pthread_t *ht,
   ht->group_ix = 0;
   ht->count_ix = 0;
   ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+  mod_rcp_init(&ht->count_rcp, ht->count);
   /* 0 <= max_num_elts */
   ht->max_num_elts = mul_alpha_sz_max(ht->count, alpha_n, log_alpha_d);
   while (min_num > ht->max_num_elts && incr_count(ht));
@@ -240,20 +550,55 @@ void ht_divchn_pthread_init(ht_divchn_pthread_t *ht,
   for (i = 0; i < ht->count; i++){
     dll_init(ht->ll, &ht->key_elts[i], ht->key_size);
   }
+  /* incremental growth */
+  ht->is_incr = 0;
+  ht->prev_count = 0;
+  ht->mig_ix = 0;
+  ht->mig_done = 0;
+  ht->mig_step = 0;
+  ht->prev_key_elts = NULL;
+  /* batch processing */
+  ht->is_grouped = 0;
   /* thread synchronization */
-  ht->num_in_threads = 0;
   ht->num_grow_threads = num_grow_threads;
   key_locks_count = pow_two_perror(log_num_locks);
   ht->key_locks_mask = C_SIZE_MAX & (key_locks_count - 1);
+  ht->max_num_locks = key_locks_count;
+  ht->stripe_size =
+    (sizeof(ht_divchn_pthread_stripe_t) + C_CACHE_LINE_SIZE - 1) /
+    C_CACHE_LINE_SIZE * C_CACHE_LINE_SIZE;
+  ht->lock_kind = HT_DIVCHN_PTHREAD_MUTEX;
+  ht->shard_size =
+    (sizeof(ht_divchn_pthread_shard_t) + C_CACHE_LINE_SIZE - 1) /
+    C_CACHE_LINE_SIZE * C_CACHE_LINE_SIZE;
+  ht->next_shard = 0;
+  ht->fold_thresh = ht->max_num_elts / (C_NUM_SHARDS * C_FOLD_DIV);
   ht->gate_open = TRUE;
   mutex_init_perror(&ht->gate_lock);
-  ht->key_locks = malloc_perror(key_locks_count,
-				sizeof(pthread_mutex_t));
-  for (i = 0; i < key_locks_count; i++){
-    mutex_init_perror(&ht->key_locks[i]);
-  }
   cond_init_perror(&ht->gate_open_cond);
-  cond_init_perror(&ht->grow_cond);
+  ht->shards = shards_alloc(ht);
+  ht->stripes = stripes_alloc(ht, key_locks_count);
+  ht->pools = NULL;
+  ht->workers = NULL;
+  ht->delegs = NULL;
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  /* statistics */
+  for (i = 0; i < HT_DIVCHN_PTHREAD_STATS_BINS; i++){
+    ht->stats.chain_hist[i] = 0;
+  }
+  ht->stats.max_chain_len = 0;
+  ht->stats.num_elts = 0;
+  ht->stats.count = 0;
+  ht->stats.num_grows = 0;
+  ht->stats.grow_time = 0;
+  ht->stats.max_grow_time = 0;
+  ht->stats.num_bytes = 0;
+  ht->stats.num_locks = 0;
+  ht->stats.num_lock_acqs = 0;
+  ht->stats.num_lock_waits = 0;
+  ht->stats.max_lock_waits = 0;
+  ht->stats.lock_wait_time = 0.0;
+#endif
   /* function pointers */
   ht->cmp_key = cmp_key;
   ht->rdc_key = rdc_key;
@@ -278,85 +623,343 @@ void ht_divchn_pthread_init(ht_divchn_pthread_t *ht,
                  which is used to access an elt_size block
 */
 void ht_divchn_pthread_align_elt(ht_divchn_pthread_t *ht, size_t alignment){
+  size_t i;
   ht->elt_alignment = alignment;
   dll_align_elt(ht->ll, alignment);
+  for (i = 0; i <= ht->key_locks_mask; i++){
+    dll_slab_init(&stripe(ht, i)->slab,
+		  ht->ll,
+		  ht->elt_size,
+		  C_SLAB_MAX_NUM_NODES);
+  }
 }
 
 /**
-   Inserts a batch of keys and associated elements into a hash table.
-   The batch_keys and batch_elts parameters are not NULL and point to
-   arrays of blocks of size key_size and elt_size respectively. The
-   batch_count parameter is the count of keys in a batch. See also the
-   specification of rdc_elts in ht_divchn_pthread_init.
+   Sets the mode of growth of a hash table. In the incremental mode, a
+   growth step allocates the new slots, and the keys in the previous slots
+   are moved by the subsequent insert, remove, delete, and search_batch
+   operations of all threads, each operation moving the keys of a range of
+   previous slots that is proportional to its batch count. The number of
+   previous slots migrated per key is set at each growth step s.t. the
+   migration is completed before the next growth step is due. As a result,
+   the threads wait at the gate only for the allocation of the new slots.
+   The operation is optionally called after ht_divchn_pthread_init is
+   completed and before any operation other than
+   ht_divchn_pthread_align_elt is called.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   is_incr     : non-zero to set the incremental mode, zero to set the
+                 default mode of growth in a single step
 */
-void ht_divchn_pthread_insert(ht_divchn_pthread_t *ht,
-			      const void *batch_keys,
-			      const void *batch_elts,
-			      size_t batch_count){
-  size_t i, ix, lock_ix;
+void ht_divchn_pthread_incr(ht_divchn_pthread_t *ht, int is_incr){
+  ht->is_incr = is_incr;
+}
+
+/**
+   Sets the mode of batch processing of a hash table. In the grouped mode,
+   the keys of a batch of an insert, remove, delete, or search_batch
+   operation are grouped by their locks with a radix sort of lock indices
+   in a block of 4 * batch_count size_t values allocated by the operation,
+   and each lock is taken once per batch. The grouped mode reduces the
+   synchronization cost per key if a batch has more keys than the number
+   of locks, or the keys are skewed towards a subset of locks. The
+   operation is optionally called after ht_divchn_pthread_init is
+   completed and before any operation other than
+   ht_divchn_pthread_align_elt and ht_divchn_pthread_incr is called.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   is_grouped  : non-zero to set the grouped mode, zero to set the default
+                 mode of taking a lock for each key of a batch
+*/
+void ht_divchn_pthread_grouped(ht_divchn_pthread_t *ht, int is_grouped){
+  ht->is_grouped = is_grouped;
+}
+
+/**
+   Sets the kind of the locks of the lock stripes of a hash table and the
+   maximum number of stripes. A mutex is the default and suits the
+   threads that may be descheduled while holding a lock, a spinlock
+   suits short critical sections with fewer threads than processors, and
+   a ticket lock grants the lock in the order of arrival. At each growth
+   step, the number of stripes is doubled while it is less than the
+   maximum number of stripes and at most half of the count of slots. The
+   operation is optionally called after ht_divchn_pthread_init is
+   completed and before any operation other than
+   ht_divchn_pthread_align_elt, ht_divchn_pthread_incr, and
+   ht_divchn_pthread_grouped is called.
+   ht                : pointer to an initialized ht_divchn_pthread_t struct
+   lock_kind         : HT_DIVCHN_PTHREAD_MUTEX, HT_DIVCHN_PTHREAD_SPIN,
+                       or HT_DIVCHN_PTHREAD_TICKET
+   log_max_num_locks : < CHAR_BIT * sizeof(size_t), log base 2 of the
+                       maximum number of stripes; if it is not greater than
+                       log_num_locks, the number of stripes is not changed
+*/
+void ht_divchn_pthread_locks(ht_divchn_pthread_t *ht,
+			     ht_divchn_pthread_lock_kind_t lock_kind,
+			     size_t log_max_num_locks){
+  size_t num_locks = ht->key_locks_mask + 1;
+  size_t max_num_locks = pow_two_perror(log_max_num_locks);
+  /* no node was allocated from the slabs of the stripes */
+  free(ht->stripes);
+  ht->lock_kind = lock_kind;
+  ht->max_num_locks = (max_num_locks > num_locks) ? max_num_locks : num_locks;
+  ht->stripes = stripes_alloc(ht, num_locks);
+}
+
+/**
+   Initializes a node pool of a thread and registers the pool with a hash
+   table. The operation is called after ht_divchn_pthread_init and the
+   optional ht_divchn_pthread_align_elt are completed, and can be called
+   concurrently with the operations of other threads. A pool is used by
+   one thread at a time, and its block is not freed until the hash table
+   is freed with ht_divchn_pthread_free, which releases its slabs.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   pool        : pointer to a preallocated block of size
+                 sizeof(ht_divchn_pthread_pool_t)
+*/
+void ht_divchn_pthread_pool_init(ht_divchn_pthread_t *ht,
+				 ht_divchn_pthread_pool_t *pool){
+  dll_slab_init(&pool->slab, ht->ll, ht->elt_size, C_SLAB_MAX_NUM_NODES);
+  pool->num_nodes = 0;
+  pool->nodes = NULL;
+  mutex_lock_perror(&ht->gate_lock);
+  pool->shard_ix = ht->next_shard;
+  ht->next_shard = (ht->next_shard + 1) % C_NUM_SHARDS;
+  pool->next = ht->pools;
+  ht->pools = pool;
+  mutex_unlock_perror(&ht->gate_lock);
+}
+
+/**
+   Inserts a batch of keys and associated elements into a hash table with
+   the nodes of a pool of the calling thread, which are constructed before
+   the thread enters the hash table. The pool parameter points to a pool
+   initialized with ht_divchn_pthread_pool_init, or is NULL and the nodes
+   are allocated under the locks of their slots. Please see the parameter
+   specification in ht_divchn_pthread_insert.
+*/
+void ht_divchn_pthread_insert_pool(ht_divchn_pthread_t *ht,
+				   ht_divchn_pthread_pool_t *pool,
+				   const void *batch_keys,
+				   const void *batch_elts,
+				   size_t batch_count){
+  size_t i, j, lock_ix, prev_lock_ix;
+  size_t mig_start, mig_count;
   size_t increased = 0;
+  size_t *grp = NULL;
   const void *key = NULL, *elt = NULL;
-  dll_node_t **head = NULL, *node = NULL;
-  /* first critical section : go through gate or wait */
-  mutex_lock_perror(&ht->gate_lock);
-  while (!ht->gate_open){
-    cond_wait_perror(&ht->gate_open_cond, &ht->gate_lock);
+  size_t shard_ix;
+  dll_node_t **head = NULL, *node = NULL, *staged = NULL;
+  /* construct the nodes of the batch outside of the hash table */
+  if (pool != NULL){
+    if (pool->num_nodes < batch_count){
+      pool->nodes = realloc_perror(pool->nodes,
+				   batch_count,
+				   sizeof(dll_node_t *));
+      pool->num_nodes = batch_count;
+    }
+    for (i = 0; i < batch_count; i++){
+      dll_prepend_new_slab(ht->ll,
+			   &pool->slab,
+			   &staged,
+			   ptr(batch_keys, i, ht->key_size),
+			   ptr(batch_elts, i, ht->elt_size),
+			   ht->key_size,
+			   ht->elt_size);
+      pool->nodes[i] = staged;
+    }
   }
-  ht->num_in_threads++;
-  mutex_unlock_perror(&ht->gate_lock);
+  /* first critical section : go through a gate shard or wait */
+  shard_ix = select_shard(ht, pool, batch_keys, batch_count);
+  gate_enter(ht, shard_ix, batch_count, &mig_start, &mig_count);
+  if (mig_count > 0) migrate(ht, mig_start, mig_count);
 
   /* insert */
-  for (i = 0; i < batch_count; i++){
+  grp = group_batch(ht, batch_keys, batch_count);
+  for (j = 0; j < batch_count; j++){
+    node = batch_search(ht, grp, batch_keys, j,
+			&i, &head, &lock_ix, &prev_lock_ix);
     key = ptr(batch_keys, i, ht->key_size);
     elt = ptr(batch_elts, i, ht->elt_size);
-    ix = hash(ht, key);
-    head = &ht->key_elts[ix];
-    lock_ix = ix & ht->key_locks_mask;
-    mutex_lock_perror(&ht->key_locks[lock_ix]);
-    node = dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
-    if (node == NULL){
+    if (node == NULL && pool != NULL){
+      /* move the constructed node of the key into the slot */
+      dll_remove(&staged, pool->nodes[i]);
+      dll_prepend(head, pool->nodes[i]);
+      increased++;
+    }else if (node == NULL){
       /* insert new key element pair */
-      dll_prepend_new(ht->ll, head, key, elt, ht->key_size, ht->elt_size);
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
+      dll_prepend_new_slab(ht->ll,
+			   &stripe(ht, lock_ix)->slab,
+			   head,
+			   key,
+			   elt,
+			   ht->key_size,
+			   ht->elt_size);
       increased++;
     }else if (ht->rdc_elts != NULL){
       /* reduce new element and current element */
       ht->rdc_elts(dll_elt_ptr(ht->ll, node), elt, ht->elt_size);
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
     }else{
       /* update current element to new element */
       if (ht->free_elt != NULL) ht->free_elt(dll_elt_ptr(ht->ll, node));
       memcpy(dll_elt_ptr(ht->ll, node), elt, ht->elt_size);
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
     }
+    batch_unlock(ht, grp, j, batch_count, lock_ix, prev_lock_ix);
   }
+  free(grp);
+  grp = NULL;
+  /* return the nodes of the keys that were in the hash table */
+  if (pool != NULL) dll_free_slab(ht->ll, &pool->slab, &staged, NULL);
 
-  /* grow ht if needed, and finish */
-  if (ht->count_ix != C_SIZE_MAX &&
-      ht->count_ix != C_PRIME_PARTS_COUNT){
-    mutex_lock_perror(&ht->gate_lock);
-    ht->num_elts += increased;
-    if (ht->num_elts > ht->max_num_elts && ht->gate_open){
-      ht->gate_open = FALSE;
-      /* wait for threads that passed first critical section to finish */
-      while (ht->num_in_threads > 1){
-	cond_wait_perror(&ht->grow_cond, &ht->gate_lock);
-      }
-      mutex_unlock_perror(&ht->gate_lock);
-      ht_grow(ht); /* single thread */
-      mutex_lock_perror(&ht->gate_lock);
-      ht->gate_open = TRUE;
-      cond_broadcast_perror(&ht->gate_open_cond);
-    }else if (!ht->gate_open){
-      cond_signal_perror(&ht->grow_cond);
-    }
-    ht->num_in_threads--;
-    mutex_unlock_perror(&ht->gate_lock);
-  }else{
-    mutex_lock_perror(&ht->gate_lock);
-    ht->num_elts += increased;
-    ht->num_in_threads--;
-    mutex_unlock_perror(&ht->gate_lock);
+  /* finish, and grow ht if needed */
+  gate_exit(ht, shard_ix, mig_count, increased, 0);
+}
+
+/**
+   Inserts a batch of keys and associated elements into a hash table.
+   The batch_keys and batch_elts parameters are not NULL and point to
+   arrays of blocks of size key_size and elt_size respectively. The
+   batch_count parameter is the count of keys in a batch. See also the
+   specification of rdc_elts in ht_divchn_pthread_init.
+*/
+void ht_divchn_pthread_insert(ht_divchn_pthread_t *ht,
+			      const void *batch_keys,
+			      const void *batch_elts,
+			      size_t batch_count){
+  ht_divchn_pthread_insert_pool(ht, NULL, batch_keys, batch_elts, batch_count);
+}
+
+/**
+   Starts the delegation mode of a hash table with num_owners owner
+   threads, each owning a contiguous range of slots. The operation is
+   called before/after all threads started/completed insert, remove,
+   delete, and search_batch operations on ht. Until the mode is stopped
+   with ht_divchn_pthread_deleg_stop, the hash table is modified only by
+   ht_divchn_pthread_deleg_insert, and is not accessed by other
+   operations. A migration of keys in the incremental mode is completed
+   when the mode is started, and the growth steps in the mode move all
+   keys. The nodes of an owner are allocated from a pool registered with
+   the hash table, which is released when the hash table is freed.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   num_owners  : >= 1, number of owner threads
+*/
+void ht_divchn_pthread_deleg_start(ht_divchn_pthread_t *ht,
+				   size_t num_owners){
+  size_t i;
+  deleg_t *d = malloc_perror(1, sizeof(deleg_t));
+  deleg_owner_t *o = NULL;
+  deleg_owner_arg_t *oa = NULL;
+  ht_divchn_pthread_shard_t *sh = NULL;
+  /* only the calling thread has access to the hash table */
+  mig_complete(ht);
+  for (i = 0; i < C_NUM_SHARDS; i++){
+    sh = shard(ht, i);
+    ht->num_elts += sh->num_elts;
+    sh->num_elts = 0;
+  }
+  d->ht = ht;
+  mutex_init_perror(&d->lock);
+  cond_init_perror(&d->grow_cond);
+  cond_init_perror(&d->idle_cond);
+  d->num_owners = num_owners;
+  deleg_route(d);
+  d->num_pending = 0;
+  d->num_paused = 0;
+  d->grow_gen = 0;
+  d->is_grow = 0;
+  d->is_stop = 0;
+  d->owners = malloc_perror(num_owners, sizeof(deleg_owner_t));
+  for (i = 0; i < num_owners; i++){
+    o = &d->owners[i];
+    cond_init_perror(&o->cond);
+    o->head = NULL;
+    o->tail = NULL;
+    ht_divchn_pthread_pool_init(ht, &o->pool);
+  }
+  d->next = ht->delegs;
+  ht->delegs = d;
+  for (i = 0; i < num_owners; i++){
+    /* freed by the owner */
+    oa = malloc_perror(1, sizeof(deleg_owner_arg_t));
+    oa->d = d;
+    oa->ix = i;
+    thread_create_perror(&d->owners[i].id, deleg_owner_thread, oa);
+  }
+}
+
+/**
+   Queues a batch of keys and associated elements for the insertion by
+   the owners of their slots, in the delegation mode of a hash table. The
+   operation is called concurrently by any number of threads, copies the
+   keys and elements, and returns before the keys are inserted. The keys
+   of a batch queued to an owner are inserted in the order of the batch,
+   unless they were routed before a growth step, and the order across
+   batches and threads is not specified, which provides a single final
+   state with a commutative and associative rdc_elts (e.g. min, max, add).
+   Please see the parameter specification in ht_divchn_pthread_insert.
+*/
+void ht_divchn_pthread_deleg_insert(ht_divchn_pthread_t *ht,
+				    const void *batch_keys,
+				    const void *batch_elts,
+				    size_t batch_count){
+  size_t i, range;
+  size_t *owner_ixs = NULL, *nums = NULL;
+  mod_rcp_t count_rcp;
+  deleg_t *d = ht->delegs;
+  deleg_parcel_t **ps = NULL;
+  if (batch_count == 0) return;
+  /* a growth step may change the routing after it is read */
+  mutex_lock_perror(&d->lock);
+  count_rcp = d->count_rcp;
+  range = d->range;
+  mutex_unlock_perror(&d->lock);
+  owner_ixs = malloc_perror(batch_count, sizeof(size_t));
+  nums = calloc_perror(d->num_owners, sizeof(size_t));
+  ps = malloc_perror(d->num_owners, sizeof(deleg_parcel_t *));
+  for (i = 0; i < batch_count; i++){
+    owner_ixs[i] =
+      rcp_mod(convert_std_key(ht, ptr(batch_keys, i, ht->key_size)),
+	      &count_rcp) / range;
+    nums[owner_ixs[i]]++;
+  }
+  for (i = 0; i < d->num_owners; i++){
+    ps[i] = (nums[i] > 0) ? parcel_new(ht, nums[i]) : NULL;
+  }
+  for (i = 0; i < batch_count; i++){
+    parcel_push(ht,
+		ps[owner_ixs[i]],
+		ptr(batch_keys, i, ht->key_size),
+		ptr(batch_elts, i, ht->elt_size));
+  }
+  mutex_lock_perror(&d->lock);
+  deleg_enqueue(d, ps);
+  mutex_unlock_perror(&d->lock);
+  free(owner_ixs);
+  free(nums);
+  free(ps);
+  owner_ixs = NULL;
+  nums = NULL;
+  ps = NULL;
+}
+
+/**
+   Waits until the keys of all queued batches are inserted, and stops the
+   delegation mode of a hash table by joining its owner threads. The
+   operation is called after all threads completed
+   ht_divchn_pthread_deleg_insert operations on ht.
+*/
+void ht_divchn_pthread_deleg_stop(ht_divchn_pthread_t *ht){
+  size_t i;
+  deleg_t *d = ht->delegs;
+  mutex_lock_perror(&d->lock);
+  while (d->num_pending > 0){
+    cond_wait_perror(&d->idle_cond, &d->lock);
+  }
+  d->is_stop = 1;
+  for (i = 0; i < d->num_owners; i++){
+    cond_signal_perror(&d->owners[i].cond);
+  }
+  mutex_unlock_perror(&d->lock);
+  for (i = 0; i < d->num_owners; i++){
+    thread_join_perror(d->owners[i].id, NULL);
   }
 }
 
@@ -369,11 +972,21 @@ void ht_divchn_pthread_insert(ht_divchn_pthread_t *ht,
 */
 void *ht_divchn_pthread_search(const ht_divchn_pthread_t *ht,
 			       const void *key){
-  const dll_node_t *node = dll_search_uq_key(ht->ll,
-					     &ht->key_elts[hash(ht, key)],
-					     key,
-					     ht->key_size,
-					     ht->cmp_key);
+  size_t std_key = convert_std_key(ht, key);
+  const dll_node_t *node = NULL;
+  node = dll_search_uq_key(ht->ll,
+			   &ht->key_elts[rcp_mod(std_key, &ht->count_rcp)],
+			   key,
+			   ht->key_size,
+			   ht->cmp_key);
+  if (node == NULL && ht->prev_key_elts != NULL){
+    node = dll_search_uq_key(ht->ll,
+			     &ht->prev_key_elts[rcp_mod(std_key,
+							&ht->prev_count_rcp)],
+			     key,
+			     ht->key_size,
+			     ht->cmp_key);
+  }
   if (node == NULL){
     return NULL;
   }else{
@@ -381,6 +994,222 @@ void *ht_divchn_pthread_search(const ht_divchn_pthread_t *ht,
   }
 }
 
+/**
+   Searches a batch of keys in a hash table by copying the element, or its
+   pointer, associated with each key that is present into the
+   corresponding block in the array of elt_size blocks pointed to by
+   batch_elts. If a key is not in the hash table, leaves the corresponding
+   elt_size block unchanged. Returns the number of keys in the batch that
+   are present in the hash table. The batch_keys and batch_elts parameters
+   are not NULL and point to arrays of blocks of size key_size and
+   elt_size respectively. The batch_count parameter is the count of keys in
+   a batch. The operation is called concurrently with insert, remove,
+   delete, and other search_batch operations. If an element is within a
+   noncontiguous memory block, the copied pointer is valid until the key
+   is removed or deleted by another thread.
+
+   A search batch takes locks as a modifying batch and may block:
+   - it enters and exits through a gate shard under the mutex of the
+   shard, and waits at the entry while the gate is closed by a growth
+   step, which in turn waits until the search batches in the hash table
+   exit,
+   - it searches a key under the stripe lock of the slot of the key, and
+   during the migration of keys also under the stripe lock of the
+   previous slot of the key, in the order of lock indices; in the grouped
+   mode, a lock is taken once for the keys of the batch that are covered
+   by the lock; the batch waits while a lock is held by another thread,
+   - during the migration of keys, it claims a range of previous slots
+   under gate_lock and moves their keys under the stripe locks; if the
+   batch is the last to exit after the migration is complete, it frees
+   the previous slots.
+*/
+size_t ht_divchn_pthread_search_batch(ht_divchn_pthread_t *ht,
+				      const void *batch_keys,
+				      void *batch_elts,
+				      size_t batch_count){
+  size_t i, j, lock_ix, prev_lock_ix;
+  size_t mig_start, mig_count;
+  size_t found = 0;
+  size_t shard_ix;
+  size_t *grp = NULL;
+  dll_node_t **head = NULL, *node = NULL;
+  /* first critical section : go through a gate shard or wait */
+  shard_ix = select_shard(ht, NULL, batch_keys, batch_count);
+  gate_enter(ht, shard_ix, batch_count, &mig_start, &mig_count);
+  if (mig_count > 0) migrate(ht, mig_start, mig_count);
+  /* search */
+  grp = group_batch(ht, batch_keys, batch_count);
+  for (j = 0; j < batch_count; j++){
+    node = batch_search(ht, grp, batch_keys, j,
+			&i, &head, &lock_ix, &prev_lock_ix);
+    if (node != NULL){
+      memcpy(ptr(batch_elts, i, ht->elt_size),
+	     dll_elt_ptr(ht->ll, node),
+	     ht->elt_size);
+      found++;
+    }
+    batch_unlock(ht, grp, j, batch_count, lock_ix, prev_lock_ix);
+  }
+  free(grp);
+  grp = NULL;
+  /* finish */
+  gate_exit(ht, shard_ix, mig_count, 0, 0);
+  return found;
+}
+
+/**
+   Returns the number of keys in a hash table, including the net changes
+   counted in the gate shards. The operation is called before/after all
+   threads started/completed insert, remove, and delete operations on ht.
+*/
+size_t ht_divchn_pthread_num_elts(const ht_divchn_pthread_t *ht){
+  size_t i;
+  size_t num_elts = ht->num_elts;
+  for (i = 0; i < C_NUM_SHARDS; i++){
+    num_elts += shard(ht, i)->num_elts; /* mod 2**n */
+  }
+  return num_elts;
+}
+
+/**
+   Initializes a cursor for enumerating the keys in a hash table with
+   ht_divchn_pthread_next. A cursor is valid until the hash table is
+   modified.
+*/
+void ht_divchn_pthread_cursor_init(ht_divchn_pthread_cursor_t *cur){
+  cur->ix = 0;
+  cur->node = NULL;
+}
+
+/**
+   Advances a cursor to the next key in a hash table. Returns a pointer to
+   the element associated with the key and sets the pointer pointed to by
+   key to point to the in-table key, or returns NULL if all keys were
+   enumerated. The operation is called before/after all threads
+   started/completed insert, remove, and delete operations on ht and does
+   not require thread synchronization overhead.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct that
+                 was not modified after the cursor was initialized
+   cur         : pointer to a cursor initialized with
+                 ht_divchn_pthread_cursor_init
+   key         : pointer to a pointer that is set to point to a key_size
+                 block
+*/
+void *ht_divchn_pthread_next(const ht_divchn_pthread_t *ht,
+			     ht_divchn_pthread_cursor_t *cur,
+			     const void **key){
+  const dll_node_t *node = NULL;
+  while (cur->node == NULL){
+    if (cur->ix == num_slots(ht)) return NULL;
+    cur->node = cursor_head(ht, cur->ix);
+    cur->ix++;
+  }
+  node = cur->node;
+  cur->node = node->next;
+  if (cur->node == cursor_head(ht, cur->ix - 1)) cur->node = NULL;
+  *key = dll_key_ptr(ht->ll, node);
+  return dll_elt_ptr(ht->ll, node);
+}
+
+/**
+   Calls a visit function on each key in a hash table and its associated
+   element. The first argument of visit points to a key_size block, the
+   second argument points to an elt_size block, and the third argument is
+   the arg parameter. The visit function does not modify the hash table,
+   except through the second argument. The operation is called
+   before/after all threads started/completed insert, remove, and delete
+   operations on ht and does not require thread synchronization overhead.
+*/
+void ht_divchn_pthread_foreach(const ht_divchn_pthread_t *ht,
+			       void (*visit)(const void *, void *, void *),
+			       void *arg){
+  const void *key = NULL;
+  void *elt = NULL;
+  ht_divchn_pthread_cursor_t cur;
+  ht_divchn_pthread_cursor_init(&cur);
+  while ((elt = ht_divchn_pthread_next(ht, &cur, &key)) != NULL){
+    visit(key, elt, arg);
+  }
+}
+
+typedef struct{
+  size_t start;
+  size_t count;
+  size_t num; /* # keys in the segment, then position of its first key */
+  char *keys;
+  char *elts;
+  const ht_divchn_pthread_t *ht;
+} export_arg_t;
+
+static void *count_thread(void *arg){
+  export_arg_t *ea = arg;
+  ea->num = export_slots(ea->ht, ea->start, ea->count, NULL, NULL, 0);
+  return NULL;
+}
+
+static void *export_thread(void *arg){
+  const export_arg_t *ea = arg;
+  export_slots(ea->ht, ea->start, ea->count, ea->keys, ea->elts, ea->num);
+  return NULL;
+}
+
+/**
+   Copies the keys of a hash table into an array of num_elts key_size
+   blocks pointed to by keys, and the elements, or pointers to elements,
+   into an array of num_elts elt_size blocks pointed to by elts, s.t. the
+   ith element is associated with the ith key. If keys or elts is NULL,
+   the corresponding array is not written. Returns num_elts. The slots
+   are partitioned across num_grow_threads threads, which first count the
+   keys in their segments and then copy the keys and elements into
+   disjoint ranges of the arrays, resulting in the same order as the order
+   of enumeration with a cursor. The operation is called before/after all
+   threads started/completed insert, remove, and delete operations on ht.
+*/
+size_t ht_divchn_pthread_export(const ht_divchn_pthread_t *ht,
+				void *keys,
+				void *elts){
+  size_t i, num = 0;
+  size_t start = 0;
+  size_t seg_count, rem_count;
+  pthread_t *eids = NULL;
+  export_arg_t *eas = NULL;
+  if (keys == NULL && elts == NULL) return ht_divchn_pthread_num_elts(ht);
+  eids = malloc_perror(ht->num_grow_threads, sizeof(pthread_t));
+  eas = malloc_perror(ht->num_grow_threads, sizeof(export_arg_t));
+  seg_count = num_slots(ht) / ht->num_grow_threads;
+  rem_count = num_slots(ht) - seg_count * ht->num_grow_threads;
+  for (i = 0; i < ht->num_grow_threads; i++){
+    eas[i].start = start;
+    eas[i].count = seg_count;
+    eas[i].count += (rem_count > 0 && rem_count--);
+    eas[i].keys = keys;
+    eas[i].elts = elts;
+    eas[i].ht = ht;
+    thread_create_perror(&eids[i], count_thread, &eas[i]);
+    start += eas[i].count;
+  }
+  for (i = 0; i < ht->num_grow_threads; i++){
+    thread_join_perror(eids[i], NULL);
+  }
+  /* exclusive prefix sum of the numbers of keys in segments */
+  for (i = 0; i < ht->num_grow_threads; i++){
+    start = eas[i].num;
+    eas[i].num = num;
+    num += start;
+  }
+  for (i = 0; i < ht->num_grow_threads; i++){
+    thread_create_perror(&eids[i], export_thread, &eas[i]);
+  }
+  for (i = 0; i < ht->num_grow_threads; i++){
+    thread_join_perror(eids[i], NULL);
+  }
+  free(eids);
+  free(eas);
+  eids = NULL;
+  eas = NULL;
+  return num;
+}
+
 /**
    Removes a batch of keys and associated elements from a hash table by
    copying the elements or its pointers into the array of elt_size blocks
@@ -394,43 +1223,51 @@ void ht_divchn_pthread_remove(ht_divchn_pthread_t *ht,
 			      const void *batch_keys,
 			      void *batch_elts,
 			      size_t batch_count){
-  size_t i, ix, lock_ix;
+  ht_divchn_pthread_remove_pool(ht, NULL, batch_keys, batch_elts, batch_count);
+}
+
+/**
+   Removes a batch of keys and associated elements from a hash table, and
+   returns the nodes of the removed keys to a pool of the calling thread,
+   or to the allocators of the lock stripes if pool is NULL. Please see
+   the parameter specification in ht_divchn_pthread_remove.
+*/
+void ht_divchn_pthread_remove_pool(ht_divchn_pthread_t *ht,
+				   ht_divchn_pthread_pool_t *pool,
+				   const void *batch_keys,
+				   void *batch_elts,
+				   size_t batch_count){
+  size_t i, j, lock_ix, prev_lock_ix;
+  size_t mig_start, mig_count;
   size_t removed = 0;
-  const void *key = NULL;
+  size_t shard_ix;
+  size_t *grp = NULL;
   void *elt = NULL;
+  dll_slab_t *slab = NULL;
   dll_node_t **head = NULL, *node = NULL;
-  /* first critical section : go through gate or wait */
-  mutex_lock_perror(&ht->gate_lock);
-  while (!ht->gate_open){
-    cond_wait_perror(&ht->gate_open_cond, &ht->gate_lock);
-  }
-  ht->num_in_threads++;
-  mutex_unlock_perror(&ht->gate_lock);
+  /* first critical section : go through a gate shard or wait */
+  shard_ix = select_shard(ht, pool, batch_keys, batch_count);
+  gate_enter(ht, shard_ix, batch_count, &mig_start, &mig_count);
+  if (mig_count > 0) migrate(ht, mig_start, mig_count);
   /* remove */
-  for (i = 0; i < batch_count; i++){
-    key = ptr(batch_keys, i, ht->key_size);
+  grp = group_batch(ht, batch_keys, batch_count);
+  for (j = 0; j < batch_count; j++){
+    node = batch_search(ht, grp, batch_keys, j,
+			&i, &head, &lock_ix, &prev_lock_ix);
     elt = ptr(batch_elts, i, ht->elt_size);
-    ix = hash(ht, key);
-    head = &ht->key_elts[ix];
-    lock_ix = ix & ht->key_locks_mask;
-    mutex_lock_perror(&ht->key_locks[lock_ix]);
-    node = dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
     if (node != NULL){
       memcpy(elt, dll_elt_ptr(ht->ll, node), ht->elt_size);
+      slab = (pool != NULL) ? &pool->slab : &stripe(ht, lock_ix)->slab;
       /* if an element is noncontiguous, only the pointer to it is deleted */
-      dll_delete(ht->ll, head, node, NULL);
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
+      dll_delete_slab(ht->ll, slab, head, node, NULL);
       removed++;
-    }else{
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
     }
+    batch_unlock(ht, grp, j, batch_count, lock_ix, prev_lock_ix);
   }
+  free(grp);
+  grp = NULL;
   /* finish */
-  mutex_lock_perror(&ht->gate_lock);
-  ht->num_elts -= removed;
-  ht->num_in_threads--;
-  if (!ht->gate_open) cond_signal_perror(&ht->grow_cond);
-  mutex_unlock_perror(&ht->gate_lock);
+  gate_exit(ht, shard_ix, mig_count, 0, removed);
 }
 
 /**
@@ -443,40 +1280,124 @@ void ht_divchn_pthread_remove(ht_divchn_pthread_t *ht,
 void ht_divchn_pthread_delete(ht_divchn_pthread_t *ht,
 			      const void *batch_keys,
 			      size_t batch_count){
-  size_t i, ix, lock_ix;
+  ht_divchn_pthread_delete_pool(ht, NULL, batch_keys, batch_count);
+}
+
+/**
+   Deletes a batch of keys and associated elements from a hash table, and
+   returns the nodes of the deleted keys to a pool of the calling thread,
+   or to the allocators of the lock stripes if pool is NULL. Please see
+   the parameter specification in ht_divchn_pthread_delete.
+*/
+void ht_divchn_pthread_delete_pool(ht_divchn_pthread_t *ht,
+				   ht_divchn_pthread_pool_t *pool,
+				   const void *batch_keys,
+				   size_t batch_count){
+  size_t i, j, lock_ix, prev_lock_ix;
+  size_t mig_start, mig_count;
   size_t deleted = 0;
-  const void *key = NULL;
+  size_t shard_ix;
+  size_t *grp = NULL;
+  dll_slab_t *slab = NULL;
   dll_node_t **head = NULL, *node = NULL;
-  /* first critical section : go through gate or wait */
-  mutex_lock_perror(&ht->gate_lock);
-  while (!ht->gate_open){
-    cond_wait_perror(&ht->gate_open_cond, &ht->gate_lock);
-  }
-  ht->num_in_threads++;
-  mutex_unlock_perror(&ht->gate_lock);
+  /* first critical section : go through a gate shard or wait */
+  shard_ix = select_shard(ht, pool, batch_keys, batch_count);
+  gate_enter(ht, shard_ix, batch_count, &mig_start, &mig_count);
+  if (mig_count > 0) migrate(ht, mig_start, mig_count);
   /* delete */
-  for (i = 0; i < batch_count; i++){
-    key = ptr(batch_keys, i, ht->key_size); 
-    ix = hash(ht, key);
-    head = &ht->key_elts[ix];
-    lock_ix = ix & ht->key_locks_mask;
-    mutex_lock_perror(&ht->key_locks[lock_ix]);
-    node = dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
+  grp = group_batch(ht, batch_keys, batch_count);
+  for (j = 0; j < batch_count; j++){
+    node = batch_search(ht, grp, batch_keys, j,
+			&i, &head, &lock_ix, &prev_lock_ix);
     if (node != NULL){
-      dll_delete(ht->ll, head, node, ht->free_elt);
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
+      slab = (pool != NULL) ? &pool->slab : &stripe(ht, lock_ix)->slab;
+      dll_delete_slab(ht->ll,
+		      slab,
+		      head,
+		      node,
+		      ht->free_elt);
       deleted++;
-    }else{
-      mutex_unlock_perror(&ht->key_locks[lock_ix]);
     }
+    batch_unlock(ht, grp, j, batch_count, lock_ix, prev_lock_ix);
   }
+  free(grp);
+  grp = NULL;
   /* finish */
-  mutex_lock_perror(&ht->gate_lock);
-  ht->num_elts -= deleted;
-  ht->num_in_threads--;
-  if (!ht->gate_open) cond_signal_perror(&ht->grow_cond);
-  mutex_unlock_perror(&ht->gate_lock);
+  gate_exit(ht, shard_ix, mig_count, 0, deleted);
+}
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+/**
+   Copies the statistics of a hash table into a block pointed to by stats.
+   The ith bin of the chain length histogram is the number of slots with
+   i keys, and the last bin also includes the longer chains. The processor
+   time of a growth operation is measured with clock() and includes the
+   processor time of all threads of the process during the operation. In
+   the incremental mode, the processor time of a growth operation does not
+   include the migration of keys by the subsequent operations, and during
+   the migration of keys, the previous slots are included in the histogram.
+   The num_bytes value includes the registered pools, the grow workers,
+   and the delegation states, and does not include the noncontiguous
+   elements. The operation is called
+   before/after all threads started/completed insert, remove, and delete
+   operations on ht.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   stats       : pointer to a preallocated block of size
+                 sizeof(ht_divchn_pthread_stats_t)
+*/
+void ht_divchn_pthread_stats(const ht_divchn_pthread_t *ht,
+			     ht_divchn_pthread_stats_t *stats){
+  size_t i, len;
+  const dll_node_t *head = NULL, *node = NULL;
+  const ht_divchn_pthread_stripe_t *s = NULL;
+  const ht_divchn_pthread_pool_t *pool = NULL;
+  const grow_workers_t *gw = NULL;
+  const deleg_t *d = NULL;
+  *stats = ht->stats;
+  stats->num_elts = ht_divchn_pthread_num_elts(ht);
+  stats->count = ht->count;
+  stats->num_bytes = sizeof(dll_t) +
+    num_slots(ht) * sizeof(dll_node_t *) +
+    (ht->key_locks_mask + 1) * ht->stripe_size +
+    C_NUM_SHARDS * ht->shard_size;
+  stats->num_locks = ht->key_locks_mask + 1;
+  for (i = 0; i <= ht->key_locks_mask; i++){
+    s = stripe(ht, i);
+    stats->num_bytes += s->slab.num_bytes;
+    stats->num_lock_acqs += s->num_acqs;
+    stats->num_lock_waits += s->num_waits;
+    stats->lock_wait_time += s->wait_time;
+    if (s->num_waits > stats->max_lock_waits){
+      stats->max_lock_waits = s->num_waits;
+    }
+  }
+  for (pool = ht->pools; pool != NULL; pool = pool->next){
+    stats->num_bytes += pool->slab.num_bytes +
+      pool->num_nodes * sizeof(dll_node_t *);
+  }
+  if (ht->workers != NULL){
+    gw = ht->workers;
+    stats->num_bytes += sizeof(grow_workers_t) +
+      (gw->num_workers - 1) * sizeof(pthread_t) +
+      gw->num_workers * sizeof(grow_range_t);
+  }
+  for (d = ht->delegs; d != NULL; d = d->next){
+    stats->num_bytes += sizeof(deleg_t) +
+      d->num_owners * sizeof(deleg_owner_t);
+  }
+  for (i = 0; i < num_slots(ht); i++){
+    len = 0;
+    head = cursor_head(ht, i);
+    node = head;
+    while (node != NULL){
+      len++;
+      node = node->next;
+      if (node == head) break;
+    }
+    stats_chain(stats, len);
+  }
 }
+#endif
 
 /**
    Frees a hash table. The operation is called after all threads completed
@@ -485,15 +1406,51 @@ void ht_divchn_pthread_delete(ht_divchn_pthread_t *ht,
 */
 void ht_divchn_pthread_free(ht_divchn_pthread_t *ht){
   size_t i;
-  for (i = 0; i < ht->count; i++){
-    dll_free(ht->ll, &ht->key_elts[i], ht->free_elt);
+  ht_divchn_pthread_pool_t *pool = NULL;
+  deleg_t *d = NULL;
+  if (ht->free_elt != NULL){
+    for (i = 0; i < ht->count; i++){
+      dll_free_slab(ht->ll,
+		    &stripe(ht, 0)->slab,
+		    &ht->key_elts[i],
+		    ht->free_elt);
+    }
+    for (i = 0; ht->prev_key_elts != NULL && i < ht->prev_count; i++){
+      dll_free_slab(ht->ll,
+		    &stripe(ht, 0)->slab,
+		    &ht->prev_key_elts[i],
+		    ht->free_elt);
+    }
+  }
+  for (i = 0; i <= ht->key_locks_mask; i++){
+    dll_slab_free(&stripe(ht, i)->slab);
   }
+  for (pool = ht->pools; pool != NULL; pool = pool->next){
+    dll_slab_free(&pool->slab);
+    free(pool->nodes);
+    pool->nodes = NULL;
+  }
+  while (ht->delegs != NULL){
+    d = ht->delegs;
+    ht->delegs = d->next;
+    free(d->owners);
+    free(d);
+  }
+  d = NULL;
+  if (ht->workers != NULL) workers_free(ht->workers);
   free(ht->ll);
   free(ht->key_elts);
-  free(ht->key_locks);
+  free(ht->prev_key_elts);
+  free(ht->shards);
+  free(ht->stripes);
+  free(ht->workers);
   ht->ll = NULL;
   ht->key_elts = NULL;
-  ht->key_locks = NULL;
+  ht->prev_key_elts = NULL;
+  ht->shards = NULL;
+  ht->stripes = NULL;
+  ht->pools = NULL;
+  ht->workers = NULL;
 }
 
 /**
@@ -510,6 +1467,32 @@ void ht_divchn_pthread_align_elt_helper(void *ht, size_t alignment){
   ht_divchn_pthread_align_elt(ht, alignment);
 }
 
+void ht_divchn_pthread_incr_helper(void *ht, int is_incr){
+  ht_divchn_pthread_incr(ht, is_incr);
+}
+
+void ht_divchn_pthread_grouped_helper(void *ht, int is_grouped){
+  ht_divchn_pthread_grouped(ht, is_grouped);
+}
+
+void ht_divchn_pthread_locks_helper(void *ht,
+				    ht_divchn_pthread_lock_kind_t lock_kind,
+				    size_t log_max_num_locks){
+  ht_divchn_pthread_locks(ht, lock_kind, log_max_num_locks);
+}
+
+void ht_divchn_pthread_pool_init_helper(void *ht, void *pool){
+  ht_divchn_pthread_pool_init(ht, pool);
+}
+
+void ht_divchn_pthread_insert_pool_helper(void *ht,
+					  void *pool,
+					  const void *batch_keys,
+					  const void *batch_elts,
+					  size_t batch_count){
+  ht_divchn_pthread_insert_pool(ht, pool, batch_keys, batch_elts, batch_count);
+}
+
 void ht_divchn_pthread_insert_helper(void *ht,
 				     const void *batch_keys,
 				     const void *batch_elts,
@@ -517,11 +1500,60 @@ void ht_divchn_pthread_insert_helper(void *ht,
   ht_divchn_pthread_insert(ht, batch_keys, batch_elts, batch_count);
 }
 
+void ht_divchn_pthread_deleg_start_helper(void *ht, size_t num_owners){
+  ht_divchn_pthread_deleg_start(ht, num_owners);
+}
+
+void ht_divchn_pthread_deleg_insert_helper(void *ht,
+					   const void *batch_keys,
+					   const void *batch_elts,
+					   size_t batch_count){
+  ht_divchn_pthread_deleg_insert(ht, batch_keys, batch_elts, batch_count);
+}
+
+void ht_divchn_pthread_deleg_stop_helper(void *ht){
+  ht_divchn_pthread_deleg_stop(ht);
+}
+
 void *ht_divchn_pthread_search_helper(const void *ht,
 				      const void *key){
   return ht_divchn_pthread_search(ht, key);
 }
 
+size_t ht_divchn_pthread_search_batch_helper(void *ht,
+					     const void *batch_keys,
+					     void *batch_elts,
+					     size_t batch_count){
+  return ht_divchn_pthread_search_batch(ht,
+					batch_keys,
+					batch_elts,
+					batch_count);
+}
+
+size_t ht_divchn_pthread_num_elts_helper(const void *ht){
+  return ht_divchn_pthread_num_elts(ht);
+}
+
+void *ht_divchn_pthread_next_helper(const void *ht,
+				    void *cur,
+				    const void **key){
+  return ht_divchn_pthread_next(ht, cur, key);
+}
+
+void ht_divchn_pthread_foreach_helper(const void *ht,
+				      void (*visit)(const void *,
+						    void *,
+						    void *),
+				      void *arg){
+  ht_divchn_pthread_foreach(ht, visit, arg);
+}
+
+size_t ht_divchn_pthread_export_helper(const void *ht,
+				       void *keys,
+				       void *elts){
+  return ht_divchn_pthread_export(ht, keys, elts);
+}
+
 void ht_divchn_pthread_remove_helper(void *ht,
 				     const void *batch_keys,
 				     void *batch_elts,
@@ -535,6 +1567,31 @@ void ht_divchn_pthread_delete_helper(void *ht,
   ht_divchn_pthread_delete(ht, batch_keys, batch_count);
 }
 
+void ht_divchn_pthread_remove_pool_helper(void *ht,
+					  void *pool,
+					  const void *batch_keys,
+					  void *batch_elts,
+					  size_t batch_count){
+  ht_divchn_pthread_remove_pool(ht,
+				pool,
+				batch_keys,
+				batch_elts,
+				batch_count);
+}
+
+void ht_divchn_pthread_delete_pool_helper(void *ht,
+					  void *pool,
+					  const void *batch_keys,
+					  size_t batch_count){
+  ht_divchn_pthread_delete_pool(ht, pool, batch_keys, batch_count);
+}
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+void ht_divchn_pthread_stats_helper(const void *ht, void *stats){
+  ht_divchn_pthread_stats(ht, stats);
+}
+#endif
+
 void ht_divchn_pthread_free_helper(void *ht){
   ht_divchn_pthread_free(ht);
 }
@@ -574,15 +1631,676 @@ static size_t convert_std_key(const ht_divchn_pthread_t *ht,
 }
 
 /**
-   Maps a hash key to a slot index in a hash table with a division method. 
+   Maps a hash key to a slot index in a hash table with a division method,
+   computed without a division instruction.
 */
 static size_t hash(const ht_divchn_pthread_t *ht, const void *key){
-  return convert_std_key(ht, key) % ht->count;
+  return rcp_mod(convert_std_key(ht, key), &ht->count_rcp);
 }
 
 /**
-   Multiplies an unsigned integer n by a load factor upper bound, represented
-   by a numerator and log base 2 of a denominator. The denominator is a
+   Initialize as private to the process, lock, try to lock, and unlock
+   a spinlock with error checking. The trylock operation returns 0 if the
+   spinlock was locked by the call, and non-zero if the spinlock is
+   already locked, and is used if HT_DIVCHN_PTHREAD_STATS is defined.
+   Spinlocks are wrapped here, because their declarations require
+   _XOPEN_SOURCE >= 600 before pthread.h is included.
+*/
+
+static void spin_init_perror(pthread_spinlock_t *spin){
+  int err = pthread_spin_init(spin, PTHREAD_PROCESS_PRIVATE);
+  if (err != 0){
+    perror("pthread_spin_init failed");
+    exit(EXIT_FAILURE);
+  }
+}
+
+static void spin_lock_perror(pthread_spinlock_t *spin){
+  int err = pthread_spin_lock(spin);
+  if (err != 0){
+    perror("pthread_spin_lock failed");
+    exit(EXIT_FAILURE);
+  }
+}
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+static int spin_trylock_perror(pthread_spinlock_t *spin){
+  int err = pthread_spin_trylock(spin);
+  if (err != 0 && err != EBUSY){
+    perror("pthread_spin_trylock failed");
+    exit(EXIT_FAILURE);
+  }
+  return err;
+}
+#endif
+
+static void spin_unlock_perror(pthread_spinlock_t *spin){
+  int err = pthread_spin_unlock(spin);
+  if (err != 0){
+    perror("pthread_spin_unlock failed");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+   Returns a pointer to a lock stripe of a hash table.
+*/
+static ht_divchn_pthread_stripe_t *stripe(const ht_divchn_pthread_t *ht,
+					  size_t lock_ix){
+  return (ht_divchn_pthread_stripe_t *)((char *)ht->stripes +
+					lock_ix * ht->stripe_size);
+}
+
+/**
+   Allocates a block of num_locks lock stripes of a hash table, aligned
+   to the cache line size, and initializes the lock of the kind of the
+   hash table and the node allocator of each stripe.
+*/
+static void *stripes_alloc(const ht_divchn_pthread_t *ht, size_t num_locks){
+  size_t i;
+  void *stripes = NULL;
+  ht_divchn_pthread_stripe_t *s = NULL;
+  if (posix_memalign(&stripes,
+		     C_CACHE_LINE_SIZE,
+		     mul_sz_perror(num_locks, ht->stripe_size)) != 0){
+    perror("posix_memalign failed");
+    exit(EXIT_FAILURE);
+  }
+  for (i = 0; i < num_locks; i++){
+    s = (ht_divchn_pthread_stripe_t *)((char *)stripes +
+				       i * ht->stripe_size);
+    if (ht->lock_kind == HT_DIVCHN_PTHREAD_SPIN){
+      spin_init_perror(&s->spin);
+    }else{
+      mutex_init_perror(&s->mutex);
+    }
+    if (ht->lock_kind == HT_DIVCHN_PTHREAD_TICKET){
+      cond_init_perror(&s->cond);
+    }
+    s->next_ticket = 0;
+    s->cur_ticket = 0;
+    dll_slab_init(&s->slab, ht->ll, ht->elt_size, C_SLAB_MAX_NUM_NODES);
+#ifdef HT_DIVCHN_PTHREAD_STATS
+    s->num_acqs = 0;
+    s->num_waits = 0;
+    s->wait_time = 0.0;
+#endif
+  }
+  return stripes;
+}
+
+/**
+   Locks a lock stripe of a hash table according to the kind of its
+   locks. A ticket lock takes the next ticket and waits until the ticket
+   is served. If HT_DIVCHN_PTHREAD_STATS is defined, a mutex or a
+   spinlock is first tried, and if the lock is held by another thread,
+   the wall time of the wait is measured. The counters of a stripe are
+   updated by the thread that holds its lock.
+*/
+static void stripe_lock(const ht_divchn_pthread_t *ht, size_t lock_ix){
+  size_t ticket;
+  ht_divchn_pthread_stripe_t *s = stripe(ht, lock_ix);
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  int is_wait = 0;
+  double t = 0.0;
+#endif
+  if (ht->lock_kind == HT_DIVCHN_PTHREAD_TICKET){
+    mutex_lock_perror(&s->mutex);
+    ticket = s->next_ticket++;
+#ifdef HT_DIVCHN_PTHREAD_STATS
+    is_wait = (ticket != s->cur_ticket);
+    if (is_wait) t = wall_time();
+#endif
+    while (ticket != s->cur_ticket){
+      cond_wait_perror(&s->cond, &s->mutex);
+    }
+    mutex_unlock_perror(&s->mutex);
+  }else if (ht->lock_kind == HT_DIVCHN_PTHREAD_SPIN){
+#ifdef HT_DIVCHN_PTHREAD_STATS
+    is_wait = spin_trylock_perror(&s->spin);
+    if (is_wait){
+      t = wall_time();
+      spin_lock_perror(&s->spin);
+    }
+#else
+    spin_lock_perror(&s->spin);
+#endif
+  }else{
+#ifdef HT_DIVCHN_PTHREAD_STATS
+    is_wait = mutex_trylock_perror(&s->mutex);
+    if (is_wait){
+      t = wall_time();
+      mutex_lock_perror(&s->mutex);
+    }
+#else
+    mutex_lock_perror(&s->mutex);
+#endif
+  }
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  if (is_wait){
+    s->num_waits++;
+    s->wait_time += wall_time() - t;
+  }
+  s->num_acqs++;
+#endif
+}
+
+/**
+   Unlocks a lock stripe of a hash table according to the kind of its
+   locks. A ticket lock serves the next ticket.
+*/
+static void stripe_unlock(const ht_divchn_pthread_t *ht, size_t lock_ix){
+  ht_divchn_pthread_stripe_t *s = stripe(ht, lock_ix);
+  if (ht->lock_kind == HT_DIVCHN_PTHREAD_TICKET){
+    mutex_lock_perror(&s->mutex);
+    s->cur_ticket++;
+    cond_broadcast_perror(&s->cond);
+    mutex_unlock_perror(&s->mutex);
+  }else if (ht->lock_kind == HT_DIVCHN_PTHREAD_SPIN){
+    spin_unlock_perror(&s->spin);
+  }else{
+    mutex_unlock_perror(&s->mutex);
+  }
+}
+
+/**
+   Doubles the number of lock stripes of a hash table while it is less
+   than max_num_locks and at most half of the count of slots. The node
+   allocators and the counters of the stripes are kept at the same lock
+   indices. The operation is called during a growth step, when only the
+   calling thread has access to the hash table.
+*/
+static void scale_locks(ht_divchn_pthread_t *ht){
+  size_t i;
+  size_t num_locks = ht->key_locks_mask + 1;
+  size_t new_num_locks = num_locks;
+  void *stripes = NULL;
+  ht_divchn_pthread_stripe_t *s = NULL, *prev_s = NULL;
+  while (new_num_locks < ht->max_num_locks &&
+	 new_num_locks <= ht->count / 2){
+    new_num_locks *= 2;
+  }
+  if (new_num_locks == num_locks) return;
+  stripes = stripes_alloc(ht, new_num_locks);
+  for (i = 0; i < num_locks; i++){
+    s = (ht_divchn_pthread_stripe_t *)((char *)stripes +
+				       i * ht->stripe_size);
+    prev_s = stripe(ht, i);
+    s->slab = prev_s->slab;
+#ifdef HT_DIVCHN_PTHREAD_STATS
+    s->num_acqs = prev_s->num_acqs;
+    s->num_waits = prev_s->num_waits;
+    s->wait_time = prev_s->wait_time;
+#endif
+  }
+  free(ht->stripes);
+  ht->stripes = stripes;
+  ht->key_locks_mask = new_num_locks - 1;
+}
+
+/**
+   Returns a pointer to a gate shard of a hash table.
+*/
+static ht_divchn_pthread_shard_t *shard(const ht_divchn_pthread_t *ht,
+					size_t shard_ix){
+  return (ht_divchn_pthread_shard_t *)((char *)ht->shards +
+				       shard_ix * ht->shard_size);
+}
+
+/**
+   Allocates a block of C_NUM_SHARDS gate shards of a hash table, aligned
+   to the cache line size, and initializes each shard as open.
+*/
+static void *shards_alloc(const ht_divchn_pthread_t *ht){
+  size_t i;
+  void *shards = NULL;
+  ht_divchn_pthread_shard_t *sh = NULL;
+  if (posix_memalign(&shards,
+		     C_CACHE_LINE_SIZE,
+		     mul_sz_perror(C_NUM_SHARDS, ht->shard_size)) != 0){
+    perror("posix_memalign failed");
+    exit(EXIT_FAILURE);
+  }
+  for (i = 0; i < C_NUM_SHARDS; i++){
+    sh = (ht_divchn_pthread_shard_t *)((char *)shards +
+				       i * ht->shard_size);
+    mutex_init_perror(&sh->lock);
+    cond_init_perror(&sh->open_cond);
+    cond_init_perror(&sh->quiet_cond);
+    sh->is_closed = FALSE;
+    sh->num_in = 0;
+    sh->num_elts = 0;
+  }
+  return shards;
+}
+
+/**
+   Returns the index of the gate shard of a batch, which is the shard of
+   the pool if pool is not NULL, or is selected by the first key of the
+   batch. The index does not depend on the count of slots, which may be
+   changed by another thread.
+*/
+static size_t select_shard(const ht_divchn_pthread_t *ht,
+			   const ht_divchn_pthread_pool_t *pool,
+			   const void *batch_keys,
+			   size_t batch_count){
+  if (pool != NULL) return pool->shard_ix;
+  if (batch_count == 0) return 0;
+  return convert_std_key(ht, batch_keys) % C_NUM_SHARDS;
+}
+
+/**
+   Enters a hash table through a gate shard, waiting while the shard is
+   closed, and claims a range of previous slots for the migration of keys
+   under gate_lock if a migration is in progress. The previous slots are
+   set and freed only while no thread is in the hash table.
+*/
+static void gate_enter(ht_divchn_pthread_t *ht,
+		       size_t shard_ix,
+		       size_t batch_count,
+		       size_t *mig_start,
+		       size_t *mig_count){
+  ht_divchn_pthread_shard_t *sh = shard(ht, shard_ix);
+  mutex_lock_perror(&sh->lock);
+  while (sh->is_closed){
+    cond_wait_perror(&sh->open_cond, &sh->lock);
+  }
+  sh->num_in++;
+  mutex_unlock_perror(&sh->lock);
+  *mig_start = 0;
+  *mig_count = 0;
+  if (ht->prev_key_elts != NULL){
+    mutex_lock_perror(&ht->gate_lock);
+    mig_claim(ht, batch_count, mig_start, mig_count);
+    mutex_unlock_perror(&ht->gate_lock);
+  }
+}
+
+/**
+   Exits a hash table through the gate shard of entry, after recording
+   the migration of the keys of mig_count previous slots, and adds the
+   net change of the number of keys of the batch to the counts of the
+   shard. If the magnitude of the counts of the shard exceeds fold_thresh,
+   adds the counts to num_elts under gate_lock. If the migration of keys
+   was completed and the gate is open, the calling thread closes the gate
+   and frees the previous slots with gate_quiesce. If alpha is exceeded
+   and the hash table can grow, the calling thread waits until the gate
+   is open, and if alpha is still exceeded, closes the gate and completes
+   the growth step with gate_quiesce.
+*/
+static void gate_exit(ht_divchn_pthread_t *ht,
+		      size_t shard_ix,
+		      size_t mig_count,
+		      size_t added,
+		      size_t removed){
+  int is_closer = 0;
+  int is_grow = 0;
+  ht_divchn_pthread_shard_t *sh = shard(ht, shard_ix);
+  if (mig_count > 0){
+    mutex_lock_perror(&ht->gate_lock);
+    is_closer = mig_finish(ht, mig_count);
+    mutex_unlock_perror(&ht->gate_lock);
+  }
+  mutex_lock_perror(&sh->lock);
+  if (added != removed){
+    /* the counts are not written by a batch that did not change them */
+    sh->num_elts += added;
+    sh->num_elts -= removed;
+  }
+  if (sh->num_elts > ht->fold_thresh &&
+      sh->num_elts < C_SIZE_MAX - ht->fold_thresh){
+    /* lock order: a shard lock, then gate_lock */
+    mutex_lock_perror(&ht->gate_lock);
+    ht->num_elts += sh->num_elts;
+    sh->num_elts = 0;
+    is_grow = is_grow_due(ht);
+    mutex_unlock_perror(&ht->gate_lock);
+  }
+  sh->num_in--;
+  if (sh->is_closed && sh->num_in == 0){
+    cond_signal_perror(&sh->quiet_cond);
+  }
+  mutex_unlock_perror(&sh->lock);
+  if (is_closer) gate_quiesce(ht, 0);
+  if (is_grow){
+    mutex_lock_perror(&ht->gate_lock);
+    while (!ht->gate_open){
+      cond_wait_perror(&ht->gate_open_cond, &ht->gate_lock);
+    }
+    is_grow = is_grow_due(ht);
+    if (is_grow) ht->gate_open = FALSE;
+    mutex_unlock_perror(&ht->gate_lock);
+    if (is_grow) gate_quiesce(ht, 1);
+  }
+}
+
+/**
+   Returns 1 if alpha is exceeded by num_elts and the hash table can
+   grow, otherwise returns 0. Called by a thread holding gate_lock or
+   by the thread that closed the gate.
+*/
+static int is_grow_due(const ht_divchn_pthread_t *ht){
+  return (ht->num_elts > ht->max_num_elts &&
+	  ht->count_ix != C_SIZE_MAX &&
+	  ht->count_ix != C_PRIME_PARTS_COUNT);
+}
+
+/**
+   Closes each gate shard of a hash table and waits until no thread is in
+   the shard. In the resulting quiescent state, if is_grow is non-zero,
+   adds the counts of the shards to num_elts, grows the hash table if
+   alpha is still exceeded, and sets fold_thresh. Otherwise, or if alpha
+   is no longer exceeded, frees the previous slots if the migration of
+   keys was completed; the counts are not written, so that a thread that
+   only completed a migration, e.g. in a search_batch operation, does
+   not modify num_elts. Then reopens the shards and opens the gate, and
+   wakes the threads waiting to grow the hash table. The gate is opened
+   after all shards are reopened, so that another thread does not close
+   the shards while they are reopened. The operation is called by the
+   thread that set gate_open to FALSE, after the thread exited the hash
+   table. The thread does not hold gate_lock while it locks a shard.
+*/
+static void gate_quiesce(ht_divchn_pthread_t *ht, int is_grow){
+  size_t i;
+  ht_divchn_pthread_shard_t *sh = NULL;
+  for (i = 0; i < C_NUM_SHARDS; i++){
+    sh = shard(ht, i);
+    mutex_lock_perror(&sh->lock);
+    sh->is_closed = TRUE;
+    while (sh->num_in > 0){
+      cond_wait_perror(&sh->quiet_cond, &sh->lock);
+    }
+    mutex_unlock_perror(&sh->lock);
+  }
+  /* only the calling thread has access to the hash table */
+  if (is_grow){
+    for (i = 0; i < C_NUM_SHARDS; i++){
+      sh = shard(ht, i);
+      ht->num_elts += sh->num_elts;
+      sh->num_elts = 0;
+    }
+  }
+  if (is_grow && is_grow_due(ht)){
+    ht_grow(ht); /* single thread */
+    ht->fold_thresh = ht->max_num_elts / (C_NUM_SHARDS * C_FOLD_DIV);
+  }else if (ht->prev_key_elts != NULL &&
+	    ht->mig_done == ht->prev_count){
+    free(ht->prev_key_elts);
+    ht->prev_key_elts = NULL;
+    ht->prev_count = 0;
+    ht->mig_ix = 0;
+    ht->mig_done = 0;
+  }
+  for (i = 0; i < C_NUM_SHARDS; i++){
+    sh = shard(ht, i);
+    mutex_lock_perror(&sh->lock);
+    sh->is_closed = FALSE;
+    cond_broadcast_perror(&sh->open_cond);
+    mutex_unlock_perror(&sh->lock);
+  }
+  mutex_lock_perror(&ht->gate_lock);
+  ht->gate_open = TRUE;
+  cond_broadcast_perror(&ht->gate_open_cond);
+  mutex_unlock_perror(&ht->gate_lock);
+}
+
+/**
+   Locks the slot of a key and, during the migration of keys, the previous
+   slot of the key, in the increasing order of lock indices to avoid a
+   deadlock. Returns a pointer to the node with the key, searched in the
+   slot and then in the previous slot, and sets the pointer pointed to by
+   head to the head of the chain with the node, if the key is in the hash
+   table. Otherwise returns NULL and sets the pointer pointed to by head to
+   the head of the slot of the key. Sets the indices of the locks of the
+   slot and the previous slot, which are equal if no migration is in
+   progress.
+*/
+static dll_node_t *lock_search(ht_divchn_pthread_t *ht,
+			       const void *key,
+			       dll_node_t ***head,
+			       size_t *lock_ix,
+			       size_t *prev_lock_ix){
+  size_t std_key = convert_std_key(ht, key);
+  size_t ix = rcp_mod(std_key, &ht->count_rcp);
+  size_t prev_ix = 0;
+  dll_node_t **prev_head = NULL, *node = NULL;
+  *lock_ix = ix & ht->key_locks_mask;
+  *prev_lock_ix = *lock_ix;
+  if (ht->prev_key_elts != NULL){
+    prev_ix = rcp_mod(std_key, &ht->prev_count_rcp);
+    *prev_lock_ix = prev_ix & ht->key_locks_mask;
+  }
+  if (*prev_lock_ix < *lock_ix){
+    stripe_lock(ht, *prev_lock_ix);
+    stripe_lock(ht, *lock_ix);
+  }else if (*prev_lock_ix > *lock_ix){
+    stripe_lock(ht, *lock_ix);
+    stripe_lock(ht, *prev_lock_ix);
+  }else{
+    stripe_lock(ht, *lock_ix);
+  }
+  *head = &ht->key_elts[ix];
+  node = dll_search_key(ht->ll, *head, key, ht->key_size, ht->cmp_key);
+  if (node == NULL && ht->prev_key_elts != NULL){
+    prev_head = &ht->prev_key_elts[prev_ix];
+    node = dll_search_key(ht->ll, prev_head, key, ht->key_size, ht->cmp_key);
+    if (node != NULL) *head = prev_head;
+  }
+  return node;
+}
+
+/**
+   Unlocks the locks taken by lock_search.
+*/
+static void unlock_slots(ht_divchn_pthread_t *ht,
+			 size_t lock_ix,
+			 size_t prev_lock_ix){
+  stripe_unlock(ht, lock_ix);
+  if (prev_lock_ix != lock_ix){
+    stripe_unlock(ht, prev_lock_ix);
+  }
+}
+
+/**
+   Groups the keys of a batch by their locks if the grouped mode is set,
+   no migration of keys is in progress, and the batch has more than one
+   key and the hash table more than one lock. Returns a pointer to an
+   array of batch_count pairs, each pair with the slot of a key followed
+   by the index of the key in the batch, sorted by the lock indices of the
+   slots with a stable LSD radix sort on the bytes of the lock indices.
+   The array is freed by the caller. Otherwise returns NULL. The operation
+   is called by a thread that entered a hash table, which keeps the slots
+   and the migration state unchanged until the thread exits.
+*/
+static size_t *group_batch(const ht_divchn_pthread_t *ht,
+			   const void *batch_keys,
+			   size_t batch_count){
+  size_t i, d, n, c;
+  size_t shift;
+  size_t counts[UCHAR_MAX + 1];
+  size_t *grp = NULL, *src = NULL, *dst = NULL, *t = NULL;
+  if (!ht->is_grouped ||
+      ht->prev_key_elts != NULL ||
+      batch_count < 2 ||
+      ht->key_locks_mask == 0) return NULL;
+  grp = malloc_perror(batch_count, 4 * sizeof(size_t));
+  src = grp;
+  dst = grp + 2 * batch_count;
+  for (i = 0; i < batch_count; i++){
+    src[2 * i] = hash(ht, ptr(batch_keys, i, ht->key_size));
+    src[2 * i + 1] = i;
+  }
+  for (shift = 0;
+       shift < C_FULL_BIT && (ht->key_locks_mask >> shift) > 0;
+       shift += C_BYTE_BIT){
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < batch_count; i++){
+      counts[((src[2 * i] & ht->key_locks_mask) >> shift) & UCHAR_MAX]++;
+    }
+    for (n = 0, d = 0; d <= UCHAR_MAX; d++){
+      c = counts[d];
+      counts[d] = n;
+      n += c;
+    }
+    for (i = 0; i < batch_count; i++){
+      d = ((src[2 * i] & ht->key_locks_mask) >> shift) & UCHAR_MAX;
+      dst[2 * counts[d]] = src[2 * i];
+      dst[2 * counts[d] + 1] = src[2 * i + 1];
+      counts[d]++;
+    }
+    t = src;
+    src = dst;
+    dst = t;
+  }
+  if (src != grp) memcpy(grp, src, 2 * batch_count * sizeof(size_t));
+  return grp;
+}
+
+/**
+   Searches the jth key of a batch in the order of processing, where the
+   order is the order of the batch if grp is NULL and the order of grp
+   otherwise. Sets the value pointed to by i to the index of the key in
+   the batch, and sets head, lock_ix, and prev_lock_ix as lock_search.
+   If grp is not NULL, the lock of the key is taken only if the key is the
+   first key of its group.
+*/
+static dll_node_t *batch_search(ht_divchn_pthread_t *ht,
+				const size_t *grp,
+				const void *batch_keys,
+				size_t j,
+				size_t *i,
+				dll_node_t ***head,
+				size_t *lock_ix,
+				size_t *prev_lock_ix){
+  if (grp == NULL){
+    *i = j;
+    return lock_search(ht,
+		       ptr(batch_keys, j, ht->key_size),
+		       head,
+		       lock_ix,
+		       prev_lock_ix);
+  }
+  *i = grp[2 * j + 1];
+  *lock_ix = grp[2 * j] & ht->key_locks_mask;
+  *prev_lock_ix = *lock_ix;
+  if (j == 0 || (grp[2 * (j - 1)] & ht->key_locks_mask) != *lock_ix){
+    stripe_lock(ht, *lock_ix);
+  }
+  *head = &ht->key_elts[grp[2 * j]];
+  return dll_search_key(ht->ll,
+			*head,
+			ptr(batch_keys, *i, ht->key_size),
+			ht->key_size,
+			ht->cmp_key);
+}
+
+/**
+   Releases the locks of the jth key of a batch in the order of
+   processing. If grp is not NULL, the lock of the key is released only
+   if the key is the last key of its group.
+*/
+static void batch_unlock(ht_divchn_pthread_t *ht,
+			 const size_t *grp,
+			 size_t j,
+			 size_t batch_count,
+			 size_t lock_ix,
+			 size_t prev_lock_ix){
+  if (grp == NULL){
+    unlock_slots(ht, lock_ix, prev_lock_ix);
+  }else if (j == batch_count - 1 ||
+	    (grp[2 * (j + 1)] & ht->key_locks_mask) != lock_ix){
+    stripe_unlock(ht, lock_ix);
+  }
+}
+
+/**
+   Claims a range of previous slots for the migration of keys by a thread
+   that entered a hash table with a batch of batch_count keys. Sets the
+   start and the count of the range, where the count is 0 if no migration
+   is in progress or all previous slots were claimed. The operation is
+   called by a thread holding gate_lock.
+*/
+static void mig_claim(ht_divchn_pthread_t *ht,
+		      size_t batch_count,
+		      size_t *start,
+		      size_t *count){
+  size_t rem;
+  *start = ht->mig_ix;
+  *count = 0;
+  if (ht->prev_key_elts == NULL) return;
+  rem = ht->prev_count - ht->mig_ix;
+  /* batch_count * mig_step < rem if the first condition is true */
+  if (batch_count < rem / ht->mig_step){
+    *count = batch_count * ht->mig_step;
+  }else{
+    *count = rem;
+  }
+  ht->mig_ix += *count;
+}
+
+/**
+   Records the migration of the keys of count previous slots by a thread
+   holding gate_lock, before the thread exits a hash table. If the keys of
+   all previous slots were moved and the gate is open, closes the gate
+   and returns 1, and the thread frees the previous slots with
+   gate_quiesce. Otherwise returns 0, and if the gate is closed, the
+   previous slots are freed by the thread that closed the gate.
+*/
+static int mig_finish(ht_divchn_pthread_t *ht, size_t count){
+  if (ht->prev_key_elts == NULL) return 0;
+  ht->mig_done += count;
+  if (ht->mig_done == ht->prev_count && ht->gate_open){
+    ht->gate_open = FALSE;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+   Moves the keys in count previous slots, starting at the previous slot
+   start, to the slots of a hash table, concurrently with the operations
+   of other threads. Each key is moved under the locks of its previous
+   slot and its slot, taken in the increasing order of lock indices. The
+   range of previous slots is claimed with mig_claim.
+*/
+static void migrate(ht_divchn_pthread_t *ht, size_t start, size_t count){
+  size_t i, ix, lock_ix, prev_lock_ix;
+  dll_node_t **head = NULL, *node = NULL;
+  for (i = start; i < start + count; i++){
+    head = &ht->prev_key_elts[i];
+    prev_lock_ix = i & ht->key_locks_mask;
+    stripe_lock(ht, prev_lock_ix);
+    while (*head != NULL){
+      node = *head;
+      ix = hash(ht, dll_key_ptr(ht->ll, node));
+      lock_ix = ix & ht->key_locks_mask;
+      if (lock_ix == prev_lock_ix){
+	dll_remove(head, node);
+	dll_prepend(&ht->key_elts[ix], node);
+      }else if (lock_ix > prev_lock_ix){
+	stripe_lock(ht, lock_ix);
+	dll_remove(head, node);
+	dll_prepend(&ht->key_elts[ix], node);
+	stripe_unlock(ht, lock_ix);
+      }else{
+	/* relock in order; a node is not added to a previous slot */
+	stripe_unlock(ht, prev_lock_ix);
+	stripe_lock(ht, lock_ix);
+	stripe_lock(ht, prev_lock_ix);
+	if (*head == node){
+	  dll_remove(head, node);
+	  dll_prepend(&ht->key_elts[ix], node);
+	}
+	stripe_unlock(ht, lock_ix);
+      }
+    }
+    stripe_unlock(ht, prev_lock_ix);
+  }
+}
+
+/**
+   Multiplies an unsigned integer n by a load factor upper bound, represented
+   by a numerator and log base 2 of a denominator. The denominator is a
    power of two. Returns the product if it is representable as size_t.
    Otherwise returns the maximal value of size_t.
 */
@@ -609,72 +2327,494 @@ static size_t mul_alpha_sz_max(size_t n, size_t alpha_n, size_t log_alpha_d){
    If the largest representable prime is reached, count_ix may not yet be set
    to C_SIZE_MAX or C_PRIME_PARTS_COUNT, which requires one additional call
    that does not increase the count. Otherwise, each call increases the
-   count.
+   count. In the incremental mode, completes the migration of keys if it
+   is in progress, and starts a new migration of keys, which is continued
+   by the subsequent operations.
 */
+static void ht_grow(ht_divchn_pthread_t *ht){
+  size_t i, prev_count, room;
+  dll_node_t **prev_key_elts = NULL;
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  clock_t t = clock();
+#endif
+  mig_complete(ht);
+  /* initialize next ht; num_elts can be used without lock */
+  prev_count = ht->count;
+  while (ht->num_elts > ht->max_num_elts && incr_count(ht));
+  if (prev_count == ht->count) return; /* load factor not lowered */
+  scale_locks(ht);
+  prev_key_elts = ht->key_elts;
+  ht->key_elts = malloc_perror(ht->count, sizeof(dll_node_t *));
+  /* ll is not reinitialized, it is read by threads outside of the gate */
+  for (i = 0; i < ht->count; i++){
+    ht->key_elts[i] = NULL;
+  }
+  if (ht->is_incr){
+    /* mig_step * room >= prev_count if room > 0 */
+    room = (ht->max_num_elts > ht->num_elts) ?
+      ht->max_num_elts - ht->num_elts : 0;
+    ht->prev_count = prev_count;
+    mod_rcp_init(&ht->prev_count_rcp, prev_count);
+    ht->mig_ix = 0;
+    ht->mig_done = 0;
+    ht->mig_step = (room > 0) ? prev_count / room + 1 : prev_count;
+    ht->prev_key_elts = prev_key_elts;
+  }else{
+    reinsert(ht, prev_key_elts, 0, prev_count);
+    free(prev_key_elts);
+    prev_key_elts = NULL;
+  }
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  t = clock() - t;
+  ht->stats.num_grows++;
+  ht->stats.grow_time += t;
+  if (t > ht->stats.max_grow_time) ht->stats.max_grow_time = t;
+#endif
+}
 
-typedef struct{
-  size_t start;
-  size_t count;
-  dll_node_t **prev_key_elts;
-  const ht_divchn_pthread_t *ht;
-} reinsert_arg_t;
+/**
+   Moves the keys in count previous slots, starting at the previous slot
+   start, to the slots of a hash table. If num_grow_threads is greater
+   than 1 and count is at least C_GROW_MIN_COUNT, the previous slots are
+   partitioned into the ranges of the grow workers, which are created at
+   the first such call, and the calling thread moves the keys as worker 0
+   and waits until the other workers completed. Otherwise, the calling
+   thread moves the keys. The operation is called if only the calling
+   thread has access to the hash table.
+*/
+static void reinsert(ht_divchn_pthread_t *ht,
+		     dll_node_t **prev_key_elts,
+		     size_t start,
+		     size_t count){
+  size_t i;
+  size_t seg_count, rem_count;
+  grow_workers_t *gw = NULL;
+  grow_range_t *r = NULL;
+  if (count == 0) return;
+  if (ht->num_grow_threads == 1 || count < C_GROW_MIN_COUNT){
+    reinsert_slots(ht, prev_key_elts, start, start + count);
+    return;
+  }
+  if (ht->workers == NULL) ht->workers = workers_create(ht);
+  gw = ht->workers;
+  seg_count = count / gw->num_workers;
+  rem_count = count - seg_count * gw->num_workers;
+  for (i = 0; i < gw->num_workers; i++){
+    r = &gw->ranges[i];
+    mutex_lock_perror(&r->lock);
+    r->start = start;
+    r->end = start + seg_count + (rem_count > 0 && rem_count--);
+    mutex_unlock_perror(&r->lock);
+    start = r->end;
+  }
+  mutex_lock_perror(&gw->lock);
+  gw->prev_key_elts = prev_key_elts;
+  gw->num_active = gw->num_workers - 1;
+  gw->epoch++;
+  cond_broadcast_perror(&gw->start_cond);
+  mutex_unlock_perror(&gw->lock);
+  worker_run(gw, 0);
+  mutex_lock_perror(&gw->lock);
+  while (gw->num_active > 0){
+    cond_wait_perror(&gw->done_cond, &gw->lock);
+  }
+  mutex_unlock_perror(&gw->lock);
+}
 
-static void *reinsert_thread(void *arg){
+/**
+   Moves the keys in the previous slots start, ..., end - 1 to the slots
+   of a hash table. The operation is called concurrently by grow workers
+   on disjoint ranges of previous slots.
+*/
+static void reinsert_slots(ht_divchn_pthread_t *ht,
+			   dll_node_t **prev_key_elts,
+			   size_t start,
+			   size_t end){
   size_t i, ix, lock_ix;
   dll_node_t **head = NULL, *node = NULL;
-  const reinsert_arg_t *ra = arg;
-  for (i = ra->start; i < ra->start + ra->count; i++){
-    head = &ra->prev_key_elts[i];
+  for (i = start; i < end; i++){
+    head = &prev_key_elts[i];
     while (*head != NULL){
       node = *head;
       dll_remove(head, node);
-      ix = hash(ra->ht, dll_key_ptr(ra->ht->ll, node));
-      lock_ix = ix & ra->ht->key_locks_mask;
-      mutex_lock_perror(&ra->ht->key_locks[lock_ix]);
-      dll_prepend(&ra->ht->key_elts[ix], node);
-      mutex_unlock_perror(&ra->ht->key_locks[lock_ix]);
+      ix = hash(ht, dll_key_ptr(ht->ll, node));
+      lock_ix = ix & ht->key_locks_mask;
+      stripe_lock(ht, lock_ix);
+      dll_prepend(&ht->key_elts[ix], node);
+      stripe_unlock(ht, lock_ix);
     }
   }
+}
+
+/**
+   Creates num_grow_threads - 1 grow workers of a hash table, each waiting
+   for the start of a reinsertion.
+*/
+static grow_workers_t *workers_create(ht_divchn_pthread_t *ht){
+  size_t i;
+  grow_workers_t *gw = malloc_perror(1, sizeof(grow_workers_t));
+  grow_worker_arg_t *wa = NULL;
+  mutex_init_perror(&gw->lock);
+  cond_init_perror(&gw->start_cond);
+  cond_init_perror(&gw->done_cond);
+  gw->epoch = 0;
+  gw->num_active = 0;
+  gw->is_exit = 0;
+  gw->num_workers = ht->num_grow_threads;
+  gw->prev_key_elts = NULL;
+  gw->ht = ht;
+  gw->ids = malloc_perror(gw->num_workers - 1, sizeof(pthread_t));
+  gw->ranges = malloc_perror(gw->num_workers, sizeof(grow_range_t));
+  for (i = 0; i < gw->num_workers; i++){
+    mutex_init_perror(&gw->ranges[i].lock);
+    gw->ranges[i].start = 0;
+    gw->ranges[i].end = 0;
+  }
+  for (i = 1; i < gw->num_workers; i++){
+    /* freed by the worker */
+    wa = malloc_perror(1, sizeof(grow_worker_arg_t));
+    wa->gw = gw;
+    wa->ix = i;
+    thread_create_perror(&gw->ids[i - 1], worker_thread, wa);
+  }
+  return gw;
+}
+
+static void *worker_thread(void *arg){
+  size_t epoch = 0;
+  grow_workers_t *gw = ((grow_worker_arg_t *)arg)->gw;
+  size_t ix = ((grow_worker_arg_t *)arg)->ix;
+  free(arg);
+  arg = NULL;
+  mutex_lock_perror(&gw->lock);
+  while (1){
+    while (!gw->is_exit && gw->epoch == epoch){
+      cond_wait_perror(&gw->start_cond, &gw->lock);
+    }
+    if (gw->is_exit) break;
+    epoch = gw->epoch;
+    mutex_unlock_perror(&gw->lock);
+    worker_run(gw, ix);
+    mutex_lock_perror(&gw->lock);
+    gw->num_active--;
+    if (gw->num_active == 0) cond_signal_perror(&gw->done_cond);
+  }
+  mutex_unlock_perror(&gw->lock);
   return NULL;
 }
 
-static void ht_grow(ht_divchn_pthread_t *ht){
-  size_t i, prev_count = ht->count;
-  size_t start = 0;
-  size_t seg_count, rem_count;
-  dll_node_t **prev_key_elts = ht->key_elts;
-  pthread_t *rids = NULL;
-  reinsert_arg_t *ras = NULL;
-  /* initialize next ht; num_elts can be used without lock */
-  while (ht->num_elts > ht->max_num_elts && incr_count(ht));
-  if (prev_count == ht->count) return; /* load factor not lowered */
-  rids = malloc_perror(ht->num_grow_threads, sizeof(pthread_t));
-  ras = malloc_perror(ht->num_grow_threads, sizeof(reinsert_arg_t));
-  ht->key_elts = malloc_perror(ht->count, sizeof(dll_node_t *));
-  for (i = 0; i < ht->count; i++){
-    dll_init(ht->ll, &ht->key_elts[i], ht->key_size);
+/**
+   Moves the keys of the chunks claimed by the worker ix until no slots
+   remain in the ranges of the workers.
+*/
+static void worker_run(grow_workers_t *gw, size_t ix){
+  size_t start, end;
+  while (worker_claim(gw, ix, &start, &end)){
+    reinsert_slots(gw->ht, gw->prev_key_elts, start, end);
   }
-  /* multithreaded reinsertion */
-  seg_count = prev_count / ht->num_grow_threads;
-  rem_count = prev_count - seg_count * ht->num_grow_threads;
-  for (i = 0; i < ht->num_grow_threads; i++){
-    ras[i].start = start;
-    ras[i].count = seg_count;
-    ras[i].count += (rem_count > 0 && rem_count--);
-    ras[i].prev_key_elts = prev_key_elts;
-    ras[i].ht = ht;
-    thread_create_perror(&rids[i], reinsert_thread, &ras[i]);
-    start += ras[i].count;
+}
+
+/**
+   Claims upto C_GROW_CHUNK slots from the front of the range of the
+   worker ix. If the range is empty, steals the back half of the range of
+   the first other worker with remaining slots, in the order of indices
+   starting at ix + 1, and claims from the stolen range. Returns 1 if
+   slots start, ..., end - 1 were claimed, otherwise returns 0. A thread
+   holds at most one range lock.
+*/
+static int worker_claim(grow_workers_t *gw,
+			size_t ix,
+			size_t *start,
+			size_t *end){
+  size_t i, rem, v;
+  size_t steal_start = 0, steal_end = 0;
+  grow_range_t *r = &gw->ranges[ix], *vr = NULL;
+  mutex_lock_perror(&r->lock);
+  if (r->start < r->end){
+    *start = r->start;
+    rem = r->end - r->start;
+    r->start += (rem < C_GROW_CHUNK) ? rem : C_GROW_CHUNK;
+    *end = r->start;
+    mutex_unlock_perror(&r->lock);
+    return 1;
   }
-  for (i = 0; i < ht->num_grow_threads; i++){
-    thread_join_perror(rids[i], NULL);
+  mutex_unlock_perror(&r->lock);
+  for (i = 1; i < gw->num_workers && steal_start == steal_end; i++){
+    v = (ix + i) % gw->num_workers;
+    vr = &gw->ranges[v];
+    mutex_lock_perror(&vr->lock);
+    if (vr->start < vr->end){
+      rem = vr->end - vr->start;
+      steal_end = vr->end;
+      vr->end -= rem / 2 + (rem & 1);
+      steal_start = vr->end;
+    }
+    mutex_unlock_perror(&vr->lock);
+  }
+  if (steal_start == steal_end) return 0;
+  /* the range of the worker ix is only refilled by the worker ix */
+  rem = steal_end - steal_start;
+  *start = steal_start;
+  *end = steal_start + ((rem < C_GROW_CHUNK) ? rem : C_GROW_CHUNK);
+  mutex_lock_perror(&r->lock);
+  r->start = *end;
+  r->end = steal_end;
+  mutex_unlock_perror(&r->lock);
+  return 1;
+}
+
+/**
+   Signals the grow workers to exit, joins the workers, and frees their
+   memory except the block pointed to by gw.
+*/
+static void workers_free(grow_workers_t *gw){
+  size_t i;
+  mutex_lock_perror(&gw->lock);
+  gw->is_exit = 1;
+  cond_broadcast_perror(&gw->start_cond);
+  mutex_unlock_perror(&gw->lock);
+  for (i = 1; i < gw->num_workers; i++){
+    thread_join_perror(gw->ids[i - 1], NULL);
   }
-  free(prev_key_elts);
-  free(rids);
-  free(ras);
-  prev_key_elts = NULL;
-  rids = NULL;
-  ras = NULL;
+  free(gw->ids);
+  free(gw->ranges);
+  gw->ids = NULL;
+  gw->ranges = NULL;
+}
+
+/**
+   Moves the keys of the previous slots that were not claimed by a
+   migration, and frees the previous slots, if a migration of keys is in
+   progress. The operation is called if only the calling thread has
+   access to the hash table, and all claimed ranges were migrated by the
+   threads that exited.
+*/
+static void mig_complete(ht_divchn_pthread_t *ht){
+  if (ht->prev_key_elts == NULL) return;
+  reinsert(ht,
+	   ht->prev_key_elts,
+	   ht->mig_ix,
+	   ht->prev_count - ht->mig_ix);
+  free(ht->prev_key_elts);
+  ht->prev_key_elts = NULL;
+  ht->prev_count = 0;
+  ht->mig_ix = 0;
+  ht->mig_done = 0;
+}
+
+/**
+   Sets the routing of keys to the owners of a delegation state according
+   to the count of slots of the hash table. The operation is called by a
+   thread holding the lock of the state, or before the owners are created.
+*/
+static void deleg_route(deleg_t *d){
+  const ht_divchn_pthread_t *ht = d->ht;
+  d->count_rcp = ht->count_rcp;
+  d->range = ht->count / d->num_owners + (ht->count % d->num_owners > 0);
+}
+
+/**
+   Allocates a parcel with room for count > 0 keys and elements, and
+   copies a key and an element into a parcel, doubling its room if it is
+   full, in the delegation mode.
+*/
+static deleg_parcel_t *parcel_new(const ht_divchn_pthread_t *ht,
+				  size_t count){
+  deleg_parcel_t *p = malloc_perror(1, sizeof(deleg_parcel_t));
+  p->next = NULL;
+  p->num = 0;
+  p->cap = count;
+  p->keys = malloc_perror(count, ht->key_size);
+  p->elts = malloc_perror(count, ht->elt_size);
+  return p;
+}
+
+static void parcel_push(const ht_divchn_pthread_t *ht,
+			deleg_parcel_t *p,
+			const void *key,
+			const void *elt){
+  if (p->num == p->cap){
+    p->cap = mul_sz_perror(p->cap, 2);
+    p->keys = realloc_perror(p->keys, p->cap, ht->key_size);
+    p->elts = realloc_perror(p->elts, p->cap, ht->elt_size);
+  }
+  memcpy(ptr(p->keys, p->num, ht->key_size), key, ht->key_size);
+  memcpy(ptr(p->elts, p->num, ht->elt_size), elt, ht->elt_size);
+  p->num++;
+}
+
+static void parcel_free(deleg_parcel_t *p){
+  free(p->keys);
+  free(p->elts);
+  free(p);
+}
+
+/**
+   Appends the non-NULL parcels in the array of num_owners parcels
+   pointed to by ps to the queues of the corresponding owners, signals
+   the owners, and sets the array elements to NULL. The operation is
+   called by a thread holding the lock of the delegation state.
+*/
+static void deleg_enqueue(deleg_t *d, deleg_parcel_t **ps){
+  size_t i;
+  deleg_owner_t *o = NULL;
+  for (i = 0; i < d->num_owners; i++){
+    if (ps[i] == NULL) continue;
+    o = &d->owners[i];
+    if (o->tail == NULL){
+      o->head = ps[i];
+    }else{
+      o->tail->next = ps[i];
+    }
+    o->tail = ps[i];
+    ps[i] = NULL;
+    d->num_pending++;
+    cond_signal_perror(&o->cond);
+  }
+}
+
+/**
+   Runs an owner of a delegation state. The owner takes all parcels of
+   its queue under the lock of the state, inserts their keys without the
+   lock, and then adds the number of inserted keys to num_elts and queues
+   the forwarded keys under the lock. If alpha is exceeded, the owner
+   requests a growth step and wakes the other owners, which pause at the
+   growth barrier. The owner exits if the mode is stopped and its queue
+   is empty.
+*/
+static void *deleg_owner_thread(void *arg){
+  size_t i, increased, num_applied;
+  deleg_t *d = ((deleg_owner_arg_t *)arg)->d;
+  size_t ix = ((deleg_owner_arg_t *)arg)->ix;
+  deleg_owner_t *o = &d->owners[ix];
+  deleg_parcel_t *head = NULL, *p = NULL;
+  deleg_parcel_t **fwd = NULL;
+  free(arg);
+  arg = NULL;
+  fwd = malloc_perror(d->num_owners, sizeof(deleg_parcel_t *));
+  for (i = 0; i < d->num_owners; i++){
+    fwd[i] = NULL;
+  }
+  mutex_lock_perror(&d->lock);
+  while (1){
+    while (o->head == NULL && !d->is_grow && !d->is_stop){
+      cond_wait_perror(&o->cond, &d->lock);
+    }
+    if (d->is_grow){
+      deleg_pause(d);
+      continue;
+    }
+    if (o->head == NULL) break;
+    head = o->head;
+    o->head = NULL;
+    o->tail = NULL;
+    mutex_unlock_perror(&d->lock);
+    increased = 0;
+    num_applied = 0;
+    while (head != NULL){
+      p = head;
+      head = head->next;
+      increased += deleg_apply(d, ix, p, fwd);
+      parcel_free(p);
+      num_applied++;
+    }
+    mutex_lock_perror(&d->lock);
+    deleg_enqueue(d, fwd);
+    d->num_pending -= num_applied;
+    d->ht->num_elts += increased;
+    if (!d->is_grow && is_grow_due(d->ht)){
+      d->is_grow = 1;
+      for (i = 0; i < d->num_owners; i++){
+	cond_signal_perror(&d->owners[i].cond);
+      }
+    }
+    if (d->num_pending == 0) cond_broadcast_perror(&d->idle_cond);
+  }
+  mutex_unlock_perror(&d->lock);
+  free(fwd);
+  fwd = NULL;
+  return NULL;
+}
+
+/**
+   Inserts the keys and elements of a parcel that are in the range of
+   slots of the owner ix without locks, and returns the number of keys
+   that were not in the hash table. A key in the range of another owner,
+   which was routed before a growth step, is copied into the parcel of
+   the owner in the array pointed to by fwd.
+*/
+static size_t deleg_apply(deleg_t *d,
+			  size_t ix,
+			  const deleg_parcel_t *p,
+			  deleg_parcel_t **fwd){
+  size_t i, slot, owner_ix;
+  size_t increased = 0;
+  const void *key = NULL, *elt = NULL;
+  dll_node_t **head = NULL, *node = NULL;
+  ht_divchn_pthread_t *ht = d->ht;
+  ht_divchn_pthread_pool_t *pool = &d->owners[ix].pool;
+  for (i = 0; i < p->num; i++){
+    key = ptr(p->keys, i, ht->key_size);
+    elt = ptr(p->elts, i, ht->elt_size);
+    slot = hash(ht, key);
+    owner_ix = slot / d->range;
+    if (owner_ix != ix){
+      if (fwd[owner_ix] == NULL) fwd[owner_ix] = parcel_new(ht, p->num - i);
+      parcel_push(ht, fwd[owner_ix], key, elt);
+      continue;
+    }
+    head = &ht->key_elts[slot];
+    node = dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
+    if (node == NULL){
+      dll_prepend_new_slab(ht->ll,
+			   &pool->slab,
+			   head,
+			   key,
+			   elt,
+			   ht->key_size,
+			   ht->elt_size);
+      increased++;
+    }else if (ht->rdc_elts != NULL){
+      ht->rdc_elts(dll_elt_ptr(ht->ll, node), elt, ht->elt_size);
+    }else{
+      if (ht->free_elt != NULL) ht->free_elt(dll_elt_ptr(ht->ll, node));
+      memcpy(dll_elt_ptr(ht->ll, node), elt, ht->elt_size);
+    }
+  }
+  return increased;
+}
+
+/**
+   Pauses an owner at the growth barrier of a delegation state. The last
+   owner that pauses grows the hash table without the lock of the state,
+   so that callers can queue parcels, and then updates the routing and
+   releases the owners. The growth step moves all keys. The operation is
+   called by an owner holding the lock of the state.
+*/
+static void deleg_pause(deleg_t *d){
+  int is_incr;
+  size_t gen = d->grow_gen;
+  ht_divchn_pthread_t *ht = d->ht;
+  d->num_paused++;
+  if (d->num_paused < d->num_owners){
+    while (gen == d->grow_gen){
+      cond_wait_perror(&d->grow_cond, &d->lock);
+    }
+    return;
+  }
+  /* only the calling thread has access to the slots */
+  mutex_unlock_perror(&d->lock);
+  is_incr = ht->is_incr;
+  ht->is_incr = 0;
+  ht_grow(ht);
+  ht->is_incr = is_incr;
+  ht->fold_thresh = ht->max_num_elts / (C_NUM_SHARDS * C_FOLD_DIV);
+  mutex_lock_perror(&d->lock);
+  deleg_route(d);
+  d->num_paused = 0;
+  d->is_grow = 0;
+  d->grow_gen++;
+  cond_broadcast_perror(&d->grow_cond);
 }
 
 /**
@@ -695,6 +2835,7 @@ static int incr_count(ht_divchn_pthread_t *ht){
     return 0;
   }else{
     ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+    mod_rcp_init(&ht->count_rcp, ht->count);
     /* 0 <= max_num_elts <= C_SIZE_MAX */
     ht->max_num_elts = mul_alpha_sz_max(ht->count,
 					ht->alpha_n,
@@ -733,6 +2874,87 @@ static size_t build_prime(size_t start, size_t count){
   return p;
 }
 
+/**
+   Returns the head of a slot in the order of enumeration, where the
+   previous slots precede the slots during the migration of keys.
+*/
+static const dll_node_t *cursor_head(const ht_divchn_pthread_t *ht,
+				     size_t ix){
+  if (ht->prev_key_elts != NULL){
+    if (ix < ht->prev_count) return ht->prev_key_elts[ix];
+    ix -= ht->prev_count;
+  }
+  return ht->key_elts[ix];
+}
+
+/**
+   Returns the number of slots in the order of enumeration, including the
+   previous slots during the migration of keys.
+*/
+static size_t num_slots(const ht_divchn_pthread_t *ht){
+  if (ht->prev_key_elts != NULL) return ht->prev_count + ht->count;
+  return ht->count;
+}
+
+/**
+   Copies the keys and elements in count slots in the order of
+   enumeration, starting at the slot start, into the arrays pointed to by
+   keys and elts, starting at the position num in each array. If keys or
+   elts is NULL, the corresponding array is not written. Returns num
+   incremented by the number of keys in the slots.
+*/
+static size_t export_slots(const ht_divchn_pthread_t *ht,
+			   size_t start,
+			   size_t count,
+			   char *keys,
+			   char *elts,
+			   size_t num){
+  size_t i;
+  const dll_node_t *head = NULL, *node = NULL;
+  for (i = start; i < start + count; i++){
+    head = cursor_head(ht, i);
+    if (head == NULL) continue;
+    node = head;
+    do{
+      if (keys != NULL){
+	memcpy(keys + num * ht->key_size,
+	       dll_key_ptr(ht->ll, node),
+	       ht->key_size);
+      }
+      if (elts != NULL){
+	memcpy(elts + num * ht->elt_size,
+	       dll_elt_ptr(ht->ll, node),
+	       ht->elt_size);
+      }
+      num++;
+      node = node->next;
+    }while (node != head);
+  }
+  return num;
+}
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+/**
+   Returns the wall time in seconds.
+*/
+static double wall_time(void){
+  struct timeval tm;
+  gettimeofday(&tm, NULL);
+  return tm.tv_sec + tm.tv_usec / 1e6;
+}
+
+/**
+   Counts a chain of length len in the statistics.
+*/
+static void stats_chain(ht_divchn_pthread_stats_t *stats, size_t len){
+  if (len > stats->max_chain_len) stats->max_chain_len = len;
+  if (len >= HT_DIVCHN_PTHREAD_STATS_BINS){
+    len = HT_DIVCHN_PTHREAD_STATS_BINS - 1;
+  }
+  stats->chain_hist[len]++;
+}
+#endif
+
 /**
    Computes a pointer to the ith element of size size in a block.
 */
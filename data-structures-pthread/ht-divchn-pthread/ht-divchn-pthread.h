@@ -20,6 +20,124 @@
    after the maximum representable count of slots in a hash table is
    reached.
 
+   The keys of a hash table are enumerated with a cursor, with a foreach
+   operation, or are copied with their elements into contiguous arrays
+   with a multithreaded export operation, before/after all threads
+   started/completed insert, remove, and delete operations.
+
+   A hash table grows in a single step by default, in which the threads
+   wait at the gate while num_grow_threads threads move all keys. In the
+   optional incremental mode of growth, a growth step only allocates the
+   new slots and keeps the previous slots, and each subsequent insert,
+   remove, delete, and search_batch operation claims a bounded range of
+   previous slots and moves their keys, concurrently with the operations
+   of other threads, until all keys are moved. During the migration of
+   keys, an operation on a key locks the slot and the previous slot of the
+   key in the order of lock indices, and consults the slot and then the
+   previous slot. The previous slots are freed by the thread that
+   completes the migration, after it closes the gate and no thread is in
+   the hash table.
+
+   The keys of a growth step are moved by the closing thread and by
+   num_grow_threads - 1 worker threads that are created at the first
+   growth step that moves the keys of at least C_GROW_MIN_COUNT slots, and
+   are kept until the hash table is freed. Each worker is assigned a range
+   of previous slots and claims chunks of C_GROW_CHUNK slots from its
+   range, and a worker without slots steals the back half of the remaining
+   range of another worker, so that long chains do not leave the workers
+   idle. The keys of fewer slots are moved by the closing thread.
+
+   A thread enters and exits a hash table through one of a fixed number
+   of gate shards, each beginning at a cache line boundary, which is
+   selected by the pool of the thread or by the first key of a batch. A
+   shard counts the threads that are in the hash table and the net change
+   of the number of keys by the threads that exited, which is added to
+   the number of keys of the hash table when its magnitude exceeds a
+   threshold. The thread whose addition exceeds alpha closes the gate by
+   closing each shard and waiting until no thread is in the shard, and
+   grows the hash table in the resulting quiescent state. If the gate is
+   closed by another thread, the thread waits until the gate is opened
+   and grows the hash table if alpha is still exceeded, so that a growth
+   step due to a batch is completed when the batch returns. As a result,
+   the entry and exit of a batch lock only its shard, and the threads
+   share gate_lock only when they add the counts of a shard, claim and
+   record the migration of keys, or register a pool. The number of keys
+   is read with ht_divchn_pthread_num_elts.
+
+   In the optional grouped mode, an insert, remove, delete, and
+   search_batch operation hashes its batch and partitions the keys by
+   their locks with a stable radix sort, taking each lock once for all
+   keys of the batch that are covered by the lock, instead of once for
+   each key. The relative order of the keys covered by a lock is kept,
+   so that the keys that are inserted more than once in a batch are
+   reduced or updated in the order of the batch. The grouped mode is not
+   applied to the batches that enter a hash table during the migration
+   of keys.
+
+   A batch of keys is searched with ht_divchn_pthread_search_batch
+   concurrently with insert, remove, and delete operations, including
+   growth steps. A search batch is not lock-free: it enters a hash table
+   through a gate shard as a modifying batch, waits while the gate is
+   closed, and copies the element of each found key under the stripe lock
+   of the key's slot, because a pointer to an in-table element may be
+   invalidated by another thread.
+
+   The slots are synchronized with lock stripes, each beginning at a cache
+   line boundary and padded to a multiple of the cache line size, so that
+   the locks of different stripes do not share a cache line. A stripe
+   holds a mutex, a spinlock, or a ticket lock, selected with
+   ht_divchn_pthread_locks. A ticket lock grants the lock in the order of
+   arrival and is built from a mutex and a condition variable, because
+   C89/C90 provides no atomic operations. Optionally, the number of
+   stripes is doubled at growth steps, upto a set maximum and at most one
+   stripe per slot.
+
+   The nodes of the chains are allocated from slab allocators, one per
+   lock stripe, and each allocator is accessed by a thread that holds the
+   lock of its stripe. A node is returned for reuse to the allocator of
+   the lock of its current slot, and the slabs of all allocators are
+   released in bulk when the hash table is freed, without visiting the
+   nodes if the elements do not require free_elt.
+
+   Optionally, a thread registers its own node pool with a hash table
+   with ht_divchn_pthread_pool_init and calls the *_pool variants of
+   insert, remove, and delete operations. The nodes of a batch of an
+   insert operation are then allocated from the slab allocator of the
+   pool and constructed before the thread enters a hash table, so that
+   neither an allocation nor a copy of a key or an element is made
+   under a lock, the unused nodes are returned to the pool after the
+   batch, and the nodes of the keys removed or deleted by the thread are
+   returned to its pool for reuse. The slabs of all registered pools are
+   released in bulk when the hash table is freed.
+
+   In the optional delegation mode, started with
+   ht_divchn_pthread_deleg_start and stopped with
+   ht_divchn_pthread_deleg_stop, the slots are partitioned into
+   contiguous ranges, each owned by an owner thread. A thread calling
+   ht_divchn_pthread_deleg_insert copies its batch into a parcel for each
+   owner whose range contains the slot of a key, and queues the parcels.
+   An owner inserts the keys of its parcels, and reduces or updates the
+   elements, without locking a slot, and forwards a key to the owner of
+   its slot if the key was routed before a growth step. A growth step is
+   completed by the last owner that pauses, after the owner that exceeded
+   alpha requests the growth. The queues of owners share a single lock
+   that is taken once per parcel, instead of the lock of a slot taken
+   once per key, which removes the contention on the slots of frequent
+   keys, e.g. in aggregations with rdc_elts.
+
+   The slot of a key is computed without a division instruction, with a
+   reciprocal of the count of slots that is precomputed with mod_rcp_init
+   when the count changes during a growth step.
+
+   If HT_DIVCHN_PTHREAD_STATS is defined at compile time, a hash table
+   maintains statistics that are read with ht_divchn_pthread_stats before/
+   after all threads started/completed insert, remove, and delete
+   operations, including the distribution of chain lengths, the growth
+   events and their processor times, the number of allocated bytes, and
+   the lock acquisitions, waits, and wall times of waits, which are
+   counted per stripe by the thread that holds the lock of the stripe.
+   Otherwise, the statistics and their instrumentation are not compiled.
+
    A hash table is modified by threads calling insert, remove, and/or delete
    operations concurrently. The design provides the following guarantees
    with respect to the final state of a hash table, defined as a pair of
@@ -50,7 +168,8 @@
    growth step, in which case alpha no longer bounds the load factor
 
    ** to the extent dependent on the number of threads that passed the
-   first critical section and their batch sizes
+   first critical section and their batch sizes, and the keys counted in
+   the shards and not yet added, at most max_num_elts / 8 keys
 */
 
 #ifndef HT_DIVCHN_PTHREAD_H  
@@ -60,10 +179,71 @@
 
 #include <stddef.h>
 #include <pthread.h>
+#ifdef HT_DIVCHN_PTHREAD_STATS
+#include <time.h>
+#endif
 #include "dll.h"
+#include "utilities-mod.h"
 
 typedef enum{FALSE, TRUE} boolean_t;
 
+#ifdef HT_DIVCHN_PTHREAD_STATS
+#define HT_DIVCHN_PTHREAD_STATS_BINS 16
+
+typedef struct{
+  size_t chain_hist[HT_DIVCHN_PTHREAD_STATS_BINS];
+  size_t max_chain_len;
+  size_t num_elts;
+  size_t count;
+  size_t num_grows;
+  clock_t grow_time; /* processor time of growth across grow threads */
+  clock_t max_grow_time;
+  size_t num_bytes; /* allocated for slots, nodes, and locks */
+  size_t num_locks;
+  size_t num_lock_acqs;
+  size_t num_lock_waits; /* acquisitions after waiting for another thread */
+  size_t max_lock_waits; /* of a single stripe */
+  double lock_wait_time; /* wall time in seconds across threads */
+} ht_divchn_pthread_stats_t;
+#endif
+
+typedef enum{
+  HT_DIVCHN_PTHREAD_MUTEX,
+  HT_DIVCHN_PTHREAD_SPIN,
+  HT_DIVCHN_PTHREAD_TICKET
+} ht_divchn_pthread_lock_kind_t;
+
+typedef struct{
+  pthread_mutex_t mutex; /* mutex, or mutex of a ticket lock */
+  pthread_cond_t cond; /* ticket lock */
+  pthread_spinlock_t spin;
+  size_t next_ticket; /* ticket lock */
+  size_t cur_ticket; /* ticket lock */
+  dll_slab_t slab; /* node allocator, accessed under the lock */
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  size_t num_acqs;
+  size_t num_waits;
+  double wait_time;
+#endif
+} ht_divchn_pthread_stripe_t; /* at stripe_size intervals in a block */
+
+typedef struct{
+  pthread_mutex_t lock;
+  pthread_cond_t open_cond; /* broadcast when the shard is reopened */
+  pthread_cond_t quiet_cond; /* signaled when the last thread exits */
+  boolean_t is_closed;
+  size_t num_in; /* threads in a hash table that entered through the shard */
+  size_t num_elts; /* net change of num_elts not yet added, mod 2**n */
+} ht_divchn_pthread_shard_t; /* at shard_size intervals in a block */
+
+typedef struct ht_divchn_pthread_pool{
+  dll_slab_t slab; /* node allocator, accessed by the owner thread */
+  size_t num_nodes; /* capacity of nodes */
+  dll_node_t **nodes; /* nodes of a batch constructed before locking */
+  size_t shard_ix; /* gate shard of the owner thread */
+  struct ht_divchn_pthread_pool *next; /* next registered pool or NULL */
+} ht_divchn_pthread_pool_t;
+
 typedef struct{
   /* hash table */
   size_t key_size;
@@ -72,22 +252,48 @@ typedef struct{
   size_t group_ix;
   size_t count_ix; /* max size_t value if last representable prime reached */
   size_t count;
+  mod_rcp_t count_rcp; /* precomputed for division-free % count */
   size_t max_num_elts; /*  >= 0, <= C_SIZE_MAX, represents alpha */
-  size_t num_elts;
+  size_t num_elts; /* excludes the counts of the shards not yet added */
   size_t alpha_n;
   size_t log_alpha_d;
   dll_t *ll;
   dll_node_t **key_elts; /* array of pointers to nodes */
 
+  /* incremental growth */
+  int is_incr; /* non-zero in the incremental mode of growth */
+  size_t prev_count; /* 0 if no migration is in progress */
+  mod_rcp_t prev_count_rcp; /* reciprocal of prev_count */
+  size_t mig_ix; /* next previous slot to be claimed for migration */
+  size_t mig_done; /* number of migrated previous slots */
+  size_t mig_step; /* number of previous slots migrated per key in a batch */
+  dll_node_t **prev_key_elts; /* NULL if no migration is in progress */
+
+  /* batch processing */
+  int is_grouped; /* non-zero if keys are grouped by locks in a batch */
+
   /* thread synchronization */
-  size_t num_in_threads; /* passed gate_lock's first critical section */
   size_t num_grow_threads;
   size_t key_locks_mask; /* -> probability of waiting at a slot */
-  boolean_t gate_open;
+  size_t max_num_locks; /* stripes are doubled at growth upto this count */
+  size_t stripe_size; /* multiple of cache line size */
+  ht_divchn_pthread_lock_kind_t lock_kind;
+  size_t shard_size; /* multiple of cache line size */
+  size_t next_shard; /* shard of the next registered pool */
+  size_t fold_thresh; /* counts of a shard are added beyond this magnitude */
+  boolean_t gate_open; /* FALSE while a thread closes the shards */
   pthread_mutex_t gate_lock;
-  pthread_mutex_t *key_locks; /* locks, each covering a subset of slots */
   pthread_cond_t gate_open_cond;
-  pthread_cond_t grow_cond;
+  void *shards; /* cache-line-aligned gate shards */
+  void *stripes; /* cache-line-aligned lock stripes and node allocators */
+  ht_divchn_pthread_pool_t *pools; /* registered, released at free */
+  void *workers; /* persistent grow workers, NULL until first used */
+  void *delegs; /* delegation states, latest first, released at free */
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+  /* statistics */
+  ht_divchn_pthread_stats_t stats; /* counters, other fields set by query */
+#endif
 
   /* function pointers */
   int (*cmp_key)(const void *, const void *);
@@ -96,6 +302,11 @@ typedef struct{
   void (*free_elt)(void *);
 } ht_divchn_pthread_t;
 
+typedef struct{
+  size_t ix; /* next slot, previous slots first during migration */
+  const dll_node_t *node; /* next node in the slot ix - 1, or NULL */
+} ht_divchn_pthread_cursor_t;
+
 /**
    Initializes a hash table. The initialization operation is called and
    must return before any thread calls insert, remove, and/or delete,
@@ -114,16 +325,20 @@ typedef struct{
                       resulting in a speedup by avoiding unnecessary growth
                       steps of a hash table; 0 if a positive value is not
                       specified and all growth steps are to be completed
-   alpha_n           : > 0 numerator of load factor upper bound
+   alpha_n          : > 0 numerator of load factor upper bound
    log_alpha_d      : < CHAR_BIT * sizeof(size_t) log base 2 of denominator
                       of load factor upper bound; denominator is a power of
                       two
-   log_num_locks    : log base 2 number of mutex locks for synchronizing
-                      insert, remove, and delete operations; a larger number
-                      reduces the size of a set of slots that maps to a lock
-                      and may reduce the time threads are blocked, depending
-                      on the scheduler and at the expense of space
-   num_grow_threads : >= 1, number of threads used in growing the hash table
+   log_num_locks    : log base 2 number of stripe locks of the kind
+                      selected with ht_divchn_pthread_locks, for
+                      synchronizing insert, remove, delete, and search_batch
+                      operations; a larger number reduces the size of a set
+                      of slots that maps to a lock and may reduce the time
+                      threads are blocked, depending on the scheduler and at
+                      the expense of space
+   num_grow_threads : >= 1, number of threads used in growing the hash
+                      table, including the thread that grows the hash
+                      table; the other threads are kept until free
    cmp_key          : - if NULL then a default memcmp-based comparison of 
                       keys is performed
                       - otherwise comparison function is applied which
@@ -189,6 +404,92 @@ void ht_divchn_pthread_init(ht_divchn_pthread_t *ht,
 */
 void ht_divchn_pthread_align_elt(ht_divchn_pthread_t *ht, size_t alignment);
 
+/**
+   Sets the mode of growth of a hash table. In the incremental mode, a
+   growth step allocates the new slots, and the keys in the previous slots
+   are moved by the subsequent insert, remove, delete, and search_batch
+   operations of all threads, each operation moving the keys of a range of
+   previous slots that is proportional to its batch count. The number of
+   previous slots migrated per key is set at each growth step s.t. the
+   migration is completed before the next growth step is due. As a result,
+   the threads wait at the gate only for the allocation of the new slots.
+   The operation is optionally called after ht_divchn_pthread_init is
+   completed and before any operation other than
+   ht_divchn_pthread_align_elt is called.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   is_incr     : non-zero to set the incremental mode, zero to set the
+                 default mode of growth in a single step
+*/
+void ht_divchn_pthread_incr(ht_divchn_pthread_t *ht, int is_incr);
+
+/**
+   Sets the mode of batch processing of a hash table. In the grouped mode,
+   the keys of a batch of an insert, remove, delete, or search_batch
+   operation are grouped by their locks with a radix sort of lock indices
+   in a block of 4 * batch_count size_t values allocated by the operation,
+   and each lock is taken once per batch. The grouped mode reduces the
+   synchronization cost per key if a batch has more keys than the number
+   of locks, or the keys are skewed towards a subset of locks. The
+   operation is optionally called after ht_divchn_pthread_init is
+   completed and before any operation other than
+   ht_divchn_pthread_align_elt and ht_divchn_pthread_incr is called.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   is_grouped  : non-zero to set the grouped mode, zero to set the default
+                 mode of taking a lock for each key of a batch
+*/
+void ht_divchn_pthread_grouped(ht_divchn_pthread_t *ht, int is_grouped);
+
+/**
+   Sets the kind of the locks of the lock stripes of a hash table and the
+   maximum number of stripes. A mutex is the default and suits the
+   threads that may be descheduled while holding a lock, a spinlock
+   suits short critical sections with fewer threads than processors, and
+   a ticket lock grants the lock in the order of arrival. At each growth
+   step, the number of stripes is doubled while it is less than the
+   maximum number of stripes and at most half of the count of slots. The
+   operation is optionally called after ht_divchn_pthread_init is
+   completed and before any operation other than
+   ht_divchn_pthread_align_elt, ht_divchn_pthread_incr, and
+   ht_divchn_pthread_grouped is called.
+   ht                : pointer to an initialized ht_divchn_pthread_t struct
+   lock_kind         : HT_DIVCHN_PTHREAD_MUTEX, HT_DIVCHN_PTHREAD_SPIN,
+                       or HT_DIVCHN_PTHREAD_TICKET
+   log_max_num_locks : < CHAR_BIT * sizeof(size_t), log base 2 of the
+                       maximum number of stripes; if it is not greater than
+                       log_num_locks, the number of stripes is not changed
+*/
+void ht_divchn_pthread_locks(ht_divchn_pthread_t *ht,
+			     ht_divchn_pthread_lock_kind_t lock_kind,
+			     size_t log_max_num_locks);
+
+/**
+   Initializes a node pool of a thread and registers the pool with a hash
+   table. The operation is called after ht_divchn_pthread_init and the
+   optional ht_divchn_pthread_align_elt are completed, and can be called
+   concurrently with the operations of other threads. A pool is used by
+   one thread at a time, and its block is not freed until the hash table
+   is freed with ht_divchn_pthread_free, which releases its slabs.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   pool        : pointer to a preallocated block of size
+                 sizeof(ht_divchn_pthread_pool_t)
+*/
+void ht_divchn_pthread_pool_init(ht_divchn_pthread_t *ht,
+				 ht_divchn_pthread_pool_t *pool);
+
+/**
+   Inserts a batch of keys and associated elements into a hash table with
+   the nodes of a pool of the calling thread, which are constructed before
+   the thread enters the hash table. The pool parameter points to a pool
+   initialized with ht_divchn_pthread_pool_init, or is NULL and the nodes
+   are allocated under the locks of their slots. Please see the parameter
+   specification in ht_divchn_pthread_insert.
+*/
+void ht_divchn_pthread_insert_pool(ht_divchn_pthread_t *ht,
+				   ht_divchn_pthread_pool_t *pool,
+				   const void *batch_keys,
+				   const void *batch_elts,
+				   size_t batch_count);
+
 /**
    Inserts a batch of keys and associated elements into a hash table.
    The batch_keys and batch_elts parameters are not NULL and point to
@@ -201,6 +502,47 @@ void ht_divchn_pthread_insert(ht_divchn_pthread_t *ht,
 			      const void *batch_elts,
 			      size_t batch_count);
 
+/**
+   Starts the delegation mode of a hash table with num_owners owner
+   threads, each owning a contiguous range of slots. The operation is
+   called before/after all threads started/completed insert, remove,
+   delete, and search_batch operations on ht. Until the mode is stopped
+   with ht_divchn_pthread_deleg_stop, the hash table is modified only by
+   ht_divchn_pthread_deleg_insert, and is not accessed by other
+   operations. A migration of keys in the incremental mode is completed
+   when the mode is started, and the growth steps in the mode move all
+   keys. The nodes of an owner are allocated from a pool registered with
+   the hash table, which is released when the hash table is freed.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   num_owners  : >= 1, number of owner threads
+*/
+void ht_divchn_pthread_deleg_start(ht_divchn_pthread_t *ht,
+				   size_t num_owners);
+
+/**
+   Queues a batch of keys and associated elements for the insertion by
+   the owners of their slots, in the delegation mode of a hash table. The
+   operation is called concurrently by any number of threads, copies the
+   keys and elements, and returns before the keys are inserted. The keys
+   of a batch queued to an owner are inserted in the order of the batch,
+   unless they were routed before a growth step, and the order across
+   batches and threads is not specified, which provides a single final
+   state with a commutative and associative rdc_elts (e.g. min, max, add).
+   Please see the parameter specification in ht_divchn_pthread_insert.
+*/
+void ht_divchn_pthread_deleg_insert(ht_divchn_pthread_t *ht,
+				    const void *batch_keys,
+				    const void *batch_elts,
+				    size_t batch_count);
+
+/**
+   Waits until the keys of all queued batches are inserted, and stops the
+   delegation mode of a hash table by joining its owner threads. The
+   operation is called after all threads completed
+   ht_divchn_pthread_deleg_insert operations on ht.
+*/
+void ht_divchn_pthread_deleg_stop(ht_divchn_pthread_t *ht);
+
 /**
    If a key is present in a hash table, returns a pointer to its associated 
    element, otherwise returns NULL. The key parameter is not NULL.
@@ -211,6 +553,101 @@ void ht_divchn_pthread_insert(ht_divchn_pthread_t *ht,
 void *ht_divchn_pthread_search(const ht_divchn_pthread_t *ht,
 			       const void *key);
 
+/**
+   Searches a batch of keys in a hash table by copying the element, or its
+   pointer, associated with each key that is present into the
+   corresponding block in the array of elt_size blocks pointed to by
+   batch_elts. If a key is not in the hash table, leaves the corresponding
+   elt_size block unchanged. Returns the number of keys in the batch that
+   are present in the hash table. The batch_keys and batch_elts parameters
+   are not NULL and point to arrays of blocks of size key_size and
+   elt_size respectively. The batch_count parameter is the count of keys in
+   a batch. The operation is called concurrently with insert, remove,
+   delete, and other search_batch operations. If an element is within a
+   noncontiguous memory block, the copied pointer is valid until the key
+   is removed or deleted by another thread.
+
+   A search batch takes locks as a modifying batch and may block:
+   - it enters and exits through a gate shard under the mutex of the
+   shard, and waits at the entry while the gate is closed by a growth
+   step, which in turn waits until the search batches in the hash table
+   exit,
+   - it searches a key under the stripe lock of the slot of the key, and
+   during the migration of keys also under the stripe lock of the
+   previous slot of the key, in the order of lock indices; in the grouped
+   mode, a lock is taken once for the keys of the batch that are covered
+   by the lock; the batch waits while a lock is held by another thread,
+   - during the migration of keys, it claims a range of previous slots
+   under gate_lock and moves their keys under the stripe locks; if the
+   batch is the last to exit after the migration is complete, it frees
+   the previous slots.
+*/
+size_t ht_divchn_pthread_search_batch(ht_divchn_pthread_t *ht,
+				      const void *batch_keys,
+				      void *batch_elts,
+				      size_t batch_count);
+
+/**
+   Returns the number of keys in a hash table, including the net changes
+   counted in the gate shards. The operation is called before/after all
+   threads started/completed insert, remove, and delete operations on ht.
+*/
+size_t ht_divchn_pthread_num_elts(const ht_divchn_pthread_t *ht);
+
+/**
+   Initializes a cursor for enumerating the keys in a hash table with
+   ht_divchn_pthread_next. A cursor is valid until the hash table is
+   modified.
+*/
+void ht_divchn_pthread_cursor_init(ht_divchn_pthread_cursor_t *cur);
+
+/**
+   Advances a cursor to the next key in a hash table. Returns a pointer to
+   the element associated with the key and sets the pointer pointed to by
+   key to point to the in-table key, or returns NULL if all keys were
+   enumerated. The operation is called before/after all threads
+   started/completed insert, remove, and delete operations on ht and does
+   not require thread synchronization overhead.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct that
+                 was not modified after the cursor was initialized
+   cur         : pointer to a cursor initialized with
+                 ht_divchn_pthread_cursor_init
+   key         : pointer to a pointer that is set to point to a key_size
+                 block
+*/
+void *ht_divchn_pthread_next(const ht_divchn_pthread_t *ht,
+			     ht_divchn_pthread_cursor_t *cur,
+			     const void **key);
+
+/**
+   Calls a visit function on each key in a hash table and its associated
+   element. The first argument of visit points to a key_size block, the
+   second argument points to an elt_size block, and the third argument is
+   the arg parameter. The visit function does not modify the hash table,
+   except through the second argument. The operation is called
+   before/after all threads started/completed insert, remove, and delete
+   operations on ht and does not require thread synchronization overhead.
+*/
+void ht_divchn_pthread_foreach(const ht_divchn_pthread_t *ht,
+			       void (*visit)(const void *, void *, void *),
+			       void *arg);
+
+/**
+   Copies the keys of a hash table into an array of num_elts key_size
+   blocks pointed to by keys, and the elements, or pointers to elements,
+   into an array of num_elts elt_size blocks pointed to by elts, s.t. the
+   ith element is associated with the ith key. If keys or elts is NULL,
+   the corresponding array is not written. Returns num_elts. The slots
+   are partitioned across num_grow_threads threads, which first count the
+   keys in their segments and then copy the keys and elements into
+   disjoint ranges of the arrays, resulting in the same order as the order
+   of enumeration with a cursor. The operation is called before/after all
+   threads started/completed insert, remove, and delete operations on ht.
+*/
+size_t ht_divchn_pthread_export(const ht_divchn_pthread_t *ht,
+				void *keys,
+				void *elts);
+
 /**
    Removes a batch of keys and associated elements from a hash table by
    copying the elements or its pointers into the array of elt_size blocks
@@ -225,6 +662,18 @@ void ht_divchn_pthread_remove(ht_divchn_pthread_t *ht,
 			      void *batch_elts,
 			      size_t batch_count);
 
+/**
+   Removes a batch of keys and associated elements from a hash table, and
+   returns the nodes of the removed keys to a pool of the calling thread,
+   or to the allocators of the lock stripes if pool is NULL. Please see
+   the parameter specification in ht_divchn_pthread_remove.
+*/
+void ht_divchn_pthread_remove_pool(ht_divchn_pthread_t *ht,
+				   ht_divchn_pthread_pool_t *pool,
+				   const void *batch_keys,
+				   void *batch_elts,
+				   size_t batch_count);
+
 /**
    Deletes a batch of keys and associated elements from a hash table.
    If a key is not in the hash table, no operation with respect to the key
@@ -236,6 +685,40 @@ void ht_divchn_pthread_delete(ht_divchn_pthread_t *ht,
 			      const void *batch_keys,
 			      size_t batch_count);
 
+/**
+   Deletes a batch of keys and associated elements from a hash table, and
+   returns the nodes of the deleted keys to a pool of the calling thread,
+   or to the allocators of the lock stripes if pool is NULL. Please see
+   the parameter specification in ht_divchn_pthread_delete.
+*/
+void ht_divchn_pthread_delete_pool(ht_divchn_pthread_t *ht,
+				   ht_divchn_pthread_pool_t *pool,
+				   const void *batch_keys,
+				   size_t batch_count);
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+/**
+   Copies the statistics of a hash table into a block pointed to by stats.
+   The ith bin of the chain length histogram is the number of slots with
+   i keys, and the last bin also includes the longer chains. The processor
+   time of a growth operation is measured with clock() and includes the
+   processor time of all threads of the process during the operation. In
+   the incremental mode, the processor time of a growth operation does not
+   include the migration of keys by the subsequent operations, and during
+   the migration of keys, the previous slots are included in the histogram.
+   The num_bytes value includes the registered pools, the grow workers,
+   and the delegation states, and does not include the noncontiguous
+   elements. The operation is called
+   before/after all threads started/completed insert, remove, and delete
+   operations on ht.
+   ht          : pointer to an initialized ht_divchn_pthread_t struct
+   stats       : pointer to a preallocated block of size
+                 sizeof(ht_divchn_pthread_stats_t)
+*/
+void ht_divchn_pthread_stats(const ht_divchn_pthread_t *ht,
+			     ht_divchn_pthread_stats_t *stats);
+#endif
+
 /**
    Frees a hash table. The operation is called after all threads completed
    insert, remove, delete, and search operations. Leaves a block of size
@@ -255,14 +738,60 @@ void ht_divchn_pthread_free(ht_divchn_pthread_t *ht);
 
 void ht_divchn_pthread_align_elt_helper(void *ht, size_t alignment);
 
+void ht_divchn_pthread_incr_helper(void *ht, int is_incr);
+
+void ht_divchn_pthread_grouped_helper(void *ht, int is_grouped);
+
+void ht_divchn_pthread_locks_helper(void *ht,
+				    ht_divchn_pthread_lock_kind_t lock_kind,
+				    size_t log_max_num_locks);
+
+void ht_divchn_pthread_pool_init_helper(void *ht, void *pool);
+
+void ht_divchn_pthread_insert_pool_helper(void *ht,
+					  void *pool,
+					  const void *batch_keys,
+					  const void *batch_elts,
+					  size_t batch_count);
+
 void ht_divchn_pthread_insert_helper(void *ht,
 				     const void *batch_keys,
 				     const void *batch_elts,
 				     size_t batch_count);
 
+void ht_divchn_pthread_deleg_start_helper(void *ht, size_t num_owners);
+
+void ht_divchn_pthread_deleg_insert_helper(void *ht,
+					   const void *batch_keys,
+					   const void *batch_elts,
+					   size_t batch_count);
+
+void ht_divchn_pthread_deleg_stop_helper(void *ht);
+
 void *ht_divchn_pthread_search_helper(const void *ht,
 				      const void *key);
 
+size_t ht_divchn_pthread_search_batch_helper(void *ht,
+					     const void *batch_keys,
+					     void *batch_elts,
+					     size_t batch_count);
+
+size_t ht_divchn_pthread_num_elts_helper(const void *ht);
+
+void *ht_divchn_pthread_next_helper(const void *ht,
+				    void *cur,
+				    const void **key);
+
+void ht_divchn_pthread_foreach_helper(const void *ht,
+				      void (*visit)(const void *,
+						    void *,
+						    void *),
+				      void *arg);
+
+size_t ht_divchn_pthread_export_helper(const void *ht,
+				       void *keys,
+				       void *elts);
+
 void ht_divchn_pthread_remove_helper(void *ht,
 				     const void *batch_keys,
 				     void *batch_elts,
@@ -272,6 +801,21 @@ void ht_divchn_pthread_delete_helper(void *ht,
 				     const void *batch_keys,
 				     size_t batch_count);
 
+void ht_divchn_pthread_remove_pool_helper(void *ht,
+					  void *pool,
+					  const void *batch_keys,
+					  void *batch_elts,
+					  size_t batch_count);
+
+void ht_divchn_pthread_delete_pool_helper(void *ht,
+					  void *pool,
+					  const void *batch_keys,
+					  size_t batch_count);
+
+#ifdef HT_DIVCHN_PTHREAD_STATS
+void ht_divchn_pthread_stats_helper(const void *ht, void *stats);
+#endif
+
 void ht_divchn_pthread_free_helper(void *ht);
 
 #endif
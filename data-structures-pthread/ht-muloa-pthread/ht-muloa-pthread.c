@@ -0,0 +1,999 @@
+/**
+   ht-muloa-pthread.c
+
+   A hash table with generic hash keys and generic elements that is
+   concurrently accessible and modifiable.
+
+   The implementation is based on a multiplication method for hashing into
+   upto 2**(CHAR_BIT * sizeof(size_t) - 1) slots and an open addressing
+   method with double hashing for resolving collisions. The keys, hash
+   values, and elements are within the fixed-size slots of a single
+   contiguous array, which eliminates an allocation per insertion and a
+   pointer dereference per probe.
+
+   A hash key is an object within a contiguous block of memory (e.g. a basic
+   type, array, struct). An element is within a contiguous or noncontiguous
+   memory block.
+
+   The load factor of a hash table is the expected number of keys in a slot
+   under the simple uniform hashing assumption, and is upper-bounded by the
+   alpha parameter. The alpha parameter does not provide an upper bound
+   after the maximum count of slots in a hash table is reached.
+
+   A slot is accessed by insert, remove, and delete operations under the
+   mutex lock that covers the slot, one slot at a time. A key is inserted
+   only into an empty slot, and a removed or deleted key leaves a
+   placeholder in its slot until the next growth step. Because a slot is
+   never emptied while threads are in a hash table, the probe sequence of
+   a key does not change under concurrent operations, and concurrent
+   insertions of the same key find the same slot.
+
+   An insert operation is completed in steps of at most max_batch_count
+   keys. A thread enters a step if the number of keys and placeholders,
+   together with max_batch_count keys for each thread in an insert step,
+   does not exceed the count of slots less one, which guarantees an empty
+   slot at the end of each probe sequence. The count of slots is at least
+   the number of keys allowed by alpha, increased by the product of
+   NUM_INS_THREADS_MINMAX and max_batch_count, so that at least
+   NUM_INS_THREADS_MINMAX threads are in insert steps simultaneously
+   if alpha is not exceeded.
+
+   A hash table is modified by threads calling insert, remove, and/or delete
+   operations concurrently. The design provides the following guarantees
+   with respect to the final state of a hash table, defined as a pair of
+   i) a load factor, and ii) the set of key-element pairs of the hash
+   table, after all operations are completed:
+     - a single final state is guaranteed with respect to concurrent insert,
+     remove, and/or delete operations if the sets of keys used by threads
+     are disjoint,
+     - if insert operations are called by more than one thread concurrently
+     and the sets of keys used by threads are not disjoint, then a single
+     final state of the hash table is guaranteed according to a user-defined
+     reduction function (e.g. min, max, add, multiply, and, or, xor of key-
+     associated elements),
+     - each thread is guaranteed to complete each insert step of at most
+     max_batch_count keys i) before a load factor upper bound (alpha) is
+     exceeded, ii) before the hash table grows as a part of a called insert
+     operation when alpha is temporarily* exceeded**, or iii) after the hash
+     table reaches its maximum count of slots on a given system and alpha
+     no longer bounds the load factor.
+
+   The implementation only uses integer and pointer operations. Integer
+   arithmetic is used in load factor operations, thereby eliminating the
+   use of float. Given parameter values within the specified ranges,
+   the implementation provides an error message and an exit is executed
+   if an integer overflow is attempted or an allocation is not completed
+   due to insufficient resources. The behavior outside the specified
+   parameter ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirements are: i) CHAR_BIT * sizeof(size_t) is greater
+   or equal to 16 and is even (every bit is required to participate
+   in the value at this time), and ii) pthreads API is available.
+
+   * unless the growth step that follows does not lower the load factor
+   below alpha because the maximum count of slots is reached during the
+   growth step, in which case alpha no longer bounds the load factor
+
+   ** to the extent dependent on the number of threads in insert steps
+   and max_batch_count
+*/
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include "ht-muloa-pthread.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-pthread.h"
+
+static const size_t C_FIRST_PRIME_PARTS[1 + 8 * (2 + 3 + 4)] =
+  {0xbe21u,                            /* 2**15 < 48673 < 2**16 */
+   0xd8d5u, 0x0002u,                   /* 2**17 < 186581 < 2**18 */
+   0x0077u, 0x000cu,                   /* 2**19 < 786551 < 2**20 */
+   0x2029u, 0x0031u,                   /* 2**21 < 3219497 < 2**22 */
+   0x5427u, 0x00bfu,                   /* 2**23 < 12538919 < 2**24 */
+   0x42bbu, 0x030fu,                   /* 2**25 < 51331771 < 2**26 */
+   0x96adu, 0x0c98u,                   /* 2**27 < 211326637 < 2**28 */
+   0xc10fu, 0x2ecfu,                   /* 2**29 < 785367311 < 2**30 */
+   0x72e9u, 0xad16u,                   /* 2**31 < 2903929577 < 2**32 */
+   0x9345u, 0xffc8u, 0x0002u,          /* 2**33 < 12881269573 < 2**34 */
+   0x1575u, 0x0a63u, 0x000cu,          /* 2**35 < 51713873269 < 2**36 */
+   0xc513u, 0x4d6bu, 0x0031u,          /* 2**37 < 211752305939 < 2**38 */
+   0xa021u, 0x5460u, 0x00beu,          /* 2**39 < 817459404833 < 2**40 */
+   0xeaafu, 0x7c3du, 0x02f5u,          /* 2**41 < 3253374675631 < 2**42 */
+   0x6b1fu, 0x29efu, 0x0c24u,          /* 2**43 < 13349461912351 < 2**44 */
+   0x57b7u, 0xccbeu, 0x2ffbu,          /* 2**45 < 52758518323127 < 2**46 */
+   0x82c3u, 0x2c9fu, 0xc2ccu,          /* 2**47 < 214182177768131 < 2**48 */
+   0x60adu, 0x46a1u, 0xf55eu, 0x0002u, /* 2**49 < 832735214133421 < 2**50 */
+   0xb24du, 0x6765u, 0x38b5u, 0x000bu, /* 2**51 < 3158576518771277 < 2**52 */
+   0x0d35u, 0x5443u, 0xff54u, 0x0030u, /* 2**53 < 13791536538127669 < 2**54 */
+   0xd017u, 0x90c7u, 0x37b3u, 0x00c6u, /* 2**55 < 55793289756397591 < 2**56 */
+   0x6f8fu, 0x423bu, 0x8949u, 0x0304u, /* 2**57 < 217449629757435791 < 2**58 */
+   0xbbc1u, 0x662cu, 0x4d90u, 0x0badu, /* 2**59 < 841413987972987841 < 2**60 */
+   0xc647u, 0x3c91u, 0x46b2u, 0x2e9bu, /* 2**61 < 3358355678469146183 < 2**62 */
+   0x8969u, 0x4c70u, 0x6dbeu, 0xdad8u  /* 2**63 < 15769474759331449193 < 2**64 */
+  }; 
+
+static const size_t C_SECOND_PRIME_PARTS[1 + 8 * (2 + 3 + 4)] =
+  {0xc221u,                            /* 2**15 < 49697 < 2**16 */
+   0xe04bu, 0x0002u,                   /* 2**17 < 188491 < 2**18 */
+   0xf6a7u, 0x000bu,                   /* 2**19 < 784039 < 2**20 */
+   0x1b4fu, 0x0030u,                   /* 2**21 < 3152719 < 2**22 */
+   0x4761u, 0x00beu,                   /* 2**23 < 12470113 < 2**24 */
+   0x3eadu, 0x0312u,                   /* 2**25 < 51527341 < 2**26 */
+   0x08e9u, 0x0ca5u,                   /* 2**27 < 212142313 < 2**28 */
+   0x06b9u, 0x2eecu,                   /* 2**29 < 787220153 < 2**30 */
+   0x5391u, 0xbba6u,                   /* 2**31 < 3148239761 < 2**32 */
+   0x3739u, 0xf7fdu, 0x0002u,          /* 2**33 < 12750501689 < 2**34 */
+   0x852bu, 0x07f8u, 0x000cu,          /* 2**35 < 51673335083 < 2**36 */
+   0xa61bu, 0x457au, 0x0031u,          /* 2**37 < 211619063323 < 2**38 */
+   0xb041u, 0xbf9eu, 0x00bdu,          /* 2**39 < 814963667009 < 2**40 */
+   0x4515u, 0x3eafu, 0x0308u,          /* 2**41 < 3333946295573 < 2**42 */
+   0x6f4fu, 0xc0d9u, 0x0c3cu,          /* 2**43 < 13455073046351 < 2**44 */
+   0x0da1u, 0x6600u, 0x3025u,          /* 2**45 < 52937183202721 < 2**46 */
+   0xb229u, 0x8facu, 0xc1e5u,          /* 2**47 < 213191702131241 < 2**48 */
+   0x58f1u, 0x94e9u, 0xff18u, 0x0002u, /* 2**49 < 843430996039921 < 2**50 */
+   0x73abu, 0xda62u, 0x9da8u, 0x000bu, /* 2**51 < 3269573287769003 < 2**52 */
+   0x37f1u, 0xd800u, 0x135bu, 0x0031u, /* 2**53 < 13813559045666801 < 2**54 */
+   0xd909u, 0xa518u, 0xebc1u, 0x00c4u, /* 2**55 < 55428312366373129 < 2**56 */
+   0x03a7u, 0x5cb0u, 0xba89u, 0x0302u, /* 2**57 < 216940831195530151 < 2**58 */
+   0x12adu, 0x7477u, 0xb251u, 0x0c10u, /* 2**59 < 869390790998561453 < 2**60 */
+   0xe411u, 0x4bacu, 0x9c82u, 0x2f17u, /* 2**61 < 3393352927676261393 < 2**62 */
+   0xd047u, 0x33a5u, 0x5cb7u, 0xbd8fu  /* 2**63 < 13659238136753279047 < 2**64 */
+  };
+
+static const size_t C_LAST_PRIME_IX = 1 + 8 * (2 + 3 + 4) - 4;
+static const size_t C_PARTS_PER_PRIME[4] = {1, 2, 3, 4};
+static const size_t C_PARTS_ACC_COUNTS[4] = {1,
+					     1 + 8 * 2,
+					     1 + 8 * (2 + 3),
+					     1 + 8 * (2 + 3 + 4)};
+static const size_t C_BUILD_SHIFT = 16;
+static const size_t C_BYTE_BIT = CHAR_BIT;
+static const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
+static const size_t C_LOG_COUNT_MIN = 8; /* > 0 */
+static const size_t C_LOG_COUNT_MAX = CHAR_BIT * sizeof(size_t) - 1;
+static const size_t C_SIZE_MAX = (size_t)-1;
+
+static ke_t *ke_at(const ht_muloa_pthread_t *ht,
+		   const void *slots,
+		   size_t ix);
+static int is_empty(const ke_t *ke);
+static int is_ph(const ke_t *ke);
+static void *ke_key_ptr(const ht_muloa_pthread_t *ht, const ke_t *ke);
+static void *ke_elt_ptr(const ht_muloa_pthread_t *ht, const ke_t *ke);
+static int is_key_eq(const ht_muloa_pthread_t *ht,
+		     const ke_t *ke,
+		     size_t fval,
+		     const void *key);
+static void slots_init(ht_muloa_pthread_t *ht);
+static void slot_size_update(ht_muloa_pthread_t *ht);
+static size_t convert_std_key(const ht_muloa_pthread_t *ht,
+			      const void *key);
+static void hash(const ht_muloa_pthread_t *ht,
+		 const void *key,
+		 size_t *fval,
+		 size_t *sval);
+static size_t adjust_dist(size_t dist);
+static int insert_key(ht_muloa_pthread_t *ht,
+		      const void *key,
+		      const void *elt);
+static int remove_key(ht_muloa_pthread_t *ht,
+		      const void *key,
+		      void *elt,
+		      void (*free_elt)(void *));
+static void enter_gate(ht_muloa_pthread_t *ht);
+static void exit_gate(ht_muloa_pthread_t *ht);
+static size_t mul_alpha(size_t n, size_t alpha_n, size_t log_alpha_d);
+static void set_max_sum(ht_muloa_pthread_t *ht);
+static int incr_count(ht_muloa_pthread_t *ht);
+static void ht_grow(ht_muloa_pthread_t *ht);
+static int is_overflow(const size_t *parts, size_t start, size_t count);
+static size_t build_prime(const size_t *parts, size_t start, size_t count);
+static size_t find_build_prime(const size_t *parts);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Initializes a hash table. The initialization operation is called and
+   must return before any thread calls insert, remove, and/or delete,
+   or search operation.
+   ht               : a pointer to a preallocated block of size
+                      sizeof(ht_muloa_pthread_t).
+   key_size         : non-zero size of a key object
+   elt_size         : - non-zero size of an element, if the element is
+                      within a contiguous memory block and a copy of the
+                      element is inserted,
+                      - size of a pointer to an element, if the element
+                      is within a noncontiguous memory block or a pointer to
+                      a contiguous element is inserted
+   min_num          : minimum number of keys that are known or expected to
+                      become present simultaneously in a hash table,
+                      resulting in a speedup by avoiding unnecessary growth
+                      steps of a hash table; 0 if a positive value is not
+                      specified and all growth steps are to be completed
+   alpha_n          : > 0 numerator of load factor upper bound
+   log_alpha_d      : < CHAR_BIT * sizeof(size_t) log base 2 of denominator
+                      of load factor upper bound; denominator is a power of
+                      two and is greater or equal to alpha_n
+   max_batch_count  : > 0 maximum number of keys inserted by a thread in an
+                      insert step; see NUM_INS_THREADS_MINMAX
+   log_num_locks    : log base 2 number of mutex locks for synchronizing
+                      insert, remove, and delete operations; a larger number
+                      reduces the size of a set of slots that maps to a lock
+                      and may reduce the time threads are blocked, depending
+                      on the scheduler and at the expense of space
+   num_grow_threads : >= 1, number of threads used in growing the hash table
+   cmp_key          : - if NULL then a default memcmp-based comparison of
+                      keys is performed
+                      - otherwise comparison function is applied which
+                      returns a zero integer value iff the two keys accessed
+                      through the first and the second arguments are equal;
+                      each argument is a pointer to a key_size block
+   rdc_key          : - if NULL then a default conversion of a bit pattern
+                      in the block pointed to by key is performed prior to
+                      hashing, which may introduce regularities
+                      - otherwise rdc_key is applied to a key prior to
+                      hashing; the first argument points to a key and the
+                      second argument provides the size of the key
+   rdc_elts         : - NULL, if a key is in the hash table when the key is
+                      inserted, the key-associated element in the hash table
+                      is updated to the inserted element
+                      - non-NULL, if a key is in the hash table when the
+                      key is inserted, performs a reduction of the element
+                      already in the hash table and the inserted element;
+                      the result of the reduction is associated with the key
+                      in the hash table; the first argument points to an
+                      elt_size-sized block in the hash table, the second
+                      argument points to an elt_size-sized block of the
+                      inserted element, and the third argument is equal to a
+                      elt_size value
+   free_elt         : - if an element is within a contiguous memory block and
+                      a copy of the element was inserted, then NULL as
+                      free_elt is sufficient to delete the element,
+                      - if an element is within a noncontiguous memory block
+                      or a pointer to a contiguous element was inserted, then
+                      an element-specific free_elt, taking a pointer to a
+                      pointer to an element as its argument and leaving a
+                      block of size elt_size pointed to by the argument, is
+                      necessary to delete the element
+*/
+void ht_muloa_pthread_init(ht_muloa_pthread_t *ht,
+			   size_t key_size,
+			   size_t elt_size,
+			   size_t min_num,
+			   size_t alpha_n,
+			   size_t log_alpha_d,
+			   size_t max_batch_count,
+			   size_t log_num_locks,
+			   size_t num_grow_threads,
+			   int (*cmp_key)(const void *, const void *),
+			   size_t (*rdc_key)(const void *, size_t),
+			   void (*rdc_elts)(void *, const void *, size_t),
+			   void (*free_elt)(void *)){
+  size_t i, rem;
+  size_t key_locks_count;
+  /* hash table */
+  ht->key_size = key_size;
+  ht->elt_size = elt_size;
+  /* align ke_t relative to a malloc's pointer */
+  if (key_size <= sizeof(size_t)){
+    ht->key_offset = sizeof(size_t);
+  }else{
+    rem = key_size % sizeof(size_t);
+    ht->key_offset = key_size;
+    ht->key_offset = add_sz_perror(ht->key_offset,
+				   (rem > 0) * (sizeof(size_t) - rem));
+  }
+  /* elt_size block accessible with a character pointer */
+  ht->elt_offset = sizeof(ke_t);
+  ht->elt_alignment = 1;
+  slot_size_update(ht);
+  ht->alpha_n = alpha_n;
+  ht->log_alpha_d = log_alpha_d;
+  ht->max_batch_count = max_batch_count;
+  ht->log_count = C_LOG_COUNT_MIN;
+  ht->count = pow_two_perror(C_LOG_COUNT_MIN);
+  set_max_sum(ht);
+  /* allowed excess: count - 1 >= max_sum + NUM_INS_THREADS_MINMAX * mbc */
+  while ((min_num > ht->max_sum ||
+	  ht->count - 1 <= mul_sz_perror(NUM_INS_THREADS_MINMAX,
+					 max_batch_count)) &&
+	 incr_count(ht));
+  ht->num_elts = 0;
+  ht->num_phs = 0;
+  ht->fprime = find_build_prime(C_FIRST_PRIME_PARTS);
+  ht->sprime = find_build_prime(C_SECOND_PRIME_PARTS);
+  slots_init(ht);
+  /* thread synchronization */
+  ht->num_in_threads = 0;
+  ht->num_in_ins_threads = 0;
+  ht->num_grow_threads = num_grow_threads;
+  key_locks_count = pow_two_perror(log_num_locks);
+  ht->key_locks_mask = C_SIZE_MAX & (key_locks_count - 1);
+  ht->gate_open = TRUE;
+  mutex_init_perror(&ht->gate_lock);
+  ht->key_locks = malloc_perror(key_locks_count,
+				sizeof(pthread_mutex_t));
+  for (i = 0; i < key_locks_count; i++){
+    mutex_init_perror(&ht->key_locks[i]);
+  }
+  cond_init_perror(&ht->gate_open_cond);
+  cond_init_perror(&ht->grow_cond);
+  /* function pointers */
+  ht->cmp_key = cmp_key;
+  ht->rdc_key = rdc_key;
+  ht->rdc_elts = rdc_elts;
+  ht->free_elt = free_elt;
+}
+
+/**
+   Aligns each in-table elt_size block to be accessible with a pointer to a
+   type T other than character (in addition to a character pointer). If
+   alignment requirement of T is unknown, the size of T can be used
+   as a value of the alignment parameter because size of T >= alignment
+   requirement of T (due to structure of arrays), which may result in
+   overalignment. The hash table keeps the effective type of a copied
+   elt_size block, if it had one at the time of insertion, and T must
+   be compatible with the type to comply with the strict aliasing rules.
+   T can be the same or a cvr-qualified/signed/unsigned version of the
+   type. The operation is optionally called after ht_muloa_pthread_init is
+   completed and before any other operation is called.
+   ht          : pointer to an initialized ht_muloa_pthread_t struct
+   alignment   : alignment requirement or size of the type, a pointer to
+                 which is used to access an elt_size block
+*/
+void ht_muloa_pthread_align_elt(ht_muloa_pthread_t *ht, size_t alignment){
+  size_t rem;
+  ht->elt_alignment = alignment;
+  rem = add_sz_perror(ht->key_offset, ht->elt_offset) % alignment;
+  ht->elt_offset = add_sz_perror(ht->elt_offset,
+				 (rem > 0) * (alignment - rem));
+  slot_size_update(ht);
+  free(ht->slots);
+  slots_init(ht);
+}
+
+/**
+   Inserts a batch of keys and associated elements into a hash table.
+   The batch_keys and batch_elts parameters are not NULL and point to
+   arrays of blocks of size key_size and elt_size respectively. The
+   batch_count parameter is the count of keys in a batch, and the batch
+   is inserted in steps of at most max_batch_count keys. See also the
+   specification of rdc_elts in ht_muloa_pthread_init.
+*/
+void ht_muloa_pthread_insert(ht_muloa_pthread_t *ht,
+			     const void *batch_keys,
+			     const void *batch_elts,
+			     size_t batch_count){
+  size_t i, j;
+  size_t step_count;
+  size_t increased;
+  for (i = 0; i < batch_count; i += step_count){
+    step_count = batch_count - i;
+    if (step_count > ht->max_batch_count) step_count = ht->max_batch_count;
+
+    /* first critical section : go through gate or wait */
+    mutex_lock_perror(&ht->gate_lock);
+    while (!ht->gate_open ||
+	   ht->num_elts + ht->num_phs +
+	   (ht->num_in_ins_threads + 1) * ht->max_batch_count >
+	   ht->count - 1){
+      cond_wait_perror(&ht->gate_open_cond, &ht->gate_lock);
+    }
+    ht->num_in_threads++;
+    ht->num_in_ins_threads++;
+    mutex_unlock_perror(&ht->gate_lock);
+
+    /* insert */
+    increased = 0;
+    for (j = i; j < i + step_count; j++){
+      increased += insert_key(ht,
+			      ptr(batch_keys, j, ht->key_size),
+			      ptr(batch_elts, j, ht->elt_size));
+    }
+
+    /* grow ht if needed, and finish */
+    mutex_lock_perror(&ht->gate_lock);
+    ht->num_elts += increased;
+    ht->num_in_ins_threads--;
+    exit_gate(ht);
+  }
+}
+
+/**
+   If a key is present in a hash table, returns a pointer to its associated
+   element, otherwise returns NULL. The key parameter is not NULL.
+   The operation is called before/after all threads started/completed
+   insert, remove, and delete operations on ht and does not require
+   thread synchronization overhead.
+*/
+void *ht_muloa_pthread_search(const ht_muloa_pthread_t *ht,
+			      const void *key){
+  size_t fval, sval, ix, dist;
+  const ke_t *ke = NULL;
+  hash(ht, key, &fval, &sval);
+  ix = fval >> (C_FULL_BIT - ht->log_count);
+  dist = adjust_dist(sval >> (C_FULL_BIT - ht->log_count));
+  ke = ke_at(ht, ht->slots, ix);
+  while (!is_empty(ke)){
+    if (is_key_eq(ht, ke, fval, key)) return ke_elt_ptr(ht, ke);
+    ix = sum_mod(dist, ix, ht->count);
+    ke = ke_at(ht, ht->slots, ix);
+  }
+  return NULL;
+}
+
+/**
+   Removes a batch of keys and associated elements from a hash table by
+   copying the elements or its pointers into the array of elt_size blocks
+   pointed to by batch_elts. If a key is not in the hash table, leaves the
+   corresponding elt_size block unchanged. The batch_keys and batch_elts
+   parameters are not NULL and point to arrays of blocks of size key_size and
+   elt_size respectively. The batch_count parameter is the count of keys in a
+   batch.
+*/
+void ht_muloa_pthread_remove(ht_muloa_pthread_t *ht,
+			     const void *batch_keys,
+			     void *batch_elts,
+			     size_t batch_count){
+  size_t i;
+  size_t removed = 0;
+  enter_gate(ht);
+  for (i = 0; i < batch_count; i++){
+    /* if an element is noncontiguous, only the pointer to it is deleted */
+    removed += remove_key(ht,
+			  ptr(batch_keys, i, ht->key_size),
+			  ptr(batch_elts, i, ht->elt_size),
+			  NULL);
+  }
+  mutex_lock_perror(&ht->gate_lock);
+  ht->num_elts -= removed;
+  ht->num_phs += removed;
+  exit_gate(ht);
+}
+
+/**
+   Deletes a batch of keys and associated elements from a hash table.
+   If a key is not in the hash table, no operation with respect to the key
+   is performed. The batch_keys parameter is not NULL and points to an array
+   of blocks of size key_size. The batch_count parameter is the count of keys
+   in a batch.
+*/
+void ht_muloa_pthread_delete(ht_muloa_pthread_t *ht,
+			     const void *batch_keys,
+			     size_t batch_count){
+  size_t i;
+  size_t deleted = 0;
+  enter_gate(ht);
+  for (i = 0; i < batch_count; i++){
+    deleted += remove_key(ht,
+			  ptr(batch_keys, i, ht->key_size),
+			  NULL,
+			  ht->free_elt);
+  }
+  mutex_lock_perror(&ht->gate_lock);
+  ht->num_elts -= deleted;
+  ht->num_phs += deleted;
+  exit_gate(ht);
+}
+
+/**
+   Frees a hash table. The operation is called after all threads completed
+   insert, remove, delete, and search operations. Leaves a block of size
+   sizeof(ht_muloa_pthread_t) pointed to by the ht parameter.
+*/
+void ht_muloa_pthread_free(ht_muloa_pthread_t *ht){
+  size_t i;
+  ke_t *ke = NULL;
+  if (ht->free_elt != NULL){
+    for (i = 0; i < ht->count; i++){
+      ke = ke_at(ht, ht->slots, i);
+      if (!is_empty(ke) && !is_ph(ke)) ht->free_elt(ke_elt_ptr(ht, ke));
+    }
+  }
+  free(ht->slots);
+  free(ht->key_locks);
+  ht->slots = NULL;
+  ht->key_locks = NULL;
+}
+
+/**
+   Help construct a hash table parameter value in algorithms and data
+   structures with a hash table parameter, complying with the stict aliasing
+   rules and compatibility rules for function types. In each case, a
+   (qualified) ht_muloa_pthread_t *p0 is converted to (qualified) void *
+   and back to a (qualified) ht_muloa_ptrhead_t *p1, thus guaranteeing that
+   the value of p0 equals the value of p1. An initialization helper is
+   constructed by the user.
+*/
+
+void ht_muloa_pthread_align_elt_helper(void *ht, size_t alignment){
+  ht_muloa_pthread_align_elt(ht, alignment);
+}
+
+void ht_muloa_pthread_insert_helper(void *ht,
+				    const void *batch_keys,
+				    const void *batch_elts,
+				    size_t batch_count){
+  ht_muloa_pthread_insert(ht, batch_keys, batch_elts, batch_count);
+}
+
+void *ht_muloa_pthread_search_helper(const void *ht,
+				     const void *key){
+  return ht_muloa_pthread_search(ht, key);
+}
+
+void ht_muloa_pthread_remove_helper(void *ht,
+				    const void *batch_keys,
+				    void *batch_elts,
+				    size_t batch_count){
+  ht_muloa_pthread_remove(ht, batch_keys, batch_elts, batch_count);
+}
+
+void ht_muloa_pthread_delete_helper(void *ht,
+				    const void *batch_keys,
+				    size_t batch_count){
+  ht_muloa_pthread_delete(ht, batch_keys, batch_count);
+}
+
+void ht_muloa_pthread_free_helper(void *ht){
+  ht_muloa_pthread_free(ht);
+}
+
+/** Auxiliary functions */
+
+/**
+   Returns a pointer to the key element in the slot ix of an array of
+   slots.
+*/
+static ke_t *ke_at(const ht_muloa_pthread_t *ht,
+		   const void *slots,
+		   size_t ix){
+  return (ke_t *)((char *)slots + ix * ht->slot_size + ht->key_offset);
+}
+
+/**
+   Test if a slot is empty, and if a slot that is not empty contains a
+   placeholder. An empty slot is identified by the fval and sval values
+   equal to 1, and a placeholder by the fval and sval values equal to 1
+   and 0 respectively.
+*/
+
+static int is_empty(const ke_t *ke){
+  return (ke->fval == 1 && ke->sval == 1);
+}
+
+static int is_ph(const ke_t *ke){
+  return (ke->fval == 1);
+}
+
+/**
+   Return pointers to the key and element of a key element in a slot.
+*/
+
+static void *ke_key_ptr(const ht_muloa_pthread_t *ht, const ke_t *ke){
+  return (void *)((char *)ke - ht->key_offset);
+}
+
+static void *ke_elt_ptr(const ht_muloa_pthread_t *ht, const ke_t *ke){
+  return (void *)((char *)ke + ht->elt_offset);
+}
+
+/**
+   Tests if a slot that is not empty contains a key with the first hash
+   value fval. The first hash values are compared before the keys, and a
+   placeholder does not match any key.
+*/
+static int is_key_eq(const ht_muloa_pthread_t *ht,
+		     const ke_t *ke,
+		     size_t fval,
+		     const void *key){
+  if (ke->fval != fval - (fval & 1)) return 0;
+  if (ht->cmp_key != NULL) return ht->cmp_key(ke_key_ptr(ht, ke), key) == 0;
+  return memcmp(ke_key_ptr(ht, ke), key, ht->key_size) == 0;
+}
+
+/**
+   Initializes the empty slots of a hash table according to its count.
+*/
+static void slots_init(ht_muloa_pthread_t *ht){
+  size_t i;
+  ke_t *ke = NULL;
+  ht->slots = malloc_perror(ht->count, ht->slot_size);
+  for (i = 0; i < ht->count; i++){
+    ke = ke_at(ht, ht->slots, i);
+    ke->fval = 1;
+    ke->sval = 1;
+  }
+}
+
+/**
+   Computes the size of a slot according to key_offset, elt_offset, and
+   elt_alignment, s.t. the ke_t struct and the elt_size block in each slot
+   of a malloc'ed array are aligned.
+*/
+static void slot_size_update(ht_muloa_pthread_t *ht){
+  size_t rem, unit;
+  unit = lcm_perror(sizeof(size_t), ht->elt_alignment);
+  ht->slot_size = add_sz_perror(ht->key_offset,
+				add_sz_perror(ht->elt_offset, ht->elt_size));
+  rem = ht->slot_size % unit;
+  ht->slot_size = add_sz_perror(ht->slot_size, (rem > 0) * (unit - rem));
+}
+
+/**
+   Converts a key to a key of the standard size. This is a safe conversion
+   of any bit pattern in the block pointed to by key to size_t.
+*/
+static size_t convert_std_key(const ht_muloa_pthread_t *ht,
+			      const void *key){
+  size_t i;
+  size_t sz_count, rem_size;
+  size_t std_key = 0;
+  size_t buf_size = sizeof(size_t);
+  unsigned char buf[sizeof(size_t)];
+  const char *k = NULL, *k_start = NULL, *k_end = NULL;
+  if (ht->rdc_key != NULL) return ht->rdc_key(key, ht->key_size);
+  sz_count = ht->key_size / buf_size; /* division by sizeof(size_t) */
+  rem_size = ht->key_size - sz_count * buf_size;
+  k = key;
+  memset(buf, 0, buf_size);
+  memcpy(buf, k, rem_size);
+  for (i = 0; i < rem_size; i++){
+    std_key += (size_t)buf[i] << (i * C_BYTE_BIT);
+  }
+  k_start = k + rem_size;
+  k_end = k_start + sz_count * buf_size;
+  for (k = k_start; k != k_end; k += buf_size){
+    memcpy(buf, k, buf_size);
+    for (i = 0; i < buf_size; i++){
+      std_key += (size_t)buf[i] << (i * C_BYTE_BIT);
+    }
+  }
+  return std_key;
+}
+
+/**
+   Computes the first and second hash values of a key.
+*/
+static void hash(const ht_muloa_pthread_t *ht,
+		 const void *key,
+		 size_t *fval,
+		 size_t *sval){
+  size_t std_key = convert_std_key(ht, key);
+  *fval = ht->fprime * std_key; /* mod 2**C_FULL_BIT */
+  *sval = ht->sprime * std_key; /* mod 2**C_FULL_BIT */
+}
+
+/**
+   Adjusts a probe distance to an odd distance, if necessary.
+*/
+static size_t adjust_dist(size_t dist){
+  size_t ret = dist;
+  if (!(dist & 1)){
+    if (dist == 0){
+      ret++;
+    }else{
+      ret--;
+    }
+  }
+  return ret;
+}
+
+/**
+   Inserts a key and an associated element into a hash table. Each slot in
+   the probe sequence of the key is accessed under the lock that covers
+   the slot. Returns 1 if the key was inserted into an empty slot, and 0
+   if the element associated with the key was updated or reduced.
+*/
+static int insert_key(ht_muloa_pthread_t *ht,
+		      const void *key,
+		      const void *elt){
+  size_t fval, sval, ix, dist;
+  ke_t *ke = NULL;
+  pthread_mutex_t *lock = NULL;
+  hash(ht, key, &fval, &sval);
+  ix = fval >> (C_FULL_BIT - ht->log_count);
+  dist = adjust_dist(sval >> (C_FULL_BIT - ht->log_count));
+  while (1){
+    lock = &ht->key_locks[ix & ht->key_locks_mask];
+    mutex_lock_perror(lock);
+    ke = ke_at(ht, ht->slots, ix);
+    if (is_empty(ke)){
+      /* 1st bit not used in hashing => 1 as ph identifier */
+      ke->fval = fval - (fval & 1);
+      ke->sval = sval;
+      memcpy(ke_key_ptr(ht, ke), key, ht->key_size);
+      memcpy(ke_elt_ptr(ht, ke), elt, ht->elt_size);
+      mutex_unlock_perror(lock);
+      return 1;
+    }else if (is_key_eq(ht, ke, fval, key)){
+      if (ht->rdc_elts != NULL){
+	/* reduce new element and current element */
+	ht->rdc_elts(ke_elt_ptr(ht, ke), elt, ht->elt_size);
+      }else{
+	/* update current element to new element */
+	if (ht->free_elt != NULL) ht->free_elt(ke_elt_ptr(ht, ke));
+	memcpy(ke_elt_ptr(ht, ke), elt, ht->elt_size);
+      }
+      mutex_unlock_perror(lock);
+      return 0;
+    }
+    mutex_unlock_perror(lock);
+    ix = sum_mod(dist, ix, ht->count);
+  }
+}
+
+/**
+   If a key is in a hash table, replaces the key with a placeholder and
+   returns 1, otherwise returns 0. If elt is not NULL, the element or its
+   pointer is copied into the block of size elt_size pointed to by elt.
+   If free_elt is not NULL, the element is deleted with free_elt. Each slot
+   in the probe sequence of the key is accessed under the lock that covers
+   the slot.
+*/
+static int remove_key(ht_muloa_pthread_t *ht,
+		      const void *key,
+		      void *elt,
+		      void (*free_elt)(void *)){
+  size_t fval, sval, ix, dist;
+  ke_t *ke = NULL;
+  pthread_mutex_t *lock = NULL;
+  hash(ht, key, &fval, &sval);
+  ix = fval >> (C_FULL_BIT - ht->log_count);
+  dist = adjust_dist(sval >> (C_FULL_BIT - ht->log_count));
+  while (1){
+    lock = &ht->key_locks[ix & ht->key_locks_mask];
+    mutex_lock_perror(lock);
+    ke = ke_at(ht, ht->slots, ix);
+    if (is_empty(ke)){
+      mutex_unlock_perror(lock);
+      return 0;
+    }else if (is_key_eq(ht, ke, fval, key)){
+      if (elt != NULL) memcpy(elt, ke_elt_ptr(ht, ke), ht->elt_size);
+      if (free_elt != NULL) free_elt(ke_elt_ptr(ht, ke));
+      ke->fval = 1;
+      ke->sval = 0;
+      mutex_unlock_perror(lock);
+      return 1;
+    }
+    mutex_unlock_perror(lock);
+    ix = sum_mod(dist, ix, ht->count);
+  }
+}
+
+/**
+   Enters a hash table for a remove or delete operation after waiting
+   for the gate to open.
+*/
+static void enter_gate(ht_muloa_pthread_t *ht){
+  /* first critical section : go through gate or wait */
+  mutex_lock_perror(&ht->gate_lock);
+  while (!ht->gate_open){
+    cond_wait_perror(&ht->gate_open_cond, &ht->gate_lock);
+  }
+  ht->num_in_threads++;
+  mutex_unlock_perror(&ht->gate_lock);
+}
+
+/**
+   Exits a hash table after an insert step, or a remove or delete
+   operation. The operation is called with gate_lock held, after num_elts
+   and num_phs were updated, and releases gate_lock. If the sum of keys
+   and placeholders exceeds max_sum and growth or elimination of
+   placeholders is possible, the gate is closed, the calling thread waits
+   for the other threads in the hash table to exit, and grows the hash
+   table.
+*/
+static void exit_gate(ht_muloa_pthread_t *ht){
+  if (ht->num_elts + ht->num_phs > ht->max_sum &&
+      (ht->log_count < C_LOG_COUNT_MAX || ht->num_phs > 0) &&
+      ht->gate_open){
+    ht->gate_open = FALSE;
+    /* wait for threads that passed first critical section to finish */
+    while (ht->num_in_threads > 1){
+      cond_wait_perror(&ht->grow_cond, &ht->gate_lock);
+    }
+    mutex_unlock_perror(&ht->gate_lock);
+    ht_grow(ht); /* single thread */
+    mutex_lock_perror(&ht->gate_lock);
+    ht->gate_open = TRUE;
+  }else if (!ht->gate_open){
+    cond_signal_perror(&ht->grow_cond);
+  }
+  ht->num_in_threads--;
+  /* the gate may be open or an insert step may be allowed */
+  cond_broadcast_perror(&ht->gate_open_cond);
+  mutex_unlock_perror(&ht->gate_lock);
+}
+
+/**
+   Multiplies an unsigned integer n by a load factor upper bound, represented
+   by a numerator and log base 2 of a denominator. The denominator is a
+   power of two.
+*/
+static size_t mul_alpha(size_t n, size_t alpha_n, size_t log_alpha_d){
+  size_t h, l;
+  mul_ext(n, alpha_n, &h, &l);
+  l >>= log_alpha_d;
+  h <<= (C_FULL_BIT - log_alpha_d);
+  return l + h;
+}
+
+/**
+   Sets max_sum of a hash table according to its count and alpha, s.t.
+   max_sum does not exceed count - 1 less the product of
+   NUM_INS_THREADS_MINMAX and max_batch_count.
+*/
+static void set_max_sum(ht_muloa_pthread_t *ht){
+  size_t excess = mul_sz_perror(NUM_INS_THREADS_MINMAX, ht->max_batch_count);
+  ht->max_sum = mul_alpha(ht->count, ht->alpha_n, ht->log_alpha_d);
+  if (ht->count - 1 <= excess){
+    ht->max_sum = 0;
+  }else if (ht->max_sum > ht->count - 1 - excess){
+    ht->max_sum = ht->count - 1 - excess;
+  }
+}
+
+/**
+   Attempts to increase the count of a hash table. Returns 1 if the count
+   was increased. Otherwise returns 0. Updates count, log_count, and max_sum
+   of the hash table accordingly. If 2**C_LOG_COUNT_MAX is reached, log_count
+   is set to C_LOG_COUNT_MAX.
+*/
+static int incr_count(ht_muloa_pthread_t *ht){
+  if (ht->log_count == C_LOG_COUNT_MAX) return 0;
+  ht->log_count++;
+  ht->count <<= 1;
+  set_max_sum(ht);
+  return 1;
+}
+
+/**
+   Increases the count of a hash table to the next power of two that
+   accomodates alpha as a load factor upper bound, or eliminates the
+   placeholders without changing the count if num_elts < num_phs. The
+   operation is called if i) alpha was exceeded (i.e. num_elts + num_phs >
+   max_sum) and log_count is not equal to C_LOG_COUNT_MAX or there are
+   placeholders in the hash table, AND ii) it is
+   guaranteed that only the calling thread has access to the hash table
+   throughout the operation. The keys are reinserted into the new slots by
+   num_grow_threads threads, each on a segment of the previous slots.
+*/
+
+typedef struct{
+  size_t start;
+  size_t count;
+  const void *prev_slots;
+  ht_muloa_pthread_t *ht;
+} reinsert_arg_t;
+
+static void *reinsert_thread(void *arg){
+  size_t i, ix, dist;
+  const ke_t *prev_ke = NULL;
+  ke_t *ke = NULL;
+  pthread_mutex_t *lock = NULL;
+  const reinsert_arg_t *ra = arg;
+  ht_muloa_pthread_t *ht = ra->ht;
+  for (i = ra->start; i < ra->start + ra->count; i++){
+    prev_ke = ke_at(ht, ra->prev_slots, i);
+    if (is_empty(prev_ke) || is_ph(prev_ke)) continue;
+    ix = prev_ke->fval >> (C_FULL_BIT - ht->log_count);
+    dist = adjust_dist(prev_ke->sval >> (C_FULL_BIT - ht->log_count));
+    while (1){
+      lock = &ht->key_locks[ix & ht->key_locks_mask];
+      mutex_lock_perror(lock);
+      ke = ke_at(ht, ht->slots, ix);
+      if (is_empty(ke)){
+	memcpy(ke_key_ptr(ht, ke), ke_key_ptr(ht, prev_ke), ht->slot_size);
+	mutex_unlock_perror(lock);
+	break;
+      }
+      mutex_unlock_perror(lock);
+      ix = sum_mod(dist, ix, ht->count);
+    }
+  }
+  return NULL;
+}
+
+static void ht_grow(ht_muloa_pthread_t *ht){
+  size_t i, prev_count = ht->count;
+  size_t start = 0;
+  size_t seg_count, rem_count;
+  void *prev_slots = ht->slots;
+  pthread_t *rids = NULL;
+  reinsert_arg_t *ras = NULL;
+  /* initialize next ht; num_elts and num_phs can be used without lock */
+  if (ht->num_elts >= ht->num_phs){
+    while (ht->num_elts + ht->num_phs > ht->max_sum && incr_count(ht));
+  }else{
+    while (ht->num_elts > ht->max_sum && incr_count(ht));
+  }
+  rids = malloc_perror(ht->num_grow_threads, sizeof(pthread_t));
+  ras = malloc_perror(ht->num_grow_threads, sizeof(reinsert_arg_t));
+  slots_init(ht);
+  /* multithreaded reinsertion */
+  seg_count = prev_count / ht->num_grow_threads;
+  rem_count = prev_count - seg_count * ht->num_grow_threads;
+  for (i = 0; i < ht->num_grow_threads; i++){
+    ras[i].start = start;
+    ras[i].count = seg_count;
+    ras[i].count += (rem_count > 0 && rem_count--);
+    ras[i].prev_slots = prev_slots;
+    ras[i].ht = ht;
+    thread_create_perror(&rids[i], reinsert_thread, &ras[i]);
+    start += ras[i].count;
+  }
+  for (i = 0; i < ht->num_grow_threads; i++){
+    thread_join_perror(rids[i], NULL);
+  }
+  ht->num_phs = 0;
+  free(prev_slots);
+  free(rids);
+  free(ras);
+  prev_slots = NULL;
+  rids = NULL;
+  ras = NULL;
+}
+
+/**
+   Tests if the next prime number results in an overflow of size_t
+   on a given system. Returns 0 if no overflow, otherwise returns 1.
+*/
+static int is_overflow(const size_t *parts, size_t start, size_t count){
+  size_t c = 0;
+  size_t n_shift;
+  n_shift = parts[start + (count - 1)];
+  while (n_shift){
+    n_shift >>= 1;
+    c++;
+  }
+  return (c + (count - 1) * C_BUILD_SHIFT > C_FULL_BIT);
+}
+
+/**
+   Builds a prime number from parts in the C_FIRST_PRIME_PARTS or
+   C_SECOND_PRIME_PARTS array.
+*/
+static size_t build_prime(const size_t *parts, size_t start, size_t count){
+  size_t p = 0;
+  size_t n_shift;
+  size_t i;
+  for (i = 0; i < count; i++){
+    n_shift = parts[start + i];
+    n_shift <<= (i * C_BUILD_SHIFT);
+    p |= n_shift;
+  }
+  return p;
+}
+
+/**
+   Finds and builds a prime number p, s.t. 2**(n - 1) < p < 2**n where
+   n = CHAR_BIT * sizeof(size_t), from parts in the C_FIRST_PRIME_PARTS or
+   C_SECOND_PRIME_PARTS array.
+*/
+static size_t find_build_prime(const size_t *parts){
+  size_t p;
+  size_t i = 0, j = 0;
+  p = build_prime(parts, i, C_PARTS_PER_PRIME[j]);
+  i += C_PARTS_PER_PRIME[j];
+  if (i == C_PARTS_ACC_COUNTS[j]) j++;
+  while (i <= C_LAST_PRIME_IX &&
+	 !is_overflow(parts, i, C_PARTS_PER_PRIME[j])){
+    p = build_prime(parts, i, C_PARTS_PER_PRIME[j]);
+    i += C_PARTS_PER_PRIME[j];
+    if (i == C_PARTS_ACC_COUNTS[j]) j++;
+  }
+  return p;
+}
+
+/**
+   Computes a pointer to the ith element of size size in a block.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
@@ -1,54 +1,125 @@
 /**
    ht-muloa-pthread.h
 
-   Struct declarations and declarations of accessible functions of a hash 
+   Struct declarations and declarations of accessible functions of a hash
    table with generic hash keys and generic elements that is concurrently
    accessible and modifiable.
 
+   The implementation is based on a multiplication method for hashing into
+   upto 2**(CHAR_BIT * sizeof(size_t) - 1) slots and an open addressing
+   method with double hashing for resolving collisions. The keys, hash
+   values, and elements are within the fixed-size slots of a single
+   contiguous array, which eliminates an allocation per insertion and a
+   pointer dereference per probe.
+
+   A hash key is an object within a contiguous block of memory (e.g. a basic
+   type, array, struct). An element is within a contiguous or noncontiguous
+   memory block.
+
+   The load factor of a hash table is the expected number of keys in a slot
+   under the simple uniform hashing assumption, and is upper-bounded by the
+   alpha parameter. The alpha parameter does not provide an upper bound
+   after the maximum count of slots in a hash table is reached.
+
+   A slot is accessed by insert, remove, and delete operations under the
+   mutex lock that covers the slot, one slot at a time. A key is inserted
+   only into an empty slot, and a removed or deleted key leaves a
+   placeholder in its slot until the next growth step. Because a slot is
+   never emptied while threads are in a hash table, the probe sequence of
+   a key does not change under concurrent operations, and concurrent
+   insertions of the same key find the same slot.
+
+   An insert operation is completed in steps of at most max_batch_count
+   keys. A thread enters a step if the number of keys and placeholders,
+   together with max_batch_count keys for each thread in an insert step,
+   does not exceed the count of slots less one, which guarantees an empty
+   slot at the end of each probe sequence. The count of slots is at least
+   the number of keys allowed by alpha, increased by the product of
+   NUM_INS_THREADS_MINMAX and max_batch_count, so that at least
+   NUM_INS_THREADS_MINMAX threads are in insert steps simultaneously
+   if alpha is not exceeded.
+
+   A hash table is modified by threads calling insert, remove, and/or delete
+   operations concurrently. The design provides the following guarantees
+   with respect to the final state of a hash table, defined as a pair of
+   i) a load factor, and ii) the set of key-element pairs of the hash
+   table, after all operations are completed:
+     - a single final state is guaranteed with respect to concurrent insert,
+     remove, and/or delete operations if the sets of keys used by threads
+     are disjoint,
+     - if insert operations are called by more than one thread concurrently
+     and the sets of keys used by threads are not disjoint, then a single
+     final state of the hash table is guaranteed according to a user-defined
+     reduction function (e.g. min, max, add, multiply, and, or, xor of key-
+     associated elements),
+     - each thread is guaranteed to complete each insert step of at most
+     max_batch_count keys i) before a load factor upper bound (alpha) is
+     exceeded, ii) before the hash table grows as a part of a called insert
+     operation when alpha is temporarily* exceeded**, or iii) after the hash
+     table reaches its maximum count of slots on a given system and alpha
+     no longer bounds the load factor.
+
+   The implementation only uses integer and pointer operations. Integer
+   arithmetic is used in load factor operations, thereby eliminating the
+   use of float. Given parameter values within the specified ranges,
+   the implementation provides an error message and an exit is executed
+   if an integer overflow is attempted or an allocation is not completed
+   due to insufficient resources. The behavior outside the specified
+   parameter ranges is undefined.
+
    The implementation does not use stdint.h and is portable under C89/C90
    and C99. The requirements are: i) CHAR_BIT * sizeof(size_t) is greater
-   or equal to 16 and is even, and ii) pthreads API is available.
+   or equal to 16 and is even (every bit is required to participate
+   in the value at this time), and ii) pthreads API is available.
+
+   * unless the growth step that follows does not lower the load factor
+   below alpha because the maximum count of slots is reached during the
+   growth step, in which case alpha no longer bounds the load factor
+
+   ** to the extent dependent on the number of threads in insert steps
+   and max_batch_count
 */
 
-#ifndef HT_MULOA_PTHREAD_H  
+#ifndef HT_MULOA_PTHREAD_H
 #define HT_MULOA_PTHREAD_H
 
 #define _XOPEN_SOURCE 600
 
 #include <stddef.h>
 #include <pthread.h>
-#include "dll.h"
 
 typedef enum{FALSE, TRUE} boolean_t;
 
 typedef struct{
-  boolean_t is_ph;
-  size_t fval;
-  size_t sval;
-  void *key;
-  void *elt;
-} key_elt_t; /* first and second hash values, key and element pointers */
+  size_t fval; /* first hash value with first bit only set in placeholder */
+  size_t sval; /* second hash value */
+} ke_t;        /* given char *p pointer to a ke_t in a slot,
+                  p - key_offset points to key_size block and
+                  p + elt_offset points to elt_size block */
 
 typedef struct{
   /* hash table */
   size_t key_size;
   size_t elt_size;
+  size_t key_offset;
+  size_t elt_offset;
+  size_t elt_alignment;
+  size_t slot_size;
   size_t log_count;
   size_t count;
-  size_t max_count;
-  size_t max_num_probes;
+  size_t max_sum; /* >= 0, < count, represents alpha */
   size_t num_elts;
   size_t num_phs;
-  size_t fprime; /* >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
-  size_t sprime; /* >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
-  float alpha;
-  key_elt_t *ph;
-  key_elt_t **key_elts;
+  size_t fprime; /* odd, >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
+  size_t sprime; /* odd, >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
+  size_t alpha_n;
+  size_t log_alpha_d;
+  void *slots;
 
   /* thread synchronization */
   size_t max_batch_count;
   size_t num_in_threads; /* passed gate_lock's first critical section */
-  size_t num_in_ins_threads;
+  size_t num_in_ins_threads; /* in insert steps */
   size_t num_grow_threads;
   size_t key_locks_mask; /* -> probability of waiting at a slot */
   boolean_t gate_open;
@@ -58,8 +129,9 @@ typedef struct{
   pthread_cond_t grow_cond;
 
   /* function pointers */
+  int (*cmp_key)(const void *, const void *);
   size_t (*rdc_key)(const void *, size_t);
-  void (*rdc_elt)(void *, const void *, size_t); /* e.g. min, max, add */
+  void (*rdc_elts)(void *, const void *, size_t); /* e.g. min, max, add */
   void (*free_elt)(void *);
 } ht_muloa_pthread_t;
 
@@ -67,24 +139,105 @@ typedef struct{
    Initializes a hash table. The initialization operation is called and
    must return before any thread calls insert, remove, and/or delete,
    or search operation.
+   ht               : a pointer to a preallocated block of size
+                      sizeof(ht_muloa_pthread_t).
+   key_size         : non-zero size of a key object
+   elt_size         : - non-zero size of an element, if the element is
+                      within a contiguous memory block and a copy of the
+                      element is inserted,
+                      - size of a pointer to an element, if the element
+                      is within a noncontiguous memory block or a pointer to
+                      a contiguous element is inserted
+   min_num          : minimum number of keys that are known or expected to
+                      become present simultaneously in a hash table,
+                      resulting in a speedup by avoiding unnecessary growth
+                      steps of a hash table; 0 if a positive value is not
+                      specified and all growth steps are to be completed
+   alpha_n          : > 0 numerator of load factor upper bound
+   log_alpha_d      : < CHAR_BIT * sizeof(size_t) log base 2 of denominator
+                      of load factor upper bound; denominator is a power of
+                      two and is greater or equal to alpha_n
+   max_batch_count  : > 0 maximum number of keys inserted by a thread in an
+                      insert step; see NUM_INS_THREADS_MINMAX
+   log_num_locks    : log base 2 number of mutex locks for synchronizing
+                      insert, remove, and delete operations; a larger number
+                      reduces the size of a set of slots that maps to a lock
+                      and may reduce the time threads are blocked, depending
+                      on the scheduler and at the expense of space
+   num_grow_threads : >= 1, number of threads used in growing the hash table
+   cmp_key          : - if NULL then a default memcmp-based comparison of
+                      keys is performed
+                      - otherwise comparison function is applied which
+                      returns a zero integer value iff the two keys accessed
+                      through the first and the second arguments are equal;
+                      each argument is a pointer to a key_size block
+   rdc_key          : - if NULL then a default conversion of a bit pattern
+                      in the block pointed to by key is performed prior to
+                      hashing, which may introduce regularities
+                      - otherwise rdc_key is applied to a key prior to
+                      hashing; the first argument points to a key and the
+                      second argument provides the size of the key
+   rdc_elts         : - NULL, if a key is in the hash table when the key is
+                      inserted, the key-associated element in the hash table
+                      is updated to the inserted element
+                      - non-NULL, if a key is in the hash table when the
+                      key is inserted, performs a reduction of the element
+                      already in the hash table and the inserted element;
+                      the result of the reduction is associated with the key
+                      in the hash table; the first argument points to an
+                      elt_size-sized block in the hash table, the second
+                      argument points to an elt_size-sized block of the
+                      inserted element, and the third argument is equal to a
+                      elt_size value
+   free_elt         : - if an element is within a contiguous memory block and
+                      a copy of the element was inserted, then NULL as
+                      free_elt is sufficient to delete the element,
+                      - if an element is within a noncontiguous memory block
+                      or a pointer to a contiguous element was inserted, then
+                      an element-specific free_elt, taking a pointer to a
+                      pointer to an element as its argument and leaving a
+                      block of size elt_size pointed to by the argument, is
+                      necessary to delete the element
 */
 void ht_muloa_pthread_init(ht_muloa_pthread_t *ht,
 			   size_t key_size,
 			   size_t elt_size,
 			   size_t min_num,
-			   float alpha,
+			   size_t alpha_n,
+			   size_t log_alpha_d,
 			   size_t max_batch_count,
 			   size_t log_num_locks,
 			   size_t num_grow_threads,
+			   int (*cmp_key)(const void *, const void *),
 			   size_t (*rdc_key)(const void *, size_t),
-			   void (*rdc_elt)(void *, const void *, size_t),
+			   void (*rdc_elts)(void *, const void *, size_t),
 			   void (*free_elt)(void *));
 
+/**
+   Aligns each in-table elt_size block to be accessible with a pointer to a
+   type T other than character (in addition to a character pointer). If
+   alignment requirement of T is unknown, the size of T can be used
+   as a value of the alignment parameter because size of T >= alignment
+   requirement of T (due to structure of arrays), which may result in
+   overalignment. The hash table keeps the effective type of a copied
+   elt_size block, if it had one at the time of insertion, and T must
+   be compatible with the type to comply with the strict aliasing rules.
+   T can be the same or a cvr-qualified/signed/unsigned version of the
+   type. The operation is optionally called after ht_muloa_pthread_init is
+   completed and before any other operation is called.
+   ht          : pointer to an initialized ht_muloa_pthread_t struct
+   alignment   : alignment requirement or size of the type, a pointer to
+                 which is used to access an elt_size block
+*/
+void ht_muloa_pthread_align_elt(ht_muloa_pthread_t *ht, size_t alignment);
+
 /**
    Inserts a batch of keys and associated elements into a hash table.
-   The batch_keys and batch_elts parameters are not NULL. The
-   batch_count parameter is the count of keys in a batch. See also the
-   specification of rdc_elt in ht_muloa_pthread_init.
+   The batch_keys and batch_elts parameters are not NULL and point to
+   arrays of blocks of size key_size and elt_size respectively. The
+   batch_count parameter is the count of keys in a batch, and the batch
+   is inserted in steps of at most max_batch_count keys. See also the
+   specification of rdc_elts in ht_muloa_pthread_init.
 */
 void ht_muloa_pthread_insert(ht_muloa_pthread_t *ht,
 			     const void *batch_keys,
@@ -92,19 +245,23 @@ void ht_muloa_pthread_insert(ht_muloa_pthread_t *ht,
 			     size_t batch_count);
 
 /**
-   If a key is present in a hash table, returns a pointer to its associated 
+   If a key is present in a hash table, returns a pointer to its associated
    element, otherwise returns NULL. The key parameter is not NULL.
    The operation is called before/after all threads started/completed
-   insert, remove, and delete operations on ht. This is a non-modifying
-   query operation and has no synchronization overhead.
+   insert, remove, and delete operations on ht and does not require
+   thread synchronization overhead.
 */
 void *ht_muloa_pthread_search(const ht_muloa_pthread_t *ht,
 			      const void *key);
 
 /**
-   Removes a batch of keys and associated elements from a hash table.
-   The batch_keys and batch_elts parameters are not NULL. The
-   batch_count parameter is the count of keys in a batch.
+   Removes a batch of keys and associated elements from a hash table by
+   copying the elements or its pointers into the array of elt_size blocks
+   pointed to by batch_elts. If a key is not in the hash table, leaves the
+   corresponding elt_size block unchanged. The batch_keys and batch_elts
+   parameters are not NULL and point to arrays of blocks of size key_size and
+   elt_size respectively. The batch_count parameter is the count of keys in a
+   batch.
 */
 void ht_muloa_pthread_remove(ht_muloa_pthread_t *ht,
 			     const void *batch_keys,
@@ -113,8 +270,10 @@ void ht_muloa_pthread_remove(ht_muloa_pthread_t *ht,
 
 /**
    Deletes a batch of keys and associated elements from a hash table.
-   The batch_keys and batch_elts parameters are not NULL. The
-   batch_count parameter is the count of keys in a batch.
+   If a key is not in the hash table, no operation with respect to the key
+   is performed. The batch_keys parameter is not NULL and points to an array
+   of blocks of size key_size. The batch_count parameter is the count of keys
+   in a batch.
 */
 void ht_muloa_pthread_delete(ht_muloa_pthread_t *ht,
 			     const void *batch_keys,
@@ -122,10 +281,42 @@ void ht_muloa_pthread_delete(ht_muloa_pthread_t *ht,
 
 /**
    Frees a hash table. The operation is called after all threads completed
-   insert, remove, delete, and search operations.
+   insert, remove, delete, and search operations. Leaves a block of size
+   sizeof(ht_muloa_pthread_t) pointed to by the ht parameter.
 */
 void ht_muloa_pthread_free(ht_muloa_pthread_t *ht);
 
+/**
+   Help construct a hash table parameter value in algorithms and data
+   structures with a hash table parameter, complying with the stict aliasing
+   rules and compatibility rules for function types. In each case, a
+   (qualified) ht_muloa_pthread_t *p0 is converted to (qualified) void *
+   and back to a (qualified) ht_muloa_ptrhead_t *p1, thus guaranteeing that
+   the value of p0 equals the value of p1. An initialization helper is
+   constructed by the user.
+*/
+
+void ht_muloa_pthread_align_elt_helper(void *ht, size_t alignment);
+
+void ht_muloa_pthread_insert_helper(void *ht,
+				    const void *batch_keys,
+				    const void *batch_elts,
+				    size_t batch_count);
+
+void *ht_muloa_pthread_search_helper(const void *ht,
+				     const void *key);
+
+void ht_muloa_pthread_remove_helper(void *ht,
+				    const void *batch_keys,
+				    void *batch_elts,
+				    size_t batch_count);
+
+void ht_muloa_pthread_delete_helper(void *ht,
+				    const void *batch_keys,
+				    size_t batch_count);
+
+void ht_muloa_pthread_free_helper(void *ht);
+
 /**
    The product of NUM_INS_THREADS_MINMAX and the value of max_batch_count
    determines:
@@ -11,11 +11,13 @@
       [0, 1] : on/off prepend append free int test
       [0, 1] : on/off prepend append free int_ptr (noncontiguous) test
       [0, 1] : on/off corner cases test
+      [0, 1] : on/off slab allocator int test
 
    usage examples:
    ./dll-test
    ./dll-test 23
    ./dll-test 24 1 0 0
+   ./dll-test 24 0 0 0 1
 
    dll-test can be run with any subset of command line arguments in the
    above-defined order. If the (i + 1)th argument is specified then the ith
@@ -46,13 +48,15 @@ const char *C_USAGE =
   "[0, bit width of int - 2) : i s.t. # inserts = 2**i\n"
   "[0, 1] : on/off prepend append free int test\n"
   "[0, 1] : on/off prepend append free int_ptr (noncontiguous) test\n"
-  "[0, 1] : on/off corner cases test\n";
-const int C_ARGC_MAX = 5;
-const size_t C_ARGS_DEF[4] = {13, 1, 1, 1};
+  "[0, 1] : on/off corner cases test\n"
+  "[0, 1] : on/off slab allocator int test\n";
+const int C_ARGC_MAX = 6;
+const size_t C_ARGS_DEF[5] = {13, 1, 1, 1, 1};
 const size_t C_INT_BIT = CHAR_BIT * sizeof(int);
 
 /* tests */
 const int C_START_VAL = 0;
+const size_t C_SLAB_MAX_NUM_BLOCKS = 4096;
 
 void prepend_append_free(const dll_t *ll_prep,
 			 const dll_t *ll_app,
@@ -339,6 +343,107 @@ void run_corner_cases_test(){
   print_test_result(res);
 }
 
+/**
+   Runs a test of a slab allocator with integer keys and integer elements.
+   Nodes are created with and without a slab allocator, the nodes of a list
+   are deleted and created again from the free list of a slab allocator,
+   and the lists are freed by returning the node blocks to a slab allocator
+   and by releasing the slabs in bulk.
+*/
+void run_slab_int_test(int log_ins){
+  int res = 1;
+  int num_ins;
+  int i;
+  size_t key_size = sizeof(int);
+  size_t elt_size = sizeof(int);
+  size_t num_bytes;
+  dll_t ll;
+  dll_slab_t slab, slab_app;
+  dll_node_t *head_m, *head_s1, *head_s2, *node = NULL;
+  clock_t t_m, t_s, t_free_m, t_free_s;
+  num_ins = pow_two_perror(log_ins);
+  dll_init(&ll, &head_m, key_size);
+  dll_init(&ll, &head_s1, key_size);
+  dll_init(&ll, &head_s2, key_size);
+  dll_align_elt(&ll, sizeof(int));
+  dll_slab_init(&slab, &ll, elt_size, C_SLAB_MAX_NUM_BLOCKS);
+  dll_slab_init(&slab_app, &ll, elt_size, C_SLAB_MAX_NUM_BLOCKS);
+  printf("Run slab allocator test on int keys and int elements\n");
+  printf("\t# nodes: %d\n", num_ins);
+  t_m = clock();
+  for (i = 0; i < num_ins; i++){
+    dll_prepend_new(&ll, &head_m, &i, &i, key_size, elt_size);
+  }
+  t_m = clock() - t_m;
+  t_s = clock();
+  for (i = 0; i < num_ins; i++){
+    dll_prepend_new_slab(&ll, &slab, &head_s1, &i, &i, key_size, elt_size);
+  }
+  t_s = clock() - t_s;
+  for (i = 0; i < num_ins; i++){
+    dll_append_new_slab(&ll,
+			&slab_app,
+			&head_s2,
+			&i,
+			&i,
+			key_size,
+			elt_size);
+  }
+  node = head_s1;
+  for (i = 0; i < num_ins; i++){
+    res *= (*(int *)dll_key_ptr(&ll, node) == num_ins - 1 - i &&
+	    *(int *)dll_elt_ptr(&ll, node) == num_ins - 1 - i);
+    node = node->next;
+  }
+  node = head_s2;
+  for (i = 0; i < num_ins; i++){
+    res *= (*(int *)dll_key_ptr(&ll, node) == i &&
+	    *(int *)dll_elt_ptr(&ll, node) == i);
+    node = node->next;
+  }
+  /* delete and create again from the free list */
+  num_bytes = slab.num_bytes;
+  for (i = 0; i < num_ins; i++){
+    res *= (*(int *)dll_key_ptr(&ll, head_s1) == num_ins - 1 - i);
+    dll_delete_slab(&ll, &slab, &head_s1, head_s1, NULL);
+  }
+  res *= (head_s1 == NULL);
+  for (i = 0; i < num_ins; i++){
+    dll_append_new_slab(&ll, &slab, &head_s1, &i, &i, key_size, elt_size);
+  }
+  res *= (slab.num_bytes == num_bytes);
+  node = head_s1;
+  for (i = 0; i < num_ins; i++){
+    res *= (*(int *)dll_key_ptr(&ll, node) == i &&
+	    *(int *)dll_elt_ptr(&ll, node) == i);
+    node = node->next;
+  }
+  dll_free_slab(&ll, &slab, &head_s1, NULL);
+  res *= (head_s1 == NULL);
+  for (i = 0; i < num_ins; i++){
+    dll_prepend_new_slab(&ll, &slab, &head_s1, &i, &i, key_size, elt_size);
+  }
+  res *= (slab.num_bytes == num_bytes);
+  t_free_m = clock();
+  dll_free(&ll, &head_m, NULL);
+  t_free_m = clock() - t_free_m;
+  t_free_s = clock();
+  dll_slab_free(&slab);
+  t_free_s = clock() - t_free_s;
+  dll_slab_free(&slab_app);
+  res *= (slab.num_bytes == 0 && slab.slab == NULL);
+  printf("\t\tprepend time w/o slab:   %.4f seconds\n",
+	 (float)t_m / CLOCKS_PER_SEC);
+  printf("\t\tprepend time w/ slab:    %.4f seconds\n",
+	 (float)t_s / CLOCKS_PER_SEC);
+  printf("\t\tfree time w/o slab:      %.4f seconds\n",
+	 (float)t_free_m / CLOCKS_PER_SEC);
+  printf("\t\tfree time w/ slab:       %.4f seconds\n",
+	 (float)t_free_s / CLOCKS_PER_SEC);
+  printf("\t\tcorrectness:             ");
+  print_test_result(res);
+}
+
 /** Helper functions */
 
 /**
@@ -461,7 +566,8 @@ int main(int argc, char *argv[]){
   if (args[0] > C_INT_BIT - 3 ||
       args[1] > 1 ||
       args[2] > 1 ||
-      args[3] > 1){
+      args[3] > 1 ||
+      args[4] > 1){
     fprintf(stderr, "USAGE:\n%s", C_USAGE);
     exit(EXIT_FAILURE);
   }
@@ -474,6 +580,9 @@ int main(int argc, char *argv[]){
   if (args[3]){
     run_corner_cases_test();
   }
+  if (args[4]){
+    run_slab_int_test(args[0]);
+  }
   free(args);
   args = NULL;
   return 0;
@@ -37,6 +37,14 @@
    In combination with the circular representation, the node implementation
    also facilitates the parallelization of search.
 
+   The nodes of one or more lists can be optionally allocated from a slab
+   allocator with the *_slab operations. A slab allocator allocates node
+   blocks in slabs, each a single allocated block with a number of node
+   blocks that doubles from one slab to the next upto a maximum, reuses
+   the node blocks of deleted nodes through a free list, and releases
+   all slabs in bulk. A node block in a slab satisfies the alignment
+   guarantees of a malloc'ed node block.
+
    The implementation does not use stdint.h, and is portable under C89/C90
    and C99.
 */
@@ -47,6 +55,28 @@
 #include "dll.h"
 #include "utilities-mem.h"
 
+/**
+   A union of basic types, the size of which is a multiple of the highest
+   alignment requirement of the basic types, and is used to align the
+   node blocks in a slab as malloc'ed node blocks.
+*/
+typedef union{
+  long l;
+  double d;
+  long double ld;
+  void *p;
+  void (*fp)(void);
+} align_t;
+
+static void prepend_block(const dll_t *ll,
+			  dll_node_t **head,
+			  void *node_block,
+			  const void *key,
+			  const void *elt,
+			  size_t key_size,
+			  size_t elt_size);
+static void *slab_block(dll_slab_t *slab);
+
 /**
    Initializes an empty doubly linked list by setting a head pointer to NULL
    and key_offset and elt_offset in a dll_t struct to values according to
@@ -140,24 +170,11 @@ void dll_prepend_new(const dll_t *ll,
 		     size_t key_size,
 		     size_t elt_size){
   void *node_block = NULL;
-  dll_node_t *node = NULL;
   /* allocate single block for cache efficiency and to reduce admin bytes */
   node_block =  
     malloc_perror(1, add_sz_perror(ll->key_offset,
 				   add_sz_perror(ll->elt_offset, elt_size)));
-  node = (dll_node_t *)((char *)node_block + ll->key_offset);
-  memcpy(dll_key_ptr(ll, node), key, key_size);
-  memcpy(dll_elt_ptr(ll, node), elt, elt_size);
-  if (*head == NULL){
-    node->next = node;
-    node->prev = node;
-  }else{
-    node->next = *head;
-    node->prev = (*head)->prev;
-    (*head)->prev->next = node;
-    (*head)->prev = node;
-  }
-  *head = node;
+  prepend_block(ll, head, node_block, key, elt, key_size, elt_size);
 }
 
 /**
@@ -394,3 +411,190 @@ void dll_free(const dll_t *ll,
   }
   *head = NULL;
 }
+
+/**
+   Initializes a slab allocator for the nodes of the lists with a dll_t
+   struct. No slab is allocated until a node is created. The operation is
+   called after dll_init and the optional dll_align_elt are completed, and
+   is repeated if dll_align_elt is called after the slab allocator was
+   initialized and before a node was created.
+   slab           : pointer to a preallocated block of size
+                    sizeof(dll_slab_t)
+   ll             : pointer to an initialized dll_t struct
+   elt_size       : non-zero size of an element or a pointer to an element,
+                    as in dll_prepend_new
+   max_num_blocks : > 0 maximum number of node blocks in a slab
+*/
+void dll_slab_init(dll_slab_t *slab,
+		   const dll_t *ll,
+		   size_t elt_size,
+		   size_t max_num_blocks){
+  size_t rem;
+  slab->block_size = add_sz_perror(ll->key_offset,
+				   add_sz_perror(ll->elt_offset, elt_size));
+  rem = slab->block_size % sizeof(align_t);
+  slab->block_size = add_sz_perror(slab->block_size,
+				   (rem > 0) * (sizeof(align_t) - rem));
+  slab->max_num_blocks = max_num_blocks;
+  slab->num_blocks = 0;
+  slab->num_used = 0;
+  slab->num_bytes = 0;
+  slab->slab = NULL;
+  slab->free_block = NULL;
+}
+
+/**
+   Creates a node from a slab allocator and prepends or appends the node
+   relative to a head pointer. Please see the parameter specification in
+   dll_prepend_new. The slab parameter points to a slab allocator
+   initialized with ll and elt_size.
+*/
+
+void dll_prepend_new_slab(const dll_t *ll,
+			  dll_slab_t *slab,
+			  dll_node_t **head,
+			  const void *key,
+			  const void *elt,
+			  size_t key_size,
+			  size_t elt_size){
+  prepend_block(ll, head, slab_block(slab), key, elt, key_size, elt_size);
+}
+
+void dll_append_new_slab(const dll_t *ll,
+			 dll_slab_t *slab,
+			 dll_node_t **head,
+			 const void *key,
+			 const void *elt,
+			 size_t key_size,
+			 size_t elt_size){
+  prepend_block(ll, head, slab_block(slab), key, elt, key_size, elt_size);
+  *head = (*head)->next;
+}
+
+/**
+   Deletes a node created from a slab allocator and returns its node block
+   to the slab allocator for reuse. Please see the parameter specification
+   in dll_delete. A node can be deleted with any slab allocator initialized
+   with ll and the elt_size value of the allocator of the node, if the
+   allocators are released together.
+*/
+void dll_delete_slab(const dll_t *ll,
+		     dll_slab_t *slab,
+		     dll_node_t **head,
+		     dll_node_t *node,
+		     void (*free_elt)(void *)){
+  void *node_block = NULL;
+  if (*head == NULL || node == NULL) return;
+  dll_remove(head, node);
+  if (free_elt != NULL) free_elt(dll_elt_ptr(ll, node));
+  /* a node block begins with a malloc-aligned key block */
+  node_block = dll_key_ptr(ll, node);
+  *(void **)node_block = slab->free_block;
+  slab->free_block = node_block;
+}
+
+/**
+   Frees a doubly linked list with nodes created from a slab allocator by
+   returning the node blocks to the slab allocator for reuse. Please see
+   the parameter specification in dll_delete_slab.
+*/
+void dll_free_slab(const dll_t *ll,
+		   dll_slab_t *slab,
+		   dll_node_t **head,
+		   void (*free_elt)(void *)){
+  void *node_block = NULL;
+  dll_node_t *node = *head, *next_node = NULL;
+  if (node != NULL) (*head)->prev->next = NULL;
+  while(node != NULL){
+    next_node = node->next;
+    if (free_elt != NULL) free_elt(dll_elt_ptr(ll, node));
+    node_block = dll_key_ptr(ll, node);
+    *(void **)node_block = slab->free_block;
+    slab->free_block = node_block;
+    node = next_node;
+  }
+  *head = NULL;
+}
+
+/**
+   Releases all slabs of a slab allocator in bulk, including the node
+   blocks of the lists that were not freed, without visiting the nodes,
+   and leaves a block of size sizeof(dll_slab_t) pointed to by the slab
+   parameter. If the elements of the nodes in the lists require free_elt,
+   dll_free_slab is called on the lists before the slabs are released.
+*/
+void dll_slab_free(dll_slab_t *slab){
+  void *prev = NULL;
+  while (slab->slab != NULL){
+    prev = *(void **)slab->slab;
+    free(slab->slab);
+    slab->slab = prev;
+  }
+  slab->num_blocks = 0;
+  slab->num_used = 0;
+  slab->num_bytes = 0;
+  slab->free_block = NULL;
+}
+
+/** Auxiliary functions */
+
+/**
+   Constructs a node in a node block with a key and an element, and
+   prepends the node relative to a head pointer.
+*/
+static void prepend_block(const dll_t *ll,
+			  dll_node_t **head,
+			  void *node_block,
+			  const void *key,
+			  const void *elt,
+			  size_t key_size,
+			  size_t elt_size){
+  dll_node_t *node = (dll_node_t *)((char *)node_block + ll->key_offset);
+  memcpy(dll_key_ptr(ll, node), key, key_size);
+  memcpy(dll_elt_ptr(ll, node), elt, elt_size);
+  if (*head == NULL){
+    node->next = node;
+    node->prev = node;
+  }else{
+    node->next = *head;
+    node->prev = (*head)->prev;
+    (*head)->prev->next = node;
+    (*head)->prev = node;
+  }
+  *head = node;
+}
+
+/**
+   Returns a node block from a slab allocator. Reuses a node block of a
+   deleted node if available. Otherwise, takes the next node block of the
+   last slab, and allocates a new slab with twice the number of node
+   blocks, upto max_num_blocks, if the last slab is full. The first node
+   block of a slab follows an align_t-sized block with a pointer to the
+   previous slab.
+*/
+static void *slab_block(dll_slab_t *slab){
+  void *node_block = NULL;
+  void *new_slab = NULL;
+  size_t size;
+  if (slab->free_block != NULL){
+    node_block = slab->free_block;
+    slab->free_block = *(void **)node_block;
+    return node_block;
+  }
+  if (slab->num_used == slab->num_blocks){
+    slab->num_blocks = (slab->num_blocks == 0) ? 1 :
+      (slab->num_blocks > slab->max_num_blocks / 2) ?
+      slab->max_num_blocks : 2 * slab->num_blocks;
+    size = add_sz_perror(sizeof(align_t),
+			 mul_sz_perror(slab->num_blocks, slab->block_size));
+    new_slab = malloc_perror(1, size);
+    *(void **)new_slab = slab->slab;
+    slab->slab = new_slab;
+    slab->num_used = 0;
+    slab->num_bytes = add_sz_perror(slab->num_bytes, size);
+  }
+  node_block = (char *)slab->slab + sizeof(align_t) +
+    slab->num_used * slab->block_size;
+  slab->num_used++;
+  return node_block;
+}
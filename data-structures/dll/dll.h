@@ -38,6 +38,14 @@
    In combination with the circular representation, the node implementation
    also facilitates the parallelization of search.
 
+   The nodes of one or more lists can be optionally allocated from a slab
+   allocator with the *_slab operations. A slab allocator allocates node
+   blocks in slabs, each a single allocated block with a number of node
+   blocks that doubles from one slab to the next upto a maximum, reuses
+   the node blocks of deleted nodes through a free list, and releases
+   all slabs in bulk. A node block in a slab satisfies the alignment
+   guarantees of a malloc'ed node block.
+
    The implementation does not use stdint.h, and is portable under C89/C90
    and C99.
 */
@@ -58,6 +66,16 @@ typedef struct dll_node{
   struct dll_node *prev;
 } dll_node_t;
 
+typedef struct{
+  size_t block_size; /* size of a node block in a slab */
+  size_t max_num_blocks; /* maximum number of node blocks in a slab */
+  size_t num_blocks; /* number of node blocks in the last slab */
+  size_t num_used; /* number of used node blocks in the last slab */
+  size_t num_bytes; /* allocated for slabs */
+  void *slab; /* last slab, begins with a pointer to the previous slab */
+  void *free_block; /* free list of node blocks */
+} dll_slab_t;
+
 /**
    Initializes an empty doubly linked list by setting a head pointer to NULL
    and key_offset and elt_offset in a dll_t struct to values according to
@@ -242,4 +260,77 @@ void dll_free(const dll_t *ll,
 	      dll_node_t **head,
 	      void (*free_elt)(void *));
 
+/**
+   Initializes a slab allocator for the nodes of the lists with a dll_t
+   struct. No slab is allocated until a node is created. The operation is
+   called after dll_init and the optional dll_align_elt are completed, and
+   is repeated if dll_align_elt is called after the slab allocator was
+   initialized and before a node was created.
+   slab           : pointer to a preallocated block of size
+                    sizeof(dll_slab_t)
+   ll             : pointer to an initialized dll_t struct
+   elt_size       : non-zero size of an element or a pointer to an element,
+                    as in dll_prepend_new
+   max_num_blocks : > 0 maximum number of node blocks in a slab
+*/
+void dll_slab_init(dll_slab_t *slab,
+		   const dll_t *ll,
+		   size_t elt_size,
+		   size_t max_num_blocks);
+
+/**
+   Creates a node from a slab allocator and prepends or appends the node
+   relative to a head pointer. Please see the parameter specification in
+   dll_prepend_new. The slab parameter points to a slab allocator
+   initialized with ll and elt_size.
+*/
+
+void dll_prepend_new_slab(const dll_t *ll,
+			  dll_slab_t *slab,
+			  dll_node_t **head,
+			  const void *key,
+			  const void *elt,
+			  size_t key_size,
+			  size_t elt_size);
+
+void dll_append_new_slab(const dll_t *ll,
+			 dll_slab_t *slab,
+			 dll_node_t **head,
+			 const void *key,
+			 const void *elt,
+			 size_t key_size,
+			 size_t elt_size);
+
+/**
+   Deletes a node created from a slab allocator and returns its node block
+   to the slab allocator for reuse. Please see the parameter specification
+   in dll_delete. A node can be deleted with any slab allocator initialized
+   with ll and the elt_size value of the allocator of the node, if the
+   allocators are released together.
+*/
+void dll_delete_slab(const dll_t *ll,
+		     dll_slab_t *slab,
+		     dll_node_t **head,
+		     dll_node_t *node,
+		     void (*free_elt)(void *));
+
+/**
+   Frees a doubly linked list with nodes created from a slab allocator by
+   returning the node blocks to the slab allocator for reuse. Please see
+   the parameter specification in dll_delete_slab.
+*/
+void dll_free_slab(const dll_t *ll,
+		   dll_slab_t *slab,
+		   dll_node_t **head,
+		   void (*free_elt)(void *));
+
+/**
+   Releases all slabs of a slab allocator in bulk, including the node
+   blocks of the lists that were not freed, without visiting the nodes,
+   and leaves a block of size sizeof(dll_slab_t) pointed to by the slab
+   parameter. If the elements of the nodes in the lists require free_elt,
+   dll_free_slab is called on the lists before the slabs are released.
+*/
+void dll_slab_free(dll_slab_t *slab);
+
 #endif
@@ -16,6 +16,7 @@
       [0, 1] : on/off update search division hash table test
       [0, 1] : on/off push pop free multiplication hash table test
       [0, 1] : on/off update search multiplication hash table test
+      [0, 1] : on/off runs of the above tests without hash tokens
 
    usage examples:
    ./heap-test
@@ -26,6 +27,7 @@
    ./heap-test 20 1 0 10 10 0 0
    ./heap-test 20 1 0 1 0 0 0
    ./heap-test 20 1 0 100 0 0 0
+   ./heap-test 14 1 0 341 10 1 1 1 1 0
 
    heap-test can be run with any subset of command line arguments in the
    above-defined order. If the (i + 1)th argument is specified then the ith
@@ -45,6 +47,7 @@
 #include "heap.h"
 #include "ht-divchn.h"
 #include "ht-muloa.h"
+#include "ht-mulgrp.h"
 #include "utilities-mem.h"
 #include "utilities-mod.h"
 
@@ -61,9 +64,10 @@ const char *C_USAGE =
   "[0, 1] : on/off push pop free division hash table test\n"
   "[0, 1] : on/off update search division hash table test\n"
   "[0, 1] : on/off push pop free multiplication hash table test\n"
-  "[0, 1] : on/off update search multiplication hash table test\n";
-const int C_ARGC_MAX = 10;
-const size_t C_ARGS_DEF[9] = {14, 1, 0, 341, 10, 1, 1, 1, 1};
+  "[0, 1] : on/off update search multiplication hash table test\n"
+  "[0, 1] : on/off runs of the above tests without hash tokens\n";
+const int C_ARGC_MAX = 11;
+const size_t C_ARGS_DEF[10] = {14, 1, 0, 341, 10, 1, 1, 1, 1, 1};
 const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 
 /* tests */
@@ -86,23 +90,29 @@ int (*const C_CMP_PTY_ARR[3])(const void *, const void *) ={cmp_uint,
 void (*const C_NEW_PTY_ARR[3])(void *, size_t) = {new_uint,
 						  new_double,
 						  new_long_double};
-const size_t C_H_INIT_COUNT = 1;
+const size_t C_H_MIN_NUM = 0;
 
 void push_pop_free(size_t num_ins,
 		   size_t pty_size,
 		   size_t elt_size,
+		   size_t alpha_n,
+		   size_t log_alpha_d,
 		   const heap_ht_t *hht,
 		   int (*cmp_pty)(const void *, const void *),
 		   int (*cmp_elt)(const void *, const void *),
+		   size_t (*rdc_elt)(const void *, size_t),
 		   void (*new_pty)(void *, size_t),
 		   void (*new_elt)(void *, size_t),
 		   void (*free_elt)(void *));
 void update_search(size_t num_ins,
 		   size_t pty_size,
 		   size_t elt_size,
+		   size_t alpha_n,
+		   size_t log_alpha_d,
 		   const heap_ht_t *hht,
 		   int (*cmp_pty)(const void *, const void *),
 		   int (*cmp_elt)(const void *, const void *),
+		   size_t (*rdc_elt)(const void *, size_t),
 		   void (*new_pty)(void *, size_t),
 		   void (*new_elt)(void *, size_t),
 		   void (*free_elt)(void *));
@@ -162,46 +172,57 @@ void new_long_double(void *a, size_t val){
   *s = val;
 }
 
-typedef struct{
-  size_t alpha_n;
-  size_t log_alpha_d;
-} ht_divchn_context_t;
+/**
+   Set the parameters of a hash table for a heap. If is_inline is non-zero,
+   a ht_muloa_t hash table is initialized in the inline mode of storage. If
+   is_tok is zero, hash_key is NULL and the heap performs the hash table
+   operations without hash tokens. ht_mulgrp_t does not provide the
+   operations with hash tokens and is always used without them.
+*/
 
-typedef struct{
-  size_t alpha_n;
-  size_t log_alpha_d;
-  size_t (*rdc_key)(const void *, size_t);
-} ht_muloa_context_t;
-
-void ht_divchn_uint_init_helper(ht_divchn_t *ht,
-			   size_t key_size,
-			   size_t elt_size,
-			   void (*free_elt)(void *),
-			   void *context){
-  ht_divchn_context_t *c = context;
-  ht_divchn_init(ht,
-		 key_size,
-		 elt_size,
-		 0,
-		 c->alpha_n,
-		 c->log_alpha_d,
-		 free_elt);
-}
-
-void ht_muloa_init_helper(ht_muloa_t *ht,
-			  size_t key_size,
-			  size_t elt_size,
-			  void (*free_elt)(void *),
-			  void *context){
-  ht_muloa_context_t * c = context;
-  ht_muloa_init(ht,
-		key_size,
-		elt_size,
-		0,
-		c->alpha_n,
-		c->log_alpha_d,
-		c->rdc_key,
-		free_elt);
+void set_divchn_hht(heap_ht_t *hht, ht_divchn_t *ht, int is_tok){
+  hht->ht = ht;
+  hht->init = ht_divchn_init_helper;
+  hht->align = ht_divchn_align_helper;
+  hht->insert = ht_divchn_insert_helper;
+  hht->search = ht_divchn_search_helper;
+  hht->remove = ht_divchnn_remove_helper;
+  hht->free = ht_divchn_free_helper;
+  hht->hash_key = is_tok ? ht_divchn_hash_key_helper : NULL;
+  hht->insert_hashed = ht_divchn_insert_hashed_helper;
+  hht->search_hashed = ht_divchn_search_hashed_helper;
+  hht->remove_hashed = ht_divchn_remove_hashed_helper;
+}
+
+void set_muloa_hht(heap_ht_t *hht,
+		   ht_muloa_t *ht,
+		   int is_inline,
+		   int is_tok){
+  hht->ht = ht;
+  hht->init = is_inline ? ht_muloa_init_inline_helper : ht_muloa_init_helper;
+  hht->align = ht_muloa_align_helper;
+  hht->insert = ht_muloa_insert_helper;
+  hht->search = ht_muloa_search_helper;
+  hht->remove = ht_muloa_remove_helper;
+  hht->free = ht_muloa_free_helper;
+  hht->hash_key = is_tok ? ht_muloa_hash_key_helper : NULL;
+  hht->insert_hashed = ht_muloa_insert_hashed_helper;
+  hht->search_hashed = ht_muloa_search_hashed_helper;
+  hht->remove_hashed = ht_muloa_remove_hashed_helper;
+}
+
+void set_mulgrp_hht(heap_ht_t *hht, ht_mulgrp_t *ht){
+  hht->ht = ht;
+  hht->init = ht_mulgrp_init_helper;
+  hht->align = ht_mulgrp_align_helper;
+  hht->insert = ht_mulgrp_insert_helper;
+  hht->search = ht_mulgrp_search_helper;
+  hht->remove = ht_mulgrp_remove_helper;
+  hht->free = ht_mulgrp_free_helper;
+  hht->hash_key = NULL;
+  hht->insert_hashed = NULL;
+  hht->search_hashed = NULL;
+  hht->remove_hashed = NULL;
 }
 
 /**
@@ -210,24 +231,17 @@ void ht_muloa_init_helper(ht_muloa_t *ht,
 */
 void run_push_pop_free_divchn_uint_test(size_t log_ins,
 					size_t alpha_n,
-					size_t log_alpha_d){
+					size_t log_alpha_d,
+					int is_tok){
   int i;
   size_t n;
   ht_divchn_t ht_divchn;
-  ht_divchn_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  hht.ht = &ht_divchn;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_divchn_init_helper;
-  hht.insert = (heap_ht_insert)ht_divchn_insert;
-  hht.search = (heap_ht_search)ht_divchn_search;
-  hht.remove = (heap_ht_remove)ht_divchn_remove;
-  hht.free = (heap_ht_free)ht_divchn_free;
+  set_divchn_hht(&hht, &ht_divchn, is_tok);
   printf("Run a heap_{push, pop, free} test with a ht_divchn_t "
-	 "hash table on size_t elements\n");
+	 "hash table on size_t elements%s\n",
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -237,9 +251,12 @@ void run_push_pop_free_divchn_uint_test(size_t log_ins,
     push_pop_free(n,
 		  C_PTY_SIZES[i],
 		  sizeof(size_t),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint,
+		  NULL,
 		  C_NEW_PTY_ARR[i],
 		  new_uint,
 		  NULL);
@@ -252,24 +269,17 @@ void run_push_pop_free_divchn_uint_test(size_t log_ins,
 */
 void run_update_search_divchn_uint_test(size_t log_ins,
 					size_t alpha_n,
-					size_t log_alpha_d){
+					size_t log_alpha_d,
+					int is_tok){
   int i;
   size_t n;
   ht_divchn_t ht_divchn;
-  ht_divchn_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  hht.ht = &ht_divchn;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_divchn_init_helper;
-  hht.insert = (heap_ht_insert)ht_divchn_insert;
-  hht.search = (heap_ht_search)ht_divchn_search;
-  hht.remove = (heap_ht_remove)ht_divchn_remove;
-  hht.free = (heap_ht_free)ht_divchn_free;
+  set_divchn_hht(&hht, &ht_divchn, is_tok);
   printf("Run a heap_{update, search} test with a ht_divchn_t "
-	 "hash table on size_t elements\n");
+	 "hash table on size_t elements%s\n",
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -279,9 +289,12 @@ void run_update_search_divchn_uint_test(size_t log_ins,
     update_search(n,
 		  C_PTY_SIZES[i],
 		  sizeof(size_t),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint,
+		  NULL,
 		  C_NEW_PTY_ARR[i],
 		  new_uint,
 		  NULL);
@@ -294,25 +307,19 @@ void run_update_search_divchn_uint_test(size_t log_ins,
 */
 void run_push_pop_free_muloa_uint_test(size_t log_ins,
 				       size_t alpha_n,
-				       size_t log_alpha_d){
+				       size_t log_alpha_d,
+				       int is_inline,
+				       int is_tok){
   int i;
   size_t n;
   ht_muloa_t ht_muloa;
-  ht_muloa_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  context.rdc_key = NULL;
-  hht.ht = &ht_muloa;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_muloa_init_helper;
-  hht.insert = (heap_ht_insert)ht_muloa_insert;
-  hht.search = (heap_ht_search)ht_muloa_search;
-  hht.remove = (heap_ht_remove)ht_muloa_remove;
-  hht.free = (heap_ht_free)ht_muloa_free;
+  set_muloa_hht(&hht, &ht_muloa, is_inline, is_tok);
   printf("Run a heap_{push, pop, free} test with a ht_muloa_t "
-	 "hash table on size_t elements\n");
+	 "hash table on size_t elements%s%s\n",
+	 (is_inline ? ", in the inline mode" : ""),
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -323,9 +330,12 @@ void run_push_pop_free_muloa_uint_test(size_t log_ins,
     push_pop_free(n,
 		  C_PTY_SIZES[i],
 		  sizeof(size_t),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint,
+		  NULL,
 		  C_NEW_PTY_ARR[i],
 		  new_uint,
 		  NULL);
@@ -338,25 +348,19 @@ void run_push_pop_free_muloa_uint_test(size_t log_ins,
 */
 void run_update_search_muloa_uint_test(size_t log_ins,
 				       size_t alpha_n,
-				       size_t log_alpha_d){
+				       size_t log_alpha_d,
+				       int is_inline,
+				       int is_tok){
   int i;
   size_t n;
   ht_muloa_t ht_muloa;
-  ht_muloa_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  context.rdc_key = NULL;
-  hht.ht = &ht_muloa;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_muloa_init_helper;
-  hht.insert = (heap_ht_insert)ht_muloa_insert;
-  hht.search = (heap_ht_search)ht_muloa_search;
-  hht.remove = (heap_ht_remove)ht_muloa_remove;
-  hht.free = (heap_ht_free)ht_muloa_free;
+  set_muloa_hht(&hht, &ht_muloa, is_inline, is_tok);
   printf("Run a heap_{update, search} test with a ht_muloa_t "
-	 "hash table on size_t elements\n");
+	 "hash table on size_t elements%s%s\n",
+	 (is_inline ? ", in the inline mode" : ""),
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -367,9 +371,84 @@ void run_update_search_muloa_uint_test(size_t log_ins,
     update_search(n,
 		  C_PTY_SIZES[i],
 		  sizeof(size_t),
+		  alpha_n,
+		  log_alpha_d,
+		  &hht,
+		  C_CMP_PTY_ARR[i],
+		  cmp_uint,
+		  NULL,
+		  C_NEW_PTY_ARR[i],
+		  new_uint,
+		  NULL);
+  }
+}
+
+/**
+   Runs a heap_{push, pop, free} test with a ht_mulgrp_t hash table on
+   size_t elements across priority types.
+*/
+void run_push_pop_free_mulgrp_uint_test(size_t log_ins,
+					size_t alpha_n,
+					size_t log_alpha_d){
+  int i;
+  size_t n;
+  ht_mulgrp_t ht_mulgrp;
+  heap_ht_t hht;
+  n = pow_two_perror(log_ins);
+  set_mulgrp_hht(&hht, &ht_mulgrp);
+  printf("Run a heap_{push, pop, free} test with a ht_mulgrp_t "
+	 "hash table on size_t elements\n");
+  for (i = 0; i < C_PTY_TYPES_COUNT; i++){
+    printf("\tnumber of elements:      %lu\n"
+	   "\tload factor upper bound: %.4f\n"
+	   "\tpriority type:           %s\n",
+	   TOLU(n),
+	   (float)alpha_n / pow_two_perror(log_alpha_d), C_PTY_TYPES[i]);
+    push_pop_free(n,
+		  C_PTY_SIZES[i],
+		  sizeof(size_t),
+		  alpha_n,
+		  log_alpha_d,
+		  &hht,
+		  C_CMP_PTY_ARR[i],
+		  cmp_uint,
+		  NULL,
+		  C_NEW_PTY_ARR[i],
+		  new_uint,
+		  NULL);
+  }
+}
+
+/**
+   Runs a heap_{update, search} test with a ht_mulgrp_t hash table on
+   size_t elements across priority types.
+*/
+void run_update_search_mulgrp_uint_test(size_t log_ins,
+					size_t alpha_n,
+					size_t log_alpha_d){
+  int i;
+  size_t n;
+  ht_mulgrp_t ht_mulgrp;
+  heap_ht_t hht;
+  n = pow_two_perror(log_ins);
+  set_mulgrp_hht(&hht, &ht_mulgrp);
+  printf("Run a heap_{update, search} test with a ht_mulgrp_t "
+	 "hash table on size_t elements\n");
+  for (i = 0; i < C_PTY_TYPES_COUNT; i++){
+    printf("\tnumber of elements:      %lu\n"
+	   "\tload factor upper bound: %.4f\n"
+	   "\tpriority type:           %s\n",
+	   TOLU(n),
+	   (float)alpha_n / pow_two_perror(log_alpha_d), C_PTY_TYPES[i]);
+    update_search(n,
+		  C_PTY_SIZES[i],
+		  sizeof(size_t),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint,
+		  NULL,
 		  C_NEW_PTY_ARR[i],
 		  new_uint,
 		  NULL);
@@ -406,6 +485,11 @@ void new_uint_ptr(void *a, size_t val){
   s = NULL;
 }
 
+size_t rdc_uint_ptr(const void *a, size_t size){
+  (void)size;
+  return *((*(uint_ptr_t **)a)->val);
+}
+
 void free_uint_ptr(void *a){
   uint_ptr_t **s = a;
   free((*s)->val);
@@ -421,24 +505,17 @@ void free_uint_ptr(void *a){
 */
 void run_push_pop_free_divchn_uint_ptr_test(size_t log_ins,
 					    size_t alpha_n,
-					    size_t log_alpha_d){
+					    size_t log_alpha_d,
+					    int is_tok){
   int i;
   size_t n;
   ht_divchn_t ht_divchn;
-  ht_divchn_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  hht.ht = &ht_divchn;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_divchn_init_helper;
-  hht.insert = (heap_ht_insert)ht_divchn_insert;
-  hht.search = (heap_ht_search)ht_divchn_search;
-  hht.remove = (heap_ht_remove)ht_divchn_remove;
-  hht.free = (heap_ht_free)ht_divchn_free;
+  set_divchn_hht(&hht, &ht_divchn, is_tok);
   printf("Run a heap_{push, pop, free} test with a ht_divchn_t "
-	 "hash table on noncontiguous uint_ptr_t elements\n");
+	 "hash table on noncontiguous uint_ptr_t elements%s\n",
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -448,9 +525,12 @@ void run_push_pop_free_divchn_uint_ptr_test(size_t log_ins,
     push_pop_free(n,
 		  C_PTY_SIZES[i],
 		  sizeof(uint_ptr_t *),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint_ptr,
+		  rdc_uint_ptr,
 		  C_NEW_PTY_ARR[i],
 		  new_uint_ptr,
 		  free_uint_ptr);
@@ -463,24 +543,17 @@ void run_push_pop_free_divchn_uint_ptr_test(size_t log_ins,
 */
 void run_update_search_divchn_uint_ptr_test(size_t log_ins,
 					    size_t alpha_n,
-					    size_t log_alpha_d){
+					    size_t log_alpha_d,
+					    int is_tok){
   int i;
   size_t n;
   ht_divchn_t ht_divchn;
-  ht_divchn_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  hht.ht = &ht_divchn;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_divchn_init_helper;
-  hht.insert = (heap_ht_insert)ht_divchn_insert;
-  hht.search = (heap_ht_search)ht_divchn_search;
-  hht.remove = (heap_ht_remove)ht_divchn_remove;
-  hht.free = (heap_ht_free)ht_divchn_free;
+  set_divchn_hht(&hht, &ht_divchn, is_tok);
   printf("Run a heap_{update, search} test with a ht_divchn_t "
-	 "hash table on noncontiguous uint_ptr_t elements\n");
+	 "hash table on noncontiguous uint_ptr_t elements%s\n",
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -490,9 +563,12 @@ void run_update_search_divchn_uint_ptr_test(size_t log_ins,
     update_search(n,
 		  C_PTY_SIZES[i],
 		  sizeof(uint_ptr_t *),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint_ptr,
+		  rdc_uint_ptr,
 		  C_NEW_PTY_ARR[i],
 		  new_uint_ptr,
 		  free_uint_ptr);
@@ -505,25 +581,19 @@ void run_update_search_divchn_uint_ptr_test(size_t log_ins,
 */
 void run_push_pop_free_muloa_uint_ptr_test(size_t log_ins,
 					   size_t alpha_n,
-					   size_t log_alpha_d){
+					   size_t log_alpha_d,
+					   int is_inline,
+					   int is_tok){
   int i;
   size_t n;
   ht_muloa_t ht_muloa;
-  ht_muloa_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  context.rdc_key = NULL;
-  hht.ht = &ht_muloa;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_muloa_init_helper;
-  hht.insert = (heap_ht_insert)ht_muloa_insert;
-  hht.search = (heap_ht_search)ht_muloa_search;
-  hht.remove = (heap_ht_remove)ht_muloa_remove;
-  hht.free = (heap_ht_free)ht_muloa_free;
+  set_muloa_hht(&hht, &ht_muloa, is_inline, is_tok);
   printf("Run a heap_{push, pop, free} test with a ht_muloa_t "
-	 "hash table on noncontiguous uint_ptr_t elements\n");
+	 "hash table on noncontiguous uint_ptr_t elements%s%s\n",
+	 (is_inline ? ", in the inline mode" : ""),
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -534,9 +604,12 @@ void run_push_pop_free_muloa_uint_ptr_test(size_t log_ins,
     push_pop_free(n,
 		  C_PTY_SIZES[i],
 		  sizeof(uint_ptr_t *),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint_ptr,
+		  rdc_uint_ptr,
 		  C_NEW_PTY_ARR[i],
 		  new_uint_ptr,
 		  free_uint_ptr);
@@ -549,24 +622,19 @@ void run_push_pop_free_muloa_uint_ptr_test(size_t log_ins,
 */
 void run_update_search_muloa_uint_ptr_test(size_t log_ins,
 					   size_t alpha_n,
-					   size_t log_alpha_d){
+					   size_t log_alpha_d,
+					   int is_inline,
+					   int is_tok){
   int i;
   size_t n;
   ht_muloa_t ht_muloa;
-  ht_muloa_context_t context;
   heap_ht_t hht;
   n = pow_two_perror(log_ins);
-  context.alpha_n = alpha_n;
-  context.log_alpha_d = log_alpha_d;
-  hht.ht = &ht_muloa;
-  hht.context = &context;
-  hht.init = (heap_ht_init)ht_muloa_init_helper;
-  hht.insert = (heap_ht_insert)ht_muloa_insert;
-  hht.search = (heap_ht_search)ht_muloa_search;
-  hht.remove = (heap_ht_remove)ht_muloa_remove;
-  hht.free = (heap_ht_free)ht_muloa_free;
+  set_muloa_hht(&hht, &ht_muloa, is_inline, is_tok);
   printf("Run a heap_{update, search} test with a ht_muloa_t "
-	 "hash table on noncontiguous uint_ptr_t elements\n");
+	 "hash table on noncontiguous uint_ptr_t elements%s%s\n",
+	 (is_inline ? ", in the inline mode" : ""),
+	 (is_tok ? ", with hash tokens" : ""));
   for (i = 0; i < C_PTY_TYPES_COUNT; i++){
     printf("\tnumber of elements:      %lu\n"
 	   "\tload factor upper bound: %.4f\n"
@@ -577,9 +645,84 @@ void run_update_search_muloa_uint_ptr_test(size_t log_ins,
     update_search(n,
 		  C_PTY_SIZES[i],
 		  sizeof(uint_ptr_t *),
+		  alpha_n,
+		  log_alpha_d,
 		  &hht,
 		  C_CMP_PTY_ARR[i],
 		  cmp_uint_ptr,
+		  rdc_uint_ptr,
+		  C_NEW_PTY_ARR[i],
+		  new_uint_ptr,
+		  free_uint_ptr);
+  }
+}
+
+/**
+   Runs a heap_{push, pop, free} test with a ht_mulgrp_t hash table on
+   noncontiguous uint_ptr_t elements across priority types.
+*/
+void run_push_pop_free_mulgrp_uint_ptr_test(size_t log_ins,
+					    size_t alpha_n,
+					    size_t log_alpha_d){
+  int i;
+  size_t n;
+  ht_mulgrp_t ht_mulgrp;
+  heap_ht_t hht;
+  n = pow_two_perror(log_ins);
+  set_mulgrp_hht(&hht, &ht_mulgrp);
+  printf("Run a heap_{push, pop, free} test with a ht_mulgrp_t "
+	 "hash table on noncontiguous uint_ptr_t elements\n");
+  for (i = 0; i < C_PTY_TYPES_COUNT; i++){
+    printf("\tnumber of elements:      %lu\n"
+	   "\tload factor upper bound: %.4f\n"
+	   "\tpriority type:           %s\n",
+	   TOLU(n),
+	   (float)alpha_n / pow_two_perror(log_alpha_d), C_PTY_TYPES[i]);
+    push_pop_free(n,
+		  C_PTY_SIZES[i],
+		  sizeof(uint_ptr_t *),
+		  alpha_n,
+		  log_alpha_d,
+		  &hht,
+		  C_CMP_PTY_ARR[i],
+		  cmp_uint_ptr,
+		  rdc_uint_ptr,
+		  C_NEW_PTY_ARR[i],
+		  new_uint_ptr,
+		  free_uint_ptr);
+  }
+}
+
+/**
+   Runs a heap_{update, search} test with a ht_mulgrp_t hash table on
+   noncontiguous uint_ptr_t elements across priority types.
+*/
+void run_update_search_mulgrp_uint_ptr_test(size_t log_ins,
+					    size_t alpha_n,
+					    size_t log_alpha_d){
+  int i;
+  size_t n;
+  ht_mulgrp_t ht_mulgrp;
+  heap_ht_t hht;
+  n = pow_two_perror(log_ins);
+  set_mulgrp_hht(&hht, &ht_mulgrp);
+  printf("Run a heap_{update, search} test with a ht_mulgrp_t "
+	 "hash table on noncontiguous uint_ptr_t elements\n");
+  for (i = 0; i < C_PTY_TYPES_COUNT; i++){
+    printf("\tnumber of elements:      %lu\n"
+	   "\tload factor upper bound: %.4f\n"
+	   "\tpriority type:           %s\n",
+	   TOLU(n),
+	   (float)alpha_n / pow_two_perror(log_alpha_d), C_PTY_TYPES[i]);
+    update_search(n,
+		  C_PTY_SIZES[i],
+		  sizeof(uint_ptr_t *),
+		  alpha_n,
+		  log_alpha_d,
+		  &hht,
+		  C_CMP_PTY_ARR[i],
+		  cmp_uint_ptr,
+		  rdc_uint_ptr,
 		  C_NEW_PTY_ARR[i],
 		  new_uint_ptr,
 		  free_uint_ptr);
@@ -587,29 +730,32 @@ void run_update_search_muloa_uint_ptr_test(size_t log_ins,
 }
 
 /** 
-   Helper functions for heap_{push, pop, free} tests.
+   Helper functions for heap_{push, pop, free} tests. The arrays of
+   priorities and elements in tests are arrays of pairs of size
+   pty_size + elt_size.
 */
 
 void push_ptys_elts(heap_t *h,
 		    const void *pty_elts,
 		    size_t count,
                     int *res){
+  size_t pair_size = h->pty_size + h->elt_size;
   const char *p = NULL, *p_start = NULL, *p_end = NULL;
   size_t half_count;
   size_t n = h->num_elts;
   clock_t t_first, t_second;
   half_count = count >> 1;  /* count > 0 */
   p_start = pty_elts;
-  p_end = ptr(pty_elts, half_count, h->pair_size);
+  p_end = ptr(pty_elts, half_count, pair_size);
   t_first = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     heap_push(h, p, p + h->pty_size);
   }
   t_first = clock() - t_first;
-  p_start = ptr(pty_elts, half_count, h->pair_size);
-  p_end = ptr(pty_elts, count, h->pair_size);
+  p_start = ptr(pty_elts, half_count, pair_size);
+  p_end = ptr(pty_elts, count, pair_size);
   t_second = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     heap_push(h, p, p + h->pty_size);
   }
   t_second = clock() - t_second;
@@ -624,23 +770,24 @@ void push_rev_ptys_elts(heap_t *h,
 			const void *pty_elts,
 			size_t count,
                         int *res){
+  size_t pair_size = h->pty_size + h->elt_size;
   const char *p = NULL, *p_start = NULL, *p_end = NULL;
   size_t half_count;
   size_t n = h->num_elts;
   clock_t t_first, t_second;
   half_count = count >> 1;
   /* backwards pointer iteration; count > 0 */
-  p_start = ptr(pty_elts, count - 1, h->pair_size);
-  p_end = ptr(pty_elts, half_count, h->pair_size);
+  p_start = ptr(pty_elts, count - 1, pair_size);
+  p_end = ptr(pty_elts, half_count, pair_size);
   t_first = clock();
-  for (p = p_start; p != p_end; p -= h->pair_size){
+  for (p = p_start; p != p_end; p -= pair_size){
     heap_push(h, p, p + h->pty_size);
   }
   t_first = clock() - t_first;
-  p_start = ptr(pty_elts, half_count, h->pair_size);
+  p_start = ptr(pty_elts, half_count, pair_size);
   p_end = pty_elts;
   t_second = clock();
-  for (p = p_start; p >= p_end; p -= h->pair_size){
+  for (p = p_start; p >= p_end; p -= pair_size){
     heap_push(h, p, p + h->pty_size);
   }
   t_second = clock() - t_second;
@@ -657,24 +804,25 @@ void pop_ptys_elts(heap_t *h,
 		   int (*cmp_pty)(const void *, const void *),
 		   int (*cmp_elt)(const void *, const void *),
                    int *res){
+  size_t pair_size = h->pty_size + h->elt_size;
   char *p = NULL, *p_start = NULL, *p_end = NULL;
   size_t i, half_count;
   size_t n = h->num_elts;
   void *pop_pty_elts = NULL;
   clock_t t_first, t_second;
   half_count = count >> 1; /* count > 0 */
-  pop_pty_elts = malloc_perror(count, h->pair_size);
+  pop_pty_elts = malloc_perror(count, pair_size);
   p_start = pop_pty_elts;
-  p_end = ptr(pop_pty_elts, half_count, h->pair_size);
+  p_end = ptr(pop_pty_elts, half_count, pair_size);
   t_first = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     heap_pop(h, p, p + h->pty_size);
   }
   t_first = clock() - t_first;
-  p_start = ptr(pop_pty_elts, half_count, h->pair_size);
-  p_end = ptr(pop_pty_elts, count, h->pair_size);
+  p_start = ptr(pop_pty_elts, half_count, pair_size);
+  p_end = ptr(pop_pty_elts, count, pair_size);
   t_second = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     heap_pop(h, p, p + h->pty_size);
   }
   t_second = clock() - t_second;
@@ -682,15 +830,15 @@ void pop_ptys_elts(heap_t *h,
   for (i = 0; i < count; i++){
     if (i == 0){
       *res *=
-	(cmp_elt((char *)ptr(pop_pty_elts, i, h->pair_size) + h->pty_size,
-		 (char *)ptr(pty_elts, i, h->pair_size) + h->pty_size) == 0);
+	(cmp_elt((char *)ptr(pop_pty_elts, i, pair_size) + h->pty_size,
+		 (char *)ptr(pty_elts, i, pair_size) + h->pty_size) == 0);
     }else{
       *res *=
-	(cmp_pty(ptr(pop_pty_elts, i, h->pair_size),
-		 ptr(pop_pty_elts, i - 1, h->pair_size)) >= 0);
+	(cmp_pty(ptr(pop_pty_elts, i, pair_size),
+		 ptr(pop_pty_elts, i - 1, pair_size)) >= 0);
       *res *=
-	(cmp_elt((char *)ptr(pop_pty_elts, i, h->pair_size) + h->pty_size,
-		 (char *)ptr(pty_elts, i, h->pair_size) + h->pty_size) == 0);
+	(cmp_elt((char *)ptr(pop_pty_elts, i, pair_size) + h->pty_size,
+		 (char *)ptr(pty_elts, i, pair_size) + h->pty_size) == 0);
     }
   }
   printf("\t\tpop 1/2 elements:                            "
@@ -718,22 +866,23 @@ void update_ptys_elts(heap_t *h,
 		      const void *pty_elts,
 		      size_t count,
                       int *res){
+  size_t pair_size = h->pty_size + h->elt_size;
   const char *p = NULL, *p_start = NULL, *p_end = NULL;
   size_t half_count = count >> 1;
   size_t n = h->num_elts;
   clock_t t_first, t_second;
   p_start = pty_elts;
-  p_end = ptr(pty_elts, half_count, h->pair_size);
+  p_end = ptr(pty_elts, half_count, pair_size);
   t_first = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     heap_update(h, p, p + h->pty_size);
   }
   t_first = clock() - t_first;
   *res *= (h->num_elts == n);
-  p_start = ptr(pty_elts, half_count, h->pair_size);
-  p_end = ptr(pty_elts, count, h->pair_size);
+  p_start = ptr(pty_elts, half_count, pair_size);
+  p_end = ptr(pty_elts, count, pair_size);
   t_second = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     heap_update(h, p, p + h->pty_size);
   }
   t_second = clock() - t_second;
@@ -749,18 +898,19 @@ void search_ptys_elts(const heap_t *h,
 		      const void *not_heap_elts,
 		      size_t count,
                       int *res){
+  size_t pair_size = h->pty_size + h->elt_size;
   const char *p = NULL, *p_start = NULL, *p_end = NULL;
   size_t n = h->num_elts;
   void *rp = NULL;
   clock_t t_heap, t_not_heap;
   p_start = pty_elts;
-  p_end = ptr(pty_elts, count, h->pair_size);
+  p_end = ptr(pty_elts, count, pair_size);
   t_heap = clock();
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     rp = heap_search(h, p + h->pty_size);
   }
   t_heap = clock() - t_heap;
-  for (p = p_start; p != p_end; p += h->pair_size){
+  for (p = p_start; p != p_end; p += pair_size){
     rp = heap_search(h, p + h->pty_size);
     *res *= (rp != NULL);
   }
@@ -790,9 +940,12 @@ void search_ptys_elts(const heap_t *h,
 void push_pop_free(size_t num_ins,
 		   size_t pty_size,
 		   size_t elt_size,
+		   size_t alpha_n,
+		   size_t log_alpha_d,
 		   const heap_ht_t *hht,
 		   int (*cmp_pty)(const void *, const void *),
 		   int (*cmp_elt)(const void *, const void *),
+		   size_t (*rdc_elt)(const void *, size_t),
 		   void (*new_pty)(void *, size_t),
 		   void (*new_elt)(void *, size_t),
 		   void (*free_elt)(void *)){
@@ -807,7 +960,17 @@ void push_pop_free(size_t num_ins,
     new_pty(ptr(pty_elts, i, pair_size), i); /* no decrease with i */
     new_elt((char *)ptr(pty_elts, i, pair_size) + pty_size, i);
   }
-  heap_init(&h, C_H_INIT_COUNT, pty_size, elt_size, hht, cmp_pty, free_elt);
+  heap_init(&h,
+	    pty_size,
+	    elt_size,
+	    C_H_MIN_NUM,
+	    alpha_n,
+	    log_alpha_d,
+	    hht,
+	    cmp_pty,
+	    cmp_elt,
+	    rdc_elt,
+	    free_elt);
   push_ptys_elts(&h, pty_elts, num_ins, &res);
   pop_ptys_elts(&h, pty_elts, num_ins, cmp_pty, cmp_elt, &res);
   push_rev_ptys_elts(&h, pty_elts, num_ins, &res);
@@ -823,9 +986,12 @@ void push_pop_free(size_t num_ins,
 void update_search(size_t num_ins,
 		   size_t pty_size,
 		   size_t elt_size,
+		   size_t alpha_n,
+		   size_t log_alpha_d,
 		   const heap_ht_t *hht,
 		   int (*cmp_pty)(const void *, const void *),
 		   int (*cmp_elt)(const void *, const void *),
+		   size_t (*rdc_elt)(const void *, size_t),
 		   void (*new_pty)(void *, size_t),
 		   void (*new_elt)(void *, size_t),
 		   void (*free_elt)(void *)){
@@ -849,7 +1015,17 @@ void update_search(size_t num_ins,
 	   (char *)ptr(pty_elts, num_ins - 1 - i, pair_size) + pty_size,
 	   elt_size);
   }
-  heap_init(&h, C_H_INIT_COUNT, pty_size, elt_size, hht, cmp_pty, free_elt);
+  heap_init(&h,
+	    pty_size,
+	    elt_size,
+	    C_H_MIN_NUM,
+	    alpha_n,
+	    log_alpha_d,
+	    hht,
+	    cmp_pty,
+	    cmp_elt,
+	    rdc_elt,
+	    free_elt);
   push_ptys_elts(&h, pty_rev_elts, num_ins, &res);
   update_ptys_elts(&h, pty_elts, num_ins, &res);
   search_ptys_elts(&h, pty_elts, not_heap_elts, num_ins, &res);
@@ -890,7 +1066,7 @@ void print_test_result(int res){
 }
 
 int main(int argc, char *argv[]){
-  int i;
+  int i, is_tok;
   size_t *args = NULL;
   if (argc > C_ARGC_MAX){
     fprintf(stderr, "USAGE:\n%s", C_USAGE);
@@ -910,25 +1086,63 @@ int main(int argc, char *argv[]){
       args[5] > 1 ||
       args[6] > 1 ||
       args[7] > 1 ||
-      args[8] > 1){
+      args[8] > 1 ||
+      args[9] > 1){
     fprintf(stderr, "USAGE:\n%s", C_USAGE);
     exit(EXIT_FAILURE);
   }
-  if (args[5]){
-    run_push_pop_free_divchn_uint_test(args[0], args[1], args[2]);
-    run_push_pop_free_divchn_uint_ptr_test(args[0], args[1], args[2]);
-  }
-  if (args[6]){
-    run_update_search_divchn_uint_test(args[0], args[1], args[2]);
-    run_update_search_divchn_uint_ptr_test(args[0], args[1], args[2]);
+  /* with hash tokens, and optionally with the fallback without them */
+  for (is_tok = 1; is_tok >= !args[9]; is_tok--){
+    if (args[5]){
+      run_push_pop_free_divchn_uint_test(args[0], args[1], args[2], is_tok);
+      run_push_pop_free_divchn_uint_ptr_test(args[0],
+					     args[1],
+					     args[2],
+					     is_tok);
+    }
+    if (args[6]){
+      run_update_search_divchn_uint_test(args[0], args[1], args[2], is_tok);
+      run_update_search_divchn_uint_ptr_test(args[0],
+					     args[1],
+					     args[2],
+					     is_tok);
+    }
+    /* ht_muloa_t in the pointer and inline modes of storage */
+    for (i = 0; i <= 1; i++){
+      if (args[7]){
+	run_push_pop_free_muloa_uint_test(args[0],
+					  args[3],
+					  args[4],
+					  i,
+					  is_tok);
+	run_push_pop_free_muloa_uint_ptr_test(args[0],
+					      args[3],
+					      args[4],
+					      i,
+					      is_tok);
+      }
+      if (args[8]){
+	run_update_search_muloa_uint_test(args[0],
+					  args[3],
+					  args[4],
+					  i,
+					  is_tok);
+	run_update_search_muloa_uint_ptr_test(args[0],
+					      args[3],
+					      args[4],
+					      i,
+					      is_tok);
+      }
+    }
   }
+  /* ht_mulgrp_t without hash tokens */
   if (args[7]){
-    run_push_pop_free_muloa_uint_test(args[0], args[3], args[4]);
-    run_push_pop_free_muloa_uint_ptr_test(args[0], args[3], args[4]);
+    run_push_pop_free_mulgrp_uint_test(args[0], args[3], args[4]);
+    run_push_pop_free_mulgrp_uint_ptr_test(args[0], args[3], args[4]);
   }
   if (args[8]){
-    run_update_search_muloa_uint_test(args[0], args[3], args[4]);
-    run_update_search_muloa_uint_ptr_test(args[0], args[3], args[4]);
+    run_update_search_mulgrp_uint_test(args[0], args[3], args[4]);
+    run_update_search_mulgrp_uint_ptr_test(args[0], args[3], args[4]);
   }
   free(args);
   args = NULL;
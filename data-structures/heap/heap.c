@@ -21,6 +21,16 @@
    associating a given element in memory with more than one priority
    value in a heap.
 
+   The hash key of each element is reduced to a hash token once when the
+   element is pushed, and the token is stored next to the priority and
+   the element. Each hash table operation during heapifying is performed
+   with the stored token, avoiding the reduction and hashing of the
+   element at each of the O(log n) steps of a heap operation. heap_search
+   and heap_update search the hash table with the hash token of the given
+   element. If the hash table parameter does not provide the operations
+   with hash tokens (hash_key is NULL), the operations without hash tokens
+   are performed.
+
    Optimization:
 
    -  the pointer computations in pty_ptr and elt_ptr were optimized out
@@ -34,6 +44,7 @@
 #include <string.h>
 #include "heap.h"
 #include "utilities-mem.h"
+#include "utilities-mod.h"
 
 static void swap(heap_t *h, size_t i, size_t j);
 static void half_swap(heap_t *h, size_t t, size_t s);
@@ -41,17 +52,31 @@ static void heapify_up(heap_t *h, size_t i);
 static void heapify_down(heap_t *h, size_t i);
 static void *pty_ptr(const heap_t *h, size_t i);
 static void *elt_ptr(const heap_t *h, size_t i);
+static size_t *tok_ptr(const heap_t *h, size_t i);
+static void ht_insert(const heap_t *h, size_t i);
+static void ht_remove(const heap_t *h, size_t i);
+static void *ht_search(const heap_t *h, const void *elt);
+static void set_layout(heap_t *h,
+		       size_t pty_alignment,
+		       size_t elt_alignment,
+		       size_t sz_alignment);
+static size_t align_up(size_t n, size_t alignment);
 
 /**
    Initializes a heap.
    h           : pointer to a preallocated block of size sizeof(heap_t)
-   init_count  : > 0
    pty_size    : size of a contiguous priority object
    elt_size    : - size of an element, if the element is within a contiguous
                  memory block and a copy of the element is inserted,
                  - size of a pointer to an element, if the element is within
                  a noncontiguous memory block or a pointer to a contiguous
                  element is inserted
+   min_num     : minimum number of elements that are known or expected to
+                 become present simultaneously in a heap; 0 if a positive
+                 value is not specified
+   alpha_n     : > 0 numerator of load factor upper bound of the hash table
+   log_alpha_d : < CHAR_BIT * sizeof(size_t) log base 2 of denominator of
+                 load factor upper bound of the hash table
    hht         : a non-NULL pointer to a set of parameters specifying a
                  hash table for in-heap search and modifications; a hash
                  key has the size and bit pattern of the block of size
@@ -63,10 +88,16 @@ static void *elt_ptr(const heap_t *h, size_t i);
                  the first argument is greater than the priority value 
                  pointed to by the second, and zero integer value if the two
                  priority values are equal
-   cmp_elt     : 
-   rdc_elt     : both have to work on the same subset of bits in the element,
-                 whether the element is within a contiguous or non-contiguous
-                 memory block
+   cmp_elt     : - if NULL then a default memcmp-based comparison of the
+                 elt_size blocks of elements is performed in the hash table
+                 - otherwise a comparison function as cmp_key in the hash
+                 table
+   rdc_elt     : - if NULL then a default conversion of the elt_size block
+                 of an element is performed prior to hashing
+                 - otherwise a reduction function as rdc_key in the hash
+                 table; cmp_elt and rdc_elt have to work on the same subset
+                 of bits in the element, whether the element is within a
+                 contiguous or non-contiguous memory block
    free_elt    : - if an element is within a contiguous memory block and
                  a copy of the element was inserted, then NULL as free_elt
                  is sufficient to delete the element,
@@ -80,8 +111,8 @@ void heap_init(heap_t *h,
 	       size_t pty_size,
 	       size_t elt_size,
 	       size_t min_num,
-	       size_t alpha_n;
-	       size_t log_alpha_d;
+	       size_t alpha_n,
+	       size_t log_alpha_d,
 	       const heap_ht_t *hht,
 	       int (*cmp_pty)(const void *, const void *),
 	       int (*cmp_elt)(const void *, const void *),
@@ -89,19 +120,12 @@ void heap_init(heap_t *h,
 	       void (*free_elt)(void *)){
   h->pty_size = pty_size;
   h->elt_size = elt_size;
-  /* align priority relative to a malloc's pointer and compute pair_size */
-  if (h->pty_size <= h->elt_size){
-    h->elt_offset = h->elt_size;
-  }else{
-    elt_rem = h->pty_size % h->elt_size;
-    h->elt_offset = add_sz_perror(h->pty_size,
-				  (elt_rem > 0) * (h->elt_size - elt_rem));
-  }
-  pty_rem = add_sz_perror(h->elt_offset, h->elt_size) % h->pty_size;
-  h->pair_size = add_sz_perror(h->elt_offset + h->elt_size,
-			       (pty_rem > 0) * (h->pty_size - pty_rem));
-  h->count = min_num;
+  /* size of a type >= alignment requirement of the type */
+  set_layout(h, pty_size, elt_size, sizeof(size_t));
+  h->count = (min_num > 0) ? min_num : 1;
   h->num_elts = 0;
+  h->alpha_n = alpha_n;
+  h->log_alpha_d = log_alpha_d;
   h->buf = malloc_perror(2, h->pair_size); /* 1st heapify, 2nd swap */
   h->pty_elts = malloc_perror(h->count, h->pair_size);
   h->hht = hht;
@@ -110,10 +134,10 @@ void heap_init(heap_t *h,
   h->rdc_elt = rdc_elt;
   h->free_elt = free_elt;
   /* hash table maps an elt_size block to an index */ 
-  h->hht->init(hht->ht,
+  h->hht->init(h->hht->ht,
 	       elt_size,
 	       sizeof(size_t),
-	       h->count,
+	       min_num,
 	       alpha_n,
 	       log_alpha_d,
 	       h->cmp_elt,
@@ -122,28 +146,23 @@ void heap_init(heap_t *h,
 }
 
 /**
+   Aligns the priority, element, and hash token in each pair, and the
+   elements of the hash table. The operation is optionally called after
+   heap_init is completed and before any other operation is called.
+   h             : pointer to an initialized heap
+   pty_alignment : alignment requirement or size of the priority type
+   elt_alignment : alignment requirement or size of the type, a pointer to
+                   which is used to access an elt_size block
+   sz_alignment  : alignment requirement or size of size_t
 */
 void heap_align(heap_t *h,
 		size_t pty_alignment,
 		size_t elt_alignment,
 		size_t sz_alignment){
-  size_t elt_rem, pty_rem;
-  if (h->elt_size == 0){
-    h->elt_offset = h->pty_size;
-  }else if (h->pty_size <= elt_alignment){
-    h->elt_offset = elt_alignment;
-  }else{
-    elt_rem = h->pty_size % elt_alignment;
-    h->elt_offset = add_sz_perror(h->pty_size,
-				  (elt_rem > 0) * (elt_alignment - elt_rem));
-  }
-  pty_rem = add_sz_perror(h->elt_offset, h->elt_size) % pty_alignment;
-  h->pair_size = add_sz_perror(h->elt_offset + h->elt_size,
-			       (pty_rem > 0) * (pty_alignment - pty_rem));
+  set_layout(h, pty_alignment, elt_alignment, sz_alignment);
   h->buf = realloc_perror(h->buf, 2, h->pair_size);
-  memset(a->buf, 0, 2 * a->pair_size);
-  h->pty_elts = realloc_perror(h->pty_elts, init_count, h->pair_size);
-  h->hht->align(hht->ht, sz_alignment);
+  h->pty_elts = realloc_perror(h->pty_elts, h->count, h->pair_size);
+  h->hht->align(h->hht->ht, sz_alignment);
 }
 
 /**
@@ -164,12 +183,15 @@ void heap_push(heap_t *h, const void *pty, const void *elt){
   if (h->count == ix){
     /* grow heap; amortized constant overhead per push, 
        without considering realloc's search */
-    h->count *= mul_sz_perror(2, h->count);
+    h->count = mul_sz_perror(2, h->count);
     h->pty_elts = realloc_perror(h->pty_elts, h->count, h->pair_size);
   }
   memcpy(pty_ptr(h, ix), pty, h->pty_size);
   memcpy(elt_ptr(h, ix), elt, h->elt_size);
-  h->hht->insert(h->hht->ht, elt, &ix);
+  /* the only reduction and hashing of elt while it is in the heap */
+  *tok_ptr(h, ix) = (h->hht->hash_key != NULL) ?
+    h->hht->hash_key(h->hht->ht, elt) : 0;
+  ht_insert(h, ix);
   h->num_elts++;
   heapify_up(h, ix);
 }
@@ -183,7 +205,7 @@ void heap_push(heap_t *h, const void *pty, const void *elt){
    heap_push.
 */
 void *heap_search(const heap_t *h, const void *elt){
-  const size_t *ix_ptr = h->hht->search(h->hht->ht, elt);
+  const size_t *ix_ptr = ht_search(h, elt);
   if (ix_ptr != NULL){
     return pty_ptr(h, *ix_ptr);
   }else{
@@ -199,7 +221,7 @@ void *heap_search(const heap_t *h, const void *elt){
    specification in heap_push.
 */
 void heap_update(heap_t *h, const void *pty, const void *elt){
-  size_t ix = *(const size_t *)h->hht->search(h->hht->ht, elt);
+  size_t ix = *(const size_t *)ht_search(h, elt);
   memcpy(pty_ptr(h, ix), pty, h->pty_size);
   heapify_up(h, ix);
   heapify_down(h, ix);
@@ -212,12 +234,12 @@ void heap_update(heap_t *h, const void *pty, const void *elt){
    specification in heap_push.
 */
 void heap_pop(heap_t *h, void *pty, void *elt){
-  size_t ix_buf, ix = 0;
+  size_t ix = 0;
   if (h->num_elts == 0) return;
   memcpy(pty, pty_ptr(h, ix), h->pty_size);
   memcpy(elt, elt_ptr(h, ix), h->elt_size);
   swap(h, ix, h->num_elts - 1);
-  h->hht->remove(h->hht->ht, elt, &ix_buf);
+  ht_remove(h, h->num_elts - 1);
   h->num_elts--;
   if (h->num_elts > 0) heapify_down(h, ix);
 }
@@ -252,8 +274,8 @@ static void swap(heap_t *h, size_t i, size_t j){
   memcpy(buf, pty_ptr(h, i), h->pair_size);
   memcpy(pty_ptr(h, i), pty_ptr(h, j), h->pair_size);
   memcpy(pty_ptr(h, j), buf, h->pair_size);
-  h->hht->insert(h->hht->ht, elt_ptr(h, i), &i);
-  h->hht->insert(h->hht->ht, elt_ptr(h, j), &j);
+  ht_insert(h, i);
+  ht_insert(h, j);
 }
 
 /**
@@ -263,7 +285,7 @@ static void swap(heap_t *h, size_t i, size_t j){
 static void half_swap(heap_t *h, size_t t, size_t s){
   if (s == t) return;
   memcpy(pty_ptr(h, t), pty_ptr(h, s), h->pair_size);
-  h->hht->insert(h->hht->ht, elt_ptr(h, t), &t);
+  ht_insert(h, t);
 }
 
 /**
@@ -282,7 +304,7 @@ static void heapify_up(heap_t *h, size_t i){
     }
   }
   memcpy(pty_ptr(h, i), h->buf, h->pair_size);
-  h->hht->insert(h->hht->ht, elt_ptr(h, i), &i);
+  ht_insert(h, i);
 }
 
 /**
@@ -317,19 +339,97 @@ static void heapify_down(heap_t *h, size_t i){
     }
   }
   memcpy(pty_ptr(h, i), h->buf, h->pair_size);
-  h->hht->insert(h->hht->ht, elt_ptr(h, i), &i);
+  ht_insert(h, i);
 }
 
 /**
-   Computes a pointer to an element in the element-priority array of a heap.
+   Computes a pointer to a priority in the element-priority array of a heap.
 */
 static void *pty_ptr(const heap_t *h, size_t i){
   return (void *)((char *)h->pty_elts + i * h->pair_size);
 }
 
 /**
-   Computes a pointer to a priority in the element-priority array of a heap.
+   Computes a pointer to an element in the element-priority array of a heap.
 */
 static void *elt_ptr(const heap_t *h, size_t i){
   return (void *)((char *)h->pty_elts + i * h->pair_size + h->elt_offset);
 }
+
+/**
+   Computes a pointer to the hash token of an element in the
+   element-priority array of a heap.
+*/
+static size_t *tok_ptr(const heap_t *h, size_t i){
+  return (size_t *)((char *)h->pty_elts + i * h->pair_size + h->tok_offset);
+}
+
+/**
+   Maps the element at index i to i in the hash table with the hash token
+   stored next to the element, or without a hash token if hash_key of the
+   hash table is NULL.
+*/
+static void ht_insert(const heap_t *h, size_t i){
+  if (h->hht->hash_key != NULL){
+    h->hht->insert_hashed(h->hht->ht, elt_ptr(h, i), *tok_ptr(h, i), &i);
+  }else{
+    h->hht->insert(h->hht->ht, elt_ptr(h, i), &i);
+  }
+}
+
+/**
+   Removes the element at index i from the hash table with the hash token
+   stored next to the element, or without a hash token if hash_key of the
+   hash table is NULL.
+*/
+static void ht_remove(const heap_t *h, size_t i){
+  size_t ix_buf;
+  if (h->hht->hash_key != NULL){
+    h->hht->remove_hashed(h->hht->ht,
+			  elt_ptr(h, i),
+			  *tok_ptr(h, i),
+			  &ix_buf);
+  }else{
+    h->hht->remove(h->hht->ht, elt_ptr(h, i), &ix_buf);
+  }
+}
+
+/**
+   Searches the hash table for an element with the hash token of the
+   element, or without a hash token if hash_key of the hash table is NULL.
+*/
+static void *ht_search(const heap_t *h, const void *elt){
+  if (h->hht->hash_key != NULL){
+    return h->hht->search_hashed(h->hht->ht,
+				 elt,
+				 h->hht->hash_key(h->hht->ht, elt));
+  }else{
+    return h->hht->search(h->hht->ht, elt);
+  }
+}
+
+/**
+   Computes the offsets of an element and a hash token in a pair and the
+   size of a pair, s.t. the priority, element, and hash token in each pair
+   of the element-priority array are aligned.
+*/
+static void set_layout(heap_t *h,
+		       size_t pty_alignment,
+		       size_t elt_alignment,
+		       size_t sz_alignment){
+  h->elt_offset = align_up(h->pty_size, elt_alignment);
+  h->tok_offset = align_up(add_sz_perror(h->elt_offset, h->elt_size),
+			   sz_alignment);
+  h->pair_size =
+    align_up(add_sz_perror(h->tok_offset, sizeof(size_t)),
+	     lcm_perror(lcm_perror(pty_alignment, elt_alignment),
+			sz_alignment));
+}
+
+/**
+   Rounds n up to the nearest multiple of alignment.
+*/
+static size_t align_up(size_t n, size_t alignment){
+  size_t rem = n % alignment;
+  return add_sz_perror(n, (rem > 0) * (alignment - rem));
+}
@@ -20,6 +20,16 @@
    represented by its unique pointer, this invariant only prevents
    associating a given element in memory with more than one priority
    value in a heap.
+
+   The hash key of each element is reduced to a hash token once when the
+   element is pushed, and the token is stored next to the priority and
+   the element. Each hash table operation during heapifying is performed
+   with the stored token, avoiding the reduction and hashing of the
+   element at each of the O(log n) steps of a heap operation. heap_search
+   and heap_update search the hash table with the hash token of the given
+   element. If the hash table parameter does not provide the operations
+   with hash tokens (hash_key is NULL), the operations without hash tokens
+   are performed.
 */
 
 #ifndef HEAP_H  
@@ -45,6 +55,13 @@ typedef struct{
   void *(*search)(const void *, const void *);
   void (*remove)(void *, const void *, void *);
   void (*free)(void *);
+
+  /* pointers to hash table op helpers with hash tokens; hash_key is NULL
+     if the hash table does not provide them */
+  size_t (*hash_key)(const void *, const void *);
+  void (*insert_hashed)(void *, const void *, size_t, const void *);
+  void *(*search_hashed)(const void *, const void *, size_t);
+  void (*remove_hashed)(void *, const void *, size_t, void *);
 } heap_ht_t;
 
 typedef struct{
@@ -52,6 +69,7 @@ typedef struct{
   size_t elt_size;
   size_t pair_size; /* size of a pty elt pair aligned in memory */
   size_t elt_offset; /* number of bytes from beginning of pair to elt */
+  size_t tok_offset; /* number of bytes from beginning of pair to token */
   size_t count;
   size_t num_elts;
   size_t alpha_n;
@@ -68,13 +86,18 @@ typedef struct{
 /**
    Initializes a heap.
    h           : pointer to a preallocated block of size sizeof(heap_t)
-   init_count  : > 0
    pty_size    : size of a contiguous priority object
    elt_size    : - size of an element, if the element is within a contiguous
                  memory block and a copy of the element is inserted,
                  - size of a pointer to an element, if the element is within
                  a noncontiguous memory block or a pointer to a contiguous
                  element is inserted
+   min_num     : minimum number of elements that are known or expected to
+                 become present simultaneously in a heap; 0 if a positive
+                 value is not specified
+   alpha_n     : > 0 numerator of load factor upper bound of the hash table
+   log_alpha_d : < CHAR_BIT * sizeof(size_t) log base 2 of denominator of
+                 load factor upper bound of the hash table
    hht         : a non-NULL pointer to a set of parameters specifying a
                  hash table for in-heap search and modifications; a hash
                  key has the size and bit pattern of the block of size
@@ -86,6 +109,16 @@ typedef struct{
                  the first argument is greater than the priority value 
                  pointed to by the second, and zero integer value if the two
                  priority values are equal
+   cmp_elt     : - if NULL then a default memcmp-based comparison of the
+                 elt_size blocks of elements is performed in the hash table
+                 - otherwise a comparison function as cmp_key in the hash
+                 table
+   rdc_elt     : - if NULL then a default conversion of the elt_size block
+                 of an element is performed prior to hashing
+                 - otherwise a reduction function as rdc_key in the hash
+                 table; cmp_elt and rdc_elt have to work on the same subset
+                 of bits in the element, whether the element is within a
+                 contiguous or non-contiguous memory block
    free_elt    : - if an element is within a contiguous memory block and
                  a copy of the element was inserted, then NULL as free_elt
                  is sufficient to delete the element,
@@ -99,8 +132,8 @@ void heap_init(heap_t *h,
 	       size_t pty_size,
 	       size_t elt_size,
 	       size_t min_num,
-	       size_t alpha_n;
-	       size_t log_alpha_d;
+	       size_t alpha_n,
+	       size_t log_alpha_d,
 	       const heap_ht_t *hht,
 	       int (*cmp_pty)(const void *, const void *),
 	       int (*cmp_elt)(const void *, const void *),
@@ -108,6 +141,14 @@ void heap_init(heap_t *h,
 	       void (*free_elt)(void *));
 
 /**
+   Aligns the priority, element, and hash token in each pair, and the
+   elements of the hash table. The operation is optionally called after
+   heap_init is completed and before any other operation is called.
+   h             : pointer to an initialized heap
+   pty_alignment : alignment requirement or size of the priority type
+   elt_alignment : alignment requirement or size of the type, a pointer to
+                   which is used to access an elt_size block
+   sz_alignment  : alignment requirement or size of size_t
 */
 void heap_align(heap_t *h,
 		size_t pty_alignment,
@@ -0,0 +1,794 @@
+/**
+   ht-divbkt.c
+
+   A hash table with generic hash keys and generic elements. The
+   implementation is based on a division method for hashing into upto
+   the number of slots determined by the largest prime number in the
+   C_PRIME_PARTS array, representable as size_t on a given system, and a
+   chaining method with unrolled buckets for resolving collisions. Due to
+   chaining, the number of keys and elements that can be inserted is not
+   limited by the hash table implementation.
+
+   The load factor of a hash table is the expected number of keys in a slot
+   under the simple uniform hashing assumption, and is upper-bounded by the
+   alpha parameter. The alpha parameter does not provide an upper bound
+   after the maximum count of slots in a hash table is reached.
+
+   A chain is a list of buckets, each holding upto bkt_len key element
+   pairs in a single block of upto C_BKT_SIZE bytes, where bkt_len is set
+   according to the sizes of keys and elements, and is at least 1. The
+   first bucket of each chain is within the array of slots, and the
+   remaining buckets are allocated when the previous bucket is full. The
+   pairs of a chain are kept contiguous from the first bucket, and a
+   removed pair is replaced by the last pair of its chain. As a result,
+   a search of a key that is not in a hash table examines a single bucket
+   if the chain of its slot has at most bkt_len keys, which is likely at
+   a load factor near 1.
+
+   Each pair in a bucket has a 1-byte fingerprint of its key, computed
+   from the key with a multiplication method, and a key is compared with
+   a searched key only if their fingerprints match.
+
+   The slot of a key is computed without a division instruction with
+   a reciprocal of the count of slots, which is precomputed with
+   mod_rcp_init when the count changes.
+
+   A hash key is an object within a contiguous block of memory (e.g. a basic
+   type, array, struct). An element is within a contiguous or noncontiguous
+   memory block. The key element pairs of a hash table do not keep their
+   addresses in memory, and a pointer returned by a search is valid until
+   the next insert, remove, or delete operation.
+
+   The implementation only uses integer and pointer operations. Integer
+   arithmetic is used in load factor operations, thereby eliminating the
+   use of float. Given parameter values within the specified ranges,
+   the implementation provides an error message and an exit is executed
+   if an integer overflow is attempted* or an allocation is not completed
+   due to insufficient resources. The behavior outside the specified
+   parameter ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99 with the only requirement that CHAR_BIT * sizeof(size_t) is
+   greater or equal to 16 and is even (every bit is required to participate
+   in the value at this time).
+
+   * except intended wrapping around of unsigned integers in modulo
+     operations, which is defined, and overflow detection as a part
+     of computing bounds, which is defined by the implementation.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "ht-divbkt.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+
+/**
+   An array of primes in the increasing order, approximately doubling in 
+   magnitude, that are not too close to the powers of 2 and 10 to avoid 
+   hashing regularities due to the structure of data.
+*/
+static const size_t C_PRIME_PARTS[6 * 1 + 16 * (2 + 3 + 4)] =
+  {0x0607u,                               /* 1543 */
+   0x0c2fu,                               /* 3119 */
+   0x1843u,                               /* 6211 */
+   0x3037u,                               /* 12343 */
+   0x5dadu,                               /* 23981 */
+   0xbe21u,                               /* 48673 */
+   0x5b0bu, 0x0001u,                      /* 88843 */
+   0xd8d5u, 0x0002u,                      /* 186581 */
+   0xc219u, 0x0005u,                      /* 377369 */
+   0x0077u, 0x000cu,                      /* 786551 */
+   0xa243u, 0x0016u,                      /* 1483331 */
+   0x2029u, 0x0031u,                      /* 3219497 */
+   0xcc21u, 0x005fu,                      /* 6278177 */
+   0x5427u, 0x00bfu,                      /* 12538919 */
+   0x037fu, 0x0180u,                      /* 25166719 */
+   0x42bbu, 0x030fu,                      /* 51331771 */
+   0x1c75u, 0x06b7u,                      /* 112663669 */
+   0x96adu, 0x0c98u,                      /* 211326637 */
+   0x96b7u, 0x1898u,                      /* 412653239 */
+   0xc10fu, 0x2ecfu,                      /* 785367311 */
+   0x425bu, 0x600fu,                      /* 1611612763 */
+   0x0007u, 0xc000u,                      /* 3221225479 */
+   0x016fu, 0x8000u, 0x0001u,             /* 6442451311 */
+   0x9345u, 0xffc8u, 0x0002u,             /* 12881269573 */
+   0x5523u, 0xf272u, 0x0005u,             /* 25542415651 */
+   0x1575u, 0x0a63u, 0x000cu,             /* 51713873269 */
+   0x22fbu, 0xca07u, 0x001bu,             /* 119353582331 */
+   0xc513u, 0x4d6bu, 0x0031u,             /* 211752305939 */
+   0xa6cdu, 0x50f3u, 0x0061u,             /* 417969972941 */
+   0xa021u, 0x5460u, 0x00beu,             /* 817459404833 */
+   0xea29u, 0x7882u, 0x0179u,             /* 1621224516137 */
+   0xeaafu, 0x7c3du, 0x02f5u,             /* 3253374675631 */
+   0xab5fu, 0x5a69u, 0x05ffu,             /* 6594291673951 */
+   0x6b1fu, 0x29efu, 0x0c24u,             /* 13349461912351 */
+   0xc81bu, 0x35a7u, 0x17feu,             /* 26380589320219 */
+   0x57b7u, 0xccbeu, 0x2ffbu,             /* 52758518323127 */
+   0xc8fbu, 0x1da8u, 0x6bf3u,             /* 118691918825723 */
+   0x82c3u, 0x2c9fu, 0xc2ccu,             /* 214182177768131 */
+   0x3233u, 0x1c54u, 0x7d40u, 0x0001u,    /* 419189283369523 */
+   0x60adu, 0x46a1u, 0xf55eu, 0x0002u,    /* 832735214133421 */
+   0x6babu, 0x40c4u, 0xf12au, 0x0005u,    /* 1672538661088171 */
+   0xb24du, 0x6765u, 0x38b5u, 0x000bu,    /* 3158576518771277 */
+   0x789fu, 0xfd94u, 0xc6b2u, 0x0017u,    /* 6692396525189279 */
+   0x0d35u, 0x5443u, 0xff54u, 0x0030u,    /* 13791536538127669 */
+   0x2465u, 0x74f9u, 0x42d1u, 0x005eu,    /* 26532115188884581 */
+   0xd017u, 0x90c7u, 0x37b3u, 0x00c6u,    /* 55793289756397591 */
+   0x5055u, 0x5a82u, 0x64dfu, 0x0193u,    /* 113545326073368661 */
+   0x6f8fu, 0x423bu, 0x8949u, 0x0304u,    /* 217449629757435791 */
+   0xd627u, 0x08e0u, 0x0b2fu, 0x05feu,    /* 431794910914467367 */
+   0xbbc1u, 0x662cu, 0x4d90u, 0x0badu,    /* 841413987972987841 */
+   0xf7d3u, 0x45a1u, 0x8ccbu, 0x185du,    /* 1755714234418853843 */
+   0xc647u, 0x3c91u, 0x46b2u, 0x2e9bu,    /* 3358355678469146183 */
+   0x58a1u, 0xbd96u, 0x2836u, 0x5f8cu,    /* 6884922145916737697 */
+   0x8969u, 0x4c70u, 0x6dbeu, 0xdad8u};   /* 15769474759331449193 */
+
+static const size_t C_PRIME_PARTS_COUNT = 6 + 16 * (2 + 3 + 4);
+static const size_t C_PARTS_PER_PRIME[4] = {1, 2, 3, 4};
+static const size_t C_PARTS_ACC_COUNTS[4] = {6,
+					     6 + 16 * 2,
+					     6 + 16 * (2 + 3),
+					     6 + 16 * (2 + 3 + 4)};
+static const size_t C_BUILD_SHIFT = 16;
+static const size_t C_BYTE_BIT = CHAR_BIT;
+static const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
+static const size_t C_SIZE_MAX = (size_t)-1;
+
+/* buckets and fingerprints */
+static const size_t C_BKT_SIZE = 64; /* size of a cache line on most systems */
+static const size_t C_BKT_LEN_MAX = 16;
+static const unsigned char C_FP_EMPTY = 0;
+
+/**
+   A union of basic types, the size of which is a multiple of the highest
+   alignment requirement of the basic types, and is used to align the
+   keys and the bucket blocks in the array of slots as malloc'ed blocks.
+*/
+typedef union{
+  long l;
+  double d;
+  long double ld;
+  void *p;
+  void (*fp)(void);
+} align_t;
+
+/* bucket handling */
+static size_t bkt_layout(ht_divbkt_t *ht, size_t bkt_len);
+static divbkt_t *bkt_head(const ht_divbkt_t *ht, size_t ix);
+static void bkt_init(const ht_divbkt_t *ht, divbkt_t *bkt);
+static unsigned char *bkt_fps(const ht_divbkt_t *ht, const divbkt_t *bkt);
+static void *bkt_key_ptr(const ht_divbkt_t *ht, const divbkt_t *bkt, size_t i);
+static void *bkt_elt_ptr(const ht_divbkt_t *ht, const divbkt_t *bkt, size_t i);
+static void bkt_append(ht_divbkt_t *ht,
+		       divbkt_t *bkt,
+		       size_t i,
+		       unsigned char fp,
+		       const void *key,
+		       const void *elt);
+
+/* hashing */
+static size_t convert_std_key(const ht_divbkt_t *ht, const void *key);
+static unsigned char fingerprint(const ht_divbkt_t *ht, size_t std_key);
+static int search(const ht_divbkt_t *ht,
+		  const void *key,
+		  size_t std_key,
+		  unsigned char fp,
+		  divbkt_t **bkt,
+		  size_t *i);
+
+/* hash table operations and maintenance */
+static void slots_init(ht_divbkt_t *ht);
+static void slots_free(ht_divbkt_t *ht, unsigned char *bkts, size_t count);
+static void delete_pair(ht_divbkt_t *ht, size_t ix, divbkt_t *bkt, size_t i);
+static size_t mul_alpha_sz_max(size_t n, size_t alpha_n, size_t log_alpha_d);
+static void ht_grow(ht_divbkt_t *ht);
+static int incr_count(ht_divbkt_t *ht);
+static int is_overflow(size_t start, size_t count);
+static size_t build_prime(size_t start, size_t count);
+static size_t find_build_prime(void);
+
+/**
+   Initializes a hash table.
+   ht          : a pointer to a preallocated block of size
+                 sizeof(ht_divbkt_t).
+   key_size    : non-zero size of a key object
+   elt_size    : - non-zero size of an element, if the element is within a
+                 contiguous memory block and a copy of the element is
+                 inserted,
+                 - size of a pointer to an element, if the element
+                 is within a noncontiguous memory block or a pointer to a
+                 contiguous element is inserted
+   min_num     : minimum number of keys that are known or expected to become
+                 present simultaneously in a hash table, resulting in a
+                 speedup by avoiding unnecessary growth steps of a hash
+                 table; 0 if a positive value is not specified and all growth
+                 steps are to be completed
+   alpha_n     : > 0 numerator of load factor upper bound
+   log_alpha_d : < CHAR_BIT * sizeof(size_t) log base 2 of denominator of
+                 load factor upper bound; denominator is a power of two
+   cmp_key     : - if NULL then a default memcmp-based comparison of keys
+                 is performed
+                 - otherwise comparison function is applied which returns a
+                 zero integer value iff the two keys accessed through the
+                 first and the second arguments are equal; each argument is
+                 a pointer to a key_size block
+   rdc_key     : - if NULL then a default conversion of a bit pattern
+                 in the block pointed to by key is performed prior to
+                 hashing, which may introduce regularities
+                 - otherwise rdc_key is applied to a key prior to hashing;
+                 the first argument points to a key and the second argument
+                 provides the size of the key
+   free_elt    : - if an element is within a contiguous memory block and
+                 a copy of the element was inserted, then NULL as free_elt
+                 is sufficient to delete the element,
+                 - if an element is within a noncontiguous memory block or
+                 a pointer to a contiguous element was inserted, then an
+                 element-specific free_elt, taking a pointer to a pointer to an
+                 element as its argument and leaving a block of size elt_size
+                 pointed to by the argument, is necessary to delete the element
+*/
+void ht_divbkt_init(ht_divbkt_t *ht,
+		    size_t key_size,
+		    size_t elt_size,
+		    size_t min_num,
+		    size_t alpha_n,
+		    size_t log_alpha_d,
+		    int (*cmp_key)(const void *, const void *),
+		    size_t (*rdc_key)(const void *, size_t),
+		    void (*free_elt)(void *)){
+  ht->key_size = key_size;
+  ht->elt_size = elt_size;
+  ht->elt_alignment = 1;
+  ht->fp_offset = sizeof(divbkt_t);
+  ht->bkt_len = 1;
+  while (ht->bkt_len < C_BKT_LEN_MAX &&
+	 bkt_layout(ht, ht->bkt_len + 1) <= C_BKT_SIZE){
+    ht->bkt_len++;
+  }
+  ht->bkt_size = bkt_layout(ht, ht->bkt_len);
+  ht->group_ix = 0;
+  ht->count_ix = 0;
+  ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+  mod_rcp_init(&ht->count_rcp, ht->count);
+  /* 0 <= max_num_elts */
+  ht->max_num_elts = mul_alpha_sz_max(ht->count, alpha_n, log_alpha_d);
+  ht->alpha_n = alpha_n;
+  ht->log_alpha_d = log_alpha_d;
+  while (min_num > ht->max_num_elts && incr_count(ht));
+  ht->num_elts = 0;
+  ht->fprime = find_build_prime();
+  slots_init(ht);
+  ht->cmp_key = cmp_key;
+  ht->rdc_key = rdc_key;
+  ht->free_elt = free_elt;
+}
+
+/**
+   Aligns each in-table elt_size block to be accessible with a pointer to a
+   type T other than character (in addition to a character pointer). If
+   alignment requirement of T is unknown, the size of T can be used
+   as a value of the alignment parameter because size of T >= alignment
+   requirement of T (due to structure of arrays), which may result in
+   overalignment. The hash table keeps the effective type of a copied
+   elt_size block, if it had one at the time of insertion, and T must
+   be compatible with the type to comply with the strict aliasing rules.
+   T can be the same or a cvr-qualified/signed/unsigned version of the
+   type. The operation is optionally called after ht_divbkt_init is
+   completed and before any other operation is called.
+   ht            : pointer to an initialized ht_divbkt_t struct
+   elt_alignment : alignment requirement or size of the type, a pointer to
+                   which is used to access an elt_size block
+*/
+void ht_divbkt_align(ht_divbkt_t *ht, size_t elt_alignment){
+  ht->elt_alignment = elt_alignment;
+  while (ht->bkt_len > 1 && bkt_layout(ht, ht->bkt_len) > C_BKT_SIZE){
+    ht->bkt_len--;
+  }
+  ht->bkt_size = bkt_layout(ht, ht->bkt_len);
+  free(ht->bkts);
+  slots_init(ht);
+}
+
+/**
+   Inserts a key and an associated element into a hash table. If the key is
+   in the hash table, associates the key with the new element. The key and
+   elt parameters are not NULL and point to blocks of size key_size and
+   elt_size respectively.
+*/
+void ht_divbkt_insert(ht_divbkt_t *ht, const void *key, const void *elt){
+  size_t i;
+  size_t std_key = convert_std_key(ht, key);
+  unsigned char fp = fingerprint(ht, std_key);
+  divbkt_t *bkt = NULL;
+  if (search(ht, key, std_key, fp, &bkt, &i)){
+    if (ht->free_elt != NULL) ht->free_elt(bkt_elt_ptr(ht, bkt, i));
+    memcpy(bkt_elt_ptr(ht, bkt, i), elt, ht->elt_size);
+    return;
+  }
+  bkt_append(ht, bkt, i, fp, key, elt);
+  ht->num_elts++;
+  /* grow ht after ensuring it was insertion, not update */
+  if (ht->num_elts > ht->max_num_elts &&
+      ht->count_ix != C_SIZE_MAX &&
+      ht->count_ix != C_PRIME_PARTS_COUNT){
+    ht_grow(ht);
+  }
+}
+
+/**
+   If a key is present in a hash table, returns a pointer to its associated
+   element, otherwise returns NULL. The key parameter is not NULL and points
+   to a block of size key_size. The returned pointer can be dereferenced
+   according to ht_divbkt_init and ht_divbkt_align, and is valid until the
+   next insert, remove, or delete operation.
+*/
+void *ht_divbkt_search(const ht_divbkt_t *ht, const void *key){
+  size_t i;
+  size_t std_key = convert_std_key(ht, key);
+  divbkt_t *bkt = NULL;
+  if (search(ht, key, std_key, fingerprint(ht, std_key), &bkt, &i)){
+    return bkt_elt_ptr(ht, bkt, i);
+  }
+  return NULL;
+}
+
+/**
+   Removes a key and its associated element from a hash table by copying
+   the element or its pointer into a block of size elt_size pointed to
+   by elt. If the key is not in the hash table, leaves the block pointed
+   to by elt unchanged. The key and elt parameters are not NULL and point
+   to blocks of size key_size and elt_size respectively.
+*/
+void ht_divbkt_remove(ht_divbkt_t *ht, const void *key, void *elt){
+  size_t i;
+  size_t std_key = convert_std_key(ht, key);
+  divbkt_t *bkt = NULL;
+  if (search(ht, key, std_key, fingerprint(ht, std_key), &bkt, &i)){
+    memcpy(elt, bkt_elt_ptr(ht, bkt, i), ht->elt_size);
+    /* if an element is noncontiguous, only the pointer to it is deleted */
+    delete_pair(ht, rcp_mod(std_key, &ht->count_rcp), bkt, i);
+  }
+}
+
+/**
+   If a key is in a hash table, deletes the key and its associated element
+   according to free_elt. The key parameter is not NULL and points
+   to a block of size key_size.
+*/
+void ht_divbkt_delete(ht_divbkt_t *ht, const void *key){
+  size_t i;
+  size_t std_key = convert_std_key(ht, key);
+  divbkt_t *bkt = NULL;
+  if (search(ht, key, std_key, fingerprint(ht, std_key), &bkt, &i)){
+    if (ht->free_elt != NULL) ht->free_elt(bkt_elt_ptr(ht, bkt, i));
+    delete_pair(ht, rcp_mod(std_key, &ht->count_rcp), bkt, i);
+  }
+}
+
+/**
+   Frees a hash table and leaves a block of size sizeof(ht_divbkt_t)
+   pointed to by the ht parameter.
+*/
+void ht_divbkt_free(ht_divbkt_t *ht){
+  size_t i, j;
+  const unsigned char *fps = NULL;
+  divbkt_t *bkt = NULL;
+  if (ht->free_elt != NULL){
+    for (i = 0; i < ht->count; i++){
+      for (bkt = bkt_head(ht, i); bkt != NULL; bkt = bkt->next){
+	fps = bkt_fps(ht, bkt);
+	for (j = 0; j < ht->bkt_len && fps[j] != C_FP_EMPTY; j++){
+	  ht->free_elt(bkt_elt_ptr(ht, bkt, j));
+	}
+      }
+    }
+  }
+  slots_free(ht, ht->bkts, ht->count);
+  ht->bkts = NULL;
+}
+
+/**
+   Help construct a hash table parameter value in algorithms and data
+   structures with a hash table parameter, complying with the stict aliasing
+   rules and compatibility rules for function types. In each case, a
+   (qualified) ht_divbkt_t *p0 is converted to (qualified) void * and back
+   to a (qualified) ht_divbkt_t *p1, thus guaranteeing that the value of p0
+   equals the value of p1.
+*/
+
+void ht_divbkt_init_helper(void *ht,
+			   size_t key_size,
+			   size_t elt_size,
+			   size_t min_num,
+			   size_t alpha_n,
+			   size_t log_alpha_d,
+			   int (*cmp_key)(const void *, const void *),
+			   size_t (*rdc_key)(const void *, size_t),
+			   void (*free_elt)(void *)){
+  ht_divbkt_init(ht,
+		 key_size,
+		 elt_size,
+		 min_num,
+		 alpha_n,
+		 log_alpha_d,
+		 cmp_key,
+		 rdc_key,
+		 free_elt);
+}
+
+void ht_divbkt_align_helper(void *ht, size_t elt_alignment){
+  ht_divbkt_align(ht, elt_alignment);
+}
+
+void ht_divbkt_insert_helper(void *ht, const void *key, const void *elt){
+  ht_divbkt_insert(ht, key, elt);
+}
+
+void *ht_divbkt_search_helper(const void *ht, const void *key){
+  return ht_divbkt_search(ht, key);
+}
+
+void ht_divbkt_remove_helper(void *ht, const void *key, void *elt){
+  ht_divbkt_remove(ht, key, elt);
+}
+
+void ht_divbkt_delete_helper(void *ht, const void *key){
+  ht_divbkt_delete(ht, key);
+}
+
+void ht_divbkt_free_helper(void *ht){
+  ht_divbkt_free(ht);
+}
+
+/** Auxiliary functions */
+
+/**
+   Sets the key_offset and elt_offset of a hash table for buckets with
+   bkt_len key element pairs, and returns the size of a bucket block. The
+   fingerprints follow the divbkt_t struct, the keys are aligned as a
+   malloc'ed block, the elements are aligned according to elt_alignment,
+   and the size is a multiple of sizeof(align_t), so that each bucket
+   block in the array of slots is aligned as a malloc'ed block.
+*/
+static size_t bkt_layout(ht_divbkt_t *ht, size_t bkt_len){
+  size_t size, rem;
+  size = add_sz_perror(ht->fp_offset, bkt_len);
+  rem = size % sizeof(align_t);
+  ht->key_offset = add_sz_perror(size, (rem > 0) * (sizeof(align_t) - rem));
+  size = add_sz_perror(ht->key_offset, mul_sz_perror(bkt_len, ht->key_size));
+  rem = size % ht->elt_alignment;
+  ht->elt_offset = add_sz_perror(size,
+				 (rem > 0) * (ht->elt_alignment - rem));
+  size = add_sz_perror(ht->elt_offset, mul_sz_perror(bkt_len, ht->elt_size));
+  rem = size % sizeof(align_t);
+  return add_sz_perror(size, (rem > 0) * (sizeof(align_t) - rem));
+}
+
+/**
+   Returns a pointer to the first bucket of the chain of the slot ix.
+*/
+static divbkt_t *bkt_head(const ht_divbkt_t *ht, size_t ix){
+  return (divbkt_t *)(ht->bkts + ix * ht->bkt_size);
+}
+
+/**
+   Initializes an empty bucket.
+*/
+static void bkt_init(const ht_divbkt_t *ht, divbkt_t *bkt){
+  bkt->next = NULL;
+  memset(bkt_fps(ht, bkt), C_FP_EMPTY, ht->bkt_len);
+}
+
+/**
+   Return pointers to the fingerprints, and to the ith key and element
+   of a bucket.
+*/
+
+static unsigned char *bkt_fps(const ht_divbkt_t *ht, const divbkt_t *bkt){
+  return (unsigned char *)bkt + ht->fp_offset;
+}
+
+static void *bkt_key_ptr(const ht_divbkt_t *ht, const divbkt_t *bkt, size_t i){
+  return (void *)((char *)bkt + ht->key_offset + i * ht->key_size);
+}
+
+static void *bkt_elt_ptr(const ht_divbkt_t *ht, const divbkt_t *bkt, size_t i){
+  return (void *)((char *)bkt + ht->elt_offset + i * ht->elt_size);
+}
+
+/**
+   Copies a key with the fingerprint fp and its element into the ith pair
+   of the last bucket of a chain, where i is the number of pairs in the
+   bucket. If the bucket is full, a new bucket is appended to the chain.
+*/
+static void bkt_append(ht_divbkt_t *ht,
+		       divbkt_t *bkt,
+		       size_t i,
+		       unsigned char fp,
+		       const void *key,
+		       const void *elt){
+  if (i == ht->bkt_len){
+    bkt->next = malloc_perror(1, ht->bkt_size);
+    bkt = bkt->next;
+    bkt_init(ht, bkt);
+    i = 0;
+  }
+  bkt_fps(ht, bkt)[i] = fp;
+  memcpy(bkt_key_ptr(ht, bkt, i), key, ht->key_size);
+  memcpy(bkt_elt_ptr(ht, bkt, i), elt, ht->elt_size);
+}
+
+/**
+   Converts a key to a key of the standard size. This is a safe conversion
+   of any bit pattern in the block pointed to by key to size_t.
+*/
+static size_t convert_std_key(const ht_divbkt_t *ht, const void *key){
+  size_t i;
+  size_t sz_count, rem_size;
+  size_t std_key = 0;
+  size_t buf_size = sizeof(size_t);
+  unsigned char buf[sizeof(size_t)];
+  const char *k = NULL, *k_start = NULL, *k_end = NULL;
+  if (ht->rdc_key != NULL) return ht->rdc_key(key, ht->key_size);
+  sz_count = ht->key_size / buf_size; /* division by sizeof(size_t) */
+  rem_size = ht->key_size - sz_count * buf_size;
+  k = key;
+  memset(buf, 0, buf_size);
+  memcpy(buf, k, rem_size);
+  for (i = 0; i < rem_size; i++){
+    std_key += (size_t)buf[i] << (i * C_BYTE_BIT);
+  }
+  k_start = k + rem_size;
+  k_end = k_start + sz_count * buf_size;
+  for (k = k_start; k != k_end; k += buf_size){
+    memcpy(buf, k, buf_size);
+    for (i = 0; i < buf_size; i++){
+      std_key += (size_t)buf[i] << (i * C_BYTE_BIT);
+    }
+  }
+  return std_key;
+}
+
+/**
+   Computes a non-empty fingerprint of a standard key from the high bits
+   of its product with fprime.
+*/
+static unsigned char fingerprint(const ht_divbkt_t *ht, size_t std_key){
+  unsigned char fp = (ht->fprime * std_key) >> (C_FULL_BIT - C_BYTE_BIT);
+  return fp + (fp == C_FP_EMPTY);
+}
+
+/**
+   Searches a key, converted to the standard key std_key, with the
+   fingerprint fp in the chain of its slot. If the key is in the hash
+   table, returns 1 and sets the pointers pointed to by bkt and i to
+   the bucket and the index of the pair with the key. Otherwise returns
+   0, and sets the pointers to the last bucket of the chain and the number
+   of pairs in the last bucket. The keys are compared only if their
+   fingerprints match, and a search is completed at the first empty pair.
+*/
+static int search(const ht_divbkt_t *ht,
+		  const void *key,
+		  size_t std_key,
+		  unsigned char fp,
+		  divbkt_t **bkt,
+		  size_t *i){
+  size_t j;
+  const unsigned char *fps = NULL;
+  divbkt_t *b = bkt_head(ht, rcp_mod(std_key, &ht->count_rcp));
+  while (1){
+    fps = bkt_fps(ht, b);
+    for (j = 0; j < ht->bkt_len && fps[j] != C_FP_EMPTY; j++){
+      if (fps[j] == fp &&
+	  ((ht->cmp_key != NULL &&
+	    ht->cmp_key(bkt_key_ptr(ht, b, j), key) == 0) ||
+	   (ht->cmp_key == NULL &&
+	    memcmp(bkt_key_ptr(ht, b, j), key, ht->key_size) == 0))){
+	*bkt = b;
+	*i = j;
+	return 1;
+      }
+    }
+    if (j < ht->bkt_len || b->next == NULL) break;
+    b = b->next;
+  }
+  *bkt = b;
+  *i = j;
+  return 0;
+}
+
+/**
+   Initializes the empty slots of a hash table according to its count.
+*/
+static void slots_init(ht_divbkt_t *ht){
+  size_t i;
+  ht->bkts = malloc_perror(ht->count, ht->bkt_size);
+  for (i = 0; i < ht->count; i++){
+    bkt_init(ht, bkt_head(ht, i));
+  }
+}
+
+/**
+   Frees the array bkts of count slots of a hash table and the buckets
+   appended to the first buckets of the chains.
+*/
+static void slots_free(ht_divbkt_t *ht, unsigned char *bkts, size_t count){
+  size_t i;
+  divbkt_t *bkt = NULL, *next = NULL;
+  for (i = 0; i < count; i++){
+    bkt = ((divbkt_t *)(bkts + i * ht->bkt_size))->next;
+    while (bkt != NULL){
+      next = bkt->next;
+      free(bkt);
+      bkt = next;
+    }
+  }
+  free(bkts);
+}
+
+/**
+   Deletes the ith pair of a bucket in the chain of the slot ix, without
+   calling free_elt, by moving the last pair of the chain into its place.
+   Frees the last bucket of the chain if it becomes empty and is not the
+   first bucket.
+*/
+static void delete_pair(ht_divbkt_t *ht, size_t ix, divbkt_t *bkt, size_t i){
+  size_t j;
+  unsigned char *fps = NULL;
+  divbkt_t *prev = NULL, *last = bkt_head(ht, ix);
+  while (last->next != NULL){
+    prev = last;
+    last = last->next;
+  }
+  fps = bkt_fps(ht, last);
+  for (j = 1; j < ht->bkt_len && fps[j] != C_FP_EMPTY; j++);
+  j--; /* last pair in the chain */
+  if (last != bkt || j != i){
+    bkt_fps(ht, bkt)[i] = fps[j];
+    memcpy(bkt_key_ptr(ht, bkt, i), bkt_key_ptr(ht, last, j), ht->key_size);
+    memcpy(bkt_elt_ptr(ht, bkt, i), bkt_elt_ptr(ht, last, j), ht->elt_size);
+  }
+  fps[j] = C_FP_EMPTY;
+  if (j == 0 && prev != NULL){
+    free(last);
+    prev->next = NULL;
+  }
+  ht->num_elts--;
+}
+
+/**
+   Multiplies an unsigned integer n by a load factor upper bound, represented
+   by a numerator and log base 2 of a denominator. The denominator is a
+   power of two. Returns the product if it is representable as size_t.
+   Otherwise returns the maximal value of size_t.
+*/
+static size_t mul_alpha_sz_max(size_t n, size_t alpha_n, size_t log_alpha_d){
+  size_t h, l;
+  mul_ext(n, alpha_n, &h, &l);
+  if (h >> log_alpha_d) return C_SIZE_MAX; /* overflow after division */
+  l >>= log_alpha_d;
+  h <<= (C_FULL_BIT - log_alpha_d);
+  return l + h;
+}
+
+/**
+   Increases the count of a hash table to the next prime number in the
+   C_PRIME_PARTS array that accomodates alpha as a load factor upper bound.
+   The operation is called if alpha was exceeded (i.e. num_elts >
+   max_num_elts) and count_ix is not equal to C_SIZE_MAX or
+   C_PRIME_PARTS_COUNT. The pairs are appended to the chains of the new
+   slots with their fingerprints, and the previous buckets are freed.
+*/
+static void ht_grow(ht_divbkt_t *ht){
+  size_t i, j, ix, len;
+  size_t prev_count = ht->count;
+  const unsigned char *fps = NULL;
+  unsigned char *prev_bkts = ht->bkts;
+  divbkt_t *bkt = NULL, *b = NULL;
+  while (ht->num_elts > ht->max_num_elts && incr_count(ht));
+  if (prev_count == ht->count) return; /* load factor not lowered */
+  slots_init(ht);
+  for (i = 0; i < prev_count; i++){
+    bkt = (divbkt_t *)(prev_bkts + i * ht->bkt_size);
+    for (; bkt != NULL; bkt = bkt->next){
+      fps = bkt_fps(ht, bkt);
+      for (j = 0; j < ht->bkt_len && fps[j] != C_FP_EMPTY; j++){
+	ix = rcp_mod(convert_std_key(ht, bkt_key_ptr(ht, bkt, j)),
+		     &ht->count_rcp);
+	b = bkt_head(ht, ix);
+	while (b->next != NULL) b = b->next;
+	for (len = 0;
+	     len < ht->bkt_len && bkt_fps(ht, b)[len] != C_FP_EMPTY;
+	     len++);
+	bkt_append(ht,
+		   b,
+		   len,
+		   fps[j],
+		   bkt_key_ptr(ht, bkt, j),
+		   bkt_elt_ptr(ht, bkt, j));
+      }
+    }
+  }
+  slots_free(ht, prev_bkts, prev_count);
+  prev_bkts = NULL;
+}
+
+/**
+   Attempts to increase the count of a hash table. Returns 1 if the count
+   was increased. Otherwise returns 0. Updates count_ix, group_ix, count,
+   and max_num_elts accordingly. If the largest representable prime is
+   reached, count_ix may not yet be set to C_SIZE_MAX or C_PRIME_PARTS_COUNT,
+   which requires one additional call that does not increase the count.
+   Otherwise, each call increases the count.
+*/
+static int incr_count(ht_divbkt_t *ht){
+  ht->count_ix += C_PARTS_PER_PRIME[ht->group_ix];
+  if (ht->count_ix == C_PARTS_ACC_COUNTS[ht->group_ix]) ht->group_ix++;
+  if (ht->count_ix == C_PRIME_PARTS_COUNT){
+    return 0;
+  }else if (is_overflow(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix])){
+    ht->count_ix = C_SIZE_MAX;
+    return 0;
+  }else{
+    ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+    mod_rcp_init(&ht->count_rcp, ht->count);
+    /* 0 <= max_num_elts <= C_SIZE_MAX */
+    ht->max_num_elts = mul_alpha_sz_max(ht->count,
+					ht->alpha_n,
+					ht->log_alpha_d);
+  }
+  return 1;
+}
+
+/**
+   Tests if the next prime number results in an overflow of size_t
+   on a given system. Returns 0 if no overflow, otherwise returns 1.
+*/
+static int is_overflow(size_t start, size_t count){
+  size_t c = 0;
+  size_t n_shift;
+  n_shift = C_PRIME_PARTS[start + (count - 1)];
+  while (n_shift){
+    n_shift >>= 1;
+    c++;
+  }
+  return (c + (count - 1) * C_BUILD_SHIFT > C_FULL_BIT);
+}
+
+/**
+   Builds a prime number from parts in the C_PRIME_PARTS array.
+*/
+static size_t build_prime(size_t start, size_t count){
+  size_t p = 0;
+  size_t n_shift;
+  size_t i;
+  for (i = 0; i < count; i++){
+    n_shift = C_PRIME_PARTS[start + i];
+    n_shift <<= (i * C_BUILD_SHIFT);
+    p |= n_shift;
+  }
+  return p;
+}
+
+/**
+   Finds and builds the largest prime number in the C_PRIME_PARTS array
+   that is representable as size_t on a given system, which is used as
+   the multiplier of fingerprints.
+*/
+static size_t find_build_prime(void){
+  size_t p;
+  size_t i = 0, j = 0;
+  p = build_prime(i, C_PARTS_PER_PRIME[j]);
+  i += C_PARTS_PER_PRIME[j];
+  if (i == C_PARTS_ACC_COUNTS[j]) j++;
+  while (i < C_PRIME_PARTS_COUNT &&
+	 !is_overflow(i, C_PARTS_PER_PRIME[j])){
+    p = build_prime(i, C_PARTS_PER_PRIME[j]);
+    i += C_PARTS_PER_PRIME[j];
+    if (i == C_PARTS_ACC_COUNTS[j]) j++;
+  }
+  return p;
+}
@@ -0,0 +1,236 @@
+/**
+   ht-divbkt.h
+
+   Struct declarations and declarations of accessible functions of a hash
+   table with generic hash keys and generic elements. The implementation
+   is based on a division method for hashing into upto the number of
+   slots determined by the largest prime number in the C_PRIME_PARTS
+   array, representable as size_t on a given system, and a chaining method
+   with unrolled buckets for resolving collisions. Due to chaining, the
+   number of keys and elements that can be inserted is not limited by the
+   hash table implementation.
+
+   The load factor of a hash table is the expected number of keys in a slot
+   under the simple uniform hashing assumption, and is upper-bounded by the
+   alpha parameter. The alpha parameter does not provide an upper bound
+   after the maximum count of slots in a hash table is reached.
+
+   A chain is a list of buckets, each holding upto bkt_len key element
+   pairs in a single block of upto C_BKT_SIZE bytes, where bkt_len is set
+   according to the sizes of keys and elements, and is at least 1. The
+   first bucket of each chain is within the array of slots, and the
+   remaining buckets are allocated when the previous bucket is full. The
+   pairs of a chain are kept contiguous from the first bucket, and a
+   removed pair is replaced by the last pair of its chain. As a result,
+   a search of a key that is not in a hash table examines a single bucket
+   if the chain of its slot has at most bkt_len keys, which is likely at
+   a load factor near 1.
+
+   Each pair in a bucket has a 1-byte fingerprint of its key, computed
+   from the key with a multiplication method, and a key is compared with
+   a searched key only if their fingerprints match.
+
+   The slot of a key is computed without a division instruction with
+   a reciprocal of the count of slots, which is precomputed with
+   mod_rcp_init when the count changes.
+
+   A hash key is an object within a contiguous block of memory (e.g. a basic
+   type, array, struct). An element is within a contiguous or noncontiguous
+   memory block. The key element pairs of a hash table do not keep their
+   addresses in memory, and a pointer returned by a search is valid until
+   the next insert, remove, or delete operation.
+
+   The implementation only uses integer and pointer operations. Integer
+   arithmetic is used in load factor operations, thereby eliminating the
+   use of float. Given parameter values within the specified ranges,
+   the implementation provides an error message and an exit is executed
+   if an integer overflow is attempted* or an allocation is not completed
+   due to insufficient resources. The behavior outside the specified
+   parameter ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99 with the only requirement that CHAR_BIT * sizeof(size_t) is
+   greater or equal to 16 and is even (every bit is required to participate
+   in the value at this time).
+
+   * except intended wrapping around of unsigned integers in modulo
+     operations, which is defined, and overflow detection as a part
+     of computing bounds, which is defined by the implementation.
+*/
+
+#ifndef HT_DIVBKT_H
+#define HT_DIVBKT_H
+
+#include <stddef.h>
+#include "utilities-mod.h"
+
+typedef struct divbkt{
+  struct divbkt *next; /* NULL if last bucket of a chain */
+} divbkt_t; /* given char *p pointer to a divbkt_t at the beginning of a
+               bucket block, p + fp_offset points to bkt_len fingerprints,
+               p + key_offset points to bkt_len key_size blocks, and
+               p + elt_offset points to bkt_len elt_size blocks */
+
+typedef struct{
+  size_t key_size;
+  size_t elt_size;
+  size_t elt_alignment;
+  size_t fp_offset;
+  size_t key_offset;
+  size_t elt_offset;
+  size_t bkt_len; /* >= 1, number of key element pairs in a bucket */
+  size_t bkt_size; /* size of a bucket block */
+  size_t group_ix;
+  size_t count_ix; /* max size_t value if last representable prime reached */
+  size_t count;
+  mod_rcp_t count_rcp; /* precomputed for division-free % count */
+  size_t max_num_elts; /*  >= 0, <= C_SIZE_MAX, represents alpha */
+  size_t num_elts;
+  size_t fprime; /* >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
+  size_t alpha_n;
+  size_t log_alpha_d;
+  unsigned char *bkts; /* first bucket of the chain of each slot */
+  int (*cmp_key)(const void *, const void *);
+  size_t (*rdc_key)(const void *, size_t);
+  void (*free_elt)(void *);
+} ht_divbkt_t;
+
+/**
+   Initializes a hash table.
+   ht          : a pointer to a preallocated block of size
+                 sizeof(ht_divbkt_t).
+   key_size    : non-zero size of a key object
+   elt_size    : - non-zero size of an element, if the element is within a
+                 contiguous memory block and a copy of the element is
+                 inserted,
+                 - size of a pointer to an element, if the element
+                 is within a noncontiguous memory block or a pointer to a
+                 contiguous element is inserted
+   min_num     : minimum number of keys that are known or expected to become
+                 present simultaneously in a hash table, resulting in a
+                 speedup by avoiding unnecessary growth steps of a hash
+                 table; 0 if a positive value is not specified and all growth
+                 steps are to be completed
+   alpha_n     : > 0 numerator of load factor upper bound
+   log_alpha_d : < CHAR_BIT * sizeof(size_t) log base 2 of denominator of
+                 load factor upper bound; denominator is a power of two
+   cmp_key     : - if NULL then a default memcmp-based comparison of keys
+                 is performed
+                 - otherwise comparison function is applied which returns a
+                 zero integer value iff the two keys accessed through the
+                 first and the second arguments are equal; each argument is
+                 a pointer to a key_size block
+   rdc_key     : - if NULL then a default conversion of a bit pattern
+                 in the block pointed to by key is performed prior to
+                 hashing, which may introduce regularities
+                 - otherwise rdc_key is applied to a key prior to hashing;
+                 the first argument points to a key and the second argument
+                 provides the size of the key
+   free_elt    : - if an element is within a contiguous memory block and
+                 a copy of the element was inserted, then NULL as free_elt
+                 is sufficient to delete the element,
+                 - if an element is within a noncontiguous memory block or
+                 a pointer to a contiguous element was inserted, then an
+                 element-specific free_elt, taking a pointer to a pointer to an
+                 element as its argument and leaving a block of size elt_size
+                 pointed to by the argument, is necessary to delete the element
+*/
+void ht_divbkt_init(ht_divbkt_t *ht,
+		    size_t key_size,
+		    size_t elt_size,
+		    size_t min_num,
+		    size_t alpha_n,
+		    size_t log_alpha_d,
+		    int (*cmp_key)(const void *, const void *),
+		    size_t (*rdc_key)(const void *, size_t),
+		    void (*free_elt)(void *));
+
+/**
+   Aligns each in-table elt_size block to be accessible with a pointer to a
+   type T other than character (in addition to a character pointer). If
+   alignment requirement of T is unknown, the size of T can be used
+   as a value of the alignment parameter because size of T >= alignment
+   requirement of T (due to structure of arrays), which may result in
+   overalignment. The hash table keeps the effective type of a copied
+   elt_size block, if it had one at the time of insertion, and T must
+   be compatible with the type to comply with the strict aliasing rules.
+   T can be the same or a cvr-qualified/signed/unsigned version of the
+   type. The operation is optionally called after ht_divbkt_init is
+   completed and before any other operation is called.
+   ht            : pointer to an initialized ht_divbkt_t struct
+   elt_alignment : alignment requirement or size of the type, a pointer to
+                   which is used to access an elt_size block
+*/
+void ht_divbkt_align(ht_divbkt_t *ht, size_t elt_alignment);
+
+/**
+   Inserts a key and an associated element into a hash table. If the key is
+   in the hash table, associates the key with the new element. The key and
+   elt parameters are not NULL and point to blocks of size key_size and
+   elt_size respectively.
+*/
+void ht_divbkt_insert(ht_divbkt_t *ht, const void *key, const void *elt);
+
+/**
+   If a key is present in a hash table, returns a pointer to its associated
+   element, otherwise returns NULL. The key parameter is not NULL and points
+   to a block of size key_size. The returned pointer can be dereferenced
+   according to ht_divbkt_init and ht_divbkt_align, and is valid until the
+   next insert, remove, or delete operation.
+*/
+void *ht_divbkt_search(const ht_divbkt_t *ht, const void *key);
+
+/**
+   Removes a key and its associated element from a hash table by copying
+   the element or its pointer into a block of size elt_size pointed to
+   by elt. If the key is not in the hash table, leaves the block pointed
+   to by elt unchanged. The key and elt parameters are not NULL and point
+   to blocks of size key_size and elt_size respectively.
+*/
+void ht_divbkt_remove(ht_divbkt_t *ht, const void *key, void *elt);
+
+/**
+   If a key is in a hash table, deletes the key and its associated element
+   according to free_elt. The key parameter is not NULL and points
+   to a block of size key_size.
+*/
+void ht_divbkt_delete(ht_divbkt_t *ht, const void *key);
+
+/**
+   Frees a hash table and leaves a block of size sizeof(ht_divbkt_t)
+   pointed to by the ht parameter.
+*/
+void ht_divbkt_free(ht_divbkt_t *ht);
+
+/**
+   Help construct a hash table parameter value in algorithms and data
+   structures with a hash table parameter, complying with the stict aliasing
+   rules and compatibility rules for function types. In each case, a
+   (qualified) ht_divbkt_t *p0 is converted to (qualified) void * and back
+   to a (qualified) ht_divbkt_t *p1, thus guaranteeing that the value of p0
+   equals the value of p1.
+*/
+
+void ht_divbkt_init_helper(void *ht,
+			   size_t key_size,
+			   size_t elt_size,
+			   size_t min_num,
+			   size_t alpha_n,
+			   size_t log_alpha_d,
+			   int (*cmp_key)(const void *, const void *),
+			   size_t (*rdc_key)(const void *, size_t),
+			   void (*free_elt)(void *));
+
+void ht_divbkt_align_helper(void *ht, size_t elt_alignment);
+
+void ht_divbkt_insert_helper(void *ht, const void *key, const void *elt);
+
+void *ht_divbkt_search_helper(const void *ht, const void *key);
+
+void ht_divbkt_remove_helper(void *ht, const void *key, void *elt);
+
+void ht_divbkt_delete_helper(void *ht, const void *key);
+
+void ht_divbkt_free_helper(void *ht);
+
+#endif
@@ -19,12 +19,24 @@
       [0, 1] : on/off insert search uint_ptr test
       [0, 1] : on/off remove delete uint_ptr test
       [0, 1] : on/off corner cases test
+      [0, 1] : on/off batch hashed uint test
+      [0, 1] : on/off incr uint test
+      [0, 1] : on/off shrink compact uint test
+      [0, 1] : on/off cursor export uint test
+      [0, 1] : on/off save load uint and long double test
+      [0, 1] : on/off stats uint test (if compiled with HT_DIVCHN_STATS)
 
    usage examples:
    ./ht-divchn-test
    ./ht-divchn-test 20
    ./ht-divchn-test 17 5 6
    ./ht-divchn-test 19 0 2 3000 4000 11 10
+   ./ht-divchn-test 19 0 2 3000 4000 11 10 0 0 0 0 0 1
+   ./ht-divchn-test 19 0 2 3000 4000 11 10 0 0 0 0 0 0 1
+   ./ht-divchn-test 19 0 2 3000 4000 11 10 0 0 0 0 0 0 0 1
+   ./ht-divchn-test 19 0 2 3000 4000 11 10 0 0 0 0 0 0 0 0 1
+   ./ht-divchn-test 19 0 2 3000 4000 11 10 0 0 0 0 0 0 0 0 0 1
+   ./ht-divchn-test 19 0 2 3000 4000 11 10 0 0 0 0 0 0 0 0 0 0 1
 
    ht-divchn-test can be run with any subset of command line arguments in the
    above-defined order. If the (i + 1)th argument is specified then the ith
@@ -67,14 +79,22 @@ const char *C_USAGE =
   "> 0 : c\n"
   "> 0 : d\n"
   "> 0 : e log base 2\n"
-  "> 0 : f s.t. c / 2**e <= alpha <= d / 2**e, in f steps\n"
-  "[0, 1] : on/off insert search uint test\n"
-  "[0, 1] : on/off remove delete uint test\n"
-  "[0, 1] : on/off insert search uint_ptr test\n"
-  "[0, 1] : on/off remove delete uint_ptr test\n"
-  "[0, 1] : on/off corner cases test\n";
-const int C_ARGC_MAX = 13;
-const size_t C_ARGS_DEF[12] = {14, 0, 2, 1024, 30720u, 11, 10, 1, 1, 1, 1, 1};
+  "> 0 : f s.t. c / 2**e <= alpha <= d / 2**e, in f steps\n";
+const char *C_USAGE_FLAGS =
+  "[0, 1] : insert search uint\n"
+  "[0, 1] : remove delete uint\n"
+  "[0, 1] : insert search uint_ptr\n"
+  "[0, 1] : remove delete uint_ptr\n"
+  "[0, 1] : corner cases\n"
+  "[0, 1] : batch hashed uint\n"
+  "[0, 1] : incr uint\n"
+  "[0, 1] : shrink compact uint\n"
+  "[0, 1] : cursor export uint\n"
+  "[0, 1] : save load uint, long double\n"
+  "[0, 1] : stats uint\n";
+const int C_ARGC_MAX = 19;
+const size_t C_ARGS_DEF[18] = {14, 0, 2, 1024, 30720u, 11, 10,
+			       1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
 const size_t C_SIZE_MAX = (size_t)-1;
 const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 
@@ -103,7 +123,66 @@ void remove_delete(size_t num_ins,
 		   void (*new_elt)(void *, size_t),
 		   size_t (*val_elt)(const void *),
 		   void (*free_elt)(void *));
+void batch(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+void incr(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  int is_incr,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void shrink(size_t num_ins,
+	    size_t key_size,
+	    size_t elt_size,
+	    size_t elt_alignment,
+	    size_t alpha_n,
+	    size_t log_alpha_d,
+	    void (*new_elt)(void *, size_t),
+	    size_t (*val_elt)(const void *),
+	    void (*free_elt)(void *));
+void iter(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void save_load(size_t num_ins,
+	       size_t key_size,
+	       size_t elt_size,
+	       size_t elt_alignment,
+	       size_t alpha_n,
+	       size_t log_alpha_d,
+	       void (*new_elt)(void *, size_t),
+	       size_t (*val_elt)(const void *),
+	       void (*free_elt)(void *));
+#ifdef HT_DIVCHN_STATS
+void stats(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+#endif
+void swap(void *a, void *b, size_t size);
 void *ptr(const void *block, size_t i, size_t size);
+void *read_image(FILE *file, size_t *size);
 void print_test_result(int res);
 
 /**
@@ -685,6 +764,1212 @@ void remove_delete(size_t num_ins,
   elts = NULL;
 }
 
+/**
+   Runs a test of the batch operations and the operations with hash tokens
+   on distinct keys and size_t elements across key sizes >= sizeof(size_t)
+   and load factor upper bounds. The operations are compared to the insert
+   and search operations on single keys with the same keys and elements.
+*/
+void run_batch_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_{insert, search}_{batch, hashed} test on "
+	   "distinct %lu-byte keys and size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      batch(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of the batch operations and the operations
+   with hash tokens. A first hash table is built and searched with single
+   key operations, a second hash table with batch operations, and a third
+   hash table with the operations with hash tokens computed prior to the
+   operations. The searches are performed in a random order of keys.
+*/
+
+void batch(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t val;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  unsigned char *nin_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  void **res_elts = NULL;
+  size_t *toks = NULL;
+  size_t *rnd_toks = NULL;
+  size_t *nin_toks = NULL;
+  ht_divchn_t ht;
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  nin_keys = malloc_perror(num_ins, key_size);
+  res_elts = malloc_perror(num_ins, sizeof(void *));
+  toks = malloc_perror(num_ins, sizeof(size_t));
+  rnd_toks = malloc_perror(num_ins, sizeof(size_t));
+  nin_toks = malloc_perror(num_ins, sizeof(size_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    key = ptr(nin_keys, i, key_size);
+    val = i + num_ins;
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &val, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  printf("\t\tsingle\n");
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  insert_keys_elts(&ht, keys, elts, num_ins, &res);
+  search_in_ht(&ht, rnd_keys, rnd_elts, num_ins, val_elt, &res);
+  search_nin_ht(&ht, nin_keys, num_ins, &res);
+  free_ht(&ht);
+  printf("\t\tbatch\n");
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  t = clock();
+  ht_divchn_insert_batch(&ht, keys, elts, num_ins);
+  t = clock() - t;
+  printf("\t\tinsert w/ growth time           "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  res *= (ht.num_elts == num_ins);
+  t = clock();
+  ht_divchn_search_batch(&ht, rnd_keys, num_ins, res_elts);
+  t = clock() - t;
+  printf("\t\tin ht search time:              "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  for (i = 0; i < num_ins; i++){
+    res *= (res_elts[i] != NULL &&
+	    val_elt(ptr(rnd_elts, i, elt_size)) == val_elt(res_elts[i]));
+  }
+  t = clock();
+  ht_divchn_search_batch(&ht, nin_keys, num_ins, res_elts);
+  t = clock() - t;
+  printf("\t\tnot in ht search time:          "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  for (i = 0; i < num_ins; i++){
+    res *= (res_elts[i] == NULL);
+  }
+  for (i = 0; i < num_ins; i++){
+    res *= (val_elt(ht_divchn_search(&ht, ptr(keys, i, key_size))) == i);
+  }
+  free_ht(&ht);
+  printf("\t\thashed\n");
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  for (i = 0; i < num_ins; i++){
+    toks[i] = ht_divchn_hash_key(&ht, ptr(keys, i, key_size));
+    rnd_toks[i] = ht_divchn_hash_key(&ht, ptr(rnd_keys, i, key_size));
+    nin_toks[i] = ht_divchn_hash_key(&ht, ptr(nin_keys, i, key_size));
+  }
+  t = clock();
+  for (i = 0; i < num_ins; i++){
+    ht_divchn_insert_hashed(&ht,
+			    ptr(keys, i, key_size),
+			    toks[i],
+			    ptr(elts, i, elt_size));
+  }
+  t = clock() - t;
+  printf("\t\tinsert w/ growth time           "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  res *= (ht.num_elts == num_ins);
+  t = clock();
+  for (i = 0; i < num_ins; i++){
+    res_elts[i] =
+      ht_divchn_search_hashed(&ht, ptr(rnd_keys, i, key_size), rnd_toks[i]);
+  }
+  t = clock() - t;
+  printf("\t\tin ht search time:              "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  for (i = 0; i < num_ins; i++){
+    res *= (res_elts[i] != NULL &&
+	    val_elt(ptr(rnd_elts, i, elt_size)) == val_elt(res_elts[i]));
+    res *= (ht_divchn_search_hashed(&ht,
+				    ptr(nin_keys, i, key_size),
+				    nin_toks[i]) == NULL);
+  }
+  for (i = 0; i < num_ins; i++){
+    ht_divchn_remove_hashed(&ht,
+			    ptr(rnd_keys, i, key_size),
+			    rnd_toks[i],
+			    &val);
+    res *= (val_elt(ptr(rnd_elts, i, elt_size)) == val_elt(&val));
+  }
+  res *= (ht.num_elts == 0);
+  free_ht(&ht);
+  printf("\t\tbatch hashed correctness:       ");
+  print_test_result(res);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  free(nin_keys);
+  free(res_elts);
+  free(toks);
+  free(rnd_toks);
+  free(nin_toks);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+  nin_keys = NULL;
+  res_elts = NULL;
+  toks = NULL;
+  rnd_toks = NULL;
+  nin_toks = NULL;
+}
+
+/**
+   Runs a test of the incremental mode of growth on distinct keys and
+   size_t elements across key sizes >= sizeof(size_t) and load factor upper
+   bounds. The maximal time of an insert operation, which includes the
+   time of a growth step in the default mode, is compared to the maximal
+   time of an insert operation in the incremental mode.
+*/
+void run_incr_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_incr test on distinct %lu-byte keys and "
+	   "size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      printf("\t\tgrowth in a single step\n");
+      incr(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   0,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      printf("\t\tincremental growth\n");
+      incr(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   1,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of the incremental mode of growth. Each
+   insert operation is timed, and after each insert operation a previously
+   inserted key is searched. Then the keys are updated, searched, removed
+   and deleted in a random order, with the operations interleaved with
+   the migration of keys in the incremental mode.
+*/
+void incr(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  int is_incr,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t val;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  unsigned char *nin_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  const void *elt = NULL;
+  ht_divchn_t ht;
+  clock_t t, t_op, t_max = 0;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  nin_keys = malloc_perror(num_ins, key_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    key = ptr(nin_keys, i, key_size);
+    val = i + num_ins;
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &val, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  ht_divchn_incr(&ht, is_incr);
+  t = clock();
+  for (i = 0; i < num_ins; i++){
+    t_op = clock();
+    ht_divchn_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+    t_op = clock() - t_op;
+    if (t_op > t_max) t_max = t_op;
+  }
+  t = clock() - t;
+  printf("\t\tinsert w/ growth time           "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  printf("\t\tmax insert time                 "
+	 "%.6f seconds\n", (float)t_max / CLOCKS_PER_SEC);
+  res *= (ht.num_elts == num_ins);
+  ht_divchn_free(&ht);
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  ht_divchn_incr(&ht, is_incr);
+  for (i = 0; i < num_ins; i++){
+    ht_divchn_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+    elt = ht_divchn_search(&ht, ptr(keys, i / 2, key_size));
+    res *= (elt != NULL && val_elt(elt) == i / 2);
+  }
+  for (i = 0; i < num_ins; i++){
+    ht_divchn_insert(&ht,
+		     ptr(rnd_keys, i, key_size),
+		     ptr(rnd_elts, i, elt_size));
+    elt = ht_divchn_search(&ht, ptr(rnd_keys, i, key_size));
+    res *= (elt != NULL &&
+	    val_elt(elt) == val_elt(ptr(rnd_elts, i, elt_size)));
+    res *= (ht_divchn_search(&ht, ptr(nin_keys, i, key_size)) == NULL);
+  }
+  res *= (ht.num_elts == num_ins);
+  for (i = 0; i < num_ins / 2; i++){
+    ht_divchn_remove(&ht, ptr(rnd_keys, i, key_size), &val);
+    res *= (val_elt(&val) == val_elt(ptr(rnd_elts, i, elt_size)));
+    res *= (ht_divchn_search(&ht, ptr(rnd_keys, i, key_size)) == NULL);
+  }
+  for (i = num_ins / 2; i < num_ins; i++){
+    ht_divchn_delete(&ht, ptr(rnd_keys, i, key_size));
+    res *= (ht_divchn_search(&ht, ptr(rnd_keys, i, key_size)) == NULL);
+  }
+  res *= (ht.num_elts == 0);
+  for (i = 0; i < ht.count; i++){
+    res *= (ht.key_elts[i] == NULL);
+  }
+  ht_divchn_free(&ht);
+  printf("\t\tincremental correctness:        ");
+  print_test_result(res);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  free(nin_keys);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+  nin_keys = NULL;
+}
+
+/**
+   Runs a test of shrinking and compaction in both modes of growth on
+   distinct keys and size_t elements across key sizes >= sizeof(size_t)
+   and load factor upper bounds.
+*/
+void run_shrink_uint_test(size_t log_ins,
+			  size_t log_key_start,
+			  size_t log_key_end,
+			  size_t alpha_n_start,
+			  size_t alpha_n_end,
+			  size_t log_alpha_d,
+			  size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_{remove, compact} shrinking test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      shrink(num_ins,
+	     key_size,
+	     elt_size,
+	     elt_alignment,
+	     alpha_n,
+	     log_alpha_d,
+	     new_uint,
+	     val_uint,
+	     NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of shrinking and compaction. All but
+   1/16 of the keys are removed in a random order, which shrinks the hash
+   table, and the remaining keys are searched before and after the hash
+   table is compacted. Then the keys are reinserted and deleted, which
+   returns the hash table to its count at initialization, including a
+   count set according to min_num.
+*/
+void shrink(size_t num_ins,
+	    size_t key_size,
+	    size_t elt_size,
+	    size_t elt_alignment,
+	    size_t alpha_n,
+	    size_t log_alpha_d,
+	    void (*new_elt)(void *, size_t),
+	    size_t (*val_elt)(const void *),
+	    void (*free_elt)(void *)){
+  int res = 1;
+  int is_incr;
+  size_t i, j;
+  size_t val;
+  size_t init_count, peak_count, min_num;
+  size_t num_rem = num_ins - num_ins / 16;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  const void *elt = NULL;
+  ht_divchn_t ht;
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  for (is_incr = 0; is_incr <= 1; is_incr++){
+    printf("\t\t%s\n",
+	   is_incr ? "incremental growth" : "growth in a single step");
+    for (min_num = 0; min_num <= num_ins; min_num += num_ins){
+      ht_divchn_init(&ht,
+		     key_size,
+		     elt_size,
+		     min_num,
+		     alpha_n,
+		     log_alpha_d,
+		     NULL,
+		     NULL,
+		     free_elt);
+      ht_divchn_align(&ht, elt_alignment);
+      ht_divchn_incr(&ht, is_incr);
+      init_count = ht.count;
+      for (i = 0; i < num_ins; i++){
+	ht_divchn_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+      }
+      peak_count = ht.count;
+      t = clock();
+      for (i = 0; i < num_rem; i++){
+	ht_divchn_remove(&ht, ptr(rnd_keys, i, key_size), &val);
+	res *= (val_elt(&val) == val_elt(ptr(rnd_elts, i, elt_size)));
+      }
+      t = clock() - t;
+      if (min_num == 0){
+	printf("\t\tremove w/ shrinking time        "
+	       "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+      }
+      res *= (ht.num_elts == num_ins - num_rem);
+      res *= (min_num > 0 || num_rem == 0 || peak_count == init_count ||
+	      ht.count < peak_count);
+      res *= (ht.count >= init_count);
+      t = clock();
+      ht_divchn_compact(&ht);
+      t = clock() - t;
+      if (min_num == 0){
+	printf("\t\tcompact time                    "
+	       "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+      }
+      res *= (ht.prev_key_elts == NULL &&
+	      ht.num_elts <= ht.max_num_elts &&
+	      ht.count >= init_count &&
+	      ht.count <= peak_count);
+      for (i = 0; i < num_ins; i++){
+	elt = ht_divchn_search(&ht, ptr(rnd_keys, i, key_size));
+	if (i < num_rem){
+	  res *= (elt == NULL);
+	}else{
+	  res *= (elt != NULL &&
+		  val_elt(elt) == val_elt(ptr(rnd_elts, i, elt_size)));
+	}
+      }
+      for (i = 0; i < num_rem; i++){
+	ht_divchn_insert(&ht,
+			 ptr(rnd_keys, i, key_size),
+			 ptr(rnd_elts, i, elt_size));
+      }
+      res *= (ht.num_elts == num_ins);
+      for (i = 0; i < num_ins; i++){
+	ht_divchn_delete(&ht, ptr(rnd_keys, i, key_size));
+      }
+      res *= (ht.num_elts == 0 && ht.count == init_count);
+      ht_divchn_free(&ht);
+    }
+  }
+  printf("\t\tshrink compact correctness:     ");
+  print_test_result(res);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+}
+
+/**
+   Runs a test of the cursor, foreach, and export operations in both modes
+   of growth on distinct keys and size_t elements across key sizes
+   >= sizeof(size_t) and load factor upper bounds.
+*/
+void run_iter_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_{next, foreach, export} test on distinct "
+	   "%lu-byte keys and size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      iter(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Accumulates the sum of the values of the visited elements and the
+   number of visited keys in the foreach test.
+*/
+typedef struct{
+  size_t sum;
+  size_t num;
+  size_t (*val_elt)(const void *);
+} visit_acc_t;
+
+void visit_acc(const void *key, void *elt, void *arg){
+  visit_acc_t *acc = arg;
+  acc->sum += acc->val_elt(elt);
+  acc->num++;
+  (void)key;
+}
+
+/**
+   Returns the distinct non-random sizeof(size_t)-sized block of a key.
+*/
+size_t key_id(const void *key, size_t key_size){
+  size_t id;
+  memcpy(&id, (const char *)key + key_size - sizeof(size_t), sizeof(size_t));
+  return id;
+}
+
+/**
+   Helper function for the test of the cursor, foreach, and export
+   operations. In the incremental mode, the insertion of keys stops after
+   the first half of the keys are inserted and a migration of keys is in
+   progress, if such a state is reached. Then 1/16 of the inserted keys
+   are removed. Each remaining key is required
+   to be enumerated exactly once, with its associated element.
+*/
+void iter(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  int is_incr;
+  size_t i, j, id;
+  size_t val, num, sum;
+  size_t num_put, num_rem;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *exp_keys = NULL;
+  unsigned char *seen = NULL;
+  void *elts = NULL;
+  void *exp_elts = NULL;
+  const void *cur_key = NULL;
+  void *elt = NULL;
+  visit_acc_t acc;
+  ht_divchn_cursor_t cur;
+  ht_divchn_t ht;
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  exp_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  exp_elts = malloc_perror(num_ins, elt_size);
+  seen = malloc_perror(num_ins, 1);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (is_incr = 0; is_incr <= 1; is_incr++){
+    printf("\t\t%s\n",
+	   is_incr ? "incremental growth" : "growth in a single step");
+    ht_divchn_init(&ht,
+		   key_size,
+		   elt_size,
+		   0,
+		   alpha_n,
+		   log_alpha_d,
+		   NULL,
+		   NULL,
+		   free_elt);
+    ht_divchn_align(&ht, elt_alignment);
+    ht_divchn_incr(&ht, is_incr);
+    num_put = 0;
+    while (num_put < num_ins &&
+	   !(num_put >= num_ins / 2 && ht.prev_key_elts != NULL)){
+      ht_divchn_insert(&ht,
+		       ptr(keys, num_put, key_size),
+		       ptr(elts, num_put, elt_size));
+      num_put++;
+    }
+    num_rem = num_put / 16;
+    for (i = 0; i < num_rem; i++){
+      ht_divchn_remove(&ht, ptr(keys, i, key_size), &val);
+    }
+    sum = 0;
+    for (i = num_rem; i < num_put; i++){
+      sum += i;
+    }
+    memset(seen, 0, num_ins);
+    num = 0;
+    t = clock();
+    ht_divchn_cursor_init(&cur);
+    while ((elt = ht_divchn_next(&ht, &cur, &cur_key)) != NULL){
+      id = key_id(cur_key, key_size);
+      res *= (id >= num_rem && id < num_put && !seen[id] &&
+	      val_elt(elt) == id);
+      if (id < num_ins) seen[id] = 1;
+      num++;
+    }
+    t = clock() - t;
+    printf("\t\tcursor time                     "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    res *= (num == num_put - num_rem);
+    acc.sum = 0;
+    acc.num = 0;
+    acc.val_elt = val_elt;
+    ht_divchn_foreach(&ht, visit_acc, &acc);
+    res *= (acc.num == num_put - num_rem && acc.sum == sum);
+    t = clock();
+    num = ht_divchn_export(&ht, exp_keys, exp_elts);
+    t = clock() - t;
+    printf("\t\texport time                     "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    res *= (num == num_put - num_rem);
+    memset(seen, 0, num_ins);
+    for (i = 0; i < num; i++){
+      id = key_id(ptr(exp_keys, i, key_size), key_size);
+      res *= (id >= num_rem && id < num_put && !seen[id] &&
+	      val_elt(ptr(exp_elts, i, elt_size)) == id &&
+	      memcmp(ptr(exp_keys, i, key_size),
+		     ptr(keys, id, key_size),
+		     key_size) == 0);
+      if (id < num_ins) seen[id] = 1;
+    }
+    res *= (ht_divchn_export(&ht, NULL, NULL) == num);
+    ht_divchn_free(&ht);
+  }
+  printf("\t\tcursor export correctness:      ");
+  print_test_result(res);
+  free(keys);
+  free(exp_keys);
+  free(elts);
+  free(exp_elts);
+  free(seen);
+  keys = NULL;
+  exp_keys = NULL;
+  elts = NULL;
+  exp_elts = NULL;
+  seen = NULL;
+}
+
+/**
+   Runs a test of saving a hash table into an image and loading the hash
+   table from the image on distinct keys and size_t elements across key
+   sizes >= sizeof(size_t) and load factor upper bounds.
+*/
+void run_save_load_uint_test(size_t log_ins,
+			     size_t log_key_start,
+			     size_t log_key_end,
+			     size_t alpha_n_start,
+			     size_t alpha_n_end,
+			     size_t log_alpha_d,
+			     size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_{save, load} test on distinct %lu-byte keys "
+	   "and size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      save_load(num_ins,
+		key_size,
+		elt_size,
+		elt_alignment,
+		alpha_n,
+		log_alpha_d,
+		new_uint,
+		val_uint,
+		NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Test saving and loading on distinct keys and long double elements that
+   are aligned according to an alignment greater than the alignment of
+   long double on most systems. The alignment of elements is required to
+   be preserved when the loaded hash table builds its chains and grows.
+*/
+
+void new_long_double(void *elt, size_t val){
+  long double *s = elt;
+  *s = val;
+}
+
+size_t val_long_double(const void *elt){
+  return *(long double *)elt;
+}
+
+/**
+   Runs a test of saving a hash table into an image and loading the hash
+   table from the image on distinct keys and long double elements aligned
+   according to 16 bytes, across key sizes >= sizeof(size_t) and load
+   factor upper bounds.
+*/
+void run_save_load_long_double_test(size_t log_ins,
+				    size_t log_key_start,
+				    size_t log_key_end,
+				    size_t alpha_n_start,
+				    size_t alpha_n_end,
+				    size_t log_alpha_d,
+				    size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(long double);
+  size_t elt_alignment = 16;
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_{save, load} test on distinct %lu-byte keys "
+	   "and long double elements aligned according to %lu bytes\n",
+	   TOLU(key_size), TOLU(elt_alignment));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      save_load(num_ins,
+		key_size,
+		elt_size,
+		elt_alignment,
+		alpha_n,
+		log_alpha_d,
+		new_long_double,
+		val_long_double,
+		NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of saving and loading. A quarter of the
+   keys are removed before the hash table is saved. The loaded hash table
+   is searched, enumerated, saved again into an identical image, and then
+   modified, which is required to leave the image unchanged. The
+   modification inserts the removed keys and num_ins new keys, growing the
+   loaded hash table, and is required to preserve the layout of nodes.
+*/
+void save_load(size_t num_ins,
+	       size_t key_size,
+	       size_t elt_size,
+	       size_t elt_alignment,
+	       size_t alpha_n,
+	       size_t log_alpha_d,
+	       void (*new_elt)(void *, size_t),
+	       size_t (*val_elt)(const void *),
+	       void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t val, num;
+  size_t num_rem = num_ins / 4;
+  size_t size, resave_size;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *image = NULL;
+  unsigned char *image_cpy = NULL;
+  unsigned char *resave_image = NULL;
+  void *elts = NULL;
+  void **found = NULL;
+  const void *cur_key = NULL;
+  const void *elt = NULL;
+  FILE *file = NULL;
+  ht_divchn_cursor_t cur;
+  ht_divchn_t ht, ld_ht;
+  clock_t t;
+  keys = malloc_perror(2 * num_ins, key_size);
+  elts = malloc_perror(2 * num_ins, elt_size);
+  found = malloc_perror(num_ins, sizeof(void *));
+  for (i = 0; i < 2 * num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  t = clock();
+  for (i = 0; i < num_ins; i++){
+    ht_divchn_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+  }
+  t = clock() - t;
+  printf("\t\tinsert w/ growth time           "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  for (i = 0; i < num_rem; i++){
+    ht_divchn_remove(&ht, ptr(keys, i, key_size), &val);
+  }
+  file = tmpfile();
+  if (file == NULL){
+    perror("tmpfile failed");
+    exit(EXIT_FAILURE);
+  }
+  t = clock();
+  ht_divchn_save(&ht, file);
+  t = clock() - t;
+  printf("\t\tsave time                       "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  image = read_image(file, &size);
+  fclose(file);
+  image_cpy = malloc_perror(size, 1);
+  memcpy(image_cpy, image, size);
+  t = clock();
+  ht_divchn_load(&ld_ht, image, size, NULL, NULL);
+  t = clock() - t;
+  printf("\t\tload time                       "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  res *= (ld_ht.num_elts == ht.num_elts && ld_ht.count == ht.count);
+  t = clock();
+  for (i = 0; i < num_ins; i++){
+    elt = ht_divchn_search(&ld_ht, ptr(keys, i, key_size));
+    if (i < num_rem){
+      res *= (elt == NULL);
+    }else{
+      res *= (elt != NULL && val_elt(elt) == i);
+    }
+  }
+  t = clock() - t;
+  printf("\t\tsearch in loaded ht time        "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  ht_divchn_search_batch(&ld_ht, keys, num_ins, found);
+  for (i = 0; i < num_ins; i++){
+    res *= (found[i] == ht_divchn_search(&ld_ht, ptr(keys, i, key_size)));
+  }
+  num = 0;
+  ht_divchn_cursor_init(&cur);
+  while ((elt = ht_divchn_next(&ld_ht, &cur, &cur_key)) != NULL){
+    res *= (ht_divchn_search(&ht, cur_key) != NULL &&
+	    val_elt(ht_divchn_search(&ht, cur_key)) == val_elt(elt));
+    num++;
+  }
+  res *= (num == ld_ht.num_elts);
+  res *= (ht_divchn_export(&ld_ht, NULL, NULL) == ld_ht.num_elts);
+  file = tmpfile();
+  if (file == NULL){
+    perror("tmpfile failed");
+    exit(EXIT_FAILURE);
+  }
+  ht_divchn_save(&ld_ht, file);
+  resave_image = read_image(file, &resave_size);
+  fclose(file);
+  res *= (resave_size == size && memcmp(resave_image, image, size) == 0);
+  for (i = 0; i < 2 * num_ins; i++){
+    if (i < num_rem || i >= num_ins){
+      ht_divchn_insert(&ld_ht,
+		       ptr(keys, i, key_size),
+		       ptr(elts, i, elt_size));
+    }
+  }
+  for (i = 0; i < 2 * num_ins; i++){
+    elt = ht_divchn_search(&ld_ht, ptr(keys, i, key_size));
+    res *= (elt != NULL && val_elt(elt) == i);
+  }
+  res *= (ld_ht.num_elts == 2 * num_ins);
+  res *= (ld_ht.ll->key_offset == ht.ll->key_offset &&
+	  ld_ht.ll->elt_offset == ht.ll->elt_offset);
+  res *= (memcmp(image, image_cpy, size) == 0);
+  printf("\t\tsave load correctness:          ");
+  print_test_result(res);
+  ht_divchn_free(&ld_ht);
+  ht_divchn_free(&ht);
+  free(keys);
+  free(elts);
+  free(found);
+  free(image);
+  free(image_cpy);
+  free(resave_image);
+  keys = NULL;
+  elts = NULL;
+  found = NULL;
+  image = NULL;
+  image_cpy = NULL;
+  resave_image = NULL;
+}
+
+/**
+   Runs a test of the statistics of a hash table on distinct keys and
+   size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds. The test is compiled if HT_DIVCHN_STATS is defined.
+*/
+#ifdef HT_DIVCHN_STATS
+void run_stats_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_divchn_stats test on distinct %lu-byte keys and "
+	   "size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      stats(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of statistics. Inserts num_ins keys,
+   searches the keys and num_ins keys that are not in the hash table,
+   removes half of the keys, and compares the statistics with the hash
+   table.
+*/
+void stats(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t val;
+  size_t num_rem = num_ins / 2;
+  size_t num_slots = 0, num_keys = 0;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  ht_divchn_t ht;
+  ht_divchn_stats_t st;
+  keys = malloc_perror(2 * num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < 2 * num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    if (i < num_ins) new_elt(ptr(elts, i, elt_size), i);
+  }
+  ht_divchn_init(&ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 alpha_n,
+		 log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+  ht_divchn_align(&ht, elt_alignment);
+  for (i = 0; i < num_ins; i++){
+    ht_divchn_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+  }
+  for (i = 0; i < 2 * num_ins; i++){
+    res *= ((ht_divchn_search(&ht, ptr(keys, i, key_size)) != NULL) ==
+	    (i < num_ins));
+  }
+  for (i = 0; i < num_rem; i++){
+    ht_divchn_remove(&ht, ptr(keys, i, key_size), &val);
+    res *= (val_elt(&val) == i);
+  }
+  ht_divchn_stats(&ht, &st);
+  printf("\t\tchain length histogram:         ");
+  for (i = 0; i < HT_DIVCHN_STATS_BINS; i++){
+    printf("%lu ", TOLU(st.chain_hist[i]));
+    num_slots += st.chain_hist[i];
+    num_keys += i * st.chain_hist[i];
+  }
+  printf("\n");
+  printf("\t\tmax chain length:               %lu\n",
+	 TOLU(st.max_chain_len));
+  printf("\t\tgrows, shrinks:                 %lu, %lu\n",
+	 TOLU(st.num_grows), TOLU(st.num_shrinks));
+  printf("\t\trehash time, max:               %.4f, %.4f seconds\n",
+	 (float)st.rehash_time / CLOCKS_PER_SEC,
+	 (float)st.max_rehash_time / CLOCKS_PER_SEC);
+  printf("\t\tallocated bytes:                %lu\n", TOLU(st.num_bytes));
+  res *= (num_slots == ht.count);
+  res *= (st.max_chain_len >= HT_DIVCHN_STATS_BINS - 1 ?
+	  num_keys <= ht.num_elts :
+	  num_keys == ht.num_elts);
+  res *= (st.num_elts == num_ins - num_rem && st.count == ht.count);
+  res *= (st.num_grows > 0 || ht.count_ix == ht.min_count_ix);
+  res *= (st.num_bytes >= ht.count * sizeof(void *));
+  printf("\t\tstats correctness:              ");
+  print_test_result(res);
+  ht_divchn_free(&ht);
+  free(keys);
+  free(elts);
+  keys = NULL;
+  elts = NULL;
+}
+#endif
+
 /**
    Runs a corner cases test.
 */
@@ -740,13 +2025,45 @@ void run_corner_cases_test(size_t log_ins){
    Helper functions.
 */
 
-/**
-   Computes a pointer to the ith element in the block of elements.
-*/
+void swap(void *a, void *b, size_t size){
+  size_t i;
+  unsigned char c;
+  unsigned char *p = a;
+  unsigned char *q = b;
+  for (i = 0; i < size; i++){
+    c = p[i];
+    p[i] = q[i];
+    q[i] = c;
+  }
+}
+
 void *ptr(const void *block, size_t i, size_t size){
   return (void *)((char *)block + i * size);
 }
 
+/**
+   Reads the content of a binary stream, from its start to its current
+   position, into an allocated block, and returns a pointer to the block.
+   The size of the block is copied into the block pointed to by size.
+*/
+void *read_image(FILE *file, size_t *size){
+  long end;
+  void *image = NULL;
+  end = ftell(file);
+  if (end < 0){
+    perror("ftell failed");
+    exit(EXIT_FAILURE);
+  }
+  *size = end;
+  image = malloc_perror(*size + (*size == 0), 1);
+  rewind(file);
+  if (fread(image, 1, *size, file) != *size){
+    perror("fread failed");
+    exit(EXIT_FAILURE);
+  }
+  return image;
+}
+
 /**
    Prints a test result.
 */
@@ -763,7 +2080,7 @@ int main(int argc, char *argv[]){
   size_t *args = NULL;
   RGENS_SEED();
   if (argc > C_ARGC_MAX){
-    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+    fprintf(stderr, "USAGE:\n%s%s", C_USAGE, C_USAGE_FLAGS);
     exit(EXIT_FAILURE);
   }
   args = malloc_perror(C_ARGC_MAX - 1, sizeof(size_t));
@@ -780,12 +2097,18 @@ int main(int argc, char *argv[]){
       args[5] > C_FULL_BIT - 1 ||
       args[3] > args[4] ||
       args[6] < 1 ||
-      args[7] < 1 ||
+      args[7] > 1 ||
       args[8] > 1 ||
       args[9] > 1 ||
       args[10] > 1 ||
-      args[11] > 1){
-    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+      args[11] > 1 ||
+      args[12] > 1 ||
+      args[13] > 1 ||
+      args[14] > 1 ||
+      args[15] > 1 ||
+      args[16] > 1 ||
+      args[17] > 1){
+    fprintf(stderr, "USAGE:\n%s%s", C_USAGE, C_USAGE_FLAGS);
     exit(EXIT_FAILURE);
   };
   if (args[7]) run_insert_search_free_uint_test(args[0],
@@ -817,6 +2140,59 @@ int main(int argc, char *argv[]){
 						args[5],
 						args[6]);
   if (args[11]) run_corner_cases_test(args[0]);
+  if (args[12]) run_batch_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6]);
+  if (args[13]) run_incr_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6]);
+  if (args[14]) run_shrink_uint_test(args[0],
+				     args[1],
+				     args[2],
+				     args[3],
+				     args[4],
+				     args[5],
+				     args[6]);
+  if (args[15]) run_iter_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6]);
+  if (args[16]){
+    run_save_load_uint_test(args[0],
+			    args[1],
+			    args[2],
+			    args[3],
+			    args[4],
+			    args[5],
+			    args[6]);
+    run_save_load_long_double_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6]);
+  }
+#ifdef HT_DIVCHN_STATS
+  if (args[17]) run_stats_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6]);
+#endif
   free(args);
   args = NULL;
   return 0;
@@ -14,6 +14,53 @@
    alpha parameter. The alpha parameter does not provide an upper bound 
    after the maximum count of slots in a hash table is reached.
 
+   A hash table shrinks if, after a remove or delete operation, the
+   number of keys is less than a quarter of the number of keys allowed by
+   alpha, and the count is greater than the count set at initialization.
+   After shrinking, the load factor is at most half of alpha. The
+   ht_divchn_compact operation shrinks a hash table to the smallest count
+   with a load factor not exceeding alpha.
+
+   A hash table grows in a single step by default, which moves all keys
+   in one operation. In the optional incremental mode of growth, the
+   previous slots are kept next to the new slots after a growth step, and
+   each subsequent insert, remove, or delete operation moves the keys of
+   a bounded number of previous slots, until all keys are moved. A search
+   during the migration of keys checks the new slot and then the
+   previous slot of a key.
+
+   The keys of a hash table are enumerated with a cursor, with a foreach
+   operation, or are copied with their elements into contiguous arrays
+   with an export operation. The order of enumeration is the order of
+   slots, with the previous slots first during the migration of keys.
+
+   A hash table is saved into a relocatable binary image with
+   ht_divchn_save. The image contains a header, the offsets of the chains,
+   and the keys and elements of the chains packed in the order of slots,
+   and contains no pointers. A hash table is loaded from an image in
+   memory, e.g. a memory-mapped file, with ht_divchn_load without rehashing
+   and without an allocation per key. A search in a loaded hash table
+   scans a contiguous range of keys in the image, which is not written,
+   until the first modifying operation builds the chains of the hash table
+   from the image.
+
+   The nodes of the chains are allocated from a slab allocator of the
+   hash table, which allocates the nodes in slabs of upto
+   C_SLAB_MAX_NUM_NODES nodes, reuses the nodes of removed and deleted
+   keys, and releases the slabs in bulk when the hash table is freed,
+   without visiting the nodes if the elements do not require free_elt.
+
+   The slot of a key is computed without a division instruction. When the
+   count of a hash table changes, a multiplier and shifts are precomputed
+   with mod_rcp_init, and the remainder of a standard key modulo the count
+   is computed with a high product, a subtraction, and shifts.
+
+   If HT_DIVCHN_STATS is defined at compile time, a hash table maintains
+   statistics that are read with ht_divchn_stats, including the
+   distribution of chain lengths, the growth and shrinking events and
+   their processor times, and the number of allocated bytes. Otherwise,
+   the statistics and their instrumentation are not compiled.
+
    A hash key is an object within a contiguous block of memory (e.g. a basic 
    type, array, struct). An element is within a contiguous or noncontiguous
    memory block.
@@ -116,11 +163,73 @@ static const size_t C_BUILD_SHIFT = 16;
 static const size_t C_BYTE_BIT = CHAR_BIT;
 static const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 static const size_t C_SIZE_MAX = (size_t)-1;
+static const size_t C_SHRINK_DIV = 4; /* shrink if num_elts < max / 4 */
+static const size_t C_SLAB_MAX_NUM_NODES = 4096;
+#define C_BATCH_SIZE 16 /* number of keys hashed and prefetched at a time */
+
+/* image header: an array of C_IMAGE_NUM_FIELDS size_t values, followed by
+   count + 1 chain offsets and the entries at IMG_ENTRIES_OFFSET */
+enum{IMG_MAGIC,
+     IMG_SIZE_T_SIZE,
+     IMG_KEY_SIZE,
+     IMG_ELT_SIZE,
+     IMG_ELT_ALIGNMENT,
+     IMG_ELT_OFFSET,
+     IMG_ENTRY_SIZE,
+     IMG_GROUP_IX,
+     IMG_COUNT_IX,
+     IMG_MIN_GROUP_IX,
+     IMG_MIN_COUNT_IX,
+     IMG_COUNT,
+     IMG_MAX_NUM_ELTS,
+     IMG_NUM_ELTS,
+     IMG_ALPHA_N,
+     IMG_LOG_ALPHA_D,
+     IMG_ENTRIES_OFFSET,
+     C_IMAGE_NUM_FIELDS};
+static const size_t C_IMAGE_MAGIC = 0x4443; /* detects byte order */
 
+static size_t convert_std_key(const ht_divchn_t *ht, const void *key);
 static size_t hash(const ht_divchn_t *ht, const void *key);
+static dll_node_t *search_node(const ht_divchn_t *ht,
+			       const void *key,
+			       size_t std_key,
+			       dll_node_t ***head);
+static void insert(ht_divchn_t *ht,
+		   const void *key,
+		   size_t std_key,
+		   const void *elt);
+static void prefetch_head(const ht_divchn_t *ht, size_t ix);
+static void remove_key(ht_divchn_t *ht,
+		       const void *key,
+		       size_t std_key,
+		       void *elt);
+static void delete_key(ht_divchn_t *ht, const void *key, size_t std_key);
+static void *search_image(const ht_divchn_t *ht,
+			  const void *key,
+			  size_t std_key);
+static void own_image(ht_divchn_t *ht);
+static void entry_layout(const ht_divchn_t *ht,
+			 size_t *elt_offset,
+			 size_t *entry_size);
+static void write_perror(const void *ptr, size_t size, FILE *file);
+static int is_image_layout(const size_t *hdr);
+static int is_image_offsets(const size_t *offsets,
+			    size_t count,
+			    size_t num_elts);
+#ifdef HT_DIVCHN_STATS
+static void stats_init(ht_divchn_t *ht);
+static void stats_chain(ht_divchn_stats_t *stats, size_t len);
+static void stats_rehash(ht_divchn_t *ht, size_t prev_count, clock_t t);
+#endif
 static size_t mul_alpha_sz_max(size_t n, size_t alpha_n, size_t log_alpha_d);
 static void ht_grow(ht_divchn_t *ht);
+static void ht_shrink(ht_divchn_t *ht, size_t num);
+static void rehash(ht_divchn_t *ht, size_t prev_count, int is_incr);
+static void migrate(ht_divchn_t *ht, size_t num_slots);
 static int incr_count(ht_divchn_t *ht);
+static const dll_node_t *cursor_head(const ht_divchn_t *ht, size_t ix);
+static void reset_count(ht_divchn_t *ht);
 static int is_overflow(size_t start, size_t count);
 static size_t build_prime(size_t start, size_t count);
 
@@ -180,9 +289,12 @@ void ht_divchn_init(ht_divchn_t *ht,
   ht->group_ix = 0;
   ht->count_ix = 0;
   ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+  mod_rcp_init(&ht->count_rcp, ht->count);
   /* 0 <= max_num_elts */
   ht->max_num_elts = mul_alpha_sz_max(ht->count, alpha_n, log_alpha_d);
   while (min_num > ht->max_num_elts && incr_count(ht));
+  ht->min_group_ix = ht->group_ix;
+  ht->min_count_ix = ht->count_ix;
   ht->num_elts = 0;
   ht->alpha_n = alpha_n;
   ht->log_alpha_d = log_alpha_d;
@@ -191,6 +303,20 @@ void ht_divchn_init(ht_divchn_t *ht,
   for (i = 0; i < ht->count; i++){
     dll_init(ht->ll, &ht->key_elts[i], ht->key_size);
   }
+  ht->slab = malloc_perror(1, sizeof(dll_slab_t));
+  dll_slab_init(ht->slab, ht->ll, ht->elt_size, C_SLAB_MAX_NUM_NODES);
+  ht->is_incr = 0;
+  ht->prev_count = 0;
+  ht->mig_ix = 0;
+  ht->mig_step = 0;
+  ht->prev_key_elts = NULL;
+  ht->img_offsets = NULL;
+  ht->img_entries = NULL;
+  ht->img_entry_size = 0;
+  ht->img_elt_offset = 0;
+#ifdef HT_DIVCHN_STATS
+  stats_init(ht);
+#endif
   ht->cmp_key = cmp_key;
   ht->rdc_key = rdc_key;
   ht->free_elt = free_elt;
@@ -215,6 +341,25 @@ void ht_divchn_init(ht_divchn_t *ht,
 void ht_divchn_align(ht_divchn_t *ht, size_t elt_alignment){
   ht->elt_alignment = elt_alignment;
   dll_align_elt(ht->ll, elt_alignment);
+  dll_slab_init(ht->slab, ht->ll, ht->elt_size, C_SLAB_MAX_NUM_NODES);
+}
+
+/**
+   Sets the mode of growth of a hash table. In the incremental mode, a
+   growth step allocates the new slots, and the keys in the previous slots
+   are moved by the subsequent insert, remove, and delete operations, each
+   moving the keys of a bounded number of previous slots. The number of
+   previous slots migrated per operation is set at each growth step s.t.
+   the migration is completed before the next growth step is due. As a
+   result, no single insert operation moves all keys of a hash table. The
+   operation is optionally called after ht_divchn_init is completed and
+   before any operation other than ht_divchn_align is called.
+   ht          : pointer to an initialized ht_divchn_t struct
+   is_incr     : non-zero to set the incremental mode, zero to set the
+                 default mode of growth in a single step
+*/
+void ht_divchn_incr(ht_divchn_t *ht, int is_incr){
+  ht->is_incr = is_incr;
 }
 
 /**
@@ -224,23 +369,43 @@ void ht_divchn_align(ht_divchn_t *ht, size_t elt_alignment){
    elt_size respectively.
 */
 void ht_divchn_insert(ht_divchn_t *ht, const void *key, const void *elt){
-  size_t ix;
-  dll_node_t **head = NULL, *node = NULL;
-  ix = hash(ht, key);
-  head = &ht->key_elts[ix];
-  node = dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
-  if (node == NULL){
-    dll_prepend_new(ht->ll, head, key, elt, ht->key_size, ht->elt_size);
-    ht->num_elts++;
-  }else{
-    if (ht->free_elt != NULL) ht->free_elt(dll_elt_ptr(ht->ll, node));
-    memcpy(dll_elt_ptr(ht->ll, node), elt, ht->elt_size);
-  }
-  /* grow ht after ensuring it was insertion, not update */
-  if (ht->num_elts > ht->max_num_elts && 
-      ht->count_ix != C_SIZE_MAX &&
-      ht->count_ix != C_PRIME_PARTS_COUNT){
-    ht_grow(ht);
+  insert(ht, key, convert_std_key(ht, key), elt);
+}
+
+/**
+   Inserts a batch of keys and associated elements into a hash table, with
+   the same result as calling ht_divchn_insert on each key and element in
+   the order of the batch. The keys are hashed in groups, the chain heads
+   of a group and then the first nodes of the chains are prefetched, and
+   then the keys of the group are inserted, overlapping the cache misses
+   of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   elts        : pointer to num_keys contiguous blocks of size elt_size
+   num_keys    : number of keys in the batch
+*/
+void ht_divchn_insert_batch(ht_divchn_t *ht,
+			    const void *keys,
+			    const void *elts,
+			    size_t num_keys){
+  size_t i, j, n;
+  size_t std_keys[C_BATCH_SIZE], ixs[C_BATCH_SIZE];
+  const char *k = keys, *e = elts;
+  own_image(ht);
+  for (i = 0; i < num_keys; i += n){
+    n = (num_keys - i < C_BATCH_SIZE) ? num_keys - i : C_BATCH_SIZE;
+    for (j = 0; j < n; j++){
+      std_keys[j] = convert_std_key(ht, k + j * ht->key_size);
+      ixs[j] = rcp_mod(std_keys[j], &ht->count_rcp);
+      PREFETCH(&ht->key_elts[ixs[j]]);
+    }
+    for (j = 0; j < n; j++){
+      prefetch_head(ht, ixs[j]);
+    }
+    for (j = 0; j < n; j++){
+      insert(ht, k, std_keys[j], e);
+      k += ht->key_size;
+      e += ht->elt_size;
+    }
   }
 }
 
@@ -251,11 +416,12 @@ void ht_divchn_insert(ht_divchn_t *ht, const void *key, const void *elt){
    according to ht_divchn_init and ht_divchn_align_elt.
 */
 void *ht_divchn_search(const ht_divchn_t *ht, const void *key){
-  const dll_node_t *node = dll_search_key(ht->ll,
-					  &ht->key_elts[hash(ht, key)],
-					  key,
-					  ht->key_size,
-					  ht->cmp_key);
+  dll_node_t **head = NULL;
+  const dll_node_t *node = NULL;
+  if (ht->img_offsets != NULL){
+    return search_image(ht, key, convert_std_key(ht, key));
+  }
+  node = search_node(ht, key, convert_std_key(ht, key), &head);
   if (node == NULL){
     return NULL;
   }else{
@@ -263,6 +429,51 @@ void *ht_divchn_search(const ht_divchn_t *ht, const void *key){
   }
 }
 
+/**
+   Searches a batch of keys in a hash table. The keys are hashed in groups,
+   the chain heads of a group and then the first nodes of the chains are
+   prefetched, and then the keys of the group are searched, overlapping
+   the cache misses of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   num_keys    : number of keys in the batch
+   elts        : pointer to a preallocated array of num_keys pointers; the
+                 ith pointer is set to the value returned by
+                 ht_divchn_search on the ith key
+*/
+void ht_divchn_search_batch(const ht_divchn_t *ht,
+			    const void *keys,
+			    size_t num_keys,
+			    void **elts){
+  size_t i, j, n;
+  size_t std_keys[C_BATCH_SIZE], ixs[C_BATCH_SIZE];
+  const char *k = keys;
+  dll_node_t **head = NULL;
+  const dll_node_t *node = NULL;
+  if (ht->img_offsets != NULL){
+    for (i = 0; i < num_keys; i++){
+      elts[i] = search_image(ht, k, convert_std_key(ht, k));
+      k += ht->key_size;
+    }
+    return;
+  }
+  for (i = 0; i < num_keys; i += n){
+    n = (num_keys - i < C_BATCH_SIZE) ? num_keys - i : C_BATCH_SIZE;
+    for (j = 0; j < n; j++){
+      std_keys[j] = convert_std_key(ht, k + j * ht->key_size);
+      ixs[j] = rcp_mod(std_keys[j], &ht->count_rcp);
+      PREFETCH(&ht->key_elts[ixs[j]]);
+    }
+    for (j = 0; j < n; j++){
+      prefetch_head(ht, ixs[j]);
+    }
+    for (j = 0; j < n; j++){
+      node = search_node(ht, k, std_keys[j], &head);
+      elts[i + j] = (node == NULL) ? NULL : dll_elt_ptr(ht->ll, node);
+      k += ht->key_size;
+    }
+  }
+}
+
 /**
    Removes a key and its associated element from a hash table by copying 
    the element or its pointer into a block of size elt_size pointed to
@@ -271,15 +482,7 @@ void *ht_divchn_search(const ht_divchn_t *ht, const void *key){
    to blocks of size key_size and elt_size respectively.
 */
 void ht_divchn_remove(ht_divchn_t *ht, const void *key, void *elt){
-  dll_node_t **head = &ht->key_elts[hash(ht, key)];
-  dll_node_t *node =
-    dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
-  if (node != NULL){
-    memcpy(elt, dll_elt_ptr(ht->ll, node), ht->elt_size);
-    /* if an element is noncontiguous, only the pointer to it is deleted */
-    dll_delete(ht->ll, head, node, NULL);
-    ht->num_elts--;
-  }
+  remove_key(ht, key, convert_std_key(ht, key), elt);
 }
 
 /**
@@ -288,28 +491,424 @@ void ht_divchn_remove(ht_divchn_t *ht, const void *key, void *elt){
    to a block of size key_size.
 */
 void ht_divchn_delete(ht_divchn_t *ht, const void *key){
-  dll_node_t **head = &ht->key_elts[hash(ht, key)];
-  dll_node_t *node =
-    dll_search_key(ht->ll, head, key, ht->key_size, ht->cmp_key);
-  if (node != NULL){
-    dll_delete(ht->ll, head, node, ht->free_elt);
-    ht->num_elts--;
+  delete_key(ht, key, convert_std_key(ht, key));
+}
+
+/**
+   Computes the hash token of a key. The hash token of a key depends only
+   on the key and the hash table parameters set at initialization, and is
+   valid throughout the lifetime of the hash table, including across its
+   growth. A hash token can be stored by the caller next to the key and
+   passed to the *_hashed operations in order to avoid reducing the key
+   in each operation. The key parameter is not NULL and points to a block
+   of size key_size.
+*/
+size_t ht_divchn_hash_key(const ht_divchn_t *ht, const void *key){
+  return convert_std_key(ht, key);
+}
+
+/**
+   Perform the insert, search, remove, and delete operations with a hash
+   token of a key computed by ht_divchn_hash_key on the same hash table.
+   The result is the same as the result of the corresponding operation
+   without a hash token. The key, elt parameters are as in the
+   corresponding operations.
+*/
+
+void ht_divchn_insert_hashed(ht_divchn_t *ht,
+			     const void *key,
+			     size_t tok,
+			     const void *elt){
+  insert(ht, key, tok, elt);
+}
+
+void *ht_divchn_search_hashed(const ht_divchn_t *ht,
+			      const void *key,
+			      size_t tok){
+  dll_node_t **head = NULL;
+  const dll_node_t *node = NULL;
+  if (ht->img_offsets != NULL) return search_image(ht, key, tok);
+  node = search_node(ht, key, tok, &head);
+  if (node == NULL){
+    return NULL;
+  }else{
+    return dll_elt_ptr(ht->ll, node);
+  }
+}
+
+void ht_divchn_remove_hashed(ht_divchn_t *ht,
+			     const void *key,
+			     size_t tok,
+			     void *elt){
+  remove_key(ht, key, tok, elt);
+}
+
+void ht_divchn_delete_hashed(ht_divchn_t *ht, const void *key, size_t tok){
+  delete_key(ht, key, tok);
+}
+
+/**
+   Compacts a hash table by decreasing its count to the smallest prime
+   number in the C_PRIME_PARTS array that accomodates alpha as a load
+   factor upper bound with the current number of keys, without decreasing
+   the count below the count set at initialization according to min_num.
+   The keys are moved in a single step in both modes of growth. The
+   operation can be called between any two operations, e.g. after a large
+   number of keys were removed from a hash table that is reused, in order
+   to release memory.
+   ht          : pointer to an initialized ht_divchn_t struct
+*/
+void ht_divchn_compact(ht_divchn_t *ht){
+  own_image(ht);
+  ht_shrink(ht, ht->num_elts);
+}
+
+/**
+   Initializes a cursor for enumerating the keys in a hash table with
+   ht_divchn_next. A cursor is valid until the hash table is modified.
+*/
+void ht_divchn_cursor_init(ht_divchn_cursor_t *cur){
+  cur->ix = 0;
+  cur->node = NULL;
+}
+
+/**
+   Advances a cursor to the next key in a hash table. Returns a pointer to
+   the element associated with the key and sets the pointer pointed to by
+   key to point to the in-table key, or returns NULL if all keys were
+   enumerated. The returned pointer can be dereferenced according to
+   ht_divchn_init and ht_divchn_align.
+   ht          : pointer to an initialized ht_divchn_t struct that was not
+                 modified after the cursor was initialized
+   cur         : pointer to a cursor initialized with ht_divchn_cursor_init
+   key         : pointer to a pointer that is set to point to a key_size
+                 block
+*/
+void *ht_divchn_next(const ht_divchn_t *ht,
+		     ht_divchn_cursor_t *cur,
+		     const void **key){
+  size_t num_slots = ht->count;
+  const unsigned char *entry = NULL;
+  const dll_node_t *node = NULL;
+  if (ht->img_offsets != NULL){
+    if (cur->ix == ht->num_elts) return NULL;
+    entry = ht->img_entries + cur->ix * ht->img_entry_size;
+    cur->ix++;
+    *key = entry;
+    return (void *)(entry + ht->img_elt_offset);
+  }
+  if (ht->prev_key_elts != NULL) num_slots += ht->prev_count;
+  while (cur->node == NULL){
+    if (cur->ix == num_slots) return NULL;
+    cur->node = cursor_head(ht, cur->ix);
+    cur->ix++;
   }
+  node = cur->node;
+  cur->node = node->next;
+  if (cur->node == cursor_head(ht, cur->ix - 1)) cur->node = NULL;
+  *key = dll_key_ptr(ht->ll, node);
+  return dll_elt_ptr(ht->ll, node);
 }
 
+/**
+   Calls a visit function on each key in a hash table and its associated
+   element. The first argument of visit points to a key_size block, the
+   second argument points to an elt_size block that can be dereferenced
+   according to ht_divchn_init and ht_divchn_align, and the third argument
+   is the arg parameter. The visit function does not modify the hash
+   table, except through the second argument.
+*/
+void ht_divchn_foreach(const ht_divchn_t *ht,
+		       void (*visit)(const void *, void *, void *),
+		       void *arg){
+  const void *key = NULL;
+  void *elt = NULL;
+  ht_divchn_cursor_t cur;
+  ht_divchn_cursor_init(&cur);
+  while ((elt = ht_divchn_next(ht, &cur, &key)) != NULL){
+    visit(key, elt, arg);
+  }
+}
+
+/**
+   Copies the keys of a hash table into an array of num_elts key_size
+   blocks pointed to by keys, and the elements, or pointers to elements,
+   into an array of num_elts elt_size blocks pointed to by elts, s.t. the
+   ith element is associated with the ith key. If keys or elts is NULL,
+   the corresponding array is not written. Returns num_elts.
+*/
+size_t ht_divchn_export(const ht_divchn_t *ht, void *keys, void *elts){
+  size_t i, num_slots = ht->count;
+  size_t num = 0;
+  const unsigned char *entry = NULL;
+  const dll_node_t *head = NULL, *node = NULL;
+  if (ht->img_offsets != NULL){
+    for (i = 0; i < ht->num_elts; i++){
+      entry = ht->img_entries + i * ht->img_entry_size;
+      if (keys != NULL){
+	memcpy((char *)keys + i * ht->key_size, entry, ht->key_size);
+      }
+      if (elts != NULL){
+	memcpy((char *)elts + i * ht->elt_size,
+	       entry + ht->img_elt_offset,
+	       ht->elt_size);
+      }
+    }
+    return ht->num_elts;
+  }
+  if (ht->prev_key_elts != NULL) num_slots += ht->prev_count;
+  for (i = 0; i < num_slots; i++){
+    head = cursor_head(ht, i);
+    if (head == NULL) continue;
+    node = head;
+    do{
+      if (keys != NULL){
+	memcpy((char *)keys + num * ht->key_size,
+	       dll_key_ptr(ht->ll, node),
+	       ht->key_size);
+      }
+      if (elts != NULL){
+	memcpy((char *)elts + num * ht->elt_size,
+	       dll_elt_ptr(ht->ll, node),
+	       ht->elt_size);
+      }
+      num++;
+      node = node->next;
+    }while (node != head);
+  }
+  return num;
+}
+
+/**
+   Writes a hash table into a file as a relocatable binary image. The
+   image can be loaded with ht_divchn_load by a process on a system with
+   the same size_t representation, byte order, and alignment requirements,
+   with the same cmp_key and rdc_key functions. The elements are required
+   to be within contiguous memory blocks that were copied into the hash
+   table, because pointers are not relocatable. Completes the migration
+   of keys if it is in progress. An error message is provided and an exit
+   is executed if a write is not completed.
+   ht          : pointer to an initialized ht_divchn_t struct
+   file        : pointer to a binary stream open for writing, positioned
+                 at the start of the image
+*/
+void ht_divchn_save(ht_divchn_t *ht, FILE *file){
+  size_t i, num = 0;
+  size_t elt_offset, entry_size, hdr_size;
+  size_t hdr[C_IMAGE_NUM_FIELDS];
+  unsigned char *buf = NULL;
+  const dll_node_t *node = NULL;
+  if (ht->prev_key_elts != NULL) migrate(ht, ht->prev_count);
+  entry_layout(ht, &elt_offset, &entry_size);
+  hdr[IMG_MAGIC] = C_IMAGE_MAGIC;
+  hdr[IMG_SIZE_T_SIZE] = sizeof(size_t);
+  hdr[IMG_KEY_SIZE] = ht->key_size;
+  hdr[IMG_ELT_SIZE] = ht->elt_size;
+  hdr[IMG_ELT_ALIGNMENT] = ht->elt_alignment;
+  hdr[IMG_ELT_OFFSET] = elt_offset;
+  hdr[IMG_ENTRY_SIZE] = entry_size;
+  hdr[IMG_GROUP_IX] = ht->group_ix;
+  hdr[IMG_COUNT_IX] = ht->count_ix;
+  hdr[IMG_MIN_GROUP_IX] = ht->min_group_ix;
+  hdr[IMG_MIN_COUNT_IX] = ht->min_count_ix;
+  hdr[IMG_COUNT] = ht->count;
+  hdr[IMG_MAX_NUM_ELTS] = ht->max_num_elts;
+  hdr[IMG_NUM_ELTS] = ht->num_elts;
+  hdr[IMG_ALPHA_N] = ht->alpha_n;
+  hdr[IMG_LOG_ALPHA_D] = ht->log_alpha_d;
+  hdr_size = mul_sz_perror(add_sz_perror(C_IMAGE_NUM_FIELDS + 1, ht->count),
+			   sizeof(size_t));
+  /* entries aligned for elt_alignment relative to the start of image */
+  hdr[IMG_ENTRIES_OFFSET] = add_sz_perror(hdr_size,
+					  (ht->elt_alignment -
+					   hdr_size % ht->elt_alignment) %
+					  ht->elt_alignment);
+  write_perror(hdr, sizeof(hdr), file);
+  if (ht->img_offsets != NULL){
+    write_perror(ht->img_offsets, (ht->count + 1) * sizeof(size_t), file);
+  }else{
+    for (i = 0; i < ht->count; i++){
+      write_perror(&num, sizeof(size_t), file);
+      node = ht->key_elts[i];
+      if (node == NULL) continue;
+      do{
+	num++;
+	node = node->next;
+      }while (node != ht->key_elts[i]);
+    }
+    write_perror(&num, sizeof(size_t), file);
+  }
+  /* entry_size >= elt_alignment > padding size */
+  buf = calloc_perror(1, entry_size);
+  write_perror(buf, hdr[IMG_ENTRIES_OFFSET] - hdr_size, file);
+  if (ht->img_offsets != NULL){
+    write_perror(ht->img_entries, ht->num_elts * entry_size, file);
+  }else{
+    for (i = 0; i < ht->count; i++){
+      node = ht->key_elts[i];
+      if (node == NULL) continue;
+      do{
+	memset(buf, 0, entry_size);
+	memcpy(buf, dll_key_ptr(ht->ll, node), ht->key_size);
+	memcpy(buf + elt_offset, dll_elt_ptr(ht->ll, node), ht->elt_size);
+	write_perror(buf, entry_size, file);
+	node = node->next;
+      }while (node != ht->key_elts[i]);
+    }
+  }
+  free(buf);
+  buf = NULL;
+}
+
+/**
+   Initializes a hash table from an image written by ht_divchn_save,
+   without rehashing and without an allocation per key. The keys and
+   elements of the hash table are in the image until the first insert,
+   remove, delete, or compact operation builds the chains of the hash
+   table from the image; the image is not written. A loaded hash table is
+   in the default mode of growth. An error message is provided and an exit
+   is executed if the image is not valid on the system.
+   ht          : a pointer to a preallocated block of size
+                 sizeof(ht_divchn_t)
+   image       : pointer to an image aligned as a pointer returned by
+                 malloc or mmap; the image is not modified and remains
+                 valid until ht_divchn_free is called or the chains were
+                 built
+   image_size  : size of the block pointed to by image
+   cmp_key     : cmp_key of the saved hash table, as in ht_divchn_init
+   rdc_key     : rdc_key of the saved hash table, as in ht_divchn_init
+*/
+void ht_divchn_load(ht_divchn_t *ht,
+		    const void *image,
+		    size_t image_size,
+		    int (*cmp_key)(const void *, const void *),
+		    size_t (*rdc_key)(const void *, size_t)){
+  const size_t *hdr = image;
+  dll_node_t *head = NULL;
+  if (image_size < C_IMAGE_NUM_FIELDS * sizeof(size_t) ||
+      hdr[IMG_MAGIC] != C_IMAGE_MAGIC ||
+      hdr[IMG_SIZE_T_SIZE] != sizeof(size_t) ||
+      !is_image_layout(hdr) ||
+      hdr[IMG_COUNT] == 0 ||
+      hdr[IMG_COUNT] >= image_size / sizeof(size_t) - C_IMAGE_NUM_FIELDS ||
+      hdr[IMG_ENTRIES_OFFSET] <
+      (C_IMAGE_NUM_FIELDS + hdr[IMG_COUNT] + 1) * sizeof(size_t) ||
+      hdr[IMG_ENTRIES_OFFSET] > image_size ||
+      hdr[IMG_NUM_ELTS] > (image_size - hdr[IMG_ENTRIES_OFFSET]) /
+      hdr[IMG_ENTRY_SIZE] ||
+      hdr[IMG_ALPHA_N] == 0 ||
+      hdr[IMG_LOG_ALPHA_D] >= C_FULL_BIT ||
+      !is_image_offsets(hdr + C_IMAGE_NUM_FIELDS,
+			hdr[IMG_COUNT],
+			hdr[IMG_NUM_ELTS])){
+    fprintf(stderr, "ht_divchn_load invalid image\n");
+    exit(EXIT_FAILURE);
+  }
+  ht->key_size = hdr[IMG_KEY_SIZE];
+  ht->elt_size = hdr[IMG_ELT_SIZE];
+  ht->elt_alignment = hdr[IMG_ELT_ALIGNMENT];
+  ht->group_ix = hdr[IMG_GROUP_IX];
+  ht->count_ix = hdr[IMG_COUNT_IX];
+  ht->min_group_ix = hdr[IMG_MIN_GROUP_IX];
+  ht->min_count_ix = hdr[IMG_MIN_COUNT_IX];
+  ht->count = hdr[IMG_COUNT];
+  mod_rcp_init(&ht->count_rcp, ht->count);
+  ht->max_num_elts = hdr[IMG_MAX_NUM_ELTS];
+  ht->num_elts = hdr[IMG_NUM_ELTS];
+  ht->alpha_n = hdr[IMG_ALPHA_N];
+  ht->log_alpha_d = hdr[IMG_LOG_ALPHA_D];
+  ht->ll = malloc_perror(1, sizeof(dll_t));
+  dll_init(ht->ll, &head, ht->key_size);
+  if (ht->elt_alignment > 1) dll_align_elt(ht->ll, ht->elt_alignment);
+  ht->slab = malloc_perror(1, sizeof(dll_slab_t));
+  dll_slab_init(ht->slab, ht->ll, ht->elt_size, C_SLAB_MAX_NUM_NODES);
+  ht->key_elts = NULL;
+  ht->is_incr = 0;
+  ht->prev_count = 0;
+  ht->mig_ix = 0;
+  ht->mig_step = 0;
+  ht->prev_key_elts = NULL;
+  ht->img_offsets = hdr + C_IMAGE_NUM_FIELDS;
+  ht->img_entries = (const unsigned char *)image + hdr[IMG_ENTRIES_OFFSET];
+  ht->img_entry_size = hdr[IMG_ENTRY_SIZE];
+  ht->img_elt_offset = hdr[IMG_ELT_OFFSET];
+#ifdef HT_DIVCHN_STATS
+  stats_init(ht);
+#endif
+  ht->cmp_key = cmp_key;
+  ht->rdc_key = rdc_key;
+  ht->free_elt = NULL;
+}
+
+#ifdef HT_DIVCHN_STATS
+/**
+   Copies the statistics of a hash table into a block pointed to by stats.
+   The ith bin of the chain length histogram is the number of slots with
+   i keys, and the last bin also includes the longer chains. During the
+   migration of keys, the previous slots are included. The processor time
+   of a growth or shrinking operation in the incremental mode does not
+   include the migration of keys by the subsequent operations. The
+   num_bytes value does not include the noncontiguous elements and the
+   keys and elements in a loaded image.
+   ht          : pointer to an initialized ht_divchn_t struct
+   stats       : pointer to a preallocated block of size
+                 sizeof(ht_divchn_stats_t)
+*/
+void ht_divchn_stats(const ht_divchn_t *ht, ht_divchn_stats_t *stats){
+  size_t i, len, num_slots = ht->count;
+  const dll_node_t *head = NULL, *node = NULL;
+  *stats = ht->stats;
+  stats->num_elts = ht->num_elts;
+  stats->count = ht->count;
+  stats->num_bytes = sizeof(dll_t) + ht->prev_count * sizeof(dll_node_t *);
+  if (ht->img_offsets != NULL){
+    for (i = 0; i < ht->count; i++){
+      stats_chain(stats, ht->img_offsets[i + 1] - ht->img_offsets[i]);
+    }
+    return;
+  }
+  stats->num_bytes += ht->count * sizeof(dll_node_t *) +
+    sizeof(dll_slab_t) + ht->slab->num_bytes;
+  if (ht->prev_key_elts != NULL) num_slots += ht->prev_count;
+  for (i = 0; i < num_slots; i++){
+    len = 0;
+    head = cursor_head(ht, i);
+    node = head;
+    while (node != NULL){
+      len++;
+      node = node->next;
+      if (node == head) break;
+    }
+    stats_chain(stats, len);
+  }
+}
+#endif
+
 /**
    Frees a hash table and leaves a block of size sizeof(ht_divchn_t)
    pointed to by the ht parameter.
 */
 void ht_divchn_free(ht_divchn_t *ht){
   size_t i;
-  for (i = 0; i < ht->count; i++){
-    dll_free(ht->ll, &ht->key_elts[i], ht->free_elt);
+  if (ht->free_elt != NULL){
+    for (i = 0; i < ht->count && ht->img_offsets == NULL; i++){
+      dll_free_slab(ht->ll, ht->slab, &ht->key_elts[i], ht->free_elt);
+    }
+    for (i = ht->mig_ix; i < ht->prev_count; i++){
+      dll_free_slab(ht->ll, ht->slab, &ht->prev_key_elts[i], ht->free_elt);
+    }
   }
+  dll_slab_free(ht->slab);
+  free(ht->slab);
   free(ht->ll);
   free(ht->key_elts);
+  free(ht->prev_key_elts);
   ht->ll = NULL;
+  ht->slab = NULL;
   ht->key_elts = NULL;
+  ht->prev_key_elts = NULL;
+  ht->img_offsets = NULL;
+  ht->img_entries = NULL;
 }
 
 /**
@@ -345,6 +944,10 @@ void ht_divchn_align_helper(void *ht, size_t elt_alignment){
   ht_divchn_align(ht, elt_alignment);
 }
 
+void ht_divchn_incr_helper(void *ht, int is_incr){
+  ht_divchn_incr(ht, is_incr);
+}
+
 void ht_divchn_insert_helper(void *ht, const void *key, const void *elt){
   ht_divchn_insert(ht, key, elt);
 }
@@ -361,6 +964,70 @@ void ht_divchn_delete_helper(void *ht, const void *key){
   ht_divchn_delete(ht, key);
 }
 
+size_t ht_divchn_hash_key_helper(const void *ht, const void *key){
+  return ht_divchn_hash_key(ht, key);
+}
+
+void ht_divchn_insert_hashed_helper(void *ht,
+				    const void *key,
+				    size_t tok,
+				    const void *elt){
+  ht_divchn_insert_hashed(ht, key, tok, elt);
+}
+
+void *ht_divchn_search_hashed_helper(const void *ht,
+				     const void *key,
+				     size_t tok){
+  return ht_divchn_search_hashed(ht, key, tok);
+}
+
+void ht_divchn_remove_hashed_helper(void *ht,
+				    const void *key,
+				    size_t tok,
+				    void *elt){
+  ht_divchn_remove_hashed(ht, key, tok, elt);
+}
+
+void ht_divchn_delete_hashed_helper(void *ht, const void *key, size_t tok){
+  ht_divchn_delete_hashed(ht, key, tok);
+}
+
+void ht_divchn_compact_helper(void *ht){
+  ht_divchn_compact(ht);
+}
+
+void *ht_divchn_next_helper(const void *ht, void *cur, const void **key){
+  return ht_divchn_next(ht, cur, key);
+}
+
+void ht_divchn_foreach_helper(const void *ht,
+			      void (*visit)(const void *, void *, void *),
+			      void *arg){
+  ht_divchn_foreach(ht, visit, arg);
+}
+
+size_t ht_divchn_export_helper(const void *ht, void *keys, void *elts){
+  return ht_divchn_export(ht, keys, elts);
+}
+
+void ht_divchn_save_helper(void *ht, FILE *file){
+  ht_divchn_save(ht, file);
+}
+
+void ht_divchn_load_helper(void *ht,
+			   const void *image,
+			   size_t image_size,
+			   int (*cmp_key)(const void *, const void *),
+			   size_t (*rdc_key)(const void *, size_t)){
+  ht_divchn_load(ht, image, image_size, cmp_key, rdc_key);
+}
+
+#ifdef HT_DIVCHN_STATS
+void ht_divchn_stats_helper(const void *ht, void *stats){
+  ht_divchn_stats(ht, stats);
+}
+#endif
+
 void ht_divchn_free_helper(void *ht){
   ht_divchn_free(ht);
 } 
@@ -399,10 +1066,247 @@ static size_t convert_std_key(const ht_divchn_t *ht, const void *key){
 }
 
 /**
-   Maps a hash key to a slot index in a hash table with a division method. 
+   Maps a hash key to a slot index in a hash table with a division method,
+   computed without a division instruction.
 */
 static size_t hash(const ht_divchn_t *ht, const void *key){
-  return convert_std_key(ht, key) % ht->count; 
+  return rcp_mod(convert_std_key(ht, key), &ht->count_rcp);
+}
+
+/**
+   Searches a key, converted to the standard key std_key, in a hash table.
+   Returns a pointer to the node with the key and sets the pointer pointed
+   to by head to the head of the chain with the node, if the key is in
+   the hash table. Otherwise returns NULL. During the migration of keys,
+   the previous slot of the key is searched if it was not yet migrated.
+*/
+static dll_node_t *search_node(const ht_divchn_t *ht,
+			       const void *key,
+			       size_t std_key,
+			       dll_node_t ***head){
+  size_t ix;
+  dll_node_t *node = NULL;
+  *head = &ht->key_elts[rcp_mod(std_key, &ht->count_rcp)];
+  node = dll_search_key(ht->ll, *head, key, ht->key_size, ht->cmp_key);
+  if (node == NULL && ht->prev_key_elts != NULL){
+    ix = rcp_mod(std_key, &ht->prev_count_rcp);
+    if (ix >= ht->mig_ix){
+      *head = &ht->prev_key_elts[ix];
+      node = dll_search_key(ht->ll, *head, key, ht->key_size, ht->cmp_key);
+    }
+  }
+  return node;
+}
+
+/**
+   Inserts a key, converted to the standard key std_key, and an associated
+   element into a hash table.
+*/
+static void insert(ht_divchn_t *ht,
+		   const void *key,
+		   size_t std_key,
+		   const void *elt){
+  dll_node_t **head = NULL, *node = NULL;
+  own_image(ht);
+  if (ht->prev_key_elts != NULL) migrate(ht, ht->mig_step);
+  node = search_node(ht, key, std_key, &head);
+  if (node == NULL){
+    dll_prepend_new_slab(ht->ll,
+			 ht->slab,
+			 &ht->key_elts[rcp_mod(std_key, &ht->count_rcp)],
+			 key,
+			 elt,
+			 ht->key_size,
+			 ht->elt_size);
+    ht->num_elts++;
+  }else{
+    if (ht->free_elt != NULL) ht->free_elt(dll_elt_ptr(ht->ll, node));
+    memcpy(dll_elt_ptr(ht->ll, node), elt, ht->elt_size);
+  }
+  /* grow ht after ensuring it was insertion, not update */
+  if (ht->num_elts > ht->max_num_elts && 
+      ht->count_ix != C_SIZE_MAX &&
+      ht->count_ix != C_PRIME_PARTS_COUNT){
+    ht_grow(ht);
+  }
+}
+
+/**
+   Removes a key, converted to the standard key std_key, and its associated
+   element from a hash table by copying the element or its pointer into
+   a block of size elt_size pointed to by elt, if the key is in the hash
+   table.
+*/
+static void remove_key(ht_divchn_t *ht,
+		       const void *key,
+		       size_t std_key,
+		       void *elt){
+  dll_node_t **head = NULL, *node = NULL;
+  own_image(ht);
+  if (ht->prev_key_elts != NULL) migrate(ht, ht->mig_step);
+  node = search_node(ht, key, std_key, &head);
+  if (node != NULL){
+    memcpy(elt, dll_elt_ptr(ht->ll, node), ht->elt_size);
+    /* if an element is noncontiguous, only the pointer to it is deleted */
+    dll_delete_slab(ht->ll, ht->slab, head, node, NULL);
+    ht->num_elts--;
+    if (ht->num_elts < ht->max_num_elts / C_SHRINK_DIV &&
+	ht->count_ix != ht->min_count_ix){
+      ht_shrink(ht, 2 * ht->num_elts);
+    }
+  }
+}
+
+/**
+   Deletes a key, converted to the standard key std_key, and its associated
+   element according to free_elt from a hash table, if the key is in the
+   hash table.
+*/
+static void delete_key(ht_divchn_t *ht, const void *key, size_t std_key){
+  dll_node_t **head = NULL, *node = NULL;
+  own_image(ht);
+  if (ht->prev_key_elts != NULL) migrate(ht, ht->mig_step);
+  node = search_node(ht, key, std_key, &head);
+  if (node != NULL){
+    dll_delete_slab(ht->ll, ht->slab, head, node, ht->free_elt);
+    ht->num_elts--;
+    if (ht->num_elts < ht->max_num_elts / C_SHRINK_DIV &&
+	ht->count_ix != ht->min_count_ix){
+      ht_shrink(ht, 2 * ht->num_elts);
+    }
+  }
+}
+
+/**
+   Searches a key, converted to the standard key std_key, in a hash table
+   loaded from an image. Returns a pointer to the element in the image if
+   the key is in the hash table. Otherwise returns NULL.
+*/
+static void *search_image(const ht_divchn_t *ht,
+			  const void *key,
+			  size_t std_key){
+  size_t ix = rcp_mod(std_key, &ht->count_rcp);
+  const unsigned char *entry =
+    ht->img_entries + ht->img_offsets[ix] * ht->img_entry_size;
+  const unsigned char *end =
+    ht->img_entries + ht->img_offsets[ix + 1] * ht->img_entry_size;
+  if (ht->cmp_key != NULL){
+    for (; entry != end; entry += ht->img_entry_size){
+      if (ht->cmp_key(entry, key) == 0){
+	return (void *)(entry + ht->img_elt_offset);
+      }
+    }
+  }else{
+    for (; entry != end; entry += ht->img_entry_size){
+      if (memcmp(entry, key, ht->key_size) == 0){
+	return (void *)(entry + ht->img_elt_offset);
+      }
+    }
+  }
+  return NULL;
+}
+
+/**
+   Builds the chains of a hash table loaded from an image before the first
+   modification of the hash table. The order of keys in each chain is the
+   order in the image. The heads are set to NULL without dll_init to
+   preserve the alignment of elements set in ht_divchn_load.
+*/
+static void own_image(ht_divchn_t *ht){
+  size_t i, j;
+  const unsigned char *entry = NULL;
+  if (ht->img_offsets == NULL) return;
+  ht->key_elts = malloc_perror(ht->count, sizeof(dll_node_t *));
+  for (i = 0; i < ht->count; i++){
+    ht->key_elts[i] = NULL;
+    for (j = ht->img_offsets[i + 1]; j > ht->img_offsets[i]; j--){
+      entry = ht->img_entries + (j - 1) * ht->img_entry_size;
+      dll_prepend_new_slab(ht->ll,
+			   ht->slab,
+			   &ht->key_elts[i],
+			   entry,
+			   entry + ht->img_elt_offset,
+			   ht->key_size,
+			   ht->elt_size);
+    }
+  }
+  ht->img_offsets = NULL;
+  ht->img_entries = NULL;
+}
+
+/**
+   Computes the layout of an entry in an image. An entry contains a key
+   block and an elt_size block at elt_offset, which is aligned according
+   to elt_alignment, and entry_size is a multiple of elt_alignment.
+*/
+static void entry_layout(const ht_divchn_t *ht,
+			 size_t *elt_offset,
+			 size_t *entry_size){
+  size_t rem;
+  rem = ht->key_size % ht->elt_alignment;
+  *elt_offset = add_sz_perror(ht->key_size,
+			      (rem > 0) * (ht->elt_alignment - rem));
+  *entry_size = add_sz_perror(*elt_offset, ht->elt_size);
+  rem = *entry_size % ht->elt_alignment;
+  *entry_size = add_sz_perror(*entry_size,
+			      (rem > 0) * (ht->elt_alignment - rem));
+}
+
+/**
+   Writes a block of size bytes into a file. An error message is provided
+   and an exit is executed if the write is not completed.
+*/
+static void write_perror(const void *ptr, size_t size, FILE *file){
+  if (size > 0 && fwrite(ptr, 1, size, file) != size){
+    perror("ht_divchn_save fwrite failed");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+   Returns non-zero if the entry layout in an image header is valid, i.e.
+   a key_size block is followed by an elt_size block at an offset within
+   an entry, and the element offset, entry size, and offset of the entries
+   are multiples of the alignment of elements.
+*/
+static int is_image_layout(const size_t *hdr){
+  size_t alignment = hdr[IMG_ELT_ALIGNMENT];
+  if (hdr[IMG_KEY_SIZE] == 0 ||
+      hdr[IMG_ELT_SIZE] == 0 ||
+      alignment == 0 ||
+      hdr[IMG_KEY_SIZE] > hdr[IMG_ELT_OFFSET] ||
+      hdr[IMG_ELT_OFFSET] > hdr[IMG_ENTRY_SIZE] ||
+      hdr[IMG_ELT_SIZE] > hdr[IMG_ENTRY_SIZE] - hdr[IMG_ELT_OFFSET]){
+    return 0;
+  }
+  return (hdr[IMG_ELT_OFFSET] % alignment == 0 &&
+	  hdr[IMG_ENTRY_SIZE] % alignment == 0 &&
+	  hdr[IMG_ENTRIES_OFFSET] % alignment == 0);
+}
+
+/**
+   Returns non-zero if the count + 1 offsets of the chains in an image are
+   non-decreasing, start at 0, and end at num_elts, the number of entries.
+*/
+static int is_image_offsets(const size_t *offsets,
+			    size_t count,
+			    size_t num_elts){
+  size_t i;
+  if (offsets[0] != 0) return 0;
+  for (i = 0; i < count; i++){
+    if (offsets[i] > offsets[i + 1]) return 0;
+  }
+  return (offsets[count] == num_elts);
+}
+
+/**
+   Prefetches the key of the first node in the chain at the slot index ix
+   of a hash table. Called after the chain head was prefetched.
+*/
+static void prefetch_head(const ht_divchn_t *ht, size_t ix){
+  if (ht->key_elts[ix] != NULL){
+    PREFETCH(dll_key_ptr(ht->ll, ht->key_elts[ix]));
+  }
 }
 
 /**
@@ -433,19 +1337,73 @@ static size_t mul_alpha_sz_max(size_t n, size_t alpha_n, size_t log_alpha_d){
    If the largest representable prime is reached, count_ix may not yet be set
    to C_SIZE_MAX or C_PRIME_PARTS_COUNT, which requires one additional call
    that does not increase the count. Otherwise, each call increases the
-   count.
+   count. In the incremental mode, completes the migration of keys if it
+   is in progress, and starts a new migration of keys, which is continued
+   by the subsequent operations.
 */
 static void ht_grow(ht_divchn_t *ht){
-  size_t i, prev_count = ht->count;
-  dll_node_t **prev_key_elts = ht->key_elts;
-  dll_node_t **head = NULL, *node = NULL;
+  size_t prev_count;
+  if (ht->prev_key_elts != NULL) migrate(ht, ht->prev_count);
+  prev_count = ht->count;
   while (ht->num_elts > ht->max_num_elts && incr_count(ht));
   if (prev_count == ht->count) return; /* load factor not lowered */
+  rehash(ht, prev_count, ht->is_incr);
+}
+
+/**
+   Decreases the count of a hash table to the smallest prime number in the
+   C_PRIME_PARTS array, not less than the count set at initialization,
+   s.t. num <= max_num_elts. The operation is called with num equal to
+   2 * num_elts if num_elts < max_num_elts / C_SHRINK_DIV and count_ix is
+   not equal to min_count_ix, resulting in a load factor of at most half
+   of alpha, and with num equal to num_elts by ht_divchn_compact. The keys
+   are moved according to the mode of growth in the former case, and in
+   a single step in the latter case. Completes the migration of keys if
+   it is in progress.
+*/
+static void ht_shrink(ht_divchn_t *ht, size_t num){
+  size_t prev_count;
+  if (ht->prev_key_elts != NULL) migrate(ht, ht->prev_count);
+  prev_count = ht->count;
+  reset_count(ht);
+  while (num > ht->max_num_elts && incr_count(ht));
+  if (prev_count == ht->count) return; /* count not decreased */
+  rehash(ht, prev_count, ht->is_incr && num > ht->num_elts);
+}
+
+/**
+   Allocates the slots of a hash table according to its current count and
+   moves the keys from the previous slots, with prev_count slots, to the
+   new slots. If is_incr is non-zero, keeps the previous slots and starts
+   a migration of keys, which is continued by the subsequent operations.
+   Otherwise moves all keys and frees the previous slots.
+*/
+static void rehash(ht_divchn_t *ht, size_t prev_count, int is_incr){
+  size_t i, room;
+  dll_node_t **prev_key_elts = ht->key_elts;
+  dll_node_t **head = NULL, *node = NULL;
+#ifdef HT_DIVCHN_STATS
+  clock_t t = clock();
+#endif
   ht->key_elts = malloc_perror(ht->count, sizeof(dll_node_t *));
   for (i = 0; i < ht->count; i++){
     dll_init(ht->ll, &ht->key_elts[i], ht->key_size);
   }
   if (ht->elt_alignment > 1) dll_align_elt(ht->ll, ht->elt_alignment);
+  if (is_incr){
+    /* mig_step * room >= prev_count if room > 0 */
+    room = (ht->max_num_elts > ht->num_elts) ?
+      ht->max_num_elts - ht->num_elts : 0;
+    ht->prev_count = prev_count;
+    mod_rcp_init(&ht->prev_count_rcp, prev_count);
+    ht->mig_ix = 0;
+    ht->mig_step = (room > 0) ? prev_count / room + 1 : prev_count;
+    ht->prev_key_elts = prev_key_elts;
+#ifdef HT_DIVCHN_STATS
+    stats_rehash(ht, prev_count, clock() - t);
+#endif
+    return;
+  }
   for (i = 0; i < prev_count; i++){
     head = &prev_key_elts[i];
     while (*head != NULL){
@@ -456,6 +1414,37 @@ static void ht_grow(ht_divchn_t *ht){
   }
   free(prev_key_elts);
   prev_key_elts = NULL;
+#ifdef HT_DIVCHN_STATS
+  stats_rehash(ht, prev_count, clock() - t);
+#endif
+}
+
+/**
+   Moves the keys in at most num_slots previous slots of a hash table to
+   the new slots in the incremental mode, and frees the previous slots
+   after the keys of all previous slots are moved. The operation is called
+   if a migration of keys is in progress.
+*/
+static void migrate(ht_divchn_t *ht, size_t num_slots){
+  size_t end;
+  dll_node_t **head = NULL, *node = NULL;
+  end = (ht->prev_count - ht->mig_ix < num_slots) ?
+    ht->prev_count : ht->mig_ix + num_slots;
+  while (ht->mig_ix < end){
+    head = &ht->prev_key_elts[ht->mig_ix];
+    while (*head != NULL){
+      node = *head;
+      dll_remove(head, node);
+      dll_prepend(&ht->key_elts[hash(ht, dll_key_ptr(ht->ll, node))], node);
+    }
+    ht->mig_ix++;
+  }
+  if (ht->mig_ix == ht->prev_count){
+    free(ht->prev_key_elts);
+    ht->prev_key_elts = NULL;
+    ht->prev_count = 0;
+    ht->mig_ix = 0;
+  }
 }
 
 /**
@@ -476,6 +1465,7 @@ static int incr_count(ht_divchn_t *ht){
     return 0;
   }else{
     ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+    mod_rcp_init(&ht->count_rcp, ht->count);
     /* 0 <= max_num_elts <= C_SIZE_MAX */
     ht->max_num_elts = mul_alpha_sz_max(ht->count,
 					ht->alpha_n,
@@ -484,6 +1474,32 @@ static int incr_count(ht_divchn_t *ht){
   return 1;
 }
 
+/**
+   Returns the head of a slot in the order of enumeration, where the
+   previous slots precede the slots during the migration of keys.
+*/
+static const dll_node_t *cursor_head(const ht_divchn_t *ht, size_t ix){
+  if (ht->prev_key_elts != NULL){
+    if (ix < ht->prev_count) return ht->prev_key_elts[ix];
+    ix -= ht->prev_count;
+  }
+  return ht->key_elts[ix];
+}
+
+/**
+   Sets the count_ix, group_ix, count, and max_num_elts of a hash table to
+   the values set at initialization.
+*/
+static void reset_count(ht_divchn_t *ht){
+  ht->group_ix = ht->min_group_ix;
+  ht->count_ix = ht->min_count_ix;
+  ht->count = build_prime(ht->count_ix, C_PARTS_PER_PRIME[ht->group_ix]);
+  mod_rcp_init(&ht->count_rcp, ht->count);
+  ht->max_num_elts = mul_alpha_sz_max(ht->count,
+				      ht->alpha_n,
+				      ht->log_alpha_d);
+}
+
 /**
    Tests if the next prime number results in an overflow of size_t
    on a given system. Returns 0 if no overflow, otherwise returns 1.
@@ -513,3 +1529,46 @@ static size_t build_prime(size_t start, size_t count){
   }
   return p;
 }
+
+#ifdef HT_DIVCHN_STATS
+/**
+   Zeroes the statistics of a hash table.
+*/
+static void stats_init(ht_divchn_t *ht){
+  size_t i;
+  for (i = 0; i < HT_DIVCHN_STATS_BINS; i++){
+    ht->stats.chain_hist[i] = 0;
+  }
+  ht->stats.max_chain_len = 0;
+  ht->stats.num_elts = 0;
+  ht->stats.count = 0;
+  ht->stats.num_grows = 0;
+  ht->stats.num_shrinks = 0;
+  ht->stats.rehash_time = 0;
+  ht->stats.max_rehash_time = 0;
+  ht->stats.num_bytes = 0;
+}
+
+/**
+   Counts a chain of length len in the statistics.
+*/
+static void stats_chain(ht_divchn_stats_t *stats, size_t len){
+  if (len > stats->max_chain_len) stats->max_chain_len = len;
+  if (len >= HT_DIVCHN_STATS_BINS) len = HT_DIVCHN_STATS_BINS - 1;
+  stats->chain_hist[len]++;
+}
+
+/**
+   Counts a growth or shrinking operation from prev_count slots with
+   processor time t.
+*/
+static void stats_rehash(ht_divchn_t *ht, size_t prev_count, clock_t t){
+  if (prev_count < ht->count){
+    ht->stats.num_grows++;
+  }else{
+    ht->stats.num_shrinks++;
+  }
+  ht->stats.rehash_time += t;
+  if (t > ht->stats.max_rehash_time) ht->stats.max_rehash_time = t;
+}
+#endif
@@ -15,6 +15,53 @@
    alpha parameter. The alpha parameter does not provide an upper bound 
    after the maximum count of slots in a hash table is reached.
 
+   A hash table shrinks if, after a remove or delete operation, the
+   number of keys is less than a quarter of the number of keys allowed by
+   alpha, and the count is greater than the count set at initialization.
+   After shrinking, the load factor is at most half of alpha. The
+   ht_divchn_compact operation shrinks a hash table to the smallest count
+   with a load factor not exceeding alpha.
+
+   A hash table grows in a single step by default, which moves all keys
+   in one operation. In the optional incremental mode of growth, the
+   previous slots are kept next to the new slots after a growth step, and
+   each subsequent insert, remove, or delete operation moves the keys of
+   a bounded number of previous slots, until all keys are moved. A search
+   during the migration of keys checks the new slot and then the
+   previous slot of a key.
+
+   The keys of a hash table are enumerated with a cursor, with a foreach
+   operation, or are copied with their elements into contiguous arrays
+   with an export operation. The order of enumeration is the order of
+   slots, with the previous slots first during the migration of keys.
+
+   A hash table is saved into a relocatable binary image with
+   ht_divchn_save. The image contains a header, the offsets of the chains,
+   and the keys and elements of the chains packed in the order of slots,
+   and contains no pointers. A hash table is loaded from an image in
+   memory, e.g. a memory-mapped file, with ht_divchn_load without rehashing
+   and without an allocation per key. A search in a loaded hash table
+   scans a contiguous range of keys in the image, which is not written,
+   until the first modifying operation builds the chains of the hash table
+   from the image.
+
+   The nodes of the chains are allocated from a slab allocator of the
+   hash table, which allocates the nodes in slabs of upto
+   C_SLAB_MAX_NUM_NODES nodes, reuses the nodes of removed and deleted
+   keys, and releases the slabs in bulk when the hash table is freed,
+   without visiting the nodes if the elements do not require free_elt.
+
+   The slot of a key is computed without a division instruction. When the
+   count of a hash table changes, a multiplier and shifts are precomputed
+   with mod_rcp_init, and the remainder of a standard key modulo the count
+   is computed with a high product, a subtraction, and shifts.
+
+   If HT_DIVCHN_STATS is defined at compile time, a hash table maintains
+   statistics that are read with ht_divchn_stats, including the
+   distribution of chain lengths, the growth and shrinking events and
+   their processor times, and the number of allocated bytes. Otherwise,
+   the statistics and their instrumentation are not compiled.
+
    A hash key is an object within a contiguous block of memory (e.g. a basic 
    type, array, struct). An element is within a contiguous or noncontiguous
    memory block.
@@ -41,7 +88,28 @@
 #define HT_DIVCHN_H
 
 #include <stddef.h>
+#include <stdio.h>
+#ifdef HT_DIVCHN_STATS
+#include <time.h>
+#endif
 #include "dll.h"
+#include "utilities-mod.h"
+
+#ifdef HT_DIVCHN_STATS
+#define HT_DIVCHN_STATS_BINS 16
+
+typedef struct{
+  size_t chain_hist[HT_DIVCHN_STATS_BINS];
+  size_t max_chain_len;
+  size_t num_elts;
+  size_t count;
+  size_t num_grows;
+  size_t num_shrinks;
+  clock_t rehash_time; /* processor time of growth and shrinking */
+  clock_t max_rehash_time;
+  size_t num_bytes; /* allocated for slots and nodes */
+} ht_divchn_stats_t;
+#endif
 
 typedef struct{
   size_t key_size;
@@ -49,18 +117,41 @@ typedef struct{
   size_t elt_alignment;
   size_t group_ix;
   size_t count_ix; /* max size_t value if last representable prime reached */
+  size_t min_group_ix; /* group_ix set at initialization */
+  size_t min_count_ix; /* count_ix set at initialization */
   size_t count;
   size_t max_num_elts; /*  >= 0, <= C_SIZE_MAX, represents alpha */
   size_t num_elts;
   size_t alpha_n;
   size_t log_alpha_d; 
   dll_t *ll;
+  dll_slab_t *slab; /* allocator of the nodes of all chains */
   dll_node_t **key_elts; /* array of pointers to nodes */
+  int is_incr; /* non-zero in the incremental mode of growth */
+  size_t prev_count; /* 0 if no migration is in progress */
+  size_t mig_ix; /* next previous slot to migrate */
+  size_t mig_step; /* number of previous slots migrated per operation */
+  dll_node_t **prev_key_elts; /* NULL if no migration is in progress */
+  const size_t *img_offsets; /* count + 1 chain offsets, NULL if no image */
+  const unsigned char *img_entries; /* keys and elements in an image */
+  size_t img_entry_size;
+  size_t img_elt_offset;
+  mod_rcp_t count_rcp; /* reciprocal of count for slot indices */
+  mod_rcp_t prev_count_rcp; /* reciprocal of prev_count */
+#ifdef HT_DIVCHN_STATS
+  ht_divchn_stats_t stats; /* counters, other fields set by query */
+#endif
   int (*cmp_key)(const void *, const void *);
   size_t (*rdc_key)(const void *, size_t);
   void (*free_elt)(void *);
 } ht_divchn_t;
 
+typedef struct{
+  size_t ix; /* next slot, previous slots first during migration, or
+                next entry of a loaded image */
+  const dll_node_t *node; /* next node in the slot ix - 1, or NULL */
+} ht_divchn_cursor_t;
+
 /**
    Initializes a hash table. 
    ht          : a pointer to a preallocated block of size 
@@ -129,6 +220,22 @@ void ht_divchn_init(ht_divchn_t *ht,
 */
 void ht_divchn_align(ht_divchn_t *ht, size_t alignment);
 
+/**
+   Sets the mode of growth of a hash table. In the incremental mode, a
+   growth step allocates the new slots, and the keys in the previous slots
+   are moved by the subsequent insert, remove, and delete operations, each
+   moving the keys of a bounded number of previous slots. The number of
+   previous slots migrated per operation is set at each growth step s.t.
+   the migration is completed before the next growth step is due. As a
+   result, no single insert operation moves all keys of a hash table. The
+   operation is optionally called after ht_divchn_init is completed and
+   before any operation other than ht_divchn_align is called.
+   ht          : pointer to an initialized ht_divchn_t struct
+   is_incr     : non-zero to set the incremental mode, zero to set the
+                 default mode of growth in a single step
+*/
+void ht_divchn_incr(ht_divchn_t *ht, int is_incr);
+
 /**
    Inserts a key and an associated element into a hash table. If the key is
    in the hash table, associates the key with the new element. The key and 
@@ -137,6 +244,22 @@ void ht_divchn_align(ht_divchn_t *ht, size_t alignment);
 */
 void ht_divchn_insert(ht_divchn_t *ht, const void *key, const void *elt);
 
+/**
+   Inserts a batch of keys and associated elements into a hash table, with
+   the same result as calling ht_divchn_insert on each key and element in
+   the order of the batch. The keys are hashed in groups, the chain heads
+   of a group and then the first nodes of the chains are prefetched, and
+   then the keys of the group are inserted, overlapping the cache misses
+   of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   elts        : pointer to num_keys contiguous blocks of size elt_size
+   num_keys    : number of keys in the batch
+*/
+void ht_divchn_insert_batch(ht_divchn_t *ht,
+			    const void *keys,
+			    const void *elts,
+			    size_t num_keys);
+
 /**
    If a key is present in a hash table, returns a pointer to its associated 
    element, otherwise returns NULL. The key parameter is not NULL and points
@@ -145,6 +268,22 @@ void ht_divchn_insert(ht_divchn_t *ht, const void *key, const void *elt);
 */
 void *ht_divchn_search(const ht_divchn_t *ht, const void *key);
 
+/**
+   Searches a batch of keys in a hash table. The keys are hashed in groups,
+   the chain heads of a group and then the first nodes of the chains are
+   prefetched, and then the keys of the group are searched, overlapping
+   the cache misses of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   num_keys    : number of keys in the batch
+   elts        : pointer to a preallocated array of num_keys pointers; the
+                 ith pointer is set to the value returned by
+                 ht_divchn_search on the ith key
+*/
+void ht_divchn_search_batch(const ht_divchn_t *ht,
+			    const void *keys,
+			    size_t num_keys,
+			    void **elts);
+
 /**
    Removes a key and its associated element from a hash table by copying 
    the element or its pointer into a block of size elt_size pointed to
@@ -161,6 +300,153 @@ void ht_divchn_remove(ht_divchn_t *ht, const void *key, void *elt);
 */
 void ht_divchn_delete(ht_divchn_t *ht, const void *key);
 
+/**
+   Computes the hash token of a key. The hash token of a key depends only
+   on the key and the hash table parameters set at initialization, and is
+   valid throughout the lifetime of the hash table, including across its
+   growth. A hash token can be stored by the caller next to the key and
+   passed to the *_hashed operations in order to avoid reducing the key
+   in each operation. The key parameter is not NULL and points to a block
+   of size key_size.
+*/
+size_t ht_divchn_hash_key(const ht_divchn_t *ht, const void *key);
+
+/**
+   Perform the insert, search, remove, and delete operations with a hash
+   token of a key computed by ht_divchn_hash_key on the same hash table.
+   The result is the same as the result of the corresponding operation
+   without a hash token. The key, elt parameters are as in the
+   corresponding operations.
+*/
+
+void ht_divchn_insert_hashed(ht_divchn_t *ht,
+			     const void *key,
+			     size_t tok,
+			     const void *elt);
+
+void *ht_divchn_search_hashed(const ht_divchn_t *ht,
+			      const void *key,
+			      size_t tok);
+
+void ht_divchn_remove_hashed(ht_divchn_t *ht,
+			     const void *key,
+			     size_t tok,
+			     void *elt);
+
+void ht_divchn_delete_hashed(ht_divchn_t *ht, const void *key, size_t tok);
+
+/**
+   Compacts a hash table by decreasing its count to the smallest prime
+   number in the C_PRIME_PARTS array that accomodates alpha as a load
+   factor upper bound with the current number of keys, without decreasing
+   the count below the count set at initialization according to min_num.
+   The keys are moved in a single step in both modes of growth. The
+   operation can be called between any two operations, e.g. after a large
+   number of keys were removed from a hash table that is reused, in order
+   to release memory.
+   ht          : pointer to an initialized ht_divchn_t struct
+*/
+void ht_divchn_compact(ht_divchn_t *ht);
+
+/**
+   Initializes a cursor for enumerating the keys in a hash table with
+   ht_divchn_next. A cursor is valid until the hash table is modified.
+*/
+void ht_divchn_cursor_init(ht_divchn_cursor_t *cur);
+
+/**
+   Advances a cursor to the next key in a hash table. Returns a pointer to
+   the element associated with the key and sets the pointer pointed to by
+   key to point to the in-table key, or returns NULL if all keys were
+   enumerated. The returned pointer can be dereferenced according to
+   ht_divchn_init and ht_divchn_align.
+   ht          : pointer to an initialized ht_divchn_t struct that was not
+                 modified after the cursor was initialized
+   cur         : pointer to a cursor initialized with ht_divchn_cursor_init
+   key         : pointer to a pointer that is set to point to a key_size
+                 block
+*/
+void *ht_divchn_next(const ht_divchn_t *ht,
+		     ht_divchn_cursor_t *cur,
+		     const void **key);
+
+/**
+   Calls a visit function on each key in a hash table and its associated
+   element. The first argument of visit points to a key_size block, the
+   second argument points to an elt_size block that can be dereferenced
+   according to ht_divchn_init and ht_divchn_align, and the third argument
+   is the arg parameter. The visit function does not modify the hash
+   table, except through the second argument.
+*/
+void ht_divchn_foreach(const ht_divchn_t *ht,
+		       void (*visit)(const void *, void *, void *),
+		       void *arg);
+
+/**
+   Copies the keys of a hash table into an array of num_elts key_size
+   blocks pointed to by keys, and the elements, or pointers to elements,
+   into an array of num_elts elt_size blocks pointed to by elts, s.t. the
+   ith element is associated with the ith key. If keys or elts is NULL,
+   the corresponding array is not written. Returns num_elts.
+*/
+size_t ht_divchn_export(const ht_divchn_t *ht, void *keys, void *elts);
+
+/**
+   Writes a hash table into a file as a relocatable binary image. The
+   image can be loaded with ht_divchn_load by a process on a system with
+   the same size_t representation, byte order, and alignment requirements,
+   with the same cmp_key and rdc_key functions. The elements are required
+   to be within contiguous memory blocks that were copied into the hash
+   table, because pointers are not relocatable. Completes the migration
+   of keys if it is in progress. An error message is provided and an exit
+   is executed if a write is not completed.
+   ht          : pointer to an initialized ht_divchn_t struct
+   file        : pointer to a binary stream open for writing, positioned
+                 at the start of the image
+*/
+void ht_divchn_save(ht_divchn_t *ht, FILE *file);
+
+/**
+   Initializes a hash table from an image written by ht_divchn_save,
+   without rehashing and without an allocation per key. The keys and
+   elements of the hash table are in the image until the first insert,
+   remove, delete, or compact operation builds the chains of the hash
+   table from the image; the image is not written. A loaded hash table is
+   in the default mode of growth. An error message is provided and an exit
+   is executed if the image is not valid on the system.
+   ht          : a pointer to a preallocated block of size
+                 sizeof(ht_divchn_t)
+   image       : pointer to an image aligned as a pointer returned by
+                 malloc or mmap; the image is not modified and remains
+                 valid until ht_divchn_free is called or the chains were
+                 built
+   image_size  : size of the block pointed to by image
+   cmp_key     : cmp_key of the saved hash table, as in ht_divchn_init
+   rdc_key     : rdc_key of the saved hash table, as in ht_divchn_init
+*/
+void ht_divchn_load(ht_divchn_t *ht,
+		    const void *image,
+		    size_t image_size,
+		    int (*cmp_key)(const void *, const void *),
+		    size_t (*rdc_key)(const void *, size_t));
+
+#ifdef HT_DIVCHN_STATS
+/**
+   Copies the statistics of a hash table into a block pointed to by stats.
+   The ith bin of the chain length histogram is the number of slots with
+   i keys, and the last bin also includes the longer chains. During the
+   migration of keys, the previous slots are included. The processor time
+   of a growth or shrinking operation in the incremental mode does not
+   include the migration of keys by the subsequent operations. The
+   num_bytes value does not include the noncontiguous elements and the
+   keys and elements in a loaded image.
+   ht          : pointer to an initialized ht_divchn_t struct
+   stats       : pointer to a preallocated block of size
+                 sizeof(ht_divchn_stats_t)
+*/
+void ht_divchn_stats(const ht_divchn_t *ht, ht_divchn_stats_t *stats);
+#endif
+
 /**
    Frees a hash table and leaves a block of size sizeof(ht_divchn_t)
    pointed to by the ht parameter.
@@ -188,6 +474,8 @@ void ht_divchn_init_helper(void *ht,
 
 void ht_divchn_align_helper(void *ht, size_t alignment);
 
+void ht_divchn_incr_helper(void *ht, int is_incr);
+
 void ht_divchn_insert_helper(void *ht, const void *key, const void *elt);
 
 void *ht_divchn_search_helper(const void *ht, const void *key);
@@ -196,6 +484,46 @@ void ht_divchnn_remove_helper(void *ht, const void *key, void *elt);
 
 void ht_divchn_delete_helper(void *ht, const void *key);
 
+size_t ht_divchn_hash_key_helper(const void *ht, const void *key);
+
+void ht_divchn_insert_hashed_helper(void *ht,
+				    const void *key,
+				    size_t tok,
+				    const void *elt);
+
+void *ht_divchn_search_hashed_helper(const void *ht,
+				     const void *key,
+				     size_t tok);
+
+void ht_divchn_remove_hashed_helper(void *ht,
+				    const void *key,
+				    size_t tok,
+				    void *elt);
+
+void ht_divchn_delete_hashed_helper(void *ht, const void *key, size_t tok);
+
+void ht_divchn_compact_helper(void *ht);
+
+void *ht_divchn_next_helper(const void *ht, void *cur, const void **key);
+
+void ht_divchn_foreach_helper(const void *ht,
+			      void (*visit)(const void *, void *, void *),
+			      void *arg);
+
+size_t ht_divchn_export_helper(const void *ht, void *keys, void *elts);
+
+void ht_divchn_save_helper(void *ht, FILE *file);
+
+void ht_divchn_load_helper(void *ht,
+			   const void *image,
+			   size_t image_size,
+			   int (*cmp_key)(const void *, const void *),
+			   size_t (*rdc_key)(const void *, size_t));
+
+#ifdef HT_DIVCHN_STATS
+void ht_divchn_stats_helper(const void *ht, void *stats);
+#endif
+
 void ht_divchn_free_helper(void *ht);
 
 #endif
@@ -0,0 +1,319 @@
+/**
+   ht-muloa-churn-test.c
+
+   Churn tests of hash tables with generic hash keys and generic elements,
+   based on a multiplication method for hashing and an open addressing
+   method for resolving collisions. The tests compare a hash table with
+   placeholders (ht_muloa) and a hash table with Robin Hood insertion and
+   backward shift deletion without placeholders (ht_mulrh).
+
+   In a churn test, a hash table contains a fixed number of keys, and
+   each churn operation removes a random key and inserts a new key, as in
+   the remove/insert pattern of the tsp algorithm. The test reports the
+   time of churn operations, the number of rehashing operations, and
+   the maximum number of probes across consecutive rounds of churn
+   operations.
+
+   The following command line arguments can be used to customize tests:
+   ht-muloa-churn-test
+      [0, # bits in size_t - 1) : i s.t. # keys in a hash table = 2**i
+      [0, # bits in size_t - 1) : j s.t. # churn operations in a round = 2**j
+      > 0 : k # rounds
+      > 0 : c
+      > 0 : d log base 2 s.t. alpha = c / 2**d <= 1
+
+   usage examples:
+   ./ht-muloa-churn-test
+   ./ht-muloa-churn-test 18
+   ./ht-muloa-churn-test 18 20 8
+   ./ht-muloa-churn-test 16 18 8 29491 15
+
+   ht-muloa-churn-test can be run with any subset of command line arguments
+   in the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99 with the only requirement that CHAR_BIT * sizeof(size_t)
+   is greater or equal to 16 and is even (every bit is required to
+   participate in the value at this time).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "ht-muloa.h"
+#include "ht-mulrh.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "ht-muloa-churn-test\n"
+  "[0, # bits in size_t - 1) : i s.t. # keys in a hash table = 2**i\n"
+  "[0, # bits in size_t - 1) : j s.t. # churn operations in a round = 2**j\n"
+  "> 0 : k # rounds\n"
+  "> 0 : c\n"
+  "> 0 : d log base 2 s.t. alpha = c / 2**d <= 1\n";
+const int C_ARGC_MAX = 6;
+const size_t C_ARGS_DEF[5] = {14, 16, 4, 29491u, 15}; /* alpha ~ 0.9 */
+const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
+
+/**
+   A hash table interface for the churn tests, based on the helper
+   functions of hash tables.
+*/
+typedef struct{
+  const char *name;
+  void *ht;
+  void (*init)(void *,
+	       size_t,
+	       size_t,
+	       size_t,
+	       size_t,
+	       size_t,
+	       int (*)(const void *, const void *),
+	       size_t (*)(const void *, size_t),
+	       void (*)(void *));
+  void (*align)(void *, size_t);
+  void (*insert)(void *, const void *, const void *);
+  void *(*search)(const void *, const void *);
+  void (*remove)(void *, const void *, void *);
+  void (*free)(void *);
+  size_t (*count)(const void *);
+  size_t (*num_occ)(const void *);
+  size_t (*max_num_probes)(const void *);
+} churn_ht_t;
+
+void print_test_result(int res);
+
+/**
+   Accessors of the ht_muloa and ht_mulrh hash tables for the churn tests.
+   The num_occ functions return the number of slots occupied by keys or
+   placeholders. The max_num_probes value of ht_muloa is an upper bound
+   that is reset at rehashing, and the max_num_probes value of ht_mulrh
+   is computed from the probe distances of the keys in the hash table.
+*/
+
+size_t count_muloa(const void *ht){
+  return ((const ht_muloa_t *)ht)->count;
+}
+
+size_t num_occ_muloa(const void *ht){
+  const ht_muloa_t *h = ht;
+  return h->num_elts + h->num_phs;
+}
+
+size_t max_num_probes_muloa(const void *ht){
+  return ((const ht_muloa_t *)ht)->max_num_probes;
+}
+
+size_t count_mulrh(const void *ht){
+  return ((const ht_mulrh_t *)ht)->count;
+}
+
+size_t num_occ_mulrh(const void *ht){
+  return ((const ht_mulrh_t *)ht)->num_elts;
+}
+
+size_t max_num_probes_mulrh(const void *ht){
+  size_t i;
+  size_t ret = 0;
+  const ht_mulrh_t *h = ht;
+  for (i = 0; i < h->count; i++){
+    if (h->dists[i] > ret) ret = h->dists[i];
+  }
+  return ret;
+}
+
+/**
+   Runs a churn test on a hash table with size_t keys and size_t elements.
+   The keys in the hash table are in the live array. A rehashing operation
+   is detected as an increase of the count or a decrease of the number of
+   occupied slots of the hash table after a remove/insert operation.
+*/
+void churn(churn_ht_t *cht,
+	   size_t num_keys,
+	   size_t num_ops,
+	   size_t num_rounds,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   const size_t *rnd_ixs){
+  int res = 1;
+  size_t i, j, ix;
+  size_t key, next_key;
+  size_t count, num_occ, num_rehashes;
+  size_t elt;
+  size_t *live = NULL;
+  clock_t t;
+  live = malloc_perror(num_keys, sizeof(size_t));
+  cht->init(cht->ht,
+	    sizeof(size_t),
+	    sizeof(size_t),
+	    0,
+	    alpha_n,
+	    log_alpha_d,
+	    NULL,
+	    NULL,
+	    NULL);
+  cht->align(cht->ht, sizeof(size_t));
+  for (i = 0; i < num_keys; i++){
+    live[i] = i;
+    cht->insert(cht->ht, &live[i], &live[i]);
+  }
+  next_key = num_keys;
+  printf("\t%s\n", cht->name);
+  for (i = 0; i < num_rounds; i++){
+    num_rehashes = 0;
+    count = cht->count(cht->ht);
+    num_occ = cht->num_occ(cht->ht);
+    t = clock();
+    for (j = 0; j < num_ops; j++){
+      ix = rnd_ixs[j];
+      cht->remove(cht->ht, &live[ix], &elt);
+      live[ix] = next_key;
+      cht->insert(cht->ht, &live[ix], &live[ix]);
+      next_key++;
+      if (cht->count(cht->ht) > count ||
+	  cht->num_occ(cht->ht) < num_occ){
+	num_rehashes++;
+	count = cht->count(cht->ht);
+      }
+      num_occ = cht->num_occ(cht->ht);
+    }
+    t = clock() - t;
+    printf("\t\tround %lu: churn time %.4f seconds, rehashes %lu, "
+	   "max # probes %lu, count %lu\n",
+	   TOLU(i), (float)t / CLOCKS_PER_SEC, TOLU(num_rehashes),
+	   TOLU(cht->max_num_probes(cht->ht)), TOLU(cht->count(cht->ht)));
+  }
+  t = clock();
+  for (i = 0; i < num_keys; i++){
+    res *= (*(size_t *)cht->search(cht->ht, &live[i]) == live[i]);
+  }
+  t = clock() - t;
+  printf("\t\tin ht search time:              "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  t = clock();
+  for (i = 0; i < num_keys; i++){
+    key = next_key + i;
+    res *= (cht->search(cht->ht, &key) == NULL);
+  }
+  t = clock() - t;
+  printf("\t\tnot in ht search time:          "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  count = 0;
+  for (key = 0; key < next_key; key++){
+    count += (cht->search(cht->ht, &key) != NULL);
+  }
+  res *= (count == num_keys);
+  cht->free(cht->ht);
+  printf("\t\tcorrectness:                    ");
+  print_test_result(res);
+  free(live);
+  live = NULL;
+}
+
+/**
+   Runs churn tests on ht_muloa and ht_mulrh with the same sequence of
+   removed keys.
+*/
+void run_churn_test(size_t log_keys,
+		    size_t log_ops,
+		    size_t num_rounds,
+		    size_t alpha_n,
+		    size_t log_alpha_d){
+  size_t i;
+  size_t num_keys = pow_two_perror(log_keys);
+  size_t num_ops = pow_two_perror(log_ops);
+  size_t *rnd_ixs = NULL;
+  ht_muloa_t ht_muloa;
+  ht_mulrh_t ht_mulrh;
+  churn_ht_t cht;
+  rnd_ixs = malloc_perror(num_ops, sizeof(size_t));
+  for (i = 0; i < num_ops; i++){
+    rnd_ixs[i] = DRAND() * (num_keys - 1);
+  }
+  printf("Run a churn test with %lu keys, %lu remove/insert operations "
+	 "per round, load factor upper bound: %.4f\n",
+	 TOLU(num_keys), TOLU(num_ops),
+	 (float)alpha_n / pow_two_perror(log_alpha_d));
+  cht.name = "ht_muloa";
+  cht.ht = &ht_muloa;
+  cht.init = ht_muloa_init_helper;
+  cht.align = ht_muloa_align_helper;
+  cht.insert = ht_muloa_insert_helper;
+  cht.search = ht_muloa_search_helper;
+  cht.remove = ht_muloa_remove_helper;
+  cht.free = ht_muloa_free_helper;
+  cht.count = count_muloa;
+  cht.num_occ = num_occ_muloa;
+  cht.max_num_probes = max_num_probes_muloa;
+  churn(&cht, num_keys, num_ops, num_rounds, alpha_n, log_alpha_d, rnd_ixs);
+  cht.name = "ht_mulrh";
+  cht.ht = &ht_mulrh;
+  cht.init = ht_mulrh_init_helper;
+  cht.align = ht_mulrh_align_helper;
+  cht.insert = ht_mulrh_insert_helper;
+  cht.search = ht_mulrh_search_helper;
+  cht.remove = ht_mulrh_remove_helper;
+  cht.free = ht_mulrh_free_helper;
+  cht.count = count_mulrh;
+  cht.num_occ = num_occ_mulrh;
+  cht.max_num_probes = max_num_probes_mulrh;
+  churn(&cht, num_keys, num_ops, num_rounds, alpha_n, log_alpha_d, rnd_ixs);
+  free(rnd_ixs);
+  rnd_ixs = NULL;
+}
+
+/**
+   Prints a test result.
+*/
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_MAX){
+    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_MAX - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_MAX - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_FULL_BIT - 2 ||
+      args[1] > C_FULL_BIT - 2 ||
+      args[2] < 1 ||
+      args[3] < 1 ||
+      args[4] > C_FULL_BIT - 1 ||
+      args[3] > pow_two_perror(args[4])){
+    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  run_churn_test(args[0], args[1], args[2], args[3], args[4]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -19,6 +19,14 @@
       [0, 1] : on/off insert search uint_ptr test
       [0, 1] : on/off remove delete uint_ptr test
       [0, 1] : on/off corner cases test
+      [0, 1] : on/off modes uint test
+      [0, 1] : on/off batch hashed uint test
+      [0, 1] : on/off incr uint test
+      [0, 1] : on/off shrink compact uint test
+      [0, 1] : on/off cursor export uint test
+      [0, 1] : on/off save load uint test
+      [0, 1] : on/off stats uint test (if compiled with HT_MULOA_STATS)
+      [0, 1] : on/off tune uint test
 
    usage examples:
    ./ht-muloa-test
@@ -26,6 +34,15 @@
    ./ht-muloa-test 17 5 6 
    ./ht-muloa-test 19 0 2 3000 4000 15 10
    ./ht-muloa-test 19 0 2 3000 4000 15 10 1 1 0 0 0
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 1
+   ./ht-muloa-test 20 0 0 16384 16384 15 1 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 0 0 0 0 0 1
+   ./ht-muloa-test 19 0 2 3000 4000 15 10 0 0 0 0 0 0 0 0 0 0 0 0 1
 
    ht-muloa-test can be run with any subset of command line arguments in the
    above-defined order. If the (i + 1)th argument is specified then the ith
@@ -67,18 +84,32 @@ const char *C_USAGE =
   "[0, # bits in size_t) : b s.t. k * 2**a <= key size <= k * 2**b\n"
   "> 0 : c\n"
   "> 0 : d\n"
-  "> 0 : e log base 2 s.t. c <= d <= 2**e\n"
-  "> 0 : f s.t. c / 2**e <= alpha <= d / 2**e, in f steps\n"
-  "[0, 1] : on/off insert search uint test\n"
-  "[0, 1] : on/off remove delete uint test\n"
-  "[0, 1] : on/off insert search uint_ptr test\n"
-  "[0, 1] : on/off remove delete uint_ptr test\n"
-  "[0, 1] : on/off corner cases test\n";
-const int C_ARGC_MAX = 13;
-const size_t C_ARGS_DEF[12] = {14, 0, 2, 3277, 32768u, 15, 8, 1, 1, 1, 1, 1};
+  "> 0 : e log base 2\n"
+  "> 0 : f s.t. c / 2**e <= alpha <= d / 2**e, in f steps\n";
+const char *C_USAGE_FLAGS =
+  "[0, 1] : insert search uint\n"
+  "[0, 1] : remove delete uint\n"
+  "[0, 1] : insert search uint_ptr\n"
+  "[0, 1] : remove delete uint_ptr\n"
+  "[0, 1] : corner cases\n"
+  "[0, 1] : modes uint\n"
+  "[0, 1] : batch hashed uint\n"
+  "[0, 1] : incr uint\n"
+  "[0, 1] : shrink compact uint\n"
+  "[0, 1] : cursor export uint\n"
+  "[0, 1] : save load uint\n"
+  "[0, 1] : stats uint\n"
+  "[0, 1] : tune uint\n";
+const int C_ARGC_MAX = 21;
+const size_t C_ARGS_DEF[20] = {14, 0, 2, 3277, 32768u, 15, 8,
+			       1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
 const size_t C_SIZE_MAX = (size_t)-1;
 const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 
+/* tune test */
+const size_t C_TUNE_KEY_STRIDE = 1024; /* ids of vertices in blocks */
+const size_t C_TUNE_SAMPLE_DIV = 4; /* sample of frequent keys */
+
 /* corner cases test */
 const unsigned char C_CORNER_KEY_A = 2;
 const unsigned char C_CORNER_KEY_B = 1;
@@ -105,6 +136,83 @@ void remove_delete(size_t num_ins,
 		   void (*new_elt)(void *, size_t),
 		   size_t (*val_elt)(const void *),
 		   void (*free_elt)(void *));
+void modes(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+void batch(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+void incr(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void shrink(size_t num_ins,
+	    size_t key_size,
+	    size_t elt_size,
+	    size_t elt_alignment,
+	    size_t alpha_n,
+	    size_t log_alpha_d,
+	    void (*new_elt)(void *, size_t),
+	    size_t (*val_elt)(const void *),
+	    void (*free_elt)(void *));
+void iter(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void save_load(size_t num_ins,
+	       size_t key_size,
+	       size_t elt_size,
+	       size_t elt_alignment,
+	       size_t alpha_n,
+	       size_t log_alpha_d,
+	       void (*new_elt)(void *, size_t),
+	       size_t (*val_elt)(const void *),
+	       void (*free_elt)(void *));
+#ifdef HT_MULOA_STATS
+void stats(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *));
+#endif
+void tune(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *));
+void *read_image(FILE *file, size_t *size);
+int is_empty_or_ph(const ht_muloa_t *ht, size_t i);
+void swap(void *a, void *b, size_t size);
 void *ptr(const void *block, size_t i, size_t size);
 void print_test_result(int res);
 
@@ -572,7 +680,7 @@ void remove_key_elts(ht_muloa_t *ht,
     k += ht->key_size;
   }
   for (i = 0; i < ht->count; i++){
-    if (ht->key_elts[i] != NULL) *res *= (ht->key_elts[i]->fval == 1);
+    *res *= is_empty_or_ph(ht, i);
   }
   printf("\t\tremove 1/2 elements time:       "
 	 "%.4f seconds\n", (float)t_first_half / CLOCKS_PER_SEC);
@@ -629,7 +737,7 @@ void delete_key_elts(ht_muloa_t *ht,
     k += ht->key_size;
   }
   for (i = 0; i < ht->count; i++){
-    if (ht->key_elts[i] != NULL) *res *= (ht->key_elts[i]->fval == 1);
+    *res *= is_empty_or_ph(ht, i);
   }
   printf("\t\tdelete 1/2 elements time:       "
 	 "%.4f seconds\n", (float)t_first_half / CLOCKS_PER_SEC);
@@ -687,56 +795,1564 @@ void remove_delete(size_t num_ins,
 }
 
 /**
-   Runs a corner cases test.
+   Runs a test of the pointer and inline modes of storage on distinct keys
+   and size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds. The same keys and elements are used in both modes. The
+   inline mode is expected to reduce search and remove times if the slots
+   do not fit in cache, e.g. with 2**20 inserts, and to increase the time
+   of insertions with growth at low load factor upper bounds, because
+   larger slots are moved.
 */
-void run_corner_cases_test(int log_ins){
+void run_modes_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_{insert, search, remove, free} test in the "
+	   "pointer and inline modes on distinct %lu-byte keys and size_t "
+	   "elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      modes(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of the pointer and inline modes of
+   storage. Searches are performed in a random order of keys, because
+   in the pointer mode the blocks of key elements, inserted in the
+   order of keys, are allocated in the same order on some systems.
+*/
+
+void modes(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
   int res = 1;
-  size_t elt;
+  int is_inline;
+  size_t i, j;
+  size_t val;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  unsigned char *nin_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  ht_muloa_t ht;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  nin_keys = malloc_perror(num_ins, key_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    key = ptr(nin_keys, i, key_size);
+    val = i + num_ins;
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &val, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  for (is_inline = 0; is_inline <= 1; is_inline++){
+    printf("\t\t%s mode\n", is_inline ? "inline" : "pointer");
+    if (is_inline){
+      /* as through the init helper of a hash table parameter */
+      ht_muloa_init_inline_helper(&ht,
+				  key_size,
+				  elt_size,
+				  0,
+				  alpha_n,
+				  log_alpha_d,
+				  NULL,
+				  NULL,
+				  free_elt);
+    }else{
+      ht_muloa_init(&ht,
+		    key_size,
+		    elt_size,
+		    0,
+		    alpha_n,
+		    log_alpha_d,
+		    NULL,
+		    NULL,
+		    free_elt);
+      res *= (ht.slot_size == 0); /* pointer mode by default */
+    }
+    ht_muloa_align(&ht, elt_alignment);
+    res *= ((ht.slot_size > 0) == is_inline);
+    insert_keys_elts(&ht, keys, elts, num_ins, &res);
+    search_in_ht(&ht, rnd_keys, rnd_elts, num_ins, val_elt, &res);
+    search_nin_ht(&ht, nin_keys, num_ins, &res);
+    remove_key_elts(&ht, rnd_keys, rnd_elts, num_ins, val_elt, &res);
+    free_ht(&ht);
+  }
+  printf("\t\tmodes correctness:              ");
+  print_test_result(res);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  free(nin_keys);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+  nin_keys = NULL;
+}
+
+/**
+   Runs a test of the batch operations and the operations with hash tokens
+   in the pointer and inline modes of storage on distinct keys and size_t
+   elements across key sizes >= sizeof(size_t) and load factor upper
+   bounds. The operations are compared to the insert and search operations
+   on single keys with the same keys and elements.
+*/
+void run_batch_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
   size_t elt_size = sizeof(size_t);
   size_t elt_alignment = sizeof(size_t);
-  size_t i, num_ins;
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_{insert, search}_{batch, hashed} test in the "
+	   "pointer and inline modes on distinct %lu-byte keys and size_t "
+	   "elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      batch(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of the batch operations and the operations
+   with hash tokens. In each mode, a first hash table is built and searched
+   with single key operations, a second hash table with batch operations,
+   and a third hash table with the operations with hash tokens computed
+   prior to the operations. The searches are performed in a random order
+   of keys.
+*/
+
+void batch(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  int is_inline;
+  size_t i, j;
+  size_t val;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  unsigned char *nin_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  void **res_elts = NULL;
+  size_t *toks = NULL;
+  size_t *rnd_toks = NULL;
+  size_t *nin_toks = NULL;
   ht_muloa_t ht;
-  ht_muloa_init(&ht,
-		C_CORNER_KEY_SIZE,
-		elt_size,
-		0,
-		C_CORNER_ALPHA_N,
-		C_CORNER_LOG_ALPHA_D,
-		NULL,
-		NULL,
-		NULL);
-  ht_muloa_align(&ht, elt_alignment);
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  nin_keys = malloc_perror(num_ins, key_size);
+  res_elts = malloc_perror(num_ins, sizeof(void *));
+  toks = malloc_perror(num_ins, sizeof(size_t));
+  rnd_toks = malloc_perror(num_ins, sizeof(size_t));
+  nin_toks = malloc_perror(num_ins, sizeof(size_t));
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    key = ptr(nin_keys, i, key_size);
+    val = i + num_ins;
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &val, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  for (is_inline = 0; is_inline <= 1; is_inline++){
+    printf("\t\t%s mode, single\n", is_inline ? "inline" : "pointer");
+    ht_muloa_init(&ht,
+		  key_size,
+		  elt_size,
+		  0,
+		  alpha_n,
+		  log_alpha_d,
+		  NULL,
+		  NULL,
+		  free_elt);
+    ht_muloa_align(&ht, elt_alignment);
+    ht_muloa_inline(&ht, is_inline);
+    insert_keys_elts(&ht, keys, elts, num_ins, &res);
+    search_in_ht(&ht, rnd_keys, rnd_elts, num_ins, val_elt, &res);
+    search_nin_ht(&ht, nin_keys, num_ins, &res);
+    free_ht(&ht);
+    printf("\t\t%s mode, batch\n", is_inline ? "inline" : "pointer");
+    ht_muloa_init(&ht,
+		  key_size,
+		  elt_size,
+		  0,
+		  alpha_n,
+		  log_alpha_d,
+		  NULL,
+		  NULL,
+		  free_elt);
+    ht_muloa_align(&ht, elt_alignment);
+    ht_muloa_inline(&ht, is_inline);
+    t = clock();
+    ht_muloa_insert_batch(&ht, keys, elts, num_ins);
+    t = clock() - t;
+    printf("\t\tinsert w/ growth time           "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    res *= (ht.num_elts == num_ins);
+    t = clock();
+    ht_muloa_search_batch(&ht, rnd_keys, num_ins, res_elts);
+    t = clock() - t;
+    printf("\t\tin ht search time:              "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    for (i = 0; i < num_ins; i++){
+      res *= (res_elts[i] != NULL &&
+	      val_elt(ptr(rnd_elts, i, elt_size)) == val_elt(res_elts[i]));
+    }
+    t = clock();
+    ht_muloa_search_batch(&ht, nin_keys, num_ins, res_elts);
+    t = clock() - t;
+    printf("\t\tnot in ht search time:          "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    for (i = 0; i < num_ins; i++){
+      res *= (res_elts[i] == NULL);
+    }
+    for (i = 0; i < num_ins; i++){
+      res *= (val_elt(ht_muloa_search(&ht, ptr(keys, i, key_size))) == i);
+    }
+    free_ht(&ht);
+    printf("\t\t%s mode, hashed\n", is_inline ? "inline" : "pointer");
+    ht_muloa_init(&ht,
+		  key_size,
+		  elt_size,
+		  0,
+		  alpha_n,
+		  log_alpha_d,
+		  NULL,
+		  NULL,
+		  free_elt);
+    ht_muloa_align(&ht, elt_alignment);
+    ht_muloa_inline(&ht, is_inline);
+    for (i = 0; i < num_ins; i++){
+      toks[i] = ht_muloa_hash_key(&ht, ptr(keys, i, key_size));
+      rnd_toks[i] = ht_muloa_hash_key(&ht, ptr(rnd_keys, i, key_size));
+      nin_toks[i] = ht_muloa_hash_key(&ht, ptr(nin_keys, i, key_size));
+    }
+    t = clock();
+    for (i = 0; i < num_ins; i++){
+      ht_muloa_insert_hashed(&ht,
+			     ptr(keys, i, key_size),
+			     toks[i],
+			     ptr(elts, i, elt_size));
+    }
+    t = clock() - t;
+    printf("\t\tinsert w/ growth time           "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    res *= (ht.num_elts == num_ins);
+    t = clock();
+    for (i = 0; i < num_ins; i++){
+      res_elts[i] =
+	ht_muloa_search_hashed(&ht, ptr(rnd_keys, i, key_size), rnd_toks[i]);
+    }
+    t = clock() - t;
+    printf("\t\tin ht search time:              "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    for (i = 0; i < num_ins; i++){
+      res *= (res_elts[i] != NULL &&
+	      val_elt(ptr(rnd_elts, i, elt_size)) == val_elt(res_elts[i]));
+      res *= (ht_muloa_search_hashed(&ht,
+				     ptr(nin_keys, i, key_size),
+				     nin_toks[i]) == NULL);
+    }
+    for (i = 0; i < num_ins; i++){
+      ht_muloa_remove_hashed(&ht,
+			     ptr(rnd_keys, i, key_size),
+			     rnd_toks[i],
+			     &val);
+      res *= (val_elt(ptr(rnd_elts, i, elt_size)) == val_elt(&val));
+    }
+    res *= (ht.num_elts == 0);
+    free_ht(&ht);
+  }
+  printf("\t\tbatch hashed correctness:       ");
+  print_test_result(res);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  free(nin_keys);
+  free(res_elts);
+  free(toks);
+  free(rnd_toks);
+  free(nin_toks);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+  nin_keys = NULL;
+  res_elts = NULL;
+  toks = NULL;
+  rnd_toks = NULL;
+  nin_toks = NULL;
+}
+
+/**
+   Runs a test of the incremental mode of growth in the pointer and inline
+   modes of storage on distinct keys and size_t elements across key sizes
+   >= sizeof(size_t) and load factor upper bounds. The maximal time of an
+   insert operation, which includes the time of a rehashing step in the
+   default mode, is compared to the maximal time of an insert operation
+   in the incremental mode.
+*/
+void run_incr_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
   num_ins = pow_two_perror(log_ins);
-  printf("Run corner cases test --> ");
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_incr test in the pointer and inline modes on "
+	   "distinct %lu-byte keys and size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      incr(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of the incremental mode of growth. Each
+   insert operation is timed, and after each insert operation a previously
+   inserted key is searched. Then the keys are updated, searched, removed,
+   reinserted, and deleted in a random order, with the operations
+   interleaved with the migration of keys in the incremental mode, which
+   also follows the cleaning of placeholders.
+*/
+void incr(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  int is_inline, is_incr;
+  size_t i, j;
+  size_t val;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  unsigned char *nin_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  const void *elt = NULL;
+  ht_muloa_t ht;
+  clock_t t, t_op, t_max;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  nin_keys = malloc_perror(num_ins, key_size);
   for (i = 0; i < num_ins; i++){
-    elt = i;
-    ht_muloa_insert(&ht, &C_CORNER_KEY_A, &elt);
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    key = ptr(nin_keys, i, key_size);
+    val = i + num_ins;
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &val, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
   }
-  res *= (ht.num_elts == 1 &&
-	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_A) == elt &&
-	  ht_muloa_search(&ht, &C_CORNER_KEY_B) == NULL);
-  ht_muloa_insert(&ht, &C_CORNER_KEY_B, &elt);
-  res *= (ht.count == C_CORNER_HT_COUNT &&
-	  ht.num_elts == 2 &&
-	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_A) == elt &&
-	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_B) == elt);
-  ht_muloa_delete(&ht, &C_CORNER_KEY_A);
-  res *= (ht.count == C_CORNER_HT_COUNT &&
-	  ht.num_elts == 1 &&
-	  ht_muloa_search(&ht, &C_CORNER_KEY_A) == NULL &&
-	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_B) == elt);
-  ht_muloa_delete(&ht, &C_CORNER_KEY_B);
-  res *= (ht.count == C_CORNER_HT_COUNT &&
-	  ht.num_elts == 0 &&
-	  ht_muloa_search(&ht, &C_CORNER_KEY_A) == NULL &&
-	  ht_muloa_search(&ht, &C_CORNER_KEY_B) == NULL);
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  for (is_inline = 0; is_inline <= 1; is_inline++){
+    for (is_incr = 0; is_incr <= 1; is_incr++){
+      printf("\t\t%s mode, %s\n",
+	     is_inline ? "inline" : "pointer",
+	     is_incr ? "incremental growth" : "growth in a single step");
+      ht_muloa_init(&ht,
+		    key_size,
+		    elt_size,
+		    0,
+		    alpha_n,
+		    log_alpha_d,
+		    NULL,
+		    NULL,
+		    free_elt);
+      ht_muloa_align(&ht, elt_alignment);
+      ht_muloa_inline(&ht, is_inline);
+      ht_muloa_incr(&ht, is_incr);
+      t_max = 0;
+      t = clock();
+      for (i = 0; i < num_ins; i++){
+	t_op = clock();
+	ht_muloa_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+	t_op = clock() - t_op;
+	if (t_op > t_max) t_max = t_op;
+      }
+      t = clock() - t;
+      printf("\t\tinsert w/ growth time           "
+	     "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+      printf("\t\tmax insert time                 "
+	     "%.6f seconds\n", (float)t_max / CLOCKS_PER_SEC);
+      res *= (ht.num_elts == num_ins);
+      ht_muloa_free(&ht);
+      ht_muloa_init(&ht,
+		    key_size,
+		    elt_size,
+		    0,
+		    alpha_n,
+		    log_alpha_d,
+		    NULL,
+		    NULL,
+		    free_elt);
+      ht_muloa_align(&ht, elt_alignment);
+      ht_muloa_inline(&ht, is_inline);
+      ht_muloa_incr(&ht, is_incr);
+      for (i = 0; i < num_ins; i++){
+	ht_muloa_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+	elt = ht_muloa_search(&ht, ptr(keys, i / 2, key_size));
+	res *= (elt != NULL && val_elt(elt) == i / 2);
+      }
+      for (i = 0; i < num_ins; i++){
+	ht_muloa_insert(&ht,
+			ptr(rnd_keys, i, key_size),
+			ptr(rnd_elts, i, elt_size));
+	elt = ht_muloa_search(&ht, ptr(rnd_keys, i, key_size));
+	res *= (elt != NULL &&
+		val_elt(elt) == val_elt(ptr(rnd_elts, i, elt_size)));
+	res *= (ht_muloa_search(&ht, ptr(nin_keys, i, key_size)) == NULL);
+      }
+      res *= (ht.num_elts == num_ins);
+      for (i = 0; i < num_ins; i++){
+	ht_muloa_remove(&ht, ptr(rnd_keys, i, key_size), &val);
+	res *= (val_elt(&val) == val_elt(ptr(rnd_elts, i, elt_size)));
+	res *= (ht_muloa_search(&ht, ptr(rnd_keys, i, key_size)) == NULL);
+	if (i % 2){
+	  /* placeholders accumulate and are cleaned */
+	  ht_muloa_insert(&ht,
+			  ptr(rnd_keys, i - 1, key_size),
+			  ptr(rnd_elts, i - 1, elt_size));
+	}
+      }
+      res *= (ht.num_elts == num_ins / 2);
+      for (i = 0; i < num_ins; i += 2){
+	elt = ht_muloa_search(&ht, ptr(rnd_keys, i, key_size));
+	res *= (elt != NULL &&
+		val_elt(elt) == val_elt(ptr(rnd_elts, i, elt_size)));
+	ht_muloa_delete(&ht, ptr(rnd_keys, i, key_size));
+	res *= (ht_muloa_search(&ht, ptr(rnd_keys, i, key_size)) == NULL);
+      }
+      res *= (ht.num_elts == 0);
+      for (i = 0; i < ht.count; i++){
+	res *= is_empty_or_ph(&ht, i);
+      }
+      ht_muloa_free(&ht);
+    }
+  }
+  printf("\t\tincremental correctness:        ");
   print_test_result(res);
-  free_ht(&ht);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  free(nin_keys);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+  nin_keys = NULL;
 }
 
 /**
-   Helper functions.
+   Runs a test of shrinking and compaction in the pointer and inline modes
+   of storage and in both modes of growth on distinct keys and size_t
+   elements across key sizes >= sizeof(size_t) and load factor upper
+   bounds.
 */
+void run_shrink_uint_test(size_t log_ins,
+			  size_t log_key_start,
+			  size_t log_key_end,
+			  size_t alpha_n_start,
+			  size_t alpha_n_end,
+			  size_t log_alpha_d,
+			  size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_{remove, compact} shrinking test in the pointer "
+	   "and inline modes on distinct %lu-byte keys and size_t "
+	   "elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      shrink(num_ins,
+	     key_size,
+	     elt_size,
+	     elt_alignment,
+	     alpha_n,
+	     log_alpha_d,
+	     new_uint,
+	     val_uint,
+	     NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of shrinking and compaction. All but
+   1/16 of the keys are removed in a random order, which shrinks the hash
+   table, and the remaining keys are searched before and after the hash
+   table is compacted. Then the keys are reinserted and deleted, which
+   returns the hash table to its count at initialization, including a
+   count set according to min_num.
+*/
+void shrink(size_t num_ins,
+	    size_t key_size,
+	    size_t elt_size,
+	    size_t elt_alignment,
+	    size_t alpha_n,
+	    size_t log_alpha_d,
+	    void (*new_elt)(void *, size_t),
+	    size_t (*val_elt)(const void *),
+	    void (*free_elt)(void *)){
+  int res = 1;
+  int is_inline, is_incr;
+  size_t i, j;
+  size_t val;
+  size_t init_count, peak_count, half_max_sum, min_num;
+  size_t num_rem = num_ins - num_ins / 16;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *rnd_keys = NULL;
+  void *elts = NULL;
+  void *rnd_elts = NULL;
+  const void *elt = NULL;
+  ht_muloa_t ht;
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  rnd_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  rnd_elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  memcpy(rnd_keys, keys, num_ins * key_size);
+  memcpy(rnd_elts, elts, num_ins * elt_size);
+  for (i = num_ins - 1; i > 0; i--){
+    j = DRAND() * i; /* [0, i] */
+    swap(ptr(rnd_keys, i, key_size), ptr(rnd_keys, j, key_size), key_size);
+    swap(ptr(rnd_elts, i, elt_size), ptr(rnd_elts, j, elt_size), elt_size);
+  }
+  for (is_inline = 0; is_inline <= 1; is_inline++){
+    for (is_incr = 0; is_incr <= 1; is_incr++){
+      printf("\t\t%s mode, %s\n",
+	     is_inline ? "inline" : "pointer",
+	     is_incr ? "incremental growth" : "growth in a single step");
+      for (min_num = 0; min_num <= num_ins; min_num += num_ins){
+	ht_muloa_init(&ht,
+		      key_size,
+		      elt_size,
+		      min_num,
+		      alpha_n,
+		      log_alpha_d,
+		      NULL,
+		      NULL,
+		      free_elt);
+	ht_muloa_align(&ht, elt_alignment);
+	ht_muloa_inline(&ht, is_inline);
+	ht_muloa_incr(&ht, is_incr);
+	init_count = ht.count;
+	for (i = 0; i < num_ins; i++){
+	  ht_muloa_insert(&ht,
+			  ptr(keys, i, key_size),
+			  ptr(elts, i, elt_size));
+	}
+	peak_count = ht.count;
+	t = clock();
+	for (i = 0; i < num_rem; i++){
+	  ht_muloa_remove(&ht, ptr(rnd_keys, i, key_size), &val);
+	  res *= (val_elt(&val) == val_elt(ptr(rnd_elts, i, elt_size)));
+	}
+	t = clock() - t;
+	if (min_num == 0){
+	  printf("\t\tremove w/ shrinking time        "
+		 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+	}
+	res *= (ht.num_elts == num_ins - num_rem);
+	res *= (min_num > 0 || num_rem == 0 || peak_count == init_count ||
+		ht.count < peak_count);
+	res *= (ht.count >= init_count);
+	t = clock();
+	ht_muloa_compact(&ht);
+	t = clock() - t;
+	if (min_num == 0){
+	  printf("\t\tcompact time                    "
+		 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+	}
+	/* max_sum at the half count, < half count */
+	half_max_sum = (ht.count / 2 * alpha_n) >> log_alpha_d;
+	if (half_max_sum >= ht.count / 2) half_max_sum = ht.count / 2 - 1;
+	res *= (ht.num_phs == 0 &&
+		ht.num_elts <= ht.max_sum &&
+		ht.count >= init_count &&
+		(ht.count == init_count || ht.num_elts > half_max_sum));
+	for (i = 0; i < num_ins; i++){
+	  elt = ht_muloa_search(&ht, ptr(rnd_keys, i, key_size));
+	  if (i < num_rem){
+	    res *= (elt == NULL);
+	  }else{
+	    res *= (elt != NULL &&
+		    val_elt(elt) == val_elt(ptr(rnd_elts, i, elt_size)));
+	  }
+	}
+	for (i = 0; i < num_rem; i++){
+	  ht_muloa_insert(&ht,
+			  ptr(rnd_keys, i, key_size),
+			  ptr(rnd_elts, i, elt_size));
+	}
+	res *= (ht.num_elts == num_ins);
+	for (i = 0; i < num_ins; i++){
+	  ht_muloa_delete(&ht, ptr(rnd_keys, i, key_size));
+	}
+	res *= (ht.num_elts == 0 && ht.count == init_count);
+	ht_muloa_free(&ht);
+      }
+    }
+  }
+  printf("\t\tshrink compact correctness:     ");
+  print_test_result(res);
+  free(keys);
+  free(rnd_keys);
+  free(elts);
+  free(rnd_elts);
+  keys = NULL;
+  rnd_keys = NULL;
+  elts = NULL;
+  rnd_elts = NULL;
+}
+
+/**
+   Runs a test of the cursor, foreach, and export operations in the pointer
+   and inline modes on distinct keys and size_t elements across key sizes
+   >= sizeof(size_t) and load factor upper bounds.
+*/
+void run_iter_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_{next, foreach, export} test in the pointer "
+	   "and inline modes on distinct %lu-byte keys and size_t "
+	   "elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      iter(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Accumulates the sum of the values of the visited elements and the
+   number of visited keys in the foreach test.
+*/
+typedef struct{
+  size_t sum;
+  size_t num;
+  size_t (*val_elt)(const void *);
+} visit_acc_t;
+
+void visit_acc(const void *key, void *elt, void *arg){
+  visit_acc_t *acc = arg;
+  acc->sum += acc->val_elt(elt);
+  acc->num++;
+  (void)key;
+}
+
+/**
+   Returns the distinct non-random sizeof(size_t)-sized block of a key.
+*/
+size_t key_id(const void *key, size_t key_size){
+  size_t id;
+  memcpy(&id, (const char *)key + key_size - sizeof(size_t), sizeof(size_t));
+  return id;
+}
+
+/**
+   Helper function for the test of the cursor, foreach, and export
+   operations. In the incremental mode, the insertion of keys stops after
+   the first half of the keys are inserted and a migration of keys is in
+   progress, if such a state is reached. Then 1/16 of the inserted keys
+   are removed, which leaves placeholders. Each remaining key is required
+   to be enumerated exactly once, with its associated element.
+*/
+void iter(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  int is_inline, is_incr;
+  size_t i, j, id;
+  size_t val, num, sum;
+  size_t num_put, num_rem;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *exp_keys = NULL;
+  unsigned char *seen = NULL;
+  void *elts = NULL;
+  void *exp_elts = NULL;
+  const void *cur_key = NULL;
+  void *elt = NULL;
+  visit_acc_t acc;
+  ht_muloa_cursor_t cur;
+  ht_muloa_t ht;
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  exp_keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  exp_elts = malloc_perror(num_ins, elt_size);
+  seen = malloc_perror(num_ins, 1);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (is_inline = 0; is_inline <= 1; is_inline++){
+    for (is_incr = 0; is_incr <= 1; is_incr++){
+      printf("\t\t%s mode, %s\n",
+	     is_inline ? "inline" : "pointer",
+	     is_incr ? "incremental growth" : "growth in a single step");
+      ht_muloa_init(&ht,
+		    key_size,
+		    elt_size,
+		    0,
+		    alpha_n,
+		    log_alpha_d,
+		    NULL,
+		    NULL,
+		    free_elt);
+      ht_muloa_align(&ht, elt_alignment);
+      ht_muloa_inline(&ht, is_inline);
+      ht_muloa_incr(&ht, is_incr);
+      num_put = 0;
+      while (num_put < num_ins &&
+	     !(num_put >= num_ins / 2 && ht.prev_count > 0)){
+	ht_muloa_insert(&ht,
+			ptr(keys, num_put, key_size),
+			ptr(elts, num_put, elt_size));
+	num_put++;
+      }
+      num_rem = num_put / 16;
+      for (i = 0; i < num_rem; i++){
+	ht_muloa_remove(&ht, ptr(keys, i, key_size), &val);
+      }
+      sum = 0;
+      for (i = num_rem; i < num_put; i++){
+	sum += i;
+      }
+      memset(seen, 0, num_ins);
+      num = 0;
+      t = clock();
+      ht_muloa_cursor_init(&cur);
+      while ((elt = ht_muloa_next(&ht, &cur, &cur_key)) != NULL){
+	id = key_id(cur_key, key_size);
+	res *= (id >= num_rem && id < num_put && !seen[id] &&
+		val_elt(elt) == id);
+	if (id < num_ins) seen[id] = 1;
+	num++;
+      }
+      t = clock() - t;
+      printf("\t\tcursor time                     "
+	     "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+      res *= (num == num_put - num_rem);
+      acc.sum = 0;
+      acc.num = 0;
+      acc.val_elt = val_elt;
+      ht_muloa_foreach(&ht, visit_acc, &acc);
+      res *= (acc.num == num_put - num_rem && acc.sum == sum);
+      t = clock();
+      num = ht_muloa_export(&ht, exp_keys, exp_elts);
+      t = clock() - t;
+      printf("\t\texport time                     "
+	     "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+      res *= (num == num_put - num_rem);
+      memset(seen, 0, num_ins);
+      for (i = 0; i < num; i++){
+	id = key_id(ptr(exp_keys, i, key_size), key_size);
+	res *= (id >= num_rem && id < num_put && !seen[id] &&
+		val_elt(ptr(exp_elts, i, elt_size)) == id &&
+		memcmp(ptr(exp_keys, i, key_size),
+		       ptr(keys, id, key_size),
+		       key_size) == 0);
+	if (id < num_ins) seen[id] = 1;
+      }
+      res *= (ht_muloa_export(&ht, NULL, NULL) == num);
+      ht_muloa_free(&ht);
+    }
+  }
+  printf("\t\tcursor export correctness:      ");
+  print_test_result(res);
+  free(keys);
+  free(exp_keys);
+  free(elts);
+  free(exp_elts);
+  free(seen);
+  keys = NULL;
+  exp_keys = NULL;
+  elts = NULL;
+  exp_elts = NULL;
+  seen = NULL;
+}
+
+/**
+   Runs a test of saving a hash table into an image and loading the hash
+   table from the image, in the pointer and inline modes, on distinct keys
+   and size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds.
+*/
+void run_save_load_uint_test(size_t log_ins,
+			     size_t log_key_start,
+			     size_t log_key_end,
+			     size_t alpha_n_start,
+			     size_t alpha_n_end,
+			     size_t log_alpha_d,
+			     size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_{save, load} test in the pointer and inline "
+	   "modes on distinct %lu-byte keys and size_t elements\n",
+	   TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      save_load(num_ins,
+		key_size,
+		elt_size,
+		elt_alignment,
+		alpha_n,
+		log_alpha_d,
+		new_uint,
+		val_uint,
+		NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of saving and loading. A quarter of the
+   keys are removed before the hash table is saved, which leaves
+   placeholders in the image. The loaded hash table is searched, saved
+   again into an identical image, and then modified, which is required
+   to leave the image unchanged.
+*/
+void save_load(size_t num_ins,
+	       size_t key_size,
+	       size_t elt_size,
+	       size_t elt_alignment,
+	       size_t alpha_n,
+	       size_t log_alpha_d,
+	       void (*new_elt)(void *, size_t),
+	       size_t (*val_elt)(const void *),
+	       void (*free_elt)(void *)){
+  int res = 1;
+  int is_inline;
+  size_t i, j;
+  size_t val;
+  size_t num_rem = num_ins / 4;
+  size_t size, resave_size;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  unsigned char *image = NULL;
+  unsigned char *image_cpy = NULL;
+  unsigned char *resave_image = NULL;
+  void *elts = NULL;
+  const void *elt = NULL;
+  FILE *file = NULL;
+  ht_muloa_t ht, ld_ht;
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (is_inline = 0; is_inline <= 1; is_inline++){
+    printf("\t\t%s mode\n", is_inline ? "inline" : "pointer");
+    ht_muloa_init(&ht,
+		  key_size,
+		  elt_size,
+		  0,
+		  alpha_n,
+		  log_alpha_d,
+		  NULL,
+		  NULL,
+		  free_elt);
+    ht_muloa_align(&ht, elt_alignment);
+    ht_muloa_inline(&ht, is_inline);
+    t = clock();
+    for (i = 0; i < num_ins; i++){
+      ht_muloa_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+    }
+    t = clock() - t;
+    printf("\t\tinsert w/ growth time           "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    for (i = 0; i < num_rem; i++){
+      ht_muloa_remove(&ht, ptr(keys, i, key_size), &val);
+    }
+    file = tmpfile();
+    if (file == NULL){
+      perror("tmpfile failed");
+      exit(EXIT_FAILURE);
+    }
+    t = clock();
+    ht_muloa_save(&ht, file);
+    t = clock() - t;
+    printf("\t\tsave time                       "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    image = read_image(file, &size);
+    fclose(file);
+    image_cpy = malloc_perror(size, 1);
+    memcpy(image_cpy, image, size);
+    t = clock();
+    ht_muloa_load(&ld_ht, image, size, NULL, NULL);
+    t = clock() - t;
+    printf("\t\tload time                       "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    res *= (ld_ht.num_elts == ht.num_elts &&
+	    ld_ht.count == ht.count &&
+	    ld_ht.slot_size > 0);
+    t = clock();
+    for (i = 0; i < num_ins; i++){
+      elt = ht_muloa_search(&ld_ht, ptr(keys, i, key_size));
+      if (i < num_rem){
+	res *= (elt == NULL);
+      }else{
+	res *= (elt != NULL && val_elt(elt) == i);
+      }
+    }
+    t = clock() - t;
+    printf("\t\tsearch in loaded ht time        "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    file = tmpfile();
+    if (file == NULL){
+      perror("tmpfile failed");
+      exit(EXIT_FAILURE);
+    }
+    ht_muloa_save(&ld_ht, file);
+    resave_image = read_image(file, &resave_size);
+    fclose(file);
+    res *= (resave_size == size &&
+	    memcmp(resave_image, image, size) == 0);
+    for (i = 0; i < num_rem; i++){
+      ht_muloa_insert(&ld_ht,
+		      ptr(keys, i, key_size),
+		      ptr(elts, i, elt_size));
+    }
+    for (i = 0; i < num_ins; i++){
+      elt = ht_muloa_search(&ld_ht, ptr(keys, i, key_size));
+      res *= (elt != NULL && val_elt(elt) == i);
+    }
+    res *= (ld_ht.num_elts == num_ins);
+    res *= (memcmp(image, image_cpy, size) == 0);
+    ht_muloa_free(&ld_ht);
+    ht_muloa_free(&ht);
+    free(image);
+    free(image_cpy);
+    free(resave_image);
+    image = NULL;
+    image_cpy = NULL;
+    resave_image = NULL;
+  }
+  printf("\t\tsave load correctness:          ");
+  print_test_result(res);
+  free(keys);
+  free(elts);
+  keys = NULL;
+  elts = NULL;
+}
+
+/**
+   Runs a test of the statistics of a hash table on distinct keys and
+   size_t elements across key sizes >= sizeof(size_t) and load factor
+   upper bounds. The test is compiled if HT_MULOA_STATS is defined.
+*/
+#ifdef HT_MULOA_STATS
+void run_stats_uint_test(size_t log_ins,
+			 size_t log_key_start,
+			 size_t log_key_end,
+			 size_t alpha_n_start,
+			 size_t alpha_n_end,
+			 size_t log_alpha_d,
+			 size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_stats test on distinct %lu-byte keys and "
+	   "size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      stats(num_ins,
+	    key_size,
+	    elt_size,
+	    elt_alignment,
+	    alpha_n,
+	    log_alpha_d,
+	    new_uint,
+	    val_uint,
+	    NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the test of statistics. Inserts num_ins keys,
+   searches the keys and num_ins keys that are not in the hash table, and
+   removes half of the keys, and compares the statistics with the
+   performed operations.
+*/
+void stats(size_t num_ins,
+	   size_t key_size,
+	   size_t elt_size,
+	   size_t elt_alignment,
+	   size_t alpha_n,
+	   size_t log_alpha_d,
+	   void (*new_elt)(void *, size_t),
+	   size_t (*val_elt)(const void *),
+	   void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j;
+  size_t val;
+  size_t num_rem = num_ins / 2;
+  size_t num_searches = 0, num_ins_probes = 0;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  ht_muloa_t ht;
+  ht_muloa_stats_t st;
+  keys = malloc_perror(2 * num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < 2 * num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    memcpy(key_buf, &i, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    if (i < num_ins) new_elt(ptr(elts, i, elt_size), i);
+  }
+  ht_muloa_init(&ht,
+		key_size,
+		elt_size,
+		0,
+		alpha_n,
+		log_alpha_d,
+		NULL,
+		NULL,
+		free_elt);
+  ht_muloa_align(&ht, elt_alignment);
+  for (i = 0; i < num_ins; i++){
+    ht_muloa_insert(&ht, ptr(keys, i, key_size), ptr(elts, i, elt_size));
+  }
+  for (i = 0; i < 2 * num_ins; i++){
+    res *= ((ht_muloa_search(&ht, ptr(keys, i, key_size)) != NULL) ==
+	    (i < num_ins));
+  }
+  for (i = 0; i < num_rem; i++){
+    ht_muloa_remove(&ht, ptr(keys, i, key_size), &val);
+    res *= (val_elt(&val) == i);
+  }
+  ht_muloa_stats(&ht, &st);
+  printf("\t\tsearch probe histogram:         ");
+  for (i = 0; i < HT_MULOA_STATS_BINS; i++){
+    printf("%lu ", TOLU(st.probe_hist[i]));
+    num_searches += st.probe_hist[i];
+    num_ins_probes += st.ins_probe_hist[i];
+  }
+  printf("\n");
+  printf("\t\tplaceholder ratio:              %.4f\n",
+	 (float)st.num_phs / st.count);
+  printf("\t\tgrows, shrinks, cleans:         %lu, %lu, %lu\n",
+	 TOLU(st.num_grows), TOLU(st.num_shrinks), TOLU(st.num_cleans));
+  printf("\t\trehash time, max:               %.4f, %.4f seconds\n",
+	 (float)st.rehash_time / CLOCKS_PER_SEC,
+	 (float)st.max_rehash_time / CLOCKS_PER_SEC);
+  printf("\t\tallocated bytes:                %lu\n", TOLU(st.num_bytes));
+  res *= (num_searches == 2 * num_ins + num_rem);
+  res *= (num_ins_probes == num_ins);
+  res *= (st.num_elts == num_ins - num_rem &&
+	  st.num_phs == ht.num_phs &&
+	  st.count == ht.count &&
+	  st.max_num_probes == ht.max_num_probes);
+  res *= (st.num_grows > 0 || ht.log_count == ht.min_log_count);
+  res *= (st.num_bytes >= ht.count * sizeof(void *));
+  printf("\t\tstats correctness:              ");
+  print_test_result(res);
+  ht_muloa_free(&ht);
+  free(keys);
+  free(elts);
+  keys = NULL;
+  elts = NULL;
+}
+#endif
+
+/**
+   Runs a ht_muloa_tune test on distinct keys and size_t elements across
+   key sizes >= sizeof(size_t) and load factor upper bounds. The
+   non-random block of the ith key is i * C_TUNE_KEY_STRIDE.
+*/
+void run_tune_uint_test(size_t log_ins,
+			size_t log_key_start,
+			size_t log_key_end,
+			size_t alpha_n_start,
+			size_t alpha_n_end,
+			size_t log_alpha_d,
+			size_t num_alpha_steps){
+  size_t i, j;
+  size_t num_ins;
+  size_t key_size;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t step, rem;
+  size_t alpha_n;
+  num_ins = pow_two_perror(log_ins);
+  step = (alpha_n_end - alpha_n_start) / num_alpha_steps;
+  for (i = log_key_start; i <= log_key_end; i++){
+    alpha_n = alpha_n_start;
+    rem = alpha_n_end - alpha_n_start - step * num_alpha_steps;
+    key_size = sizeof(size_t) * pow_two_perror(i);
+    printf("Run a ht_muloa_tune test on distinct %lu-byte keys with a "
+	   "stride and size_t elements\n", TOLU(key_size));
+    for (j = 0; j <= num_alpha_steps; j++){
+      printf("\tnumber of inserts: %lu, load factor upper bound: %.4f\n",
+	     TOLU(num_ins), (float)alpha_n / pow_two_perror(log_alpha_d));
+      tune(num_ins,
+	   key_size,
+	   elt_size,
+	   elt_alignment,
+	   alpha_n,
+	   log_alpha_d,
+	   new_uint,
+	   val_uint,
+	   NULL);
+      alpha_n += (j < num_alpha_steps) * step + (rem > 0 && rem--);
+    }
+  }
+}
+
+/**
+   Helper function for the tune test. The constants are tuned on a sample
+   of num_ins / C_TUNE_SAMPLE_DIV keys. A second tuning on the same sample
+   is required to not increase the number of probes. The default and tuned
+   hash tables are then compared on all keys.
+*/
+void tune(size_t num_ins,
+	  size_t key_size,
+	  size_t elt_size,
+	  size_t elt_alignment,
+	  size_t alpha_n,
+	  size_t log_alpha_d,
+	  void (*new_elt)(void *, size_t),
+	  size_t (*val_elt)(const void *),
+	  void (*free_elt)(void *)){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_sample = num_ins / C_TUNE_SAMPLE_DIV;
+  size_t num_probes, num_probes_retune;
+  size_t id;
+  unsigned char key_buf[sizeof(size_t)];
+  unsigned char *key = NULL;
+  unsigned char *keys = NULL;
+  void *elts = NULL;
+  const void *elt = NULL;
+  ht_muloa_t hts[2];
+  clock_t t;
+  keys = malloc_perror(num_ins, key_size);
+  elts = malloc_perror(num_ins, elt_size);
+  for (i = 0; i < num_ins; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < key_size - sizeof(size_t); j++){
+      *(unsigned char *)ptr(key, j, 1) = RANDOM(); /* mod 2**CHAR_BIT */
+    }
+    id = i * C_TUNE_KEY_STRIDE;
+    memcpy(key_buf, &id, sizeof(size_t)); /* eff. type in key unchanged */
+    memcpy(ptr(key, key_size - sizeof(size_t), 1), key_buf, sizeof(size_t));
+    new_elt(ptr(elts, i, elt_size), i);
+  }
+  for (k = 0; k < 2; k++){
+    ht_muloa_init(&hts[k],
+		  key_size,
+		  elt_size,
+		  0,
+		  alpha_n,
+		  log_alpha_d,
+		  NULL,
+		  NULL,
+		  free_elt);
+    ht_muloa_align(&hts[k], elt_alignment);
+  }
+  t = clock();
+  num_probes = ht_muloa_tune(&hts[1], keys, num_sample);
+  t = clock() - t;
+  printf("\t\ttune time                       "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  num_probes_retune = ht_muloa_tune(&hts[1], keys, num_sample);
+  res *= (num_probes >= num_sample && num_probes_retune <= num_probes);
+  res *= ((hts[1].fprime & 1) && (hts[1].sprime & 1) &&
+	  hts[1].fprime >> (C_FULL_BIT - 1) &&
+	  hts[1].sprime >> (C_FULL_BIT - 1));
+  printf("\t\t# probes on sample, tuned:      %lu\n", TOLU(num_probes));
+  for (k = 0; k < 2; k++){
+    printf("\t\t%s\n", k ? "tuned" : "default");
+    t = clock();
+    for (i = 0; i < num_ins; i++){
+      ht_muloa_insert(&hts[k],
+		      ptr(keys, i, key_size),
+		      ptr(elts, i, elt_size));
+    }
+    t = clock() - t;
+    printf("\t\tinsert w/ growth time           "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    t = clock();
+    for (i = 0; i < num_ins; i++){
+      elt = ht_muloa_search(&hts[k], ptr(keys, i, key_size));
+      res *= (elt != NULL && val_elt(elt) == i);
+    }
+    t = clock() - t;
+    printf("\t\tsearch time                     "
+	   "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    printf("\t\tmax # probes:                   %lu\n",
+	   TOLU(hts[k].max_num_probes));
+    res *= (hts[k].num_elts == num_ins);
+    ht_muloa_free(&hts[k]);
+  }
+  printf("\t\ttune correctness:               ");
+  print_test_result(res);
+  free(keys);
+  free(elts);
+  keys = NULL;
+  elts = NULL;
+}
+
+/**
+   Runs a corner cases test.
+*/
+void run_corner_cases_test(int log_ins){
+  int res = 1;
+  size_t elt;
+  size_t elt_size = sizeof(size_t);
+  size_t elt_alignment = sizeof(size_t);
+  size_t i, num_ins;
+  ht_muloa_t ht;
+  ht_muloa_init(&ht,
+		C_CORNER_KEY_SIZE,
+		elt_size,
+		0,
+		C_CORNER_ALPHA_N,
+		C_CORNER_LOG_ALPHA_D,
+		NULL,
+		NULL,
+		NULL);
+  ht_muloa_align(&ht, elt_alignment);
+  num_ins = pow_two_perror(log_ins);
+  printf("Run corner cases test --> ");
+  for (i = 0; i < num_ins; i++){
+    elt = i;
+    ht_muloa_insert(&ht, &C_CORNER_KEY_A, &elt);
+  }
+  res *= (ht.num_elts == 1 &&
+	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_A) == elt &&
+	  ht_muloa_search(&ht, &C_CORNER_KEY_B) == NULL);
+  ht_muloa_insert(&ht, &C_CORNER_KEY_B, &elt);
+  res *= (ht.count == C_CORNER_HT_COUNT &&
+	  ht.num_elts == 2 &&
+	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_A) == elt &&
+	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_B) == elt);
+  ht_muloa_delete(&ht, &C_CORNER_KEY_A);
+  res *= (ht.count == C_CORNER_HT_COUNT &&
+	  ht.num_elts == 1 &&
+	  ht_muloa_search(&ht, &C_CORNER_KEY_A) == NULL &&
+	  *(size_t *)ht_muloa_search(&ht, &C_CORNER_KEY_B) == elt);
+  ht_muloa_delete(&ht, &C_CORNER_KEY_B);
+  res *= (ht.count == C_CORNER_HT_COUNT &&
+	  ht.num_elts == 0 &&
+	  ht_muloa_search(&ht, &C_CORNER_KEY_A) == NULL &&
+	  ht_muloa_search(&ht, &C_CORNER_KEY_B) == NULL);
+  print_test_result(res);
+  free_ht(&ht);
+}
+
+/**
+   Helper functions.
+*/
+
+/**
+   Returns 1 if the ith slot of a hash table is empty or contains a
+   placeholder in the pointer or inline mode, otherwise returns 0.
+*/
+int is_empty_or_ph(const ht_muloa_t *ht, size_t i){
+  const ke_t *ke = NULL;
+  if (ht->slot_size == 0){
+    ke = ht->key_elts[i];
+  }else{
+    ke = (const ke_t *)((const char *)ptr(ht->slots, i, ht->slot_size) +
+			ht->key_offset);
+  }
+  return (ke == NULL || ke->fval == 1);
+}
+
+/**
+   Reads the content of a binary stream, from its start to its current
+   position, into an allocated block, and returns a pointer to the block.
+   The size of the block is copied into the block pointed to by size.
+*/
+void *read_image(FILE *file, size_t *size){
+  long end;
+  void *image = NULL;
+  end = ftell(file);
+  if (end < 0){
+    perror("ftell failed");
+    exit(EXIT_FAILURE);
+  }
+  *size = end;
+  image = malloc_perror(*size + (*size == 0), 1);
+  rewind(file);
+  if (fread(image, 1, *size, file) != *size){
+    perror("fread failed");
+    exit(EXIT_FAILURE);
+  }
+  return image;
+}
+
+/**
+   Swaps two blocks of size bytes.
+*/
+void swap(void *a, void *b, size_t size){
+  size_t i;
+  unsigned char c;
+  unsigned char *p = a;
+  unsigned char *q = b;
+  for (i = 0; i < size; i++){
+    c = p[i];
+    p[i] = q[i];
+    q[i] = c;
+  }
+}
 
 /**
    Computes a pointer to the ith element in the block of elements.
@@ -761,7 +2377,7 @@ int main(int argc, char *argv[]){
   size_t *args = NULL;
   RGENS_SEED();
   if (argc > C_ARGC_MAX){
-    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+    fprintf(stderr, "USAGE:\n%s%s", C_USAGE, C_USAGE_FLAGS);
     exit(EXIT_FAILURE);
   }
   args = malloc_perror(C_ARGC_MAX - 1, sizeof(size_t));
@@ -780,12 +2396,20 @@ int main(int argc, char *argv[]){
       args[3] > pow_two_perror(args[5]) ||
       args[4] > pow_two_perror(args[5]) ||
       args[6] < 1 ||
-      args[7] < 1 ||
+      args[7] > 1 ||
       args[8] > 1 ||
       args[9] > 1 ||
       args[10] > 1 ||
-      args[11] > 1){
-    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+      args[11] > 1 ||
+      args[12] > 1 ||
+      args[13] > 1 ||
+      args[14] > 1 ||
+      args[15] > 1 ||
+      args[16] > 1 ||
+      args[17] > 1 ||
+      args[18] > 1 ||
+      args[19] > 1){
+    fprintf(stderr, "USAGE:\n%s%s", C_USAGE, C_USAGE_FLAGS);
     exit(EXIT_FAILURE);
   };
   if (args[7]) run_insert_search_free_uint_test(args[0],
@@ -817,6 +2441,64 @@ int main(int argc, char *argv[]){
 						args[5],
 						args[6]);
   if (args[11]) run_corner_cases_test(args[0]);
+  if (args[12]) run_modes_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6]);
+  if (args[13]) run_batch_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6]);
+  if (args[14]) run_incr_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6]);
+  if (args[15]) run_shrink_uint_test(args[0],
+				     args[1],
+				     args[2],
+				     args[3],
+				     args[4],
+				     args[5],
+				     args[6]);
+  if (args[16]) run_iter_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6]);
+  if (args[17]) run_save_load_uint_test(args[0],
+					args[1],
+					args[2],
+					args[3],
+					args[4],
+					args[5],
+					args[6]);
+#ifdef HT_MULOA_STATS
+  if (args[18]) run_stats_uint_test(args[0],
+				    args[1],
+				    args[2],
+				    args[3],
+				    args[4],
+				    args[5],
+				    args[6]);
+#endif
+  if (args[19]) run_tune_uint_test(args[0],
+				   args[1],
+				   args[2],
+				   args[3],
+				   args[4],
+				   args[5],
+				   args[6]);
   free(args);
   args = NULL;
   return 0;
@@ -17,12 +17,62 @@
    expected number of probes is upper-bounded by 1/(1 - load factor) before
    the full occupancy is reached.
 
+   A hash table shrinks if, after a remove or delete operation, the
+   number of keys is less than a quarter of the number of keys allowed by
+   alpha, and the count is greater than the count set at initialization.
+   After shrinking, the load factor is at most half of alpha. The
+   ht_muloa_compact operation shrinks a hash table to the smallest count
+   with a load factor not exceeding alpha and eliminates placeholders.
+
+   The multiplication constants of a hash table are selected with
+   ht_muloa_tune to minimize the number of probes on a sample of frequent
+   keys, as determined at the time of graph construction.
+
    A hash key is an object within a contiguous block of memory (e.g. a basic
    type, array, struct). If the key size is greater than sizeof(size_t)
    bytes, then it is reduced to a sizeof(size_t)-byte block prior to hashing.
    Key size reduction methods may introduce regularities. An element is
    within a contiguous or noncontiguous block of memory.
 
+   A hash table is in a pointer mode or an inline mode of storage. In the
+   pointer mode, a key, its hash values, and an element (or a pointer to
+   an element) are within a separately allocated block, and a slot contains
+   a pointer to the block. In the inline mode, the key, hash values, and
+   element are within a fixed-size slot of a single contiguous array,
+   which eliminates an allocation per insertion and a pointer dereference
+   per probe. A probe in the inline mode accesses one or two cache lines
+   if the size of a slot does not exceed the size of a cache line. The
+   pointer mode is the default, because in the pointer mode a pointer
+   returned by a search remains valid while its key is in the hash table.
+   The inline mode is set with ht_muloa_inline.
+
+   A hash table is rehashed in a single step by default, which moves all
+   keys in one operation. In the optional incremental mode of growth, the
+   previous slots are kept next to the new slots after a rehashing step,
+   and each subsequent insert, remove, or delete operation moves the keys
+   of a bounded number of previous slots, until all keys are moved. A
+   moved key leaves a placeholder in its previous slot. A search during
+   the migration of keys probes the new slots and then the previous slots.
+
+   The keys of a hash table are enumerated with a cursor, with a foreach
+   operation, or are copied with their elements into contiguous arrays
+   with an export operation. The order of enumeration is the order of
+   slots, with the previous slots first during the migration of keys.
+
+   A hash table is saved into a relocatable binary image with
+   ht_muloa_save. The image contains a header and the slots in the inline
+   layout, and contains no pointers. A hash table is loaded from an image
+   in memory, e.g. a memory-mapped file, with ht_muloa_load without
+   rehashing and without an allocation per key. The slots of a loaded hash
+   table remain in the image, which is not written, until the first
+   modifying operation copies the slots into an allocated array.
+
+   If HT_MULOA_STATS is defined at compile time, a hash table maintains
+   statistics that are read with ht_muloa_stats, including histograms of
+   the numbers of probes, the placeholder count, the rehashing events and
+   their processor times, and the number of allocated bytes. Otherwise,
+   the statistics and their instrumentation are not compiled.
+
    The implementation only uses integer and pointer operations. Integer
    arithmetic is used in load factor operations, thereby eliminating the
    use of float. Given parameter values within the specified ranges,
@@ -116,18 +166,74 @@ static const size_t C_BYTE_BIT = CHAR_BIT;
 static const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
 static const size_t C_LOG_COUNT_MIN = 8; /* > 0 */
 static const size_t C_LOG_COUNT_MAX = CHAR_BIT * sizeof(size_t) - 1;
+static const size_t C_SIZE_MAX = (size_t)-1;
+static const size_t C_MIG_ROOM_DIV = 4; /* shortens migration of keys */
+static const size_t C_SHRINK_DIV = 4; /* shrink if num_elts < max_sum / 4 */
+static const size_t C_TUNE_NUM_PAIRS = 16; /* evaluated by ht_muloa_tune */
+
+/* image header: an array of C_IMAGE_NUM_FIELDS size_t values */
+enum{IMG_MAGIC,
+     IMG_SIZE_T_SIZE,
+     IMG_KEY_SIZE,
+     IMG_ELT_SIZE,
+     IMG_KEY_OFFSET,
+     IMG_ELT_OFFSET,
+     IMG_ELT_ALIGNMENT,
+     IMG_SLOT_SIZE,
+     IMG_LOG_COUNT,
+     IMG_MIN_LOG_COUNT,
+     IMG_COUNT,
+     IMG_MAX_SUM,
+     IMG_MAX_NUM_PROBES,
+     IMG_NUM_ELTS,
+     IMG_NUM_PHS,
+     IMG_FPRIME,
+     IMG_SPRIME,
+     IMG_ALPHA_N,
+     IMG_LOG_ALPHA_D,
+     IMG_DATA_OFFSET,
+     C_IMAGE_NUM_FIELDS};
+static const size_t C_IMAGE_MAGIC = 0x4d4f; /* detects byte order */
+#define C_BATCH_SIZE 16 /* number of keys hashed and prefetched at a time */
+
+/* statistics, compiled if HT_MULOA_STATS is defined */
+#ifdef HT_MULOA_STATS
+#define STATS_PROBES(ht, hist, n) stats_probes((ht)->stats->hist, (n))
+static ht_muloa_stats_t *stats_new();
+static void stats_probes(size_t *hist, size_t num_probes);
+static void stats_rehash(ht_muloa_t *ht, size_t prev_count, clock_t t);
+#else
+#define STATS_PROBES(ht, hist, n)
+#endif
 
 /* placeholder handling */
 static ke_t *ph_new();
 static int is_ph(const ke_t *ke);
+static void ph_put(ht_muloa_t *ht, size_t ix, int is_prev);
 static void ph_free(ke_t *ke);
 
+/* slot handling */
+static void slots_init(ht_muloa_t *ht);
+static void slot_size_update(ht_muloa_t *ht);
+static size_t inline_slot_size(const ht_muloa_t *ht);
+static int is_image_layout(const size_t *hdr);
+static void own_image(ht_muloa_t *ht);
+static ke_t *ke_at(const ht_muloa_t *ht, size_t ix);
+static ke_t *prev_ke_at(const ht_muloa_t *ht, size_t ix);
+static int is_empty(const ke_t *ke);
+
 /* key element handling */
 static ke_t *ke_new(const ht_muloa_t *ht,
 		    size_t fval,
 		    size_t sval,
 		    const void *key,
 		    const void *elt);
+static void ke_put(ht_muloa_t *ht,
+		   size_t ix,
+		   size_t fval,
+		   size_t sval,
+		   const void *key,
+		   const void *elt);
 static void ke_elt_update(const ht_muloa_t *ht, ke_t *ke, const void *elt);
 static void *ke_key_ptr(const ht_muloa_t *ht, const ke_t *ke);
 static void *ke_elt_ptr(const ht_muloa_t *ht, const ke_t *ke);
@@ -135,18 +241,58 @@ static void ke_free(const ht_muloa_t *ht, ke_t *ke);
 
 /* hashing */
 static size_t convert_std_key(const ht_muloa_t *ht, const void *key);
+static void hash(const ht_muloa_t *ht,
+		 size_t std_key,
+		 size_t *fval,
+		 size_t *sval);
 static size_t adjust_dist(size_t dist);
+static void prefetch_slot(const ht_muloa_t *ht, size_t fval);
+static void prefetch_ke(const ht_muloa_t *ht, size_t fval);
 
 /* hash table operations and maintenance*/
-static ke_t **search(const ht_muloa_t *ht, const void *key);
+static void insert(ht_muloa_t *ht,
+		   const void *key,
+		   size_t std_key,
+		   const void *elt);
+static size_t search(const ht_muloa_t *ht,
+		     const void *key,
+		     size_t std_key,
+		     int is_prev);
+static void *search_elt(const ht_muloa_t *ht,
+			const void *key,
+			size_t std_key);
+static void remove_key(ht_muloa_t *ht,
+		       const void *key,
+		       size_t std_key,
+		       void *elt);
+static void delete_key(ht_muloa_t *ht, const void *key, size_t std_key);
 static size_t mul_alpha(size_t n, size_t alpha_n, size_t log_alpha_d);
 static int incr_count(ht_muloa_t *ht);
+static void reset_count(ht_muloa_t *ht);
 static void ht_grow(ht_muloa_t *ht);
+static void ht_shrink(ht_muloa_t *ht);
 static void ht_clean(ht_muloa_t *ht);
+static void rehash(ht_muloa_t *ht, size_t prev_log_count, int is_incr);
 static void reinsert(ht_muloa_t *ht, const ke_t *prev_ke);
+static void migrate(ht_muloa_t *ht, size_t num_slots);
+static size_t export_slots(const ht_muloa_t *ht,
+			   size_t count,
+			   ke_t * const *key_elts,
+			   const void *slots,
+			   char *keys,
+			   char *elts,
+			   size_t num);
 
 /* integer constant construction */
 static size_t find_build_prime(const size_t *parts);
+static size_t tune_probes(const ht_muloa_t *ht,
+			  const size_t *std_keys,
+			  size_t num_keys,
+			  size_t fprime,
+			  size_t sprime,
+			  unsigned char *occ,
+			  size_t bound);
+static size_t tune_next(const ht_muloa_t *ht, size_t c);
 
 /**
    Initializes a hash table. 
@@ -188,6 +334,8 @@ static size_t find_build_prime(const size_t *parts);
                  element-specific free_elt, taking a pointer to a pointer to an
                  element as its argument and leaving a block of size elt_size
                  pointed to by the argument, is necessary to delete the element
+   A hash table is initialized in the pointer mode of storage. The inline
+   mode can be set with ht_muloa_inline.
 */
 void ht_muloa_init(ht_muloa_t *ht,
 		   size_t key_size,
@@ -198,7 +346,7 @@ void ht_muloa_init(ht_muloa_t *ht,
 		   int (*cmp_key)(const void *, const void *),
 		   size_t (*rdc_key)(const void *, size_t),
 		   void (*free_elt)(void *)){
-  size_t i, rem;
+  size_t rem;
   ht->key_size = key_size;
   ht->elt_size = elt_size;
   /* align ke_t relative to a malloc's pointer */
@@ -213,12 +361,14 @@ void ht_muloa_init(ht_muloa_t *ht,
   /* elt_size block accessible with a character pointer */
   ht->elt_offset = sizeof(ke_t);
   ht->elt_alignment = 1;
+  ht->slot_size = 0;
   ht->log_count = C_LOG_COUNT_MIN;
   ht->count = pow_two_perror(C_LOG_COUNT_MIN);
   /* 0 <= max_sum < count */
   ht->max_sum = mul_alpha(ht->count, alpha_n, log_alpha_d);
   if (ht->max_sum == ht->count) ht->max_sum = ht->count - 1;
   while (min_num > ht->max_sum && incr_count(ht));
+  ht->min_log_count = ht->log_count;
   ht->max_num_probes = 1; /* at least one probe */
   ht->num_elts = 0;
   ht->num_phs = 0;
@@ -227,10 +377,21 @@ void ht_muloa_init(ht_muloa_t *ht,
   ht->alpha_n = alpha_n;
   ht->log_alpha_d = log_alpha_d;
   ht->ph = ph_new();
-  ht->key_elts = malloc_perror(ht->count, sizeof(ke_t *));
-  for (i = 0; i < ht->count; i++){
-    ht->key_elts[i] = NULL;
-  }
+  ht->key_elts = NULL;
+  ht->slots = NULL;
+  slots_init(ht);
+  ht->is_incr = 0;
+  ht->prev_log_count = 0;
+  ht->prev_count = 0;
+  ht->prev_max_num_probes = 0;
+  ht->mig_ix = 0;
+  ht->mig_step = 0;
+  ht->prev_key_elts = NULL;
+  ht->prev_slots = NULL;
+  ht->is_image = 0;
+#ifdef HT_MULOA_STATS
+  ht->stats = stats_new();
+#endif
   ht->cmp_key = cmp_key;
   ht->rdc_key = rdc_key;
   ht->free_elt = free_elt;
@@ -264,6 +425,119 @@ void ht_muloa_align(ht_muloa_t *ht, size_t elt_alignment){
     ht->elt_offset = add_sz_perror(ht->elt_offset,
 				   (rem > 0) * (elt_alignment - rem));
   }
+  ht->elt_alignment = elt_alignment;
+  if (ht->slot_size > 0){
+    /* empty hash table; slots with the updated layout */
+    slot_size_update(ht);
+    free(ht->slots);
+    slots_init(ht);
+  }
+}
+
+/**
+   Sets the storage mode of a hash table. In the inline mode, keys, hash
+   values, and elements are copied into the slots of a contiguous array,
+   and are moved when the hash table grows or is cleaned of placeholders.
+   In the pointer mode, each key element pair is within a separately
+   allocated block that keeps its address throughout its presence in the
+   hash table. The operation is optionally called after ht_muloa_init is
+   completed and before any operation other than ht_muloa_align is called.
+   ht          : pointer to an initialized ht_muloa_t struct
+   is_inline   : non-zero to set the inline mode, zero to set the pointer
+                 mode
+*/
+void ht_muloa_inline(ht_muloa_t *ht, int is_inline){
+  if (is_inline){
+    slot_size_update(ht);
+  }else{
+    ht->slot_size = 0;
+  }
+  free(ht->key_elts);
+  free(ht->slots);
+  ht->key_elts = NULL;
+  ht->slots = NULL;
+  slots_init(ht);
+}
+
+/**
+   Sets the mode of growth of a hash table. In the incremental mode, a
+   growth step or a cleaning of placeholders allocates the new slots, and
+   the keys in the previous slots are moved by the subsequent insert,
+   remove, and delete operations, each moving the keys of a bounded number
+   of previous slots. The number of previous slots migrated per operation
+   is set at each rehashing step s.t. the migration is completed before
+   the next rehashing step is due. As a result, no single insert operation
+   moves all keys of a hash table. The operation is optionally called
+   after ht_muloa_init is completed and before any operation other than
+   ht_muloa_align and ht_muloa_inline is called.
+   ht          : pointer to an initialized ht_muloa_t struct
+   is_incr     : non-zero to set the incremental mode, zero to set the
+                 default mode of rehashing in a single step
+*/
+void ht_muloa_incr(ht_muloa_t *ht, int is_incr){
+  ht->is_incr = is_incr;
+}
+
+/**
+   Selects the first and second multiplication constants of a hash table
+   s.t. the number of probes is minimized on a sample of keys, e.g. the
+   vertex ids of a graph in the non-increasing order of their indegrees.
+   The pair of current constants and C_TUNE_NUM_PAIRS - 1 pairs of odd
+   constants in (2**(n - 1), 2**n), n = CHAR_BIT * sizeof(size_t), are
+   evaluated by inserting the sample keys into a set of occupied slots
+   with the count that the hash table reaches with num_keys keys. The pair
+   with the lowest number of probes is kept. Returns the number of probes
+   of the kept pair, which is not greater than the number of probes of the
+   current pair. The operation is optionally called after ht_muloa_init
+   is completed and before any operation other than ht_muloa_align,
+   ht_muloa_inline, and ht_muloa_incr is called.
+   ht          : pointer to an initialized ht_muloa_t struct
+   keys        : pointer to an array of num_keys distinct keys, each in a
+                 key_size block
+   num_keys    : number of keys in the sample
+*/
+size_t ht_muloa_tune(ht_muloa_t *ht, const void *keys, size_t num_keys){
+  size_t i, num_probes, min_num_probes;
+  size_t fprime, sprime, c;
+  size_t *std_keys = NULL;
+  unsigned char *occ = NULL;
+  ht_muloa_t sim = *ht; /* current constants, count with num_keys keys */
+  while (num_keys > sim.max_sum && incr_count(&sim));
+  if (num_keys > sim.max_sum) num_keys = sim.max_sum;
+  std_keys = malloc_perror(num_keys, sizeof(size_t));
+  occ = malloc_perror(sim.count, 1);
+  for (i = 0; i < num_keys; i++){
+    std_keys[i] = convert_std_key(ht, (const char *)keys + i * ht->key_size);
+  }
+  min_num_probes = tune_probes(&sim,
+			       std_keys,
+			       num_keys,
+			       ht->fprime,
+			       ht->sprime,
+			       occ,
+			       C_SIZE_MAX);
+  c = ht->sprime;
+  for (i = 1; i < C_TUNE_NUM_PAIRS; i++){
+    fprime = c = tune_next(&sim, c);
+    sprime = c = tune_next(&sim, c);
+    num_probes = tune_probes(&sim,
+			     std_keys,
+			     num_keys,
+			     fprime,
+			     sprime,
+			     occ,
+			     min_num_probes);
+    if (num_probes < min_num_probes){
+      min_num_probes = num_probes;
+      ht->fprime = fprime;
+      ht->sprime = sprime;
+    }
+  }
+  free(std_keys);
+  free(occ);
+  std_keys = NULL;
+  occ = NULL;
+  return min_num_probes;
 }
 
 /**
@@ -273,43 +547,40 @@ void ht_muloa_align(ht_muloa_t *ht, size_t elt_alignment){
    elt_size respectively.
 */
 void ht_muloa_insert(ht_muloa_t *ht, const void *key, const void *elt){
-  size_t num_probes = 1;
-  size_t std_key;
-  size_t fval, sval;
-  size_t ix, dist;
-  ke_t **ke = NULL;
-  std_key = convert_std_key(ht, key);
-  fval = ht->fprime * std_key; /* mod 2**C_FULL_BIT */
-  sval = ht->sprime * std_key; /* mod 2**C_FULL_BIT */
-  ix = fval >> (C_FULL_BIT - ht->log_count);
-  dist = adjust_dist(sval >> (C_FULL_BIT - ht->log_count));
-  ke = &ht->key_elts[ix];
-  while (*ke != NULL){
-    if (ht->cmp_key != NULL && /* loop invariant */
-	!is_ph(*ke) &&
-	ht->cmp_key(ke_key_ptr(ht, *ke), key) == 0){
-      ke_elt_update(ht, *ke, elt);
-      return;
-    }else if (ht->cmp_key == NULL && /* loop invariant */
-	      !is_ph(*ke) &&
-	      memcmp(ke_key_ptr(ht, *ke), key, ht->key_size) == 0){
-      ke_elt_update(ht, *ke, elt);
-      return;
+  insert(ht, key, convert_std_key(ht, key), elt);
+}
+
+/**
+   Inserts a batch of keys and associated elements into a hash table, with
+   the same result as calling ht_muloa_insert on each key and element in
+   the order of the batch. The keys are hashed in groups, the first slots
+   of the probe sequences of a group are prefetched, and then the keys of
+   the group are inserted, overlapping the cache misses of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   elts        : pointer to num_keys contiguous blocks of size elt_size
+   num_keys    : number of keys in the batch
+*/
+void ht_muloa_insert_batch(ht_muloa_t *ht,
+			   const void *keys,
+			   const void *elts,
+			   size_t num_keys){
+  size_t i, j, n;
+  size_t std_keys[C_BATCH_SIZE], fvals[C_BATCH_SIZE], sval;
+  const char *k = keys, *e = elts;
+  for (i = 0; i < num_keys; i += n){
+    n = (num_keys - i < C_BATCH_SIZE) ? num_keys - i : C_BATCH_SIZE;
+    for (j = 0; j < n; j++){
+      std_keys[j] = convert_std_key(ht, k + j * ht->key_size);
+      hash(ht, std_keys[j], &fvals[j], &sval);
+      prefetch_slot(ht, fvals[j]);
     }
-    ix = sum_mod(dist, ix, ht->count);
-    ke = &ht->key_elts[ix];
-    num_probes++;
-    if (num_probes > ht->max_num_probes) ht->max_num_probes++;
-  }
-  fval -= fval & 1; /* 1st bit not used in hashing => 1 as ph identifier */
-  *ke = ke_new(ht, fval, sval, key, elt);
-  ht->num_elts++;
-  /* max_sum < count; grow ht after ensuring it was insertion, not update */
-  if (ht->num_elts + ht->num_phs > ht->max_sum){
-    if (ht->num_elts < ht->num_phs){
-      ht_clean(ht);
-    }else if (ht->log_count < C_LOG_COUNT_MAX){
-      ht_grow(ht);
+    for (j = 0; j < n; j++){
+      prefetch_ke(ht, fvals[j]);
+    }
+    for (j = 0; j < n; j++){
+      insert(ht, k, std_keys[j], e);
+      k += ht->key_size;
+      e += ht->elt_size;
     }
   }
 }
@@ -318,14 +589,46 @@ void ht_muloa_insert(ht_muloa_t *ht, const void *key, const void *elt){
    If a key is present in a hash table, returns a pointer to its associated 
    element, otherwise returns NULL. The key parameter is not NULL and points
    to a block of size key_size. The returned pointer can be dereferenced
-   according to ht_muloa_init and ht_muloa_align_elt.
+   according to ht_muloa_init and ht_muloa_align_elt. In the inline mode,
+   the returned pointer is guaranteed to point to the element until
+   another insert, remove, or delete operation is performed.
 */
 void *ht_muloa_search(const ht_muloa_t *ht, const void *key){
-  ke_t * const *ke = search(ht, key);
-  if (ke != NULL){
-    return ke_elt_ptr(ht, *ke);
-  }else{
-    return NULL;
+  return search_elt(ht, key, convert_std_key(ht, key));
+}
+
+/**
+   Searches a batch of keys in a hash table. The keys are hashed in groups,
+   the first slots of the probe sequences of a group are prefetched, and
+   then the keys of the group are searched, overlapping the cache misses
+   of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   num_keys    : number of keys in the batch
+   elts        : pointer to a preallocated array of num_keys pointers; the
+                 ith pointer is set to the value returned by ht_muloa_search
+                 on the ith key
+*/
+void ht_muloa_search_batch(const ht_muloa_t *ht,
+			   const void *keys,
+			   size_t num_keys,
+			   void **elts){
+  size_t i, j, n;
+  size_t std_keys[C_BATCH_SIZE], fvals[C_BATCH_SIZE], sval;
+  const char *k = keys;
+  for (i = 0; i < num_keys; i += n){
+    n = (num_keys - i < C_BATCH_SIZE) ? num_keys - i : C_BATCH_SIZE;
+    for (j = 0; j < n; j++){
+      std_keys[j] = convert_std_key(ht, k + j * ht->key_size);
+      hash(ht, std_keys[j], &fvals[j], &sval);
+      prefetch_slot(ht, fvals[j]);
+    }
+    for (j = 0; j < n; j++){
+      prefetch_ke(ht, fvals[j]);
+    }
+    for (j = 0; j < n; j++){
+      elts[i + j] = search_elt(ht, k, std_keys[j]);
+      k += ht->key_size;
+    }
   }
 }
 
@@ -337,15 +640,7 @@ void *ht_muloa_search(const ht_muloa_t *ht, const void *key){
    to blocks of size key_size and elt_size respectively.
 */
 void ht_muloa_remove(ht_muloa_t *ht, const void *key, void *elt){
-  ke_t **ke = search(ht, key);
-  if (ke != NULL){
-    memcpy(elt, ke_elt_ptr(ht, *ke), ht->elt_size);
-    /* if an element is noncontiguous, only the pointer to it is deleted */
-    free(ke_key_ptr(ht, *ke));
-    *ke = ht->ph;
-    ht->num_elts--;
-    ht->num_phs++;
-  }
+  remove_key(ht, key, convert_std_key(ht, key), elt);
 }
 
 /**
@@ -354,14 +649,360 @@ void ht_muloa_remove(ht_muloa_t *ht, const void *key, void *elt){
    to a block of size key_size.
 */
 void ht_muloa_delete(ht_muloa_t *ht, const void *key){
-  ke_t **ke = search(ht, key);
-  if (ke != NULL){
-    ke_free(ht, *ke);
-    *ke = ht->ph;
-    ht->num_elts--;
-    ht->num_phs++;
+  delete_key(ht, key, convert_std_key(ht, key));
+}
+
+/**
+   Computes the hash token of a key. The hash token of a key depends only
+   on the key and the hash table parameters set at initialization, and is
+   valid throughout the lifetime of the hash table, including across its
+   growth. A hash token can be stored by the caller next to the key and
+   passed to the *_hashed operations in order to avoid reducing the key
+   and computing its hash values in each operation. The key parameter is
+   not NULL and points to a block of size key_size.
+*/
+size_t ht_muloa_hash_key(const ht_muloa_t *ht, const void *key){
+  return convert_std_key(ht, key);
+}
+
+/**
+   Perform the insert, search, remove, and delete operations with a hash
+   token of a key computed by ht_muloa_hash_key on the same hash table.
+   The result is the same as the result of the corresponding operation
+   without a hash token. The key, elt parameters are as in the
+   corresponding operations.
+*/
+
+void ht_muloa_insert_hashed(ht_muloa_t *ht,
+			    const void *key,
+			    size_t tok,
+			    const void *elt){
+  insert(ht, key, tok, elt);
+}
+
+void *ht_muloa_search_hashed(const ht_muloa_t *ht,
+			     const void *key,
+			     size_t tok){
+  return search_elt(ht, key, tok);
+}
+
+void ht_muloa_remove_hashed(ht_muloa_t *ht,
+			    const void *key,
+			    size_t tok,
+			    void *elt){
+  remove_key(ht, key, tok, elt);
+}
+
+void ht_muloa_delete_hashed(ht_muloa_t *ht, const void *key, size_t tok){
+  delete_key(ht, key, tok);
+}
+
+/**
+   Compacts a hash table by decreasing its count to the smallest power of
+   two that accomodates alpha as a load factor upper bound with the
+   current number of keys, without decreasing the count below the count
+   set at initialization according to min_num, and by eliminating the
+   placeholders. The keys are rehashed in a single step in both modes of
+   growth. The operation can be called between any two operations, e.g.
+   after a large number of keys were removed from a hash table that is
+   reused, in order to release memory.
+   ht          : pointer to an initialized ht_muloa_t struct
+*/
+void ht_muloa_compact(ht_muloa_t *ht){
+  size_t prev_log_count;
+  own_image(ht);
+  if (ht->prev_count > 0) migrate(ht, ht->prev_count);
+  prev_log_count = ht->log_count;
+  reset_count(ht);
+  while (ht->num_elts > ht->max_sum && incr_count(ht));
+  rehash(ht, prev_log_count, 0);
+}
+
+/**
+   Initializes a cursor for enumerating the keys in a hash table with
+   ht_muloa_next. A cursor is valid until the hash table is modified.
+*/
+void ht_muloa_cursor_init(ht_muloa_cursor_t *cur){
+  cur->ix = 0;
+}
+
+/**
+   Advances a cursor to the next key in a hash table. Returns a pointer to
+   the element associated with the key and sets the pointer pointed to by
+   key to point to the in-table key, or returns NULL if all keys were
+   enumerated. The returned pointer can be dereferenced according to
+   ht_muloa_init and ht_muloa_align.
+   ht          : pointer to an initialized ht_muloa_t struct that was not
+                 modified after the cursor was initialized
+   cur         : pointer to a cursor initialized with ht_muloa_cursor_init
+   key         : pointer to a pointer that is set to point to a key_size
+                 block
+*/
+void *ht_muloa_next(const ht_muloa_t *ht,
+		    ht_muloa_cursor_t *cur,
+		    const void **key){
+  ke_t *ke = NULL;
+  while (cur->ix < ht->prev_count){
+    ke = prev_ke_at(ht, cur->ix);
+    cur->ix++;
+    if (!is_empty(ke) && !is_ph(ke)){
+      *key = ke_key_ptr(ht, ke);
+      return ke_elt_ptr(ht, ke);
+    }
+  }
+  while (cur->ix - ht->prev_count < ht->count){
+    ke = ke_at(ht, cur->ix - ht->prev_count);
+    cur->ix++;
+    if (!is_empty(ke) && !is_ph(ke)){
+      *key = ke_key_ptr(ht, ke);
+      return ke_elt_ptr(ht, ke);
+    }
+  }
+  return NULL;
+}
+
+/**
+   Calls a visit function on each key in a hash table and its associated
+   element. The first argument of visit points to a key_size block, the
+   second argument points to an elt_size block that can be dereferenced
+   according to ht_muloa_init and ht_muloa_align, and the third argument
+   is the arg parameter. The visit function does not modify the hash
+   table, except through the second argument.
+*/
+void ht_muloa_foreach(const ht_muloa_t *ht,
+		      void (*visit)(const void *, void *, void *),
+		      void *arg){
+  const void *key = NULL;
+  void *elt = NULL;
+  ht_muloa_cursor_t cur;
+  ht_muloa_cursor_init(&cur);
+  while ((elt = ht_muloa_next(ht, &cur, &key)) != NULL){
+    visit(key, elt, arg);
+  }
+}
+
+/**
+   Copies the keys of a hash table into an array of num_elts key_size
+   blocks pointed to by keys, and the elements, or pointers to elements,
+   into an array of num_elts elt_size blocks pointed to by elts, s.t. the
+   ith element is associated with the ith key. If keys or elts is NULL,
+   the corresponding array is not written. Returns num_elts. In the inline
+   mode, the slots are read sequentially.
+*/
+size_t ht_muloa_export(const ht_muloa_t *ht, void *keys, void *elts){
+  size_t num = 0;
+  if (ht->prev_count > 0){
+    num = export_slots(ht,
+		       ht->prev_count,
+		       ht->prev_key_elts,
+		       ht->prev_slots,
+		       keys,
+		       elts,
+		       num);
+  }
+  num = export_slots(ht,
+		     ht->count,
+		     ht->key_elts,
+		     ht->slots,
+		     keys,
+		     elts,
+		     num);
+  return num;
+}
+
+/**
+   Writes a hash table into a file as a relocatable binary image. The
+   image can be loaded with ht_muloa_load by a process on a system with
+   the same size_t representation, byte order, and alignment requirements,
+   with the same cmp_key and rdc_key functions. The elements are required
+   to be within contiguous memory blocks that were copied into the hash
+   table, because pointers are not relocatable. The image is in the
+   inline layout regardless of the storage mode of the hash table.
+   Completes the migration of keys if it is in progress. An error message
+   is provided and an exit is executed if a write is not completed.
+   ht          : pointer to an initialized ht_muloa_t struct
+   file        : pointer to a binary stream open for writing, positioned
+                 at the start of the image
+*/
+void ht_muloa_save(ht_muloa_t *ht, FILE *file){
+  size_t i, rem;
+  size_t slot_size = inline_slot_size(ht);
+  size_t unit = lcm_perror(sizeof(size_t), ht->elt_alignment);
+  size_t hdr[C_IMAGE_NUM_FIELDS];
+  unsigned char *buf = NULL;
+  const ke_t *ke = NULL;
+  ke_t *buf_ke = NULL;
+  if (ht->prev_count > 0) migrate(ht, ht->prev_count);
+  hdr[IMG_MAGIC] = C_IMAGE_MAGIC;
+  hdr[IMG_SIZE_T_SIZE] = sizeof(size_t);
+  hdr[IMG_KEY_SIZE] = ht->key_size;
+  hdr[IMG_ELT_SIZE] = ht->elt_size;
+  hdr[IMG_KEY_OFFSET] = ht->key_offset;
+  hdr[IMG_ELT_OFFSET] = ht->elt_offset;
+  hdr[IMG_ELT_ALIGNMENT] = ht->elt_alignment;
+  hdr[IMG_SLOT_SIZE] = slot_size;
+  hdr[IMG_LOG_COUNT] = ht->log_count;
+  hdr[IMG_MIN_LOG_COUNT] = ht->min_log_count;
+  hdr[IMG_COUNT] = ht->count;
+  hdr[IMG_MAX_SUM] = ht->max_sum;
+  hdr[IMG_MAX_NUM_PROBES] = ht->max_num_probes;
+  hdr[IMG_NUM_ELTS] = ht->num_elts;
+  hdr[IMG_NUM_PHS] = ht->num_phs;
+  hdr[IMG_FPRIME] = ht->fprime;
+  hdr[IMG_SPRIME] = ht->sprime;
+  hdr[IMG_ALPHA_N] = ht->alpha_n;
+  hdr[IMG_LOG_ALPHA_D] = ht->log_alpha_d;
+  /* the slots are aligned according to the alignment unit of slots */
+  hdr[IMG_DATA_OFFSET] = C_IMAGE_NUM_FIELDS * sizeof(size_t);
+  rem = hdr[IMG_DATA_OFFSET] % unit;
+  hdr[IMG_DATA_OFFSET] += (rem > 0) * (unit - rem);
+  buf = calloc_perror(1, add_sz_perror(hdr[IMG_DATA_OFFSET], slot_size));
+  memcpy(buf, hdr, sizeof(hdr));
+  if (fwrite(buf, 1, hdr[IMG_DATA_OFFSET], file) != hdr[IMG_DATA_OFFSET]){
+    perror("ht_muloa_save fwrite failed");
+    exit(EXIT_FAILURE);
+  }
+  if (ht->slot_size > 0){
+    if (fwrite(ht->slots, slot_size, ht->count, file) != ht->count){
+      perror("ht_muloa_save fwrite failed");
+      exit(EXIT_FAILURE);
+    }
+  }else{
+    /* a slot in the inline layout is the block of a key element */
+    buf_ke = (ke_t *)(buf + ht->key_offset);
+    for (i = 0; i < ht->count; i++){
+      ke = ht->key_elts[i];
+      memset(buf, 0, slot_size);
+      if (is_empty(ke)){
+	buf_ke->fval = 1;
+	buf_ke->sval = 1;
+      }else if (is_ph(ke)){
+	buf_ke->fval = 1;
+	buf_ke->sval = 0;
+      }else{
+	memcpy(buf,
+	       ke_key_ptr(ht, ke),
+	       ht->key_offset + ht->elt_offset + ht->elt_size);
+      }
+      if (fwrite(buf, slot_size, 1, file) != 1){
+	perror("ht_muloa_save fwrite failed");
+	exit(EXIT_FAILURE);
+      }
+    }
+  }
+  free(buf);
+  buf = NULL;
+}
+
+/**
+   Initializes a hash table from an image written by ht_muloa_save,
+   without rehashing and without an allocation per key. The slots of the
+   hash table are in the image until the first insert, remove, delete, or
+   compact operation copies the slots into an allocated array; the image
+   is not written. A loaded hash table is in the inline mode of storage
+   and in the default mode of growth. An error message is provided and
+   an exit is executed if the image is not valid on the system.
+   ht          : a pointer to a preallocated block of size
+                 sizeof(ht_muloa_t)
+   image       : pointer to an image aligned as a pointer returned by
+                 malloc or mmap; the image is not modified and remains
+                 valid until ht_muloa_free is called or the slots were
+                 copied
+   image_size  : size of the block pointed to by image
+   cmp_key     : cmp_key of the saved hash table, as in ht_muloa_init
+   rdc_key     : rdc_key of the saved hash table, as in ht_muloa_init
+*/
+void ht_muloa_load(ht_muloa_t *ht,
+		   const void *image,
+		   size_t image_size,
+		   int (*cmp_key)(const void *, const void *),
+		   size_t (*rdc_key)(const void *, size_t)){
+  const size_t *hdr = image;
+  if (image_size < C_IMAGE_NUM_FIELDS * sizeof(size_t) ||
+      hdr[IMG_MAGIC] != C_IMAGE_MAGIC ||
+      hdr[IMG_SIZE_T_SIZE] != sizeof(size_t) ||
+      !is_image_layout(hdr) ||
+      hdr[IMG_LOG_COUNT] >= C_FULL_BIT ||
+      hdr[IMG_MIN_LOG_COUNT] > hdr[IMG_LOG_COUNT] ||
+      hdr[IMG_COUNT] != pow_two_perror(hdr[IMG_LOG_COUNT]) ||
+      hdr[IMG_MAX_SUM] >= hdr[IMG_COUNT] ||
+      hdr[IMG_NUM_ELTS] > hdr[IMG_COUNT] ||
+      hdr[IMG_NUM_PHS] > hdr[IMG_COUNT] - hdr[IMG_NUM_ELTS] ||
+      hdr[IMG_ALPHA_N] == 0 ||
+      hdr[IMG_LOG_ALPHA_D] >= C_FULL_BIT ||
+      hdr[IMG_DATA_OFFSET] < C_IMAGE_NUM_FIELDS * sizeof(size_t) ||
+      hdr[IMG_DATA_OFFSET] > image_size ||
+      hdr[IMG_COUNT] > (image_size - hdr[IMG_DATA_OFFSET]) /
+      hdr[IMG_SLOT_SIZE]){
+    fprintf(stderr, "ht_muloa_load invalid image\n");
+    exit(EXIT_FAILURE);
+  }
+  ht->key_size = hdr[IMG_KEY_SIZE];
+  ht->elt_size = hdr[IMG_ELT_SIZE];
+  ht->key_offset = hdr[IMG_KEY_OFFSET];
+  ht->elt_offset = hdr[IMG_ELT_OFFSET];
+  ht->elt_alignment = hdr[IMG_ELT_ALIGNMENT];
+  ht->slot_size = hdr[IMG_SLOT_SIZE];
+  ht->log_count = hdr[IMG_LOG_COUNT];
+  ht->min_log_count = hdr[IMG_MIN_LOG_COUNT];
+  ht->count = hdr[IMG_COUNT];
+  ht->max_sum = hdr[IMG_MAX_SUM];
+  ht->max_num_probes = hdr[IMG_MAX_NUM_PROBES];
+  ht->num_elts = hdr[IMG_NUM_ELTS];
+  ht->num_phs = hdr[IMG_NUM_PHS];
+  ht->fprime = hdr[IMG_FPRIME];
+  ht->sprime = hdr[IMG_SPRIME];
+  ht->alpha_n = hdr[IMG_ALPHA_N];
+  ht->log_alpha_d = hdr[IMG_LOG_ALPHA_D];
+  ht->ph = ph_new();
+  ht->key_elts = NULL;
+  ht->slots = (char *)image + hdr[IMG_DATA_OFFSET];
+  ht->is_incr = 0;
+  ht->prev_log_count = 0;
+  ht->prev_count = 0;
+  ht->prev_max_num_probes = 0;
+  ht->mig_ix = 0;
+  ht->mig_step = 0;
+  ht->prev_key_elts = NULL;
+  ht->prev_slots = NULL;
+  ht->is_image = 1;
+#ifdef HT_MULOA_STATS
+  ht->stats = stats_new();
+#endif
+  ht->cmp_key = cmp_key;
+  ht->rdc_key = rdc_key;
+  ht->free_elt = NULL;
+}
+
+#ifdef HT_MULOA_STATS
+/**
+   Copies the statistics of a hash table into a block pointed to by stats.
+   The ith bin of a probe histogram is the number of probe sequences with
+   i + 1 probes, and the last bin also includes the longer sequences. A
+   search during the migration of keys may count a probe sequence in the
+   new slots and in the previous slots. The processor time of a rehashing
+   operation in the incremental mode does not include the migration of
+   keys by the subsequent operations. The num_bytes value does not include
+   the noncontiguous elements and the slots in a loaded image.
+   ht          : pointer to an initialized ht_muloa_t struct
+   stats       : pointer to a preallocated block of size
+                 sizeof(ht_muloa_stats_t)
+*/
+void ht_muloa_stats(const ht_muloa_t *ht, ht_muloa_stats_t *stats){
+  size_t slot_size = (ht->slot_size > 0) ? ht->slot_size : sizeof(ke_t *);
+  *stats = *ht->stats;
+  stats->max_num_probes = ht->max_num_probes;
+  stats->num_elts = ht->num_elts;
+  stats->num_phs = ht->num_phs;
+  stats->count = ht->count;
+  stats->num_bytes = (ht->is_image ? 0 : ht->count * slot_size) +
+    ht->prev_count * slot_size;
+  if (ht->slot_size == 0){
+    stats->num_bytes += sizeof(ke_t) + ht->num_elts *
+      (ht->key_offset + ht->elt_offset + ht->elt_size);
   }
 }
+#endif
 
 /**
    Frees a hash table and leaves a block of size sizeof(ht_muloa_t)
@@ -369,17 +1010,37 @@ void ht_muloa_delete(ht_muloa_t *ht, const void *key){
 */
 void ht_muloa_free(ht_muloa_t *ht){
   size_t i;
-  ke_t * const *ke = NULL;
-  for (i = 0; i < ht->count; i++){
-    ke = &ht->key_elts[i];
-    if (*ke != NULL && !is_ph(*ke)){
-      ke_free(ht, *ke);
+  ke_t *ke = NULL;
+  if (ht->slot_size == 0 || ht->free_elt != NULL){
+    for (i = 0; i < ht->count; i++){
+      ke = ke_at(ht, i);
+      if (!is_empty(ke) && !is_ph(ke)){
+	ke_free(ht, ke);
+      }
+    }
+  }
+  if (ht->prev_count > 0 && (ht->slot_size == 0 || ht->free_elt != NULL)){
+    for (i = 0; i < ht->prev_count; i++){
+      ke = prev_ke_at(ht, i);
+      if (!is_empty(ke) && !is_ph(ke)){
+	ke_free(ht, ke);
+      }
     }
   }
   ph_free(ht->ph);
   free(ht->key_elts);
+  if (!ht->is_image) free(ht->slots);
+  free(ht->prev_key_elts);
+  free(ht->prev_slots);
+#ifdef HT_MULOA_STATS
+  free(ht->stats);
+  ht->stats = NULL;
+#endif
   ht->ph = NULL;
   ht->key_elts = NULL;
+  ht->slots = NULL;
+  ht->prev_key_elts = NULL;
+  ht->prev_slots = NULL;
 }
 
 /**
@@ -415,6 +1076,18 @@ void ht_muloa_align_helper(void *ht, size_t elt_alignment){
   ht_muloa_align(ht, elt_alignment);
 }
 
+void ht_muloa_inline_helper(void *ht, int is_inline){
+  ht_muloa_inline(ht, is_inline);
+}
+
+void ht_muloa_incr_helper(void *ht, int is_incr){
+  ht_muloa_incr(ht, is_incr);
+}
+
+size_t ht_muloa_tune_helper(void *ht, const void *keys, size_t num_keys){
+  return ht_muloa_tune(ht, keys, num_keys);
+}
+
 void ht_muloa_insert_helper(void *ht, const void *key, const void *elt){
   ht_muloa_insert(ht, key, elt);
 }
@@ -431,10 +1104,100 @@ void ht_muloa_delete_helper(void *ht, const void *key){
   ht_muloa_delete(ht, key);
 }
 
+size_t ht_muloa_hash_key_helper(const void *ht, const void *key){
+  return ht_muloa_hash_key(ht, key);
+}
+
+void ht_muloa_insert_hashed_helper(void *ht,
+				   const void *key,
+				   size_t tok,
+				   const void *elt){
+  ht_muloa_insert_hashed(ht, key, tok, elt);
+}
+
+void *ht_muloa_search_hashed_helper(const void *ht,
+				    const void *key,
+				    size_t tok){
+  return ht_muloa_search_hashed(ht, key, tok);
+}
+
+void ht_muloa_remove_hashed_helper(void *ht,
+				   const void *key,
+				   size_t tok,
+				   void *elt){
+  ht_muloa_remove_hashed(ht, key, tok, elt);
+}
+
+void ht_muloa_delete_hashed_helper(void *ht, const void *key, size_t tok){
+  ht_muloa_delete_hashed(ht, key, tok);
+}
+
+void ht_muloa_compact_helper(void *ht){
+  ht_muloa_compact(ht);
+}
+
+void *ht_muloa_next_helper(const void *ht, void *cur, const void **key){
+  return ht_muloa_next(ht, cur, key);
+}
+
+void ht_muloa_foreach_helper(const void *ht,
+			     void (*visit)(const void *, void *, void *),
+			     void *arg){
+  ht_muloa_foreach(ht, visit, arg);
+}
+
+size_t ht_muloa_export_helper(const void *ht, void *keys, void *elts){
+  return ht_muloa_export(ht, keys, elts);
+}
+
+void ht_muloa_save_helper(void *ht, FILE *file){
+  ht_muloa_save(ht, file);
+}
+
+void ht_muloa_load_helper(void *ht,
+			  const void *image,
+			  size_t image_size,
+			  int (*cmp_key)(const void *, const void *),
+			  size_t (*rdc_key)(const void *, size_t)){
+  ht_muloa_load(ht, image, image_size, cmp_key, rdc_key);
+}
+
+#ifdef HT_MULOA_STATS
+void ht_muloa_stats_helper(const void *ht, void *stats){
+  ht_muloa_stats(ht, stats);
+}
+#endif
+
 void ht_muloa_free_helper(void *ht){
   ht_muloa_free(ht);
 }
 
+/**
+   Initializes a hash table as ht_muloa_init_helper and sets the inline
+   mode of storage, so that the inline mode can be selected through the
+   init helper of a hash table parameter.
+*/
+void ht_muloa_init_inline_helper(void *ht,
+				 size_t key_size,
+				 size_t elt_size,
+				 size_t min_num,
+				 size_t alpha_n,
+				 size_t log_alpha_d,
+				 int (*cmp_key)(const void *, const void *),
+				 size_t (*rdc_key)(const void *, size_t),
+				 void (*free_elt)(void *)){
+  ht_muloa_init(ht,
+		key_size,
+		elt_size,
+		min_num,
+		alpha_n,
+		log_alpha_d,
+		cmp_key,
+		rdc_key,
+		free_elt);
+  ht_muloa_inline(ht, 1);
+}
+
 /** Auxiliary functions */
 
 /**
@@ -453,14 +1216,141 @@ static int is_ph(const ke_t *ke){
   return (ke->fval == 1);
 }
 
+/**
+   Replaces a key element in a slot, or in a previous slot if is_prev is
+   non-zero, with a placeholder. In the pointer mode, the block of the key
+   element is freed, and if the element is noncontiguous, only the pointer
+   to it is deleted.
+*/
+static void ph_put(ht_muloa_t *ht, size_t ix, int is_prev){
+  ke_t **key_elts = is_prev ? ht->prev_key_elts : ht->key_elts;
+  ke_t *ke = NULL;
+  if (ht->slot_size == 0){
+    free(ke_key_ptr(ht, key_elts[ix]));
+    key_elts[ix] = ht->ph;
+  }else{
+    ke = is_prev ? prev_ke_at(ht, ix) : ke_at(ht, ix);
+    ke->fval = 1;
+    ke->sval = 0;
+  }
+}
+
 static void ph_free(ke_t *ke){
   free(ke);
   ke = NULL;
 }
 
 /**
-   Create, update, and free a key element. These functions cannot be used on
-   a placeholder.
+   Initialize the slots of a hash table according to the storage mode and
+   the count of the hash table. In the inline mode, an empty slot is
+   identified by the fval and sval values equal to 1, and a placeholder
+   by the fval and sval values equal to 1 and 0 respectively. The is_ph
+   function can be used on a slot that is not empty.
+*/
+
+static void slots_init(ht_muloa_t *ht){
+  size_t i;
+  ke_t *ke = NULL;
+  if (ht->slot_size == 0){
+    ht->key_elts = malloc_perror(ht->count, sizeof(ke_t *));
+    for (i = 0; i < ht->count; i++){
+      ht->key_elts[i] = NULL;
+    }
+  }else{
+    ht->slots = malloc_perror(ht->count, ht->slot_size);
+    for (i = 0; i < ht->count; i++){
+      ke = ke_at(ht, i);
+      ke->fval = 1;
+      ke->sval = 1;
+    }
+  }
+}
+
+/**
+   Computes the size of a slot in the inline mode according to key_offset,
+   elt_offset, and elt_alignment, s.t. the ke_t struct and the elt_size
+   block in each slot of a malloc'ed array are aligned.
+*/
+static void slot_size_update(ht_muloa_t *ht){
+  ht->slot_size = inline_slot_size(ht);
+}
+
+static size_t inline_slot_size(const ht_muloa_t *ht){
+  size_t rem, unit, slot_size;
+  unit = lcm_perror(sizeof(size_t), ht->elt_alignment);
+  slot_size = add_sz_perror(ht->key_offset,
+			    add_sz_perror(ht->elt_offset, ht->elt_size));
+  rem = slot_size % unit;
+  return add_sz_perror(slot_size, (rem > 0) * (unit - rem));
+}
+
+/**
+   Returns non-zero if the slot layout in an image header is a valid
+   inline layout, i.e. a key_size block is followed by a size_t-aligned
+   ke_t block and an elt_size block within a slot, and the slot size and
+   the offset of the slots are multiples of the alignment unit of slots.
+*/
+static int is_image_layout(const size_t *hdr){
+  size_t unit, slot_size = hdr[IMG_SLOT_SIZE];
+  if (hdr[IMG_KEY_SIZE] == 0 ||
+      hdr[IMG_ELT_SIZE] == 0 ||
+      hdr[IMG_ELT_ALIGNMENT] == 0 ||
+      hdr[IMG_KEY_SIZE] > hdr[IMG_KEY_OFFSET] ||
+      hdr[IMG_KEY_OFFSET] % sizeof(size_t) != 0 ||
+      hdr[IMG_ELT_OFFSET] < sizeof(ke_t) ||
+      hdr[IMG_KEY_OFFSET] > slot_size ||
+      hdr[IMG_ELT_OFFSET] > slot_size - hdr[IMG_KEY_OFFSET] ||
+      hdr[IMG_ELT_SIZE] >
+      slot_size - hdr[IMG_KEY_OFFSET] - hdr[IMG_ELT_OFFSET]){
+    return 0;
+  }
+  unit = lcm_perror(sizeof(size_t), hdr[IMG_ELT_ALIGNMENT]);
+  return (slot_size % unit == 0 &&
+	  (hdr[IMG_KEY_OFFSET] + hdr[IMG_ELT_OFFSET]) %
+	  hdr[IMG_ELT_ALIGNMENT] == 0 &&
+	  hdr[IMG_DATA_OFFSET] % unit == 0);
+}
+
+/**
+   Copies the slots of a hash table loaded from an image into an allocated
+   array before the first modification of the hash table.
+*/
+static void own_image(ht_muloa_t *ht){
+  void *slots = NULL;
+  if (!ht->is_image) return;
+  slots = malloc_perror(ht->count, ht->slot_size);
+  memcpy(slots, ht->slots, ht->count * ht->slot_size);
+  ht->slots = slots;
+  ht->is_image = 0;
+}
+
+/**
+   Returns a pointer to the key element in a slot. In the pointer mode
+   returns NULL if the slot is empty.
+*/
+static ke_t *ke_at(const ht_muloa_t *ht, size_t ix){
+  if (ht->slot_size == 0) return ht->key_elts[ix];
+  return (ke_t *)((char *)ht->slots + ix * ht->slot_size + ht->key_offset);
+}
+
+/**
+   Returns a pointer to the key element in a previous slot during the
+   migration of keys. In the pointer mode returns NULL if the slot is
+   empty.
+*/
+static ke_t *prev_ke_at(const ht_muloa_t *ht, size_t ix){
+  if (ht->slot_size == 0) return ht->prev_key_elts[ix];
+  return (ke_t *)((char *)ht->prev_slots +
+		  ix * ht->slot_size + ht->key_offset);
+}
+
+static int is_empty(const ke_t *ke){
+  return (ke == NULL || (ke->fval == 1 && ke->sval == 1));
+}
+
+/**
+   Create, put, update, and free a key element. These functions cannot be
+   used on a placeholder.
 */
 
 static ke_t *ke_new(const ht_muloa_t *ht,
@@ -482,6 +1372,24 @@ static ke_t *ke_new(const ht_muloa_t *ht,
   return ke;
 }
 
+static void ke_put(ht_muloa_t *ht,
+		   size_t ix,
+		   size_t fval,
+		   size_t sval,
+		   const void *key,
+		   const void *elt){
+  ke_t *ke = NULL;
+  if (ht->slot_size == 0){
+    ht->key_elts[ix] = ke_new(ht, fval, sval, key, elt);
+  }else{
+    ke = ke_at(ht, ix);
+    ke->fval = fval;
+    ke->sval = sval;
+    memcpy(ke_key_ptr(ht, ke), key, ht->key_size);
+    memcpy(ke_elt_ptr(ht, ke), elt, ht->elt_size);
+  }
+}
+
 static void ke_elt_update(const ht_muloa_t *ht, ke_t *ke, const void *elt){
   if (ht->free_elt != NULL) ht->free_elt(ke_elt_ptr(ht, ke));
   memcpy(ke_elt_ptr(ht, ke), elt, ht->elt_size);
@@ -497,7 +1405,7 @@ static void *ke_elt_ptr(const ht_muloa_t *ht, const ke_t *ke){
 
 static void ke_free(const ht_muloa_t *ht, ke_t *ke){
   if (ht->free_elt != NULL) ht->free_elt(ke_elt_ptr(ht, ke));
-  free(ke_key_ptr(ht, ke));
+  if (ht->slot_size == 0) free(ke_key_ptr(ht, ke));
   ke = NULL;
 }
 
@@ -532,6 +1440,40 @@ static size_t convert_std_key(const ht_muloa_t *ht, const void *key){
   return std_key;
 }
 
+/**
+   Computes the first and second hash values of a key converted to a key
+   of the standard size.
+*/
+static void hash(const ht_muloa_t *ht,
+		 size_t std_key,
+		 size_t *fval,
+		 size_t *sval){
+  *fval = ht->fprime * std_key; /* mod 2**C_FULL_BIT */
+  *sval = ht->sprime * std_key; /* mod 2**C_FULL_BIT */
+}
+
+/**
+   Prefetch the first slot in the probe sequence of a key with the first
+   hash value fval, and in the pointer mode, the key of the block pointed
+   to from the slot. The latter is called after the slot was prefetched.
+*/
+
+static void prefetch_slot(const ht_muloa_t *ht, size_t fval){
+  size_t ix = fval >> (C_FULL_BIT - ht->log_count);
+  if (ht->slot_size == 0){
+    PREFETCH(&ht->key_elts[ix]);
+  }else{
+    PREFETCH((char *)ht->slots + ix * ht->slot_size);
+  }
+}
+
+static void prefetch_ke(const ht_muloa_t *ht, size_t fval){
+  size_t ix = fval >> (C_FULL_BIT - ht->log_count);
+  if (ht->slot_size == 0 && ht->key_elts[ix] != NULL){
+    PREFETCH(ke_key_ptr(ht, ht->key_elts[ix]));
+  }
+}
+
 /**
    Adjusts a probe distance to an odd distance, if necessary. 
 */
@@ -548,40 +1490,191 @@ static size_t adjust_dist(size_t dist){
 }
 
 /**
-   If a key is present in a hash table, returns a pointer to a slot
-   in the key_elts array that stores a pointer to ke_t with the
-   key, otherwise returns NULL.
+   Inserts a key, converted to the standard key std_key, and an associated
+   element into a hash table. During the migration of keys, if the key is
+   in a previous slot, the element is updated in the previous slot.
 */
-static ke_t **search(const ht_muloa_t *ht, const void *key){
+static void insert(ht_muloa_t *ht,
+		   const void *key,
+		   size_t std_key,
+		   const void *elt){
   size_t num_probes = 1;
-  size_t std_key, fval, sval, ix, dist;
-  ke_t * const *ke = NULL;
-  std_key = convert_std_key(ht, key);
-  fval = ht->fprime * std_key; /* mod 2**FULL_BIT */
-  sval = ht->sprime * std_key; /* mod 2**FULL_BIT */
+  size_t fval, sval, ix, dist;
+  ke_t *ke = NULL;
+  own_image(ht);
+  if (ht->prev_count > 0) migrate(ht, ht->mig_step);
+  if (ht->prev_count > 0){
+    ix = search(ht, key, std_key, 1);
+    if (ix != C_SIZE_MAX){
+      ke_elt_update(ht, prev_ke_at(ht, ix), elt);
+      return;
+    }
+  }
+  hash(ht, std_key, &fval, &sval);
   ix = fval >> (C_FULL_BIT - ht->log_count);
   dist = adjust_dist(sval >> (C_FULL_BIT - ht->log_count));
-  ke = &ht->key_elts[ix];
-  while (*ke != NULL){
+  ke = ke_at(ht, ix);
+  while (!is_empty(ke)){
     if (ht->cmp_key != NULL && /* loop invariant */
-	!is_ph(*ke) &&
-	ht->cmp_key(ke_key_ptr(ht, *ke), key) == 0){
-      return (ke_t **)ke;
+	!is_ph(ke) &&
+	ht->cmp_key(ke_key_ptr(ht, ke), key) == 0){
+      ke_elt_update(ht, ke, elt);
+      return;
     }else if (ht->cmp_key == NULL && /* loop invariant */
-	      !is_ph(*ke) &&
-	      memcmp(ke_key_ptr(ht, *ke), key, ht->key_size) == 0){
-      return (ke_t **)ke;
-    }else if (num_probes == ht->max_num_probes){
+	      !is_ph(ke) &&
+	      memcmp(ke_key_ptr(ht, ke), key, ht->key_size) == 0){
+      ke_elt_update(ht, ke, elt);
+      return;
+    }
+    ix = sum_mod(dist, ix, ht->count);
+    ke = ke_at(ht, ix);
+    num_probes++;
+    if (num_probes > ht->max_num_probes) ht->max_num_probes++;
+  }
+  STATS_PROBES(ht, ins_probe_hist, num_probes);
+  fval -= fval & 1; /* 1st bit not used in hashing => 1 as ph identifier */
+  ke_put(ht, ix, fval, sval, key, elt);
+  ht->num_elts++;
+  /* max_sum < count; grow ht after ensuring it was insertion, not update */
+  if (ht->num_elts + ht->num_phs > ht->max_sum){
+    if (ht->num_elts < ht->num_phs){
+      ht_clean(ht);
+    }else if (ht->log_count < C_LOG_COUNT_MAX){
+      ht_grow(ht);
+    }
+  }
+}
+
+/**
+   If a key, converted to the standard key std_key, is present in a hash
+   table, returns the index of the slot with the key, otherwise returns
+   C_SIZE_MAX. If is_prev is non-zero, the previous slots are searched
+   during the migration of keys.
+*/
+static size_t search(const ht_muloa_t *ht,
+		     const void *key,
+		     size_t std_key,
+		     int is_prev){
+  size_t num_probes = 1;
+  size_t fval, sval, ix, dist;
+  size_t ret = C_SIZE_MAX;
+  size_t log_count = is_prev ? ht->prev_log_count : ht->log_count;
+  size_t count = is_prev ? ht->prev_count : ht->count;
+  size_t max_num_probes =
+    is_prev ? ht->prev_max_num_probes : ht->max_num_probes;
+  const ke_t *ke = NULL;
+  hash(ht, std_key, &fval, &sval);
+  ix = fval >> (C_FULL_BIT - log_count);
+  dist = adjust_dist(sval >> (C_FULL_BIT - log_count));
+  ke = is_prev ? prev_ke_at(ht, ix) : ke_at(ht, ix);
+  while (!is_empty(ke)){
+    if (ht->cmp_key != NULL && /* loop invariant */
+	!is_ph(ke) &&
+	ht->cmp_key(ke_key_ptr(ht, ke), key) == 0){
+      ret = ix;
+      break;
+    }else if (ht->cmp_key == NULL && /* loop invariant */
+	      !is_ph(ke) &&
+	      memcmp(ke_key_ptr(ht, ke), key, ht->key_size) == 0){
+      ret = ix;
+      break;
+    }else if (num_probes == max_num_probes){
       break;
     }else{
-      ix = sum_mod(dist, ix, ht->count);
-      ke = &ht->key_elts[ix];
+      ix = sum_mod(dist, ix, count);
+      ke = is_prev ? prev_ke_at(ht, ix) : ke_at(ht, ix);
       num_probes++;
     }
   }
+  STATS_PROBES(ht, probe_hist, num_probes);
+  return ret;
+}
+
+/**
+   If a key, converted to the standard key std_key, is present in a hash
+   table, returns a pointer to its associated element, otherwise returns
+   NULL. During the migration of keys, the previous slots are searched if
+   the key is not in the new slots.
+*/
+static void *search_elt(const ht_muloa_t *ht,
+			const void *key,
+			size_t std_key){
+  size_t ix = search(ht, key, std_key, 0);
+  if (ix != C_SIZE_MAX) return ke_elt_ptr(ht, ke_at(ht, ix));
+  if (ht->prev_count > 0){
+    ix = search(ht, key, std_key, 1);
+    if (ix != C_SIZE_MAX) return ke_elt_ptr(ht, prev_ke_at(ht, ix));
+  }
   return NULL;
 }
 
+/**
+   Removes a key, converted to the standard key std_key, and its associated
+   element from a hash table by copying the element or its pointer into a
+   block of size elt_size pointed to by elt, if the key is in the hash
+   table. A placeholder in a previous slot is not counted in num_phs.
+   Shrinks the hash table if the lower load factor bound was reached.
+*/
+static void remove_key(ht_muloa_t *ht,
+		       const void *key,
+		       size_t std_key,
+		       void *elt){
+  size_t ix;
+  own_image(ht);
+  if (ht->prev_count > 0) migrate(ht, ht->mig_step);
+  ix = search(ht, key, std_key, 0);
+  if (ix != C_SIZE_MAX){
+    memcpy(elt, ke_elt_ptr(ht, ke_at(ht, ix)), ht->elt_size);
+    /* if an element is noncontiguous, only the pointer to it is deleted */
+    ph_put(ht, ix, 0);
+    ht->num_elts--;
+    ht->num_phs++;
+  }else if (ht->prev_count > 0){
+    ix = search(ht, key, std_key, 1);
+    if (ix != C_SIZE_MAX){
+      memcpy(elt, ke_elt_ptr(ht, prev_ke_at(ht, ix)), ht->elt_size);
+      ph_put(ht, ix, 1);
+      ht->num_elts--;
+    }
+  }
+  if (ht->num_elts < ht->max_sum / C_SHRINK_DIV &&
+      ht->log_count > ht->min_log_count){
+    ht_shrink(ht);
+  }
+}
+
+/**
+   Deletes a key, converted to the standard key std_key, and its associated
+   element according to free_elt from a hash table, if the key is in the
+   hash table. A placeholder in a previous slot is not counted in num_phs.
+   Shrinks the hash table if the lower load factor bound was reached.
+*/
+static void delete_key(ht_muloa_t *ht, const void *key, size_t std_key){
+  size_t ix;
+  own_image(ht);
+  if (ht->prev_count > 0) migrate(ht, ht->mig_step);
+  ix = search(ht, key, std_key, 0);
+  if (ix != C_SIZE_MAX){
+    if (ht->free_elt != NULL) ht->free_elt(ke_elt_ptr(ht, ke_at(ht, ix)));
+    ph_put(ht, ix, 0);
+    ht->num_elts--;
+    ht->num_phs++;
+  }else if (ht->prev_count > 0){
+    ix = search(ht, key, std_key, 1);
+    if (ix != C_SIZE_MAX){
+      if (ht->free_elt != NULL){
+	ht->free_elt(ke_elt_ptr(ht, prev_ke_at(ht, ix)));
+      }
+      ph_put(ht, ix, 1);
+      ht->num_elts--;
+    }
+  }
+  if (ht->num_elts < ht->max_sum / C_SHRINK_DIV &&
+      ht->log_count > ht->min_log_count){
+    ht_shrink(ht);
+  }
+}
+
 /**
    Multiplies an unsigned integer n by a load factor upper bound, represented
    by a numerator and log base 2 of a denominator. The denominator is a
@@ -604,27 +1697,33 @@ static size_t mul_alpha(size_t n, size_t alpha_n, size_t log_alpha_d){
        sufficient power of two is available, or
    ii) lowers the load factor as low as possible.
    The count is doubled at least once. If 2**C_LOG_COUNT_MAX is reached
-   log_count is set to C_LOG_COUNT_MAX.
+   log_count is set to C_LOG_COUNT_MAX. In the incremental mode, completes
+   the migration of keys if it is in progress.
 */
 static void ht_grow(ht_muloa_t *ht){
-  size_t i, prev_count = ht->count;
-  ke_t **prev_key_elts = ht->key_elts;
-  ke_t * const *ke = NULL;
+  size_t prev_log_count;
+  if (ht->prev_count > 0) migrate(ht, ht->prev_count);
+  prev_log_count = ht->log_count;
   while (ht->num_elts + ht->num_phs > ht->max_sum && incr_count(ht));
-  ht->max_num_probes = 1;
-  ht->num_phs = 0;
-  ht->key_elts = malloc_perror(ht->count, sizeof(ke_t *));
-  for (i = 0; i < ht->count; i++){
-    ht->key_elts[i] = NULL;
-  }
-  for (i = 0; i < prev_count; i++){
-    ke = &prev_key_elts[i];
-    if (*ke != NULL && !is_ph(*ke)){
-      reinsert(ht, *ke);
-    }
-  }
-  free(prev_key_elts);
-  prev_key_elts = NULL;
+  rehash(ht, prev_log_count, ht->is_incr);
+}
+
+/**
+   Decreases the count of a hash table to the smallest power of two, not
+   less than the count set at initialization, s.t. the load factor is at
+   most half of alpha, and eliminates the placeholders. The operation is
+   called if num_elts < max_sum / C_SHRINK_DIV and log_count is greater
+   than min_log_count. In the incremental mode, completes the migration
+   of keys if it is in progress.
+*/
+static void ht_shrink(ht_muloa_t *ht){
+  size_t prev_log_count;
+  if (ht->prev_count > 0) migrate(ht, ht->prev_count);
+  prev_log_count = ht->log_count;
+  reset_count(ht);
+  /* 2 * num_elts < max_sum / 2 at the previous count */
+  while (2 * ht->num_elts > ht->max_sum && incr_count(ht));
+  rehash(ht, prev_log_count, ht->is_incr);
 }
 		      
 /**
@@ -643,51 +1742,148 @@ static int incr_count(ht_muloa_t *ht){
   return 1;
 }
 
+/**
+   Sets the count, log_count, and max_sum of a hash table to the values
+   set at initialization.
+*/
+static void reset_count(ht_muloa_t *ht){
+  ht->log_count = ht->min_log_count;
+  ht->count = pow_two_perror(ht->log_count);
+  ht->max_sum = mul_alpha(ht->count, ht->alpha_n, ht->log_alpha_d);
+  if (ht->max_sum == ht->count) ht->max_sum = ht->count - 1;
+}
+
 /**
    Eliminates the placeholders left by delete and remove operations.
    If called when num_elts < num_placeholders, then for every delete/remove 
    operation at most one rehashing operation is performed, resulting in a 
    constant overhead of at most one rehashing per delete/remove operation.
+   In the incremental mode, completes the migration of keys if it is in
+   progress.
 */
 static void ht_clean(ht_muloa_t *ht){
-  size_t i;
+  if (ht->prev_count > 0) migrate(ht, ht->prev_count);
+  rehash(ht, ht->log_count, ht->is_incr);
+}
+
+/**
+   Reinserts the key elements from the previous slots of a hash table, 
+   with 2**prev_log_count slots, into new slots according to the current
+   count of the hash table, and frees the previous slots. If is_incr is
+   non-zero, keeps the previous slots and starts a migration of keys,
+   which is continued by the subsequent operations.
+*/
+static void rehash(ht_muloa_t *ht, size_t prev_log_count, int is_incr){
+  size_t i, room;
+  size_t prev_count = pow_two_perror(prev_log_count);
   ke_t **prev_key_elts = ht->key_elts;
-  ke_t * const *ke = NULL;
+  char *prev_slots = ht->slots;
+  ke_t *ke = NULL;
+#ifdef HT_MULOA_STATS
+  clock_t t = clock();
+#endif
+  if (is_incr) ht->prev_max_num_probes = ht->max_num_probes;
   ht->max_num_probes = 1;
   ht->num_phs = 0;
-  ht->key_elts = malloc_perror(ht->count, sizeof(ke_t *));
-  for (i = 0; i < ht->count; i++){
-    ht->key_elts[i] = NULL;
-  }
-  for (i = 0; i < ht->count; i++){
-    ke = &prev_key_elts[i];
-    if (*ke != NULL && !is_ph(*ke)){
-      reinsert(ht, *ke);
+  slots_init(ht);
+  if (is_incr){
+    /* migration within room insertions; mig_step * room >= prev_count */
+    room = (ht->max_sum > ht->num_elts) ?
+      (ht->max_sum - ht->num_elts) / C_MIG_ROOM_DIV : 0;
+    ht->prev_log_count = prev_log_count;
+    ht->prev_count = prev_count;
+    ht->mig_ix = 0;
+    ht->mig_step = (room > 0) ? prev_count / room + 1 : prev_count;
+    ht->prev_key_elts = prev_key_elts;
+    ht->prev_slots = prev_slots;
+#ifdef HT_MULOA_STATS
+    stats_rehash(ht, prev_count, clock() - t);
+#endif
+    return;
+  }
+  if (ht->slot_size == 0){
+    for (i = 0; i < prev_count; i++){
+      ke = prev_key_elts[i];
+      if (ke != NULL && !is_ph(ke)) reinsert(ht, ke);
+    }
+  }else{
+    for (i = 0; i < prev_count; i++){
+      ke = (ke_t *)(prev_slots + i * ht->slot_size + ht->key_offset);
+      if (!is_empty(ke) && !is_ph(ke)) reinsert(ht, ke);
     }
   }
   free(prev_key_elts);
+  free(prev_slots);
   prev_key_elts = NULL;
+  prev_slots = NULL;
+#ifdef HT_MULOA_STATS
+  stats_rehash(ht, prev_count, clock() - t);
+#endif
 }
 
 /**
    Reinserts a key and an associated element into a new hash table during 
    ht_grow and ht_clean operations by recomputing the hash values with 
-   bit shifting and without multiplication.
+   bit shifting and without multiplication. In the inline mode, the slot
+   of the key element is copied.
 */
 static void reinsert(ht_muloa_t *ht, const ke_t *prev_ke){
   size_t num_probes = 1;
   size_t ix, dist;
-  ke_t **ke = NULL;
+  ke_t *ke = NULL;
   ix = prev_ke->fval >> (C_FULL_BIT - ht->log_count);
   dist = adjust_dist(prev_ke->sval >> (C_FULL_BIT - ht->log_count));
-  ke = &ht->key_elts[ix];
-  while (*ke != NULL){
+  ke = ke_at(ht, ix);
+  while (!is_empty(ke)){
     ix = sum_mod(dist, ix, ht->count);
-    ke = &ht->key_elts[ix];
+    ke = ke_at(ht, ix);
     num_probes++;
     if (num_probes > ht->max_num_probes) ht->max_num_probes++;
   }
-  *ke = (ke_t *)prev_ke;
+  if (ht->slot_size == 0){
+    ht->key_elts[ix] = (ke_t *)prev_ke;
+  }else{
+    memcpy((char *)ke - ht->key_offset,
+	   (const char *)prev_ke - ht->key_offset,
+	   ht->slot_size);
+  }
+}
+
+/**
+   Moves the keys in at most num_slots previous slots of a hash table to
+   the new slots in the incremental mode, leaving a placeholder in each
+   previous slot of a moved key, and frees the previous slots after the
+   keys of all previous slots are moved. The operation is called if a
+   migration of keys is in progress.
+*/
+static void migrate(ht_muloa_t *ht, size_t num_slots){
+  size_t end;
+  ke_t *ke = NULL;
+  end = (ht->prev_count - ht->mig_ix < num_slots) ?
+    ht->prev_count : ht->mig_ix + num_slots;
+  while (ht->mig_ix < end){
+    ke = prev_ke_at(ht, ht->mig_ix);
+    if (!is_empty(ke) && !is_ph(ke)){
+      reinsert(ht, ke);
+      if (ht->slot_size == 0){
+	ht->prev_key_elts[ht->mig_ix] = ht->ph;
+      }else{
+	ke->fval = 1;
+	ke->sval = 0;
+      }
+    }
+    ht->mig_ix++;
+  }
+  if (ht->mig_ix == ht->prev_count){
+    free(ht->prev_key_elts);
+    free(ht->prev_slots);
+    ht->prev_key_elts = NULL;
+    ht->prev_slots = NULL;
+    ht->prev_log_count = 0;
+    ht->prev_count = 0;
+    ht->prev_max_num_probes = 0;
+    ht->mig_ix = 0;
+  }
 }
 
 /**
@@ -741,3 +1937,141 @@ static size_t find_build_prime(const size_t *parts){
   }
   return p;
 }
+
+/**
+   Inserts standard keys into a set of occupied slots, represented by the
+   count of ht and a preallocated occ array of count bytes, with double
+   hashing according to the multiplication constants fprime and sprime.
+   Returns the total number of probes, or a number >= bound as soon as the
+   number of probes reaches bound.
+*/
+static size_t tune_probes(const ht_muloa_t *ht,
+			  const size_t *std_keys,
+			  size_t num_keys,
+			  size_t fprime,
+			  size_t sprime,
+			  unsigned char *occ,
+			  size_t bound){
+  size_t i, ix, dist;
+  size_t num_probes = 0;
+  memset(occ, 0, ht->count);
+  for (i = 0; i < num_keys && num_probes < bound; i++){
+    ix = (fprime * std_keys[i]) >> (C_FULL_BIT - ht->log_count);
+    dist = adjust_dist((sprime * std_keys[i]) >> (C_FULL_BIT - ht->log_count));
+    num_probes++;
+    while (occ[ix]){
+      ix = sum_mod(dist, ix, ht->count);
+      num_probes++;
+    }
+    occ[ix] = 1;
+  }
+  return num_probes;
+}
+
+/**
+   Computes the constant that follows c in a linear congruential sequence
+   modulo 2**n, n = CHAR_BIT * sizeof(size_t), with the current first and
+   second constants of a hash table as the multiplier and increment, and
+   sets the lowest and highest bits of the result. Given a fixed pair of
+   current constants, the sequence and the evaluated pairs are fixed.
+*/
+static size_t tune_next(const ht_muloa_t *ht, size_t c){
+  c = ht->fprime * c + ht->sprime; /* mod 2**C_FULL_BIT */
+  return c | 1 | ((size_t)1 << (C_FULL_BIT - 1));
+}
+
+/**
+   Copies the keys and elements in count slots, pointed to by key_elts in
+   the pointer mode and by slots in the inline mode, into the arrays
+   pointed to by keys and elts, starting at the position num in each
+   array. If keys or elts is NULL, the corresponding array is not written.
+   Returns num incremented by the number of copied keys. In the inline
+   mode, the slots are read in a single sequential pass.
+*/
+static size_t export_slots(const ht_muloa_t *ht,
+			   size_t count,
+			   ke_t * const *key_elts,
+			   const void *slots,
+			   char *keys,
+			   char *elts,
+			   size_t num){
+  size_t i;
+  const char *p = NULL;
+  const ke_t *ke = NULL;
+  if (ht->slot_size == 0){
+    for (i = 0; i < count; i++){
+      ke = key_elts[i];
+      if (ke == NULL || is_ph(ke)) continue;
+      if (keys != NULL){
+	memcpy(keys + num * ht->key_size, ke_key_ptr(ht, ke), ht->key_size);
+      }
+      if (elts != NULL){
+	memcpy(elts + num * ht->elt_size, ke_elt_ptr(ht, ke), ht->elt_size);
+      }
+      num++;
+    }
+  }else{
+    p = slots;
+    for (i = 0; i < count; i++, p += ht->slot_size){
+      ke = (const ke_t *)(p + ht->key_offset);
+      if (ke->fval == 1) continue; /* empty or placeholder */
+      if (keys != NULL) memcpy(keys + num * ht->key_size, p, ht->key_size);
+      if (elts != NULL){
+	memcpy(elts + num * ht->elt_size,
+	       p + ht->key_offset + ht->elt_offset,
+	       ht->elt_size);
+      }
+      num++;
+    }
+  }
+  return num;
+}
+
+#ifdef HT_MULOA_STATS
+/**
+   Allocates and zeroes the statistics of a hash table.
+*/
+static ht_muloa_stats_t *stats_new(){
+  size_t i;
+  ht_muloa_stats_t *stats = malloc_perror(1, sizeof(ht_muloa_stats_t));
+  for (i = 0; i < HT_MULOA_STATS_BINS; i++){
+    stats->probe_hist[i] = 0;
+    stats->ins_probe_hist[i] = 0;
+  }
+  stats->max_num_probes = 0;
+  stats->num_elts = 0;
+  stats->num_phs = 0;
+  stats->count = 0;
+  stats->num_grows = 0;
+  stats->num_shrinks = 0;
+  stats->num_cleans = 0;
+  stats->rehash_time = 0;
+  stats->max_rehash_time = 0;
+  stats->num_bytes = 0;
+  return stats;
+}
+
+/**
+   Counts a probe sequence with num_probes probes in a histogram.
+*/
+static void stats_probes(size_t *hist, size_t num_probes){
+  if (num_probes > HT_MULOA_STATS_BINS) num_probes = HT_MULOA_STATS_BINS;
+  hist[num_probes - 1]++;
+}
+
+/**
+   Counts a rehashing operation from prev_count slots with processor time
+   t according to the change of count.
+*/
+static void stats_rehash(ht_muloa_t *ht, size_t prev_count, clock_t t){
+  if (prev_count < ht->count){
+    ht->stats->num_grows++;
+  }else if (prev_count > ht->count){
+    ht->stats->num_shrinks++;
+  }else{
+    ht->stats->num_cleans++;
+  }
+  ht->stats->rehash_time += t;
+  if (t > ht->stats->max_rehash_time) ht->stats->max_rehash_time = t;
+}
+#endif
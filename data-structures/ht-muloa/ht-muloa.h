@@ -18,12 +18,62 @@
    expected number of probes is upper-bounded by 1/(1 - load factor) before
    the full occupancy is reached.
 
+   A hash table shrinks if, after a remove or delete operation, the
+   number of keys is less than a quarter of the number of keys allowed by
+   alpha, and the count is greater than the count set at initialization.
+   After shrinking, the load factor is at most half of alpha. The
+   ht_muloa_compact operation shrinks a hash table to the smallest count
+   with a load factor not exceeding alpha and eliminates placeholders.
+
+   The multiplication constants of a hash table are selected with
+   ht_muloa_tune to minimize the number of probes on a sample of frequent
+   keys, as determined at the time of graph construction.
+
    A hash key is an object within a contiguous block of memory (e.g. a basic
    type, array, struct). If the key size is greater than sizeof(size_t)
    bytes, then it is reduced to a sizeof(size_t)-byte block prior to hashing.
    Key size reduction methods may introduce regularities. An element is
    within a contiguous or noncontiguous block of memory.
 
+   A hash table is in a pointer mode or an inline mode of storage. In the
+   pointer mode, a key, its hash values, and an element (or a pointer to
+   an element) are within a separately allocated block, and a slot contains
+   a pointer to the block. In the inline mode, the key, hash values, and
+   element are within a fixed-size slot of a single contiguous array,
+   which eliminates an allocation per insertion and a pointer dereference
+   per probe. A probe in the inline mode accesses one or two cache lines
+   if the size of a slot does not exceed the size of a cache line. The
+   pointer mode is the default, because in the pointer mode a pointer
+   returned by a search remains valid while its key is in the hash table.
+   The inline mode is set with ht_muloa_inline.
+
+   A hash table is rehashed in a single step by default, which moves all
+   keys in one operation. In the optional incremental mode of growth, the
+   previous slots are kept next to the new slots after a rehashing step,
+   and each subsequent insert, remove, or delete operation moves the keys
+   of a bounded number of previous slots, until all keys are moved. A
+   moved key leaves a placeholder in its previous slot. A search during
+   the migration of keys probes the new slots and then the previous slots.
+
+   The keys of a hash table are enumerated with a cursor, with a foreach
+   operation, or are copied with their elements into contiguous arrays
+   with an export operation. The order of enumeration is the order of
+   slots, with the previous slots first during the migration of keys.
+
+   A hash table is saved into a relocatable binary image with
+   ht_muloa_save. The image contains a header and the slots in the inline
+   layout, and contains no pointers. A hash table is loaded from an image
+   in memory, e.g. a memory-mapped file, with ht_muloa_load without
+   rehashing and without an allocation per key. The slots of a loaded hash
+   table remain in the image, which is not written, until the first
+   modifying operation copies the slots into an allocated array.
+
+   If HT_MULOA_STATS is defined at compile time, a hash table maintains
+   statistics that are read with ht_muloa_stats, including histograms of
+   the numbers of probes, the placeholder count, the rehashing events and
+   their processor times, and the number of allocated bytes. Otherwise,
+   the statistics and their instrumentation are not compiled.
+
    The implementation only uses integer and pointer operations. Integer
    arithmetic is used in load factor operations, thereby eliminating the
    use of float. Given parameter values within the specified ranges,
@@ -46,6 +96,10 @@
 #define HT_MULOA_H
 
 #include <stddef.h>
+#include <stdio.h>
+#ifdef HT_MULOA_STATS
+#include <time.h>
+#endif
 
 typedef struct{
   size_t fval; /* first hash value with first bit only set in placeholder */
@@ -55,29 +109,67 @@ typedef struct{
                   p + elt_offset points to elt_size block;
                   see ke_key_ptr and ke_elt_ptr functions */
 
+#ifdef HT_MULOA_STATS
+#define HT_MULOA_STATS_BINS 16
+
+typedef struct{
+  size_t probe_hist[HT_MULOA_STATS_BINS]; /* searches */
+  size_t ins_probe_hist[HT_MULOA_STATS_BINS]; /* insertions of new keys */
+  size_t max_num_probes;
+  size_t num_elts;
+  size_t num_phs;
+  size_t count;
+  size_t num_grows;
+  size_t num_shrinks;
+  size_t num_cleans; /* rehashing without a change of count */
+  clock_t rehash_time; /* processor time of rehashing operations */
+  clock_t max_rehash_time;
+  size_t num_bytes; /* allocated for slots and key element blocks */
+} ht_muloa_stats_t;
+#endif
+
 typedef struct{
   size_t key_size;
   size_t elt_size;
   size_t key_offset;
   size_t elt_offset;
   size_t elt_alignment;
+  size_t slot_size; /* > 0 in inline mode, 0 in pointer mode */
   size_t log_count;
+  size_t min_log_count; /* log_count set at initialization */
   size_t count;
   size_t max_sum; /* >= 0, < count, represents alpha */
   size_t max_num_probes;
   size_t num_elts;
   size_t num_phs;
-  size_t fprime; /* >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
-  size_t sprime; /* >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
+  size_t fprime; /* odd, >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
+  size_t sprime; /* odd, >2**(n - 1), <2**n, n = CHAR_BIT * sizeof(size_t) */
   size_t alpha_n;
   size_t log_alpha_d;
   ke_t *ph;
-  ke_t **key_elts;
+  ke_t **key_elts; /* pointer mode, NULL in inline mode */
+  void *slots; /* inline mode, NULL in pointer mode */
+  int is_incr; /* non-zero in the incremental mode of growth */
+  size_t prev_log_count;
+  size_t prev_count; /* 0 if no migration is in progress */
+  size_t prev_max_num_probes;
+  size_t mig_ix; /* next previous slot to migrate */
+  size_t mig_step; /* number of previous slots migrated per operation */
+  ke_t **prev_key_elts; /* pointer mode during migration, otherwise NULL */
+  void *prev_slots; /* inline mode during migration, otherwise NULL */
+  int is_image; /* non-zero if the slots are in a loaded image */
+#ifdef HT_MULOA_STATS
+  ht_muloa_stats_t *stats; /* updated by searches through a const ht */
+#endif
   int (*cmp_key)(const void *, const void *);
   size_t (*rdc_key)(const void *, size_t);
   void (*free_elt)(void *);
 } ht_muloa_t;
 
+typedef struct{
+  size_t ix; /* next slot, previous slots first during migration */
+} ht_muloa_cursor_t;
+
 /**
    Initializes a hash table. 
    ht          : a pointer to a preallocated block of size
@@ -118,6 +210,8 @@ typedef struct{
                  element-specific free_elt, taking a pointer to a pointer to an
                  element as its argument and leaving a block of size elt_size
                  pointed to by the argument, is necessary to delete the element
+   A hash table is initialized in the pointer mode of storage. The inline
+   mode can be set with ht_muloa_inline.
 */
 void ht_muloa_init(ht_muloa_t *ht,
 		   size_t key_size,
@@ -147,6 +241,57 @@ void ht_muloa_init(ht_muloa_t *ht,
 */
 void ht_muloa_align(ht_muloa_t *ht, size_t elt_alignment);
 
+/**
+   Sets the storage mode of a hash table. In the inline mode, keys, hash
+   values, and elements are copied into the slots of a contiguous array,
+   and are moved when the hash table grows or is cleaned of placeholders.
+   In the pointer mode, each key element pair is within a separately
+   allocated block that keeps its address throughout its presence in the
+   hash table. The operation is optionally called after ht_muloa_init is
+   completed and before any operation other than ht_muloa_align is called.
+   ht          : pointer to an initialized ht_muloa_t struct
+   is_inline   : non-zero to set the inline mode, zero to set the pointer
+                 mode
+*/
+void ht_muloa_inline(ht_muloa_t *ht, int is_inline);
+
+/**
+   Sets the mode of growth of a hash table. In the incremental mode, a
+   growth step or a cleaning of placeholders allocates the new slots, and
+   the keys in the previous slots are moved by the subsequent insert,
+   remove, and delete operations, each moving the keys of a bounded number
+   of previous slots. The number of previous slots migrated per operation
+   is set at each rehashing step s.t. the migration is completed before
+   the next rehashing step is due. As a result, no single insert operation
+   moves all keys of a hash table. The operation is optionally called
+   after ht_muloa_init is completed and before any operation other than
+   ht_muloa_align and ht_muloa_inline is called.
+   ht          : pointer to an initialized ht_muloa_t struct
+   is_incr     : non-zero to set the incremental mode, zero to set the
+                 default mode of rehashing in a single step
+*/
+void ht_muloa_incr(ht_muloa_t *ht, int is_incr);
+
+/**
+   Selects the first and second multiplication constants of a hash table
+   s.t. the number of probes is minimized on a sample of keys, e.g. the
+   vertex ids of a graph in the non-increasing order of their indegrees.
+   The pair of current constants and C_TUNE_NUM_PAIRS - 1 pairs of odd
+   constants in (2**(n - 1), 2**n), n = CHAR_BIT * sizeof(size_t), are
+   evaluated by inserting the sample keys into a set of occupied slots
+   with the count that the hash table reaches with num_keys keys. The pair
+   with the lowest number of probes is kept. Returns the number of probes
+   of the kept pair, which is not greater than the number of probes of the
+   current pair. The operation is optionally called after ht_muloa_init
+   is completed and before any operation other than ht_muloa_align,
+   ht_muloa_inline, and ht_muloa_incr is called.
+   ht          : pointer to an initialized ht_muloa_t struct
+   keys        : pointer to an array of num_keys distinct keys, each in a
+                 key_size block
+   num_keys    : number of keys in the sample
+*/
+size_t ht_muloa_tune(ht_muloa_t *ht, const void *keys, size_t num_keys);
+
 /**
    Inserts a key and an associated element into a hash table. If the key is
    in the hash table, associates the key with the new element. The key and 
@@ -155,14 +300,47 @@ void ht_muloa_align(ht_muloa_t *ht, size_t elt_alignment);
 */
 void ht_muloa_insert(ht_muloa_t *ht, const void *key, const void *elt);
 
+/**
+   Inserts a batch of keys and associated elements into a hash table, with
+   the same result as calling ht_muloa_insert on each key and element in
+   the order of the batch. The keys are hashed in groups, the first slots
+   of the probe sequences of a group are prefetched, and then the keys of
+   the group are inserted, overlapping the cache misses of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   elts        : pointer to num_keys contiguous blocks of size elt_size
+   num_keys    : number of keys in the batch
+*/
+void ht_muloa_insert_batch(ht_muloa_t *ht,
+			   const void *keys,
+			   const void *elts,
+			   size_t num_keys);
+
 /**
    If a key is present in a hash table, returns a pointer to its associated 
    element, otherwise returns NULL. The key parameter is not NULL and points
    to a block of size key_size. The returned pointer can be dereferenced
-   according to ht_muloa_init and ht_muloa_align_elt.
+   according to ht_muloa_init and ht_muloa_align_elt. In the inline mode,
+   the returned pointer is guaranteed to point to the element until
+   another insert, remove, or delete operation is performed.
 */
 void *ht_muloa_search(const ht_muloa_t *ht, const void *key);
 
+/**
+   Searches a batch of keys in a hash table. The keys are hashed in groups,
+   the first slots of the probe sequences of a group are prefetched, and
+   then the keys of the group are searched, overlapping the cache misses
+   of the keys.
+   keys        : pointer to num_keys contiguous blocks of size key_size
+   num_keys    : number of keys in the batch
+   elts        : pointer to a preallocated array of num_keys pointers; the
+                 ith pointer is set to the value returned by ht_muloa_search
+                 on the ith key
+*/
+void ht_muloa_search_batch(const ht_muloa_t *ht,
+			   const void *keys,
+			   size_t num_keys,
+			   void **elts);
+
 /**
    Removes a key and its associated element from a hash table by copying 
    the element or its pointer into a block of size elt_size pointed to
@@ -179,6 +357,155 @@ void ht_muloa_remove(ht_muloa_t *ht, const void *key, void *elt);
 */
 void ht_muloa_delete(ht_muloa_t *ht, const void *key);
 
+/**
+   Computes the hash token of a key. The hash token of a key depends only
+   on the key and the hash table parameters set at initialization, and is
+   valid throughout the lifetime of the hash table, including across its
+   growth. A hash token can be stored by the caller next to the key and
+   passed to the *_hashed operations in order to avoid reducing the key
+   and computing its hash values in each operation. The key parameter is
+   not NULL and points to a block of size key_size.
+*/
+size_t ht_muloa_hash_key(const ht_muloa_t *ht, const void *key);
+
+/**
+   Perform the insert, search, remove, and delete operations with a hash
+   token of a key computed by ht_muloa_hash_key on the same hash table.
+   The result is the same as the result of the corresponding operation
+   without a hash token. The key, elt parameters are as in the
+   corresponding operations.
+*/
+
+void ht_muloa_insert_hashed(ht_muloa_t *ht,
+			    const void *key,
+			    size_t tok,
+			    const void *elt);
+
+void *ht_muloa_search_hashed(const ht_muloa_t *ht,
+			     const void *key,
+			     size_t tok);
+
+void ht_muloa_remove_hashed(ht_muloa_t *ht,
+			    const void *key,
+			    size_t tok,
+			    void *elt);
+
+void ht_muloa_delete_hashed(ht_muloa_t *ht, const void *key, size_t tok);
+
+/**
+   Compacts a hash table by decreasing its count to the smallest power of
+   two that accomodates alpha as a load factor upper bound with the
+   current number of keys, without decreasing the count below the count
+   set at initialization according to min_num, and by eliminating the
+   placeholders. The keys are rehashed in a single step in both modes of
+   growth. The operation can be called between any two operations, e.g.
+   after a large number of keys were removed from a hash table that is
+   reused, in order to release memory.
+   ht          : pointer to an initialized ht_muloa_t struct
+*/
+void ht_muloa_compact(ht_muloa_t *ht);
+
+/**
+   Initializes a cursor for enumerating the keys in a hash table with
+   ht_muloa_next. A cursor is valid until the hash table is modified.
+*/
+void ht_muloa_cursor_init(ht_muloa_cursor_t *cur);
+
+/**
+   Advances a cursor to the next key in a hash table. Returns a pointer to
+   the element associated with the key and sets the pointer pointed to by
+   key to point to the in-table key, or returns NULL if all keys were
+   enumerated. The returned pointer can be dereferenced according to
+   ht_muloa_init and ht_muloa_align.
+   ht          : pointer to an initialized ht_muloa_t struct that was not
+                 modified after the cursor was initialized
+   cur         : pointer to a cursor initialized with ht_muloa_cursor_init
+   key         : pointer to a pointer that is set to point to a key_size
+                 block
+*/
+void *ht_muloa_next(const ht_muloa_t *ht,
+		    ht_muloa_cursor_t *cur,
+		    const void **key);
+
+/**
+   Calls a visit function on each key in a hash table and its associated
+   element. The first argument of visit points to a key_size block, the
+   second argument points to an elt_size block that can be dereferenced
+   according to ht_muloa_init and ht_muloa_align, and the third argument
+   is the arg parameter. The visit function does not modify the hash
+   table, except through the second argument.
+*/
+void ht_muloa_foreach(const ht_muloa_t *ht,
+		      void (*visit)(const void *, void *, void *),
+		      void *arg);
+
+/**
+   Copies the keys of a hash table into an array of num_elts key_size
+   blocks pointed to by keys, and the elements, or pointers to elements,
+   into an array of num_elts elt_size blocks pointed to by elts, s.t. the
+   ith element is associated with the ith key. If keys or elts is NULL,
+   the corresponding array is not written. Returns num_elts. In the inline
+   mode, the slots are read sequentially.
+*/
+size_t ht_muloa_export(const ht_muloa_t *ht, void *keys, void *elts);
+
+/**
+   Writes a hash table into a file as a relocatable binary image. The
+   image can be loaded with ht_muloa_load by a process on a system with
+   the same size_t representation, byte order, and alignment requirements,
+   with the same cmp_key and rdc_key functions. The elements are required
+   to be within contiguous memory blocks that were copied into the hash
+   table, because pointers are not relocatable. The image is in the
+   inline layout regardless of the storage mode of the hash table.
+   Completes the migration of keys if it is in progress. An error message
+   is provided and an exit is executed if a write is not completed.
+   ht          : pointer to an initialized ht_muloa_t struct
+   file        : pointer to a binary stream open for writing, positioned
+                 at the start of the image
+*/
+void ht_muloa_save(ht_muloa_t *ht, FILE *file);
+
+/**
+   Initializes a hash table from an image written by ht_muloa_save,
+   without rehashing and without an allocation per key. The slots of the
+   hash table are in the image until the first insert, remove, delete, or
+   compact operation copies the slots into an allocated array; the image
+   is not written. A loaded hash table is in the inline mode of storage
+   and in the default mode of growth. An error message is provided and
+   an exit is executed if the image is not valid on the system.
+   ht          : a pointer to a preallocated block of size
+                 sizeof(ht_muloa_t)
+   image       : pointer to an image aligned as a pointer returned by
+                 malloc or mmap; the image is not modified and remains
+                 valid until ht_muloa_free is called or the slots were
+                 copied
+   image_size  : size of the block pointed to by image
+   cmp_key     : cmp_key of the saved hash table, as in ht_muloa_init
+   rdc_key     : rdc_key of the saved hash table, as in ht_muloa_init
+*/
+void ht_muloa_load(ht_muloa_t *ht,
+		   const void *image,
+		   size_t image_size,
+		   int (*cmp_key)(const void *, const void *),
+		   size_t (*rdc_key)(const void *, size_t));
+
+#ifdef HT_MULOA_STATS
+/**
+   Copies the statistics of a hash table into a block pointed to by stats.
+   The ith bin of a probe histogram is the number of probe sequences with
+   i + 1 probes, and the last bin also includes the longer sequences. A
+   search during the migration of keys may count a probe sequence in the
+   new slots and in the previous slots. The processor time of a rehashing
+   operation in the incremental mode does not include the migration of
+   keys by the subsequent operations. The num_bytes value does not include
+   the noncontiguous elements and the slots in a loaded image.
+   ht          : pointer to an initialized ht_muloa_t struct
+   stats       : pointer to a preallocated block of size
+                 sizeof(ht_muloa_stats_t)
+*/
+void ht_muloa_stats(const ht_muloa_t *ht, ht_muloa_stats_t *stats);
+#endif
+
 /**
    Frees a hash table and leaves a block of size sizeof(ht_muloa_t)
    pointed to by the ht parameter.
@@ -206,6 +533,12 @@ void ht_muloa_init_helper(void *ht,
 
 void ht_muloa_align_helper(void *ht, size_t alignment);
 
+void ht_muloa_inline_helper(void *ht, int is_inline);
+
+void ht_muloa_incr_helper(void *ht, int is_incr);
+
+size_t ht_muloa_tune_helper(void *ht, const void *keys, size_t num_keys);
+
 void ht_muloa_insert_helper(void *ht, const void *key, const void *elt);
 
 void *ht_muloa_search_helper(const void *ht, const void *key);
@@ -214,6 +547,61 @@ void ht_muloa_remove_helper(void *ht, const void *key, void *elt);
 
 void ht_muloa_delete_helper(void *ht, const void *key);
 
+size_t ht_muloa_hash_key_helper(const void *ht, const void *key);
+
+void ht_muloa_insert_hashed_helper(void *ht,
+				   const void *key,
+				   size_t tok,
+				   const void *elt);
+
+void *ht_muloa_search_hashed_helper(const void *ht,
+				    const void *key,
+				    size_t tok);
+
+void ht_muloa_remove_hashed_helper(void *ht,
+				   const void *key,
+				   size_t tok,
+				   void *elt);
+
+void ht_muloa_delete_hashed_helper(void *ht, const void *key, size_t tok);
+
+void ht_muloa_compact_helper(void *ht);
+
+void *ht_muloa_next_helper(const void *ht, void *cur, const void **key);
+
+void ht_muloa_foreach_helper(const void *ht,
+			     void (*visit)(const void *, void *, void *),
+			     void *arg);
+
+size_t ht_muloa_export_helper(const void *ht, void *keys, void *elts);
+
+void ht_muloa_save_helper(void *ht, FILE *file);
+
+void ht_muloa_load_helper(void *ht,
+			  const void *image,
+			  size_t image_size,
+			  int (*cmp_key)(const void *, const void *),
+			  size_t (*rdc_key)(const void *, size_t));
+
+#ifdef HT_MULOA_STATS
+void ht_muloa_stats_helper(const void *ht, void *stats);
+#endif
+
 void ht_muloa_free_helper(void *ht);
 
+/**
+   Initializes a hash table as ht_muloa_init_helper and sets the inline
+   mode of storage, so that the inline mode can be selected through the
+   init helper of a hash table parameter.
+*/
+void ht_muloa_init_inline_helper(void *ht,
+				 size_t key_size,
+				 size_t elt_size,
+				 size_t min_num,
+				 size_t alpha_n,
+				 size_t log_alpha_d,
+				 int (*cmp_key)(const void *, const void *),
+				 size_t (*rdc_key)(const void *, size_t),
+				 void (*free_elt)(void *));
+
 #endif
@@ -37,6 +37,7 @@
 #include "heap.h"
 #include "ht-divchn.h"
 #include "ht-muloa.h"
+#include "ht-mulgrp.h"
 #include "graph.h"
 #include "stack.h"
 #include "utilities-mem.h"
@@ -69,6 +70,8 @@ const size_t C_ALPHA_N_DIVCHN = 1;
 const size_t C_LOG_ALPHA_D_DIVCHN = 0;
 const size_t C_ALPHA_N_MULOA = 13107;
 const size_t C_LOG_ALPHA_D_MULOA = 15;
+const size_t C_ALPHA_N_MULGRP = 28672;
+const size_t C_LOG_ALPHA_D_MULGRP = 15;
 
 /* small graph tests */
 const size_t C_NUM_VTS = 5;
@@ -142,6 +145,11 @@ typedef struct{
   size_t log_alpha_d;
 } context_muloa_t;
 
+typedef struct{
+  size_t alpha_n;
+  size_t log_alpha_d;
+} context_mulgrp_t;
+
 void ht_divchn_init_helper(ht_divchn_t *ht,
 			   size_t key_size,
 			   size_t elt_size,
@@ -173,6 +181,23 @@ void ht_muloa_init_helper(ht_muloa_t *ht,
 		free_elt);
 }
 
+void ht_mulgrp_init_helper(ht_mulgrp_t *ht,
+			   size_t key_size,
+			   size_t elt_size,
+			   void (*free_elt)(void *),
+			   void *context){
+  context_mulgrp_t * c = context;
+  ht_mulgrp_init(ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 c->alpha_n,
+		 c->log_alpha_d,
+		 NULL,
+		 NULL,
+		 free_elt);
+}
+
 void run_def_uint_prim(const adj_lst_t *a){
   size_t i;
   size_t *dist = NULL;
@@ -253,6 +278,37 @@ void run_muloa_uint_prim(const adj_lst_t *a){
   dist = NULL;
   prev = NULL;
 }
+
+void run_mulgrp_uint_prim(const adj_lst_t *a){
+  size_t i;
+  size_t *dist = NULL;
+  size_t *prev = NULL;
+  ht_mulgrp_t ht_mulgrp;
+  context_mulgrp_t context;
+  heap_ht_t hht;
+  dist = malloc_perror(a->num_vts, sizeof(size_t));
+  prev = malloc_perror(a->num_vts, sizeof(size_t));
+  context.alpha_n = C_ALPHA_N_MULGRP;
+  context.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  hht.ht = &ht_mulgrp;
+  hht.context = &context;
+  hht.init = (heap_ht_init)ht_mulgrp_init_helper;
+  hht.insert = (heap_ht_insert)ht_mulgrp_insert;
+  hht.search = (heap_ht_search)ht_mulgrp_search;
+  hht.remove = (heap_ht_remove)ht_mulgrp_remove;
+  hht.free = (heap_ht_free)ht_mulgrp_free;
+  for (i = 0; i < a->num_vts; i++){
+    prim(a, i, dist, prev, &hht, cmp_uint);
+    printf("distances and previous vertices with %lu as start \n", TOLU(i));
+    print_uint_arr(dist, a->num_vts);
+    print_uint_arr(prev, a->num_vts);
+  }
+  printf("\n");
+  free(dist);
+  free(prev);
+  dist = NULL;
+  prev = NULL;
+}
   
 void run_uint_graph_test(){
   graph_t g;
@@ -261,13 +317,15 @@ void run_uint_graph_test(){
   printf("Running a test on an undirected size_t graph with a \n"
 	 "i) default hash table (index array) \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_undir_build(&a, &g);
   print_adj_lst(&a, print_uint);
   run_def_uint_prim(&a);
   run_divchn_uint_prim(&a);
   run_muloa_uint_prim(&a);
+  run_mulgrp_uint_prim(&a);
   adj_lst_free(&a);
   graph_free(&g);
   graph_uint_wts_no_edges_init(&g);
@@ -275,13 +333,15 @@ void run_uint_graph_test(){
 	 "with a \n"
 	 "i) default hash table (index array) \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_undir_build(&a, &g);
   print_adj_lst(&a, print_uint);
   run_def_uint_prim(&a);
   run_divchn_uint_prim(&a);
   run_muloa_uint_prim(&a);
+  run_mulgrp_uint_prim(&a);
   adj_lst_free(&a);
   graph_free(&g);
 }
@@ -403,6 +463,37 @@ void run_muloa_double_prim(const adj_lst_t *a){
   prev = NULL;
 }
 
+void run_mulgrp_double_prim(const adj_lst_t *a){
+  size_t i;
+  size_t *prev = NULL;
+  double *dist = NULL;
+  ht_mulgrp_t ht_mulgrp;
+  context_mulgrp_t context;
+  heap_ht_t hht;
+  dist = malloc_perror(a->num_vts, sizeof(double));
+  prev = malloc_perror(a->num_vts, sizeof(size_t));
+  context.alpha_n = C_ALPHA_N_MULGRP;
+  context.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  hht.ht = &ht_mulgrp;
+  hht.context = &context;
+  hht.init = (heap_ht_init)ht_mulgrp_init_helper;
+  hht.insert = (heap_ht_insert)ht_mulgrp_insert;
+  hht.search = (heap_ht_search)ht_mulgrp_search;
+  hht.remove = (heap_ht_remove)ht_mulgrp_remove;
+  hht.free = (heap_ht_free)ht_mulgrp_free;
+  for (i = 0; i < a->num_vts; i++){
+    prim(a, i, dist, prev, &hht, cmp_double);
+    printf("distances and previous vertices with %lu as start \n", TOLU(i));
+    print_double_arr(dist, a->num_vts);
+    print_uint_arr(prev, a->num_vts);
+  }
+  printf("\n");
+  free(dist);
+  free(prev);
+  dist = NULL;
+  prev = NULL;
+}
+
 void run_double_graph_test(){
   graph_t g;
   adj_lst_t a;
@@ -410,13 +501,15 @@ void run_double_graph_test(){
   printf("Running a test on an undirected double graph with a \n"
 	 "i) default hash table (index array) \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_undir_build(&a, &g);
   print_adj_lst(&a, print_double);
   run_def_double_prim(&a);
   run_divchn_double_prim(&a);
   run_muloa_double_prim(&a);
+  run_mulgrp_double_prim(&a);
   adj_lst_free(&a);
   graph_free(&g);
   graph_double_wts_no_edges_init(&g);
@@ -424,13 +517,15 @@ void run_double_graph_test(){
 	 "with a \n"
 	 "i) default hash table (index array) \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_undir_build(&a, &g);
   print_adj_lst(&a, print_double);
   run_def_double_prim(&a);
   run_divchn_double_prim(&a);
   run_muloa_double_prim(&a);
+  run_mulgrp_double_prim(&a);
   adj_lst_free(&a);
   graph_free(&g);
 }
@@ -524,8 +619,8 @@ void sum_mst_edges(size_t *wt_mst,
 void run_rand_uint_test(int pow_start, int pow_end){
   int p, i, j;
   int res = 1;
-  size_t wt_def, wt_divchn, wt_muloa;
-  size_t num_vts_def, num_vts_divchn, num_vts_muloa;
+  size_t wt_def, wt_divchn, wt_muloa, wt_mulgrp;
+  size_t num_vts_def, num_vts_divchn, num_vts_muloa, num_vts_mulgrp;
   size_t n;
   size_t wt_l = 0, wt_h = C_WEIGHT_HIGH;
   size_t *rand_start = NULL;
@@ -534,10 +629,12 @@ void run_rand_uint_test(int pow_start, int pow_end){
   bern_arg_t b;
   ht_divchn_t ht_divchn;
   ht_muloa_t ht_muloa;
+  ht_mulgrp_t ht_mulgrp;
   context_divchn_t context_divchn;
   context_muloa_t context_muloa;
-  heap_ht_t hht_divchn, hht_muloa;
-  clock_t t_def, t_divchn, t_muloa;
+  context_mulgrp_t context_mulgrp;
+  heap_ht_t hht_divchn, hht_muloa, hht_mulgrp;
+  clock_t t_def, t_divchn, t_muloa, t_mulgrp;
   rand_start = malloc_perror(C_ITER, sizeof(size_t));
   dist = malloc_perror(pow_two(pow_end), sizeof(size_t));
   prev = malloc_perror(pow_two(pow_end), sizeof(size_t));
@@ -559,6 +656,15 @@ void run_rand_uint_test(int pow_start, int pow_end){
   hht_muloa.search = (heap_ht_search)ht_muloa_search;
   hht_muloa.remove = (heap_ht_remove)ht_muloa_remove;
   hht_muloa.free = (heap_ht_free)ht_muloa_free;
+  context_mulgrp.alpha_n = C_ALPHA_N_MULGRP;
+  context_mulgrp.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  hht_mulgrp.ht = &ht_mulgrp;
+  hht_mulgrp.context = &context_mulgrp;
+  hht_mulgrp.init = (heap_ht_init)ht_mulgrp_init_helper;
+  hht_mulgrp.insert = (heap_ht_insert)ht_mulgrp_insert;
+  hht_mulgrp.search = (heap_ht_search)ht_mulgrp_search;
+  hht_mulgrp.remove = (heap_ht_remove)ht_mulgrp_remove;
+  hht_mulgrp.free = (heap_ht_free)ht_mulgrp_free;
   printf("Run a prim test on random undirected graphs with random "
 	 "size_t weights in [%lu, %lu]\n", TOLU(wt_l), TOLU(wt_h));
   fflush(stdout);
@@ -596,18 +702,28 @@ void run_rand_uint_test(int pow_start, int pow_end){
       }
       t_muloa = clock() - t_muloa;
       sum_mst_edges(&wt_muloa, &num_vts_muloa, a.num_vts, dist, prev);
+      t_mulgrp = clock();
+      for (j = 0; j < C_ITER; j++){
+	prim(&a, rand_start[j], dist, prev, &hht_mulgrp, cmp_uint);
+      }
+      t_mulgrp = clock() - t_mulgrp;
+      sum_mst_edges(&wt_mulgrp, &num_vts_mulgrp, a.num_vts, dist, prev);
       res *= (wt_def == wt_divchn &&
-	      wt_divchn == wt_muloa);
+	      wt_divchn == wt_muloa &&
+	      wt_muloa == wt_mulgrp);
       res *= (num_vts_def == num_vts_divchn &&
-	      num_vts_divchn == num_vts_muloa);
+	      num_vts_divchn == num_vts_muloa &&
+	      num_vts_muloa == num_vts_mulgrp);
       printf("\t\tvertices: %lu, # of directed edges: %lu\n",
 	     TOLU(a.num_vts), TOLU(a.num_es));
       printf("\t\t\tprim default ht ave runtime:         %.8f seconds\n"
 	     "\t\t\tprim ht_divchn ave runtime:          %.8f seconds\n"
-	     "\t\t\tprim ht_muloa ave runtime:           %.8f seconds\n",
+	     "\t\t\tprim ht_muloa ave runtime:           %.8f seconds\n"
+	     "\t\t\tprim ht_mulgrp ave runtime:          %.8f seconds\n",
 	     (float)t_def / C_ITER / CLOCKS_PER_SEC,
 	     (float)t_divchn / C_ITER / CLOCKS_PER_SEC,
-	     (float)t_muloa / C_ITER / CLOCKS_PER_SEC);
+	     (float)t_muloa / C_ITER / CLOCKS_PER_SEC,
+	     (float)t_mulgrp / C_ITER / CLOCKS_PER_SEC);
       printf("\t\t\tcorrectness:                         ");
       print_test_result(res);
       printf("\t\t\tlast mst # edges:                    %lu\n",
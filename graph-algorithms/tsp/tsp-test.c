@@ -41,6 +41,7 @@
 #include "tsp.h"
 #include "ht-divchn.h"
 #include "ht-muloa.h"
+#include "ht-mulgrp.h"
 #include "graph.h"
 #include "stack.h"
 #include "utilities-mem.h"
@@ -81,6 +82,8 @@ const size_t C_ALPHA_N_DIVCHN = 1;
 const size_t C_LOG_ALPHA_D_DIVCHN = 0;
 const size_t C_ALPHA_N_MULOA = 13107;
 const size_t C_LOG_ALPHA_D_MULOA = 15;
+const size_t C_ALPHA_N_MULGRP = 28672;
+const size_t C_LOG_ALPHA_D_MULGRP = 15;
 
 /* small graph test */
 const size_t C_NUM_VTS = 4;
@@ -162,6 +165,12 @@ typedef struct{
   size_t (*rdc_key)(const void *, size_t);
 } context_muloa_t;
 
+typedef struct{
+  size_t alpha_n;
+  size_t log_alpha_d;
+  size_t (*rdc_key)(const void *, size_t);
+} context_mulgrp_t;
+
 void ht_divchn_init_helper(ht_divchn_t *ht,
 			   size_t key_size,
 			   size_t elt_size,
@@ -193,6 +202,23 @@ void ht_muloa_init_helper(ht_muloa_t *ht,
 		free_elt);
 }
 
+void ht_mulgrp_init_helper(ht_mulgrp_t *ht,
+			   size_t key_size,
+			   size_t elt_size,
+			   void (*free_elt)(void *),
+			   void *context){
+  context_mulgrp_t * c = context;
+  ht_mulgrp_init(ht,
+		 key_size,
+		 elt_size,
+		 0,
+		 c->alpha_n,
+		 c->log_alpha_d,
+		 NULL,
+		 c->rdc_key,
+		 free_elt);
+}
+
 void run_def_uint_tsp(const adj_lst_t *a){
   int ret = -1;
   size_t dist;
@@ -254,6 +280,31 @@ void run_muloa_uint_tsp(const adj_lst_t *a){
   printf("\n");
 }
 
+void run_mulgrp_uint_tsp(const adj_lst_t *a){
+  int ret = -1;
+  size_t dist;
+  size_t i;
+  ht_mulgrp_t ht_mulgrp;
+  context_mulgrp_t context_mulgrp;
+  tsp_ht_t tht;
+  context_mulgrp.alpha_n = C_ALPHA_N_MULGRP;
+  context_mulgrp.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  context_mulgrp.rdc_key = NULL;
+  tht.ht = &ht_mulgrp;
+  tht.context = &context_mulgrp;
+  tht.init = (tsp_ht_init)ht_mulgrp_init_helper;
+  tht.insert = (tsp_ht_insert)ht_mulgrp_insert;
+  tht.search = (tsp_ht_search)ht_mulgrp_search;
+  tht.remove = (tsp_ht_remove)ht_mulgrp_remove;
+  tht.free = (tsp_ht_free)ht_mulgrp_free;
+  for (i = 0; i < a->num_vts; i++){
+    ret = tsp(a, i, &dist, &tht, add_uint, cmp_uint);
+    printf("tsp ret: %d, tour length with %lu as start: ", ret, TOLU(i));
+    print_uint_arr(&dist, 1);
+  }
+  printf("\n");
+}
+
 
 void run_uint_graph_test(){
   graph_t g;
@@ -262,26 +313,30 @@ void run_uint_graph_test(){
   printf("Running a test on a size_t graph with a \n"
 	 "i) default hash table \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_dir_build(&a, &g);
   print_adj_lst(&a, print_uint);
   run_def_uint_tsp(&a);
   run_divchn_uint_tsp(&a);
   run_muloa_uint_tsp(&a);
+  run_mulgrp_uint_tsp(&a);
   adj_lst_free(&a);
   graph_free(&g);
   graph_uint_single_vt_init(&g);
   printf("Running a test on a size_t graph with a single vertex, with a \n"
 	 "i) default hash table \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_dir_build(&a, &g);
   print_adj_lst(&a, print_uint);
   run_def_uint_tsp(&a);
   run_divchn_uint_tsp(&a);
   run_muloa_uint_tsp(&a);
+  run_mulgrp_uint_tsp(&a);
   adj_lst_free(&a);
   graph_free(&g);
 }
@@ -387,6 +442,31 @@ void run_muloa_double_tsp(const adj_lst_t *a){
   printf("\n");
 }
 
+void run_mulgrp_double_tsp(const adj_lst_t *a){
+  int ret = -1;
+  size_t i;
+  double dist;
+  ht_mulgrp_t ht_mulgrp;
+  context_mulgrp_t context_mulgrp;
+  tsp_ht_t tht;
+  context_mulgrp.alpha_n = C_ALPHA_N_MULGRP;
+  context_mulgrp.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  context_mulgrp.rdc_key = NULL;
+  tht.ht = &ht_mulgrp;
+  tht.context = &context_mulgrp;
+  tht.init = (tsp_ht_init)ht_mulgrp_init_helper;
+  tht.insert = (tsp_ht_insert)ht_mulgrp_insert;
+  tht.search = (tsp_ht_search)ht_mulgrp_search;
+  tht.remove = (tsp_ht_remove)ht_mulgrp_remove;
+  tht.free = (tsp_ht_free)ht_mulgrp_free;
+  for (i = 0; i < a->num_vts; i++){
+    ret = tsp(a, i, &dist, &tht, add_double, cmp_double);
+    printf("tsp ret: %d, tour length with %lu as start: ", ret, TOLU(i));
+    print_double_arr(&dist, 1);
+  }
+  printf("\n");
+}
+
 
 void run_double_graph_test(){
   graph_t g;
@@ -395,26 +475,30 @@ void run_double_graph_test(){
   printf("Running a test on a double graph with a \n"
 	 "i) default hash table \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_dir_build(&a, &g);
   print_adj_lst(&a, print_double);
   run_def_double_tsp(&a);
   run_divchn_double_tsp(&a);
   run_muloa_double_tsp(&a);
+  run_mulgrp_double_tsp(&a);
   adj_lst_free(&a);
   graph_free(&g);
   graph_double_single_vt_init(&g);
   printf("Running a test on a double graph with a single vertex, with a \n"
 	 "i) default hash table \n"
 	 "ii) ht_divchn_t hash table \n"
-	 "iii) ht_muloa_t hash table \n\n");
+	 "iii) ht_muloa_t hash table \n"
+	 "iv) ht_mulgrp_t hash table \n\n");
   adj_lst_init(&a, &g);
   adj_lst_dir_build(&a, &g);
   print_adj_lst(&a, print_double);
   run_def_double_tsp(&a);
   run_divchn_double_tsp(&a);
   run_muloa_double_tsp(&a);
+  run_mulgrp_double_tsp(&a);
   adj_lst_free(&a);
   graph_free(&g);
 }
@@ -505,19 +589,21 @@ void adj_lst_rand_dir_wts(adj_lst_t *a,
 void run_rand_uint_test(int num_vts_start, int num_vts_end){
   int p, i, j;
   int res = 1;
-  int ret_def = -1, ret_divchn = -1, ret_muloa = -1;
+  int ret_def = -1, ret_divchn = -1, ret_muloa = -1, ret_mulgrp = -1;
   size_t n;
   size_t wt_l = 0, wt_h = C_WEIGHT_HIGH;
-  size_t dist_def, dist_divchn, dist_muloa;
+  size_t dist_def, dist_divchn, dist_muloa, dist_mulgrp;
   size_t *rand_start = NULL;
   adj_lst_t a;
   bern_arg_t b;
   ht_divchn_t ht_divchn;
   ht_muloa_t ht_muloa;
+  ht_mulgrp_t ht_mulgrp;
   context_divchn_t context_divchn;
   context_muloa_t context_muloa;
-  tsp_ht_t tht_divchn, tht_muloa;
-  clock_t t_def, t_divchn, t_muloa;
+  context_mulgrp_t context_mulgrp;
+  tsp_ht_t tht_divchn, tht_muloa, tht_mulgrp;
+  clock_t t_def, t_divchn, t_muloa, t_mulgrp;
   rand_start = malloc_perror(C_ITER, sizeof(size_t));
   context_divchn.alpha_n = C_ALPHA_N_DIVCHN;
   context_divchn.log_alpha_d = C_LOG_ALPHA_D_DIVCHN;
@@ -538,6 +624,16 @@ void run_rand_uint_test(int num_vts_start, int num_vts_end){
   tht_muloa.search = (tsp_ht_search)ht_muloa_search;
   tht_muloa.remove = (tsp_ht_remove)ht_muloa_remove;
   tht_muloa.free = (tsp_ht_free)ht_muloa_free;
+  context_mulgrp.alpha_n = C_ALPHA_N_MULGRP;
+  context_mulgrp.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  context_mulgrp.rdc_key = NULL;
+  tht_mulgrp.ht = &ht_mulgrp;
+  tht_mulgrp.context = &context_mulgrp;
+  tht_mulgrp.init = (tsp_ht_init)ht_mulgrp_init_helper;
+  tht_mulgrp.insert = (tsp_ht_insert)ht_mulgrp_insert;
+  tht_mulgrp.search = (tsp_ht_search)ht_mulgrp_search;
+  tht_mulgrp.remove = (tsp_ht_remove)ht_mulgrp_remove;
+  tht_mulgrp.free = (tsp_ht_free)ht_mulgrp_free;
   printf("Run a tsp test across all hash tables on random directed graphs \n"
 	 "with random size_t non-tour weights in [%lu, %lu]\n",
 	 TOLU(wt_l), TOLU(wt_h));
@@ -588,23 +684,37 @@ void run_rand_uint_test(int num_vts_start, int num_vts_end){
 		      cmp_uint);
       }
       t_muloa = clock() - t_muloa;
+      t_mulgrp = clock();
+      for (j = 0; j < C_ITER; j++){
+	ret_mulgrp = tsp(&a,
+			 rand_start[j],
+			 &dist_mulgrp,
+			 &tht_mulgrp,
+			 add_uint,
+			 cmp_uint);
+      }
+      t_mulgrp = clock() - t_mulgrp;
       if (n == 1){
 	res *= (dist_def == 0 && ret_def == 0);
 	res *= (dist_divchn == 0 && ret_divchn == 0);
 	res *= (dist_muloa == 0 && ret_muloa == 0);
+	res *= (dist_mulgrp == 0 && ret_mulgrp == 0);
       }else{
 	res *= (dist_def == n && ret_def == 0);
 	res *= (dist_divchn == n && ret_divchn == 0);
 	res *= (dist_muloa == n && ret_muloa == 0);
+	res *= (dist_mulgrp == n && ret_mulgrp == 0);
       }
       printf("\t\tvertices: %lu, # of directed edges: %lu\n",
 	     TOLU(a.num_vts), TOLU(a.num_es));
       printf("\t\t\ttsp default ht ave runtime:     %.8f seconds\n"
 	     "\t\t\ttsp ht_divchn ave runtime:      %.8f seconds\n"
-	     "\t\t\ttsp ht_muloa ave runtime:       %.8f seconds\n",
+	     "\t\t\ttsp ht_muloa ave runtime:       %.8f seconds\n"
+	     "\t\t\ttsp ht_mulgrp ave runtime:      %.8f seconds\n",
 	     (float)t_def / C_ITER / CLOCKS_PER_SEC,
 	     (float)t_divchn / C_ITER / CLOCKS_PER_SEC,
-	     (float)t_muloa / C_ITER / CLOCKS_PER_SEC);
+	     (float)t_muloa / C_ITER / CLOCKS_PER_SEC,
+	     (float)t_mulgrp / C_ITER / CLOCKS_PER_SEC);
       printf("\t\t\tcorrectness:                    ");
       print_test_result(res);
       res = 1;
@@ -685,19 +795,21 @@ void run_def_rand_uint_test(int num_vts_start, int num_vts_end){
 void run_sparse_rand_uint_test(int num_vts_start, int num_vts_end){
   int p, i, j;
   int res = 1;
-  int ret_divchn = -1, ret_muloa = -1;
+  int ret_divchn = -1, ret_muloa = -1, ret_mulgrp = -1;
   size_t n;
   size_t wt_l = 0, wt_h = C_WEIGHT_HIGH;
-  size_t dist_divchn, dist_muloa;
+  size_t dist_divchn, dist_muloa, dist_mulgrp;
   size_t *rand_start = NULL;
   adj_lst_t a;
   bern_arg_t b;
   ht_divchn_t ht_divchn;
   ht_muloa_t ht_muloa;
+  ht_mulgrp_t ht_mulgrp;
   context_divchn_t context_divchn;
   context_muloa_t context_muloa;
-  tsp_ht_t tht_divchn, tht_muloa;
-  clock_t t_divchn, t_muloa;
+  context_mulgrp_t context_mulgrp;
+  tsp_ht_t tht_divchn, tht_muloa, tht_mulgrp;
+  clock_t t_divchn, t_muloa, t_mulgrp;
   rand_start = malloc_perror(C_ITER, sizeof(size_t));
   context_divchn.alpha_n = C_ALPHA_N_DIVCHN;
   context_divchn.log_alpha_d = C_LOG_ALPHA_D_DIVCHN;
@@ -718,6 +830,16 @@ void run_sparse_rand_uint_test(int num_vts_start, int num_vts_end){
   tht_muloa.search = (tsp_ht_search)ht_muloa_search;
   tht_muloa.remove = (tsp_ht_remove)ht_muloa_remove;
   tht_muloa.free = (tsp_ht_free)ht_muloa_free;
+  context_mulgrp.alpha_n = C_ALPHA_N_MULGRP;
+  context_mulgrp.log_alpha_d = C_LOG_ALPHA_D_MULGRP;
+  context_mulgrp.rdc_key = NULL;
+  tht_mulgrp.ht = &ht_mulgrp;
+  tht_mulgrp.context = &context_mulgrp;
+  tht_mulgrp.init = (tsp_ht_init)ht_mulgrp_init_helper;
+  tht_mulgrp.insert = (tsp_ht_insert)ht_mulgrp_insert;
+  tht_mulgrp.search = (tsp_ht_search)ht_mulgrp_search;
+  tht_mulgrp.remove = (tsp_ht_remove)ht_mulgrp_remove;
+  tht_mulgrp.free = (tsp_ht_free)ht_mulgrp_free;
   printf("Run a tsp test on sparse random directed graphs with random "
 	 "size_t non-tour weights in [%lu, %lu]\n", TOLU(wt_l), TOLU(wt_h));
   fflush(stdout);
@@ -757,19 +879,33 @@ void run_sparse_rand_uint_test(int num_vts_start, int num_vts_end){
 			cmp_uint);
       }
       t_muloa = clock() - t_muloa;
+      t_mulgrp = clock();
+      for (j = 0; j < C_ITER; j++){
+	ret_mulgrp = tsp(&a,
+			 rand_start[j],
+			 &dist_mulgrp,
+			 &tht_mulgrp,
+			 add_uint,
+			 cmp_uint);
+      }
+      t_mulgrp = clock() - t_mulgrp;
       if (n == 1){
 	res *= (dist_divchn == 0 && ret_divchn == 0);
 	res *= (dist_muloa == 0 && ret_muloa == 0);
+	res *= (dist_mulgrp == 0 && ret_mulgrp == 0);
       }else{
 	res *= (dist_divchn == n && ret_divchn == 0);
 	res *= (dist_muloa == n && ret_muloa == 0);
+	res *= (dist_mulgrp == n && ret_mulgrp == 0);
       }
       printf("\t\tvertices: %lu, # of directed edges: %lu\n",
 	     TOLU(a.num_vts), TOLU(a.num_es));
       printf("\t\t\ttsp ht_divchn ave runtime:      %.8f seconds\n"
-	     "\t\t\ttsp ht_muloa ave runtime:       %.8f seconds\n",
+	     "\t\t\ttsp ht_muloa ave runtime:       %.8f seconds\n"
+	     "\t\t\ttsp ht_mulgrp ave runtime:      %.8f seconds\n",
 	     (float)t_divchn / C_ITER / CLOCKS_PER_SEC,
-	     (float)t_muloa / C_ITER / CLOCKS_PER_SEC);
+	     (float)t_muloa / C_ITER / CLOCKS_PER_SEC,
+	     (float)t_mulgrp / C_ITER / CLOCKS_PER_SEC);
       printf("\t\t\tcorrectness:                    ");
       print_test_result(res);
       res = 1;
@@ -11,6 +11,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
 #include <pthread.h>
 #include "utilities-pthread.h"
 
@@ -66,6 +67,20 @@ void mutex_unlock_perror(pthread_mutex_t *mutex){
   }
 }
 
+/**
+   Try to lock a mutex with error checking. Returns 0 if the mutex was
+   locked by the call, and non-zero if the mutex is already locked.
+*/
+
+int mutex_trylock_perror(pthread_mutex_t *mutex){
+  int err = pthread_mutex_trylock(mutex);
+  if (err != 0 && err != EBUSY){
+    perror("pthread_mutex_trylock failed");
+    exit(EXIT_FAILURE);
+  }
+  return err;
+}
+
 /**
    Initialize a condition variable with default attributes and
    error checking. Wait on and signal a condition with error checking.
@@ -42,6 +42,12 @@ void mutex_lock_perror(pthread_mutex_t *mutex);
 
 void mutex_unlock_perror(pthread_mutex_t *mutex);
 
+/**
+   Try to lock a mutex with error checking. Returns 0 if the mutex was
+   locked by the call, and non-zero if the mutex is already locked.
+*/
+int mutex_trylock_perror(pthread_mutex_t *mutex);
+
 /**
    Initialize a condition variable with default attributes and
    error checking. Wait on and signal a condition with error checking.
@@ -30,4 +30,15 @@ void *realloc_perror(void *ptr, size_t num, size_t size);
 
 void *calloc_perror(size_t num, size_t size);
 
+/**
+   Prefetches the block of memory at the address p into cache if software
+   prefetching is supported by the compiler, otherwise has no effect. The
+   address is not dereferenced and is not required to be valid.
+*/
+#ifdef __GNUC__
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)0)
+#endif
+
 #endif
@@ -9,10 +9,12 @@
       [0, # bits in size_t) : n for 2^n # trials in mem mod tests
       [0, # bits in size_t) : a
       [0, # bits in size_t) : b s.t. 2^a <= size - 1 <= 2^b in mem mod tests
-      [0, 1] : pow_mod, mul_mod, mul_mod_pow_two, and sum_mod tests on/off
+      [0, 1] : pow_mod, mul_mod, mul_mod_pow_two, sum_mod, and rcp_mod tests
+            on/off
       [0, 1] : mem_mod test on/off
       [0, 1] : fast_mem_mod test on/off
-      [0, 1] : mul_ext, represent_uint, and pow_two tests on/off
+      [0, 1] : mul_ext, represent_uint, pow_two, and lcm_perror tests
+            on/off
 
    usage examples: 
    ./utilities-mod-test 20
@@ -57,10 +59,12 @@ const char *C_USAGE =
   "[0, # bits in size_t) : n for 2^n # trials in mem mod tests \n"
   "[0, # bits in size_t) : a \n"
   "[0, # bits in size_t) : b s.t. 2^a <= size - 1 <= 2^b in mem mod tests \n"
-  "[0, 1] : pow_mod, mul_mod, mul_mod_pow_two, and sum_mod tests on/off \n"
+  "[0, 1] : pow_mod, mul_mod, mul_mod_pow_two, sum_mod, and rcp_mod tests "
+  "on/off \n"
   "[0, 1] : mem_mod test on/off \n"
   "[0, 1] : fast_mem_mod test on/off \n"
-  "[0, 1] : mul_ext, represent_uint, and pow_two tests on/off \n";
+  "[0, 1] : mul_ext, represent_uint, pow_two, and lcm_perror tests "
+  "on/off \n";
 const int C_ARGC_MAX = 9;
 const size_t C_ARGS_DEF[8] = {15, 10, 10, 15, 1, 1, 1, 1};
 
@@ -276,6 +280,51 @@ void run_sum_mod_test(int pow_trials){
   print_test_result(res);
 }
 
+/**
+   Tests rcp_mod.
+*/
+void run_rcp_mod_test(int pow_trials){
+  int res = 1;
+  size_t i, j, trials;
+  size_t a, n;
+  size_t ns[7];
+  mod_rcp_t rcp;
+  trials = pow_two(pow_trials);
+  printf("Run rcp_mod random test\n");
+  for (i = 0; i < trials; i++){
+    a = (size_t)(DRAND() * C_SIZE_MAX) ^ RANDOM();
+    n = (i & 1) ? 1 + DRAND() * C_BASE_MAX : 1 + DRAND() * (C_SIZE_MAX - 1);
+    mod_rcp_init(&rcp, n);
+    res *= (rcp_mod(a, &rcp) == a % n);
+    res *= (rcp_mod(a % n, &rcp) == a % n);
+  }
+  printf("	0 <= a <= 2^%lu - 1, 0 < n <= 2^%lu - 1 --> ",
+	 TOLU(C_FULL_BIT), TOLU(C_FULL_BIT));
+  print_test_result(res);
+  res = 1;
+  ns[0] = 1;
+  ns[1] = 2;
+  ns[2] = 3;
+  ns[3] = pow_two(C_FULL_BIT - 1) - 1;
+  ns[4] = pow_two(C_FULL_BIT - 1);
+  ns[5] = pow_two(C_FULL_BIT - 1) + 1;
+  ns[6] = C_SIZE_MAX;
+  for (i = 0; i < 7; i++){
+    mod_rcp_init(&rcp, ns[i]);
+    for (j = 0; j < C_FULL_BIT; j++){
+      res *= (rcp_mod(pow_two(j), &rcp) == pow_two(j) % ns[i]);
+      res *= (rcp_mod(pow_two(j) - 1, &rcp) == (pow_two(j) - 1) % ns[i]);
+    }
+    res *= (rcp_mod(0, &rcp) == 0);
+    res *= (rcp_mod(ns[i] - 1, &rcp) == ns[i] - 1);
+    res *= (rcp_mod(ns[i], &rcp) == 0);
+    res *= (rcp_mod(C_SIZE_MAX, &rcp) == C_SIZE_MAX % ns[i]);
+    res *= (rcp_mod(C_SIZE_MAX - 1, &rcp) == (C_SIZE_MAX - 1) % ns[i]);
+  }
+  printf("	corner cases --> ");
+  print_test_result(res);
+}
+
 /**
    Tests mem_mod.
 */
@@ -526,6 +575,35 @@ void run_pow_two_test(){
   print_test_result(res);
 }
 
+/**
+   Tests lcm_perror.
+*/
+void run_lcm_perror_test(int pow_trials){
+  int res = 1;
+  int i, trials;
+  size_t a, b, l;
+  trials = pow_two(pow_trials);
+  printf("Run lcm_perror random test --> ");
+  for (i = 0; i < trials; i++){
+    a = RANDOM() % C_UCHAR_MAX + 1;
+    b = RANDOM() % C_UCHAR_MAX + 1;
+    l = lcm_perror(a, b);
+    /* a * b is the product of the lcm and the greatest common divisor */
+    res *= (l % a == 0 && l % b == 0 && (a * b) % l == 0);
+    res *= (a % ((a * b) / l) == 0 && b % ((a * b) / l) == 0);
+  }
+  print_test_result(res);
+  res = 1;
+  printf("Run lcm_perror corner cases test --> ");
+  res *= (lcm_perror(1, 1) == 1);
+  res *= (lcm_perror(4, 6) == 12);
+  res *= (lcm_perror(6, 4) == 12);
+  res *= (lcm_perror(8, 16) == 16);
+  res *= (lcm_perror(pow_two(C_FULL_BIT - 1), 2) == pow_two(C_FULL_BIT - 1));
+  res *= (lcm_perror(C_SIZE_MAX, C_SIZE_MAX) == C_SIZE_MAX);
+  print_test_result(res);
+}
+
 void print_test_result(int res){
   if (res){
     printf("SUCCESS\n");
@@ -564,6 +642,7 @@ int main(int argc, char *argv[]){
     run_mul_mod_test(args[0]);
     run_mul_mod_pow_two_test(args[0]);
     run_sum_mod_test(args[0]);
+    run_rcp_mod_test(args[0]);
   }
   if (args[5]) run_mem_mod_test(args[1], args[2], args[3]);
   if (args[6]) run_fast_mem_mod_test(args[1], args[2], args[3]);
@@ -571,6 +650,7 @@ int main(int argc, char *argv[]){
     run_mul_ext_test(args[0]);
     run_represent_uint_test(args[0]);
     run_pow_two_test();
+    run_lcm_perror_test(args[0]);
   }
   free(args);
   args = NULL;
@@ -17,6 +17,8 @@ static const size_t C_HALF_BIT = CHAR_BIT * sizeof(size_t) / 2;
 static const size_t C_LOW_MASK = ((size_t)-1 >>
 				  (CHAR_BIT * sizeof(size_t) / 2));
 
+static void mul_high(size_t a, size_t b, size_t *h, size_t *l);
+
 /**
    Computes overflow-safe mod n of the kth power in O(logk) time,
    based on the binary representation of k and inductively applying the
@@ -200,6 +202,45 @@ void mul_ext(size_t a, size_t b, size_t *h, size_t *l){
   *l = (overlap << C_HALF_BIT) + (al_bl & C_LOW_MASK);
 }
 
+/**
+   Computes the reciprocal of a divisor n > 0, which is then used to
+   compute a mod n with rcp_mod by multiplications and shifts, without a
+   division, according to the method of Granlund and Montgomery for
+   invariant integer division. The computation of a reciprocal is
+   performed once for a divisor, e.g. when the count of slots of a hash
+   table is changed.
+*/
+void mod_rcp_init(mod_rcp_t *rcp, size_t n){
+  size_t i, l = 0, r, q = 0, carry;
+  while (l < C_FULL_BIT && ((size_t)1 << l) < n) l++;
+  /* mul = floor(2**C_FULL_BIT * (2**l - n) / n) + 1, where 2**l - n < n */
+  r = (l < C_FULL_BIT) ? ((size_t)1 << l) - n : 0 - n;
+  for (i = 0; i < C_FULL_BIT; i++){
+    carry = r >> (C_FULL_BIT - 1);
+    r <<= 1;
+    q <<= 1;
+    if (carry || r >= n){
+      r -= n;
+      q |= 1;
+    }
+  }
+  rcp->n = n;
+  rcp->mul = q + 1;
+  rcp->shift_a = (l > 0);
+  rcp->shift_b = (l > 0) ? l - 1 : 0;
+}
+
+/**
+   Computes a mod n, where n is the divisor of a reciprocal initialized
+   with mod_rcp_init.
+*/
+size_t rcp_mod(size_t a, const mod_rcp_t *rcp){
+  size_t h, l, q;
+  mul_high(a, rcp->mul, &h, &l);
+  q = (h + ((a - h) >> rcp->shift_a)) >> rcp->shift_b;
+  return a - q * rcp->n;
+}
+
 /**
    Represents n as u * 2^k, where u is odd.
 */
@@ -233,3 +274,44 @@ size_t pow_two_perror(size_t k){
   }
   return (size_t)1 << k;
 } 
+
+/**
+   Returns the least common multiple of two positive integers, if it is
+   representable as size_t. Exits with an error otherwise.
+*/
+size_t lcm_perror(size_t a, size_t b){
+  size_t x = a, y = b, r;
+  while (y){
+    r = x % y;
+    x = y;
+    y = r;
+  }
+  /* a / x * b, where x is the greatest common divisor */
+  if (a / x > (size_t)-1 / b){
+    perror("lcm size_t overflow");
+    exit(EXIT_FAILURE);
+  }
+  return a / x * b;
+}
+
+/** Auxiliary functions */
+
+/**
+   Copies the high bits of the product of two numbers into the block
+   pointed to by h, and, if the product is computed with mul_ext, the low
+   bits into the block pointed to by l. The product is computed with a
+   single multiplication if the compiler provides an unsigned integer type
+   with twice the width of a 64-bit size_t and UTILITIES_MOD_PORTABLE is
+   not defined, otherwise the product is computed with mul_ext.
+*/
+static void mul_high(size_t a, size_t b, size_t *h, size_t *l){
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__) && \
+  !defined(UTILITIES_MOD_PORTABLE)
+  if (C_FULL_BIT == 64){
+    __extension__ typedef unsigned __int128 uint_ext_t;
+    *h = (size_t)(((uint_ext_t)a * b) >> 64);
+    return;
+  }
+#endif
+  mul_ext(a, b, h, l);
+}
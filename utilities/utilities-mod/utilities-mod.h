@@ -11,6 +11,13 @@
 
 #include <stddef.h>
 
+typedef struct{
+  size_t n; /* divisor */
+  size_t mul; /* multiplier s.t. a / n is computed with a high product */
+  size_t shift_a; /* 0 if n is 1, 1 otherwise */
+  size_t shift_b; /* ceiling of log base 2 of n, minus 1 if n > 1 */
+} mod_rcp_t;
+
 /**
    Computes overflow-safe mod n of the kth power.
 */
@@ -53,6 +60,22 @@ size_t fast_mem_mod(const void *s, size_t size, size_t n);
 */
 void mul_ext(size_t a, size_t b, size_t *h, size_t *l);
 
+/**
+   Computes the reciprocal of a divisor n > 0, which is then used to
+   compute a mod n with rcp_mod by multiplications and shifts, without a
+   division, according to the method of Granlund and Montgomery for
+   invariant integer division. The computation of a reciprocal is
+   performed once for a divisor, e.g. when the count of slots of a hash
+   table is changed.
+*/
+void mod_rcp_init(mod_rcp_t *rcp, size_t n);
+
+/**
+   Computes a mod n, where n is the divisor of a reciprocal initialized
+   with mod_rcp_init.
+*/
+size_t rcp_mod(size_t a, const mod_rcp_t *rcp);
+
 /**
    Represents n as u * 2^k, where u is odd.
 */
@@ -65,4 +88,10 @@ void represent_uint(size_t n, size_t *k, size_t *u);
 size_t pow_two(size_t k);
 size_t pow_two_perror(size_t k);
 
+/**
+   Returns the least common multiple of two positive integers, if it is
+   representable as size_t. Exits with an error otherwise.
+*/
+size_t lcm_perror(size_t a, size_t b);
+
 #endif
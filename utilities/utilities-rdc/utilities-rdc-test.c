@@ -0,0 +1,322 @@
+/**
+   utilities-rdc-test.c
+
+   Tests and a benchmark of key reduction functions. The reduction
+   functions are compared to the default conversion of a key in the
+   ht_divchn and ht_muloa hash tables, on tsp-like keys and sequential
+   keys. The benchmark reports the time of reducing keys, the maximum and
+   the mean length of non-empty chains in ht_divchn, the maximum number of
+   probes in ht_muloa, and the time of search operations in both hash
+   tables.
+
+   A tsp-like key is a bitset of a fixed size with a fixed number of
+   randomly set bits, as the sets of vertices in the tsp algorithm. A
+   sequential key is a block of a fixed size with a sizeof(size_t)-byte
+   counter in its first bytes and zero bytes otherwise.
+
+   The following command line arguments can be used to customize tests:
+   utilities-rdc-test
+      [0, # bits in size_t - 1) : i s.t. # keys = 2**i
+      > 0 : s # size_t words in a tsp-like key
+      > 0 : b # set bits in a tsp-like key, b <= s * # bits in size_t
+      > 0 : k # size_t words in a sequential key
+      [0, 1] : on/off tsp-like keys test
+      [0, 1] : on/off sequential keys test
+
+   usage examples:
+   ./utilities-rdc-test
+   ./utilities-rdc-test 18
+   ./utilities-rdc-test 18 16 12 16
+   ./utilities-rdc-test 18 16 12 16 0 1
+
+   utilities-rdc-test can be run with any subset of command line arguments
+   in the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99 with the only requirement that CHAR_BIT * sizeof(size_t)
+   is greater or equal to 16 and is even.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "utilities-rdc.h"
+#include "ht-divchn.h"
+#include "ht-muloa.h"
+#include "dll.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "utilities-rdc-test\n"
+  "[0, # bits in size_t - 1) : i s.t. # keys = 2**i\n"
+  "> 0 : s # size_t words in a tsp-like key\n"
+  "> 0 : b # set bits in a tsp-like key, b <= s * # bits in size_t\n"
+  "> 0 : k # size_t words in a sequential key\n"
+  "[0, 1] : on/off tsp-like keys test\n"
+  "[0, 1] : on/off sequential keys test\n";
+const int C_ARGC_MAX = 7;
+const size_t C_ARGS_DEF[6] = {16, 4, 8, 4, 1, 1};
+const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
+
+/* hash table parameters */
+const size_t C_DIVCHN_ALPHA_N = 1024;
+const size_t C_DIVCHN_LOG_ALPHA_D = 10; /* alpha is 1.0 */
+const size_t C_MULOA_ALPHA_N = 16384;
+const size_t C_MULOA_LOG_ALPHA_D = 15; /* alpha is 0.5 */
+
+/* reduction functions */
+#define C_RDC_COUNT 3
+const char *C_RDC_NAMES[C_RDC_COUNT] = {"default", "rdc_fold",
+					"rdc_mul_xorshift"};
+size_t (* const C_RDCS[C_RDC_COUNT])(const void *, size_t) = {NULL,
+							      rdc_fold,
+							      rdc_mul_xorshift};
+
+void run_rdcs(const void *keys, size_t num_keys, size_t key_size);
+void divchn(const void *keys,
+	    size_t num_keys,
+	    size_t key_size,
+	    size_t (*rdc_key)(const void *, size_t),
+	    size_t *num_elts,
+	    int *res);
+void muloa(const void *keys,
+	   size_t num_keys,
+	   size_t key_size,
+	   size_t (*rdc_key)(const void *, size_t),
+	   size_t *num_elts,
+	   int *res);
+void *ptr(const void *block, size_t i, size_t size);
+void print_test_result(int res);
+
+/**
+   Runs a test on tsp-like keys with num_bits randomly set bits in a bitset
+   of set_count size_t words. Duplicate keys are included in the keys
+   and are counted once in the hash tables.
+*/
+void run_tsp_test(size_t log_keys, size_t set_count, size_t num_bits){
+  size_t i, j, bit;
+  size_t num_keys = pow_two_perror(log_keys);
+  size_t key_size = mul_sz_perror(set_count, sizeof(size_t));
+  size_t *keys = NULL;
+  size_t *key = NULL;
+  keys = calloc_perror(mul_sz_perror(num_keys, set_count), sizeof(size_t));
+  for (i = 0; i < num_keys; i++){
+    key = ptr(keys, i, key_size);
+    for (j = 0; j < num_bits; j++){
+      bit = DRAND() * (set_count * C_FULL_BIT - 1);
+      key[bit / C_FULL_BIT] |= (size_t)1 << (bit % C_FULL_BIT);
+    }
+  }
+  printf("Run a reduction test on %lu tsp-like %lu-byte keys with "
+	 "%lu set bits\n", TOLU(num_keys), TOLU(key_size), TOLU(num_bits));
+  run_rdcs(keys, num_keys, key_size);
+  free(keys);
+  keys = NULL;
+}
+
+/**
+   Runs a test on sequential keys of key_count size_t words.
+*/
+void run_seq_test(size_t log_keys, size_t key_count){
+  size_t i;
+  size_t num_keys = pow_two_perror(log_keys);
+  size_t key_size = mul_sz_perror(key_count, sizeof(size_t));
+  size_t *keys = NULL;
+  keys = calloc_perror(mul_sz_perror(num_keys, key_count), sizeof(size_t));
+  for (i = 0; i < num_keys; i++){
+    *(size_t *)ptr(keys, i, key_size) = i;
+  }
+  printf("Run a reduction test on %lu sequential %lu-byte keys\n",
+	 TOLU(num_keys), TOLU(key_size));
+  run_rdcs(keys, num_keys, key_size);
+  free(keys);
+  keys = NULL;
+}
+
+/**
+   Runs the reduction functions and the default conversion on the keys
+   and reports the benchmark results. The number of distinct keys in a
+   hash table is required to be the same across the reduction functions.
+*/
+void run_rdcs(const void *keys, size_t num_keys, size_t key_size){
+  int res = 1;
+  size_t i, j;
+  size_t acc = 0;
+  size_t num_elts_def = 0, num_elts;
+  clock_t t;
+  for (i = 0; i < C_RDC_COUNT; i++){
+    printf("\t%s\n", C_RDC_NAMES[i]);
+    if (C_RDCS[i] != NULL){
+      t = clock();
+      for (j = 0; j < num_keys; j++){
+	acc += C_RDCS[i](ptr(keys, j, key_size), key_size);
+      }
+      t = clock() - t;
+      printf("\t\treduction time:                 "
+	     "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+    }
+    divchn(keys, num_keys, key_size, C_RDCS[i], &num_elts, &res);
+    if (i == 0) num_elts_def = num_elts;
+    res *= (num_elts == num_elts_def);
+    muloa(keys, num_keys, key_size, C_RDCS[i], &num_elts, &res);
+    res *= (num_elts == num_elts_def);
+  }
+  printf("\t# distinct keys: %lu, reduction checksum: %lu\n",
+	 TOLU(num_elts_def), TOLU(acc));
+  printf("\tcorrectness:                            ");
+  print_test_result(res);
+}
+
+/**
+   Inserts and searches keys in ht_divchn and reports the lengths of
+   chains.
+*/
+void divchn(const void *keys,
+	    size_t num_keys,
+	    size_t key_size,
+	    size_t (*rdc_key)(const void *, size_t),
+	    size_t *num_elts,
+	    int *res){
+  size_t i;
+  size_t len, max_len = 0, num_chains = 0;
+  const dll_node_t *head = NULL, *node = NULL;
+  ht_divchn_t ht;
+  clock_t t;
+  ht_divchn_init(&ht,
+		 key_size,
+		 sizeof(size_t),
+		 0,
+		 C_DIVCHN_ALPHA_N,
+		 C_DIVCHN_LOG_ALPHA_D,
+		 NULL,
+		 rdc_key,
+		 NULL);
+  ht_divchn_align(&ht, sizeof(size_t));
+  for (i = 0; i < num_keys; i++){
+    ht_divchn_insert(&ht, ptr(keys, i, key_size), &i);
+  }
+  t = clock();
+  for (i = 0; i < num_keys; i++){
+    *res *= (ht_divchn_search(&ht, ptr(keys, i, key_size)) != NULL);
+  }
+  t = clock() - t;
+  for (i = 0; i < ht.count; i++){
+    head = ht.key_elts[i];
+    if (head == NULL) continue;
+    len = 1;
+    for (node = head->next; node != head; node = node->next) len++;
+    if (len > max_len) max_len = len;
+    num_chains++;
+  }
+  printf("\t\tht_divchn max chain length:     %lu\n", TOLU(max_len));
+  printf("\t\tht_divchn mean chain length:    %.4f\n",
+	 (float)ht.num_elts / num_chains);
+  printf("\t\tht_divchn search time:          "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  *num_elts = ht.num_elts;
+  ht_divchn_free(&ht);
+}
+
+/**
+   Inserts and searches keys in ht_muloa and reports the maximum number of
+   probes in an insertion.
+*/
+void muloa(const void *keys,
+	   size_t num_keys,
+	   size_t key_size,
+	   size_t (*rdc_key)(const void *, size_t),
+	   size_t *num_elts,
+	   int *res){
+  size_t i;
+  ht_muloa_t ht;
+  clock_t t;
+  ht_muloa_init(&ht,
+		key_size,
+		sizeof(size_t),
+		0,
+		C_MULOA_ALPHA_N,
+		C_MULOA_LOG_ALPHA_D,
+		NULL,
+		rdc_key,
+		NULL);
+  ht_muloa_align(&ht, sizeof(size_t));
+  for (i = 0; i < num_keys; i++){
+    ht_muloa_insert(&ht, ptr(keys, i, key_size), &i);
+  }
+  t = clock();
+  for (i = 0; i < num_keys; i++){
+    *res *= (ht_muloa_search(&ht, ptr(keys, i, key_size)) != NULL);
+  }
+  t = clock() - t;
+  printf("\t\tht_muloa max # probes:          %lu\n",
+	 TOLU(ht.max_num_probes));
+  printf("\t\tht_muloa search time:           "
+	 "%.4f seconds\n", (float)t / CLOCKS_PER_SEC);
+  *num_elts = ht.num_elts;
+  ht_muloa_free(&ht);
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
+
+/**
+   Prints a test result.
+*/
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_MAX){
+    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_MAX - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_MAX - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_FULL_BIT - 2 ||
+      args[1] < 1 ||
+      args[2] < 1 ||
+      args[3] < 1 ||
+      args[2] > args[1] * C_FULL_BIT ||
+      args[4] > 1 ||
+      args[5] > 1){
+    fprintf(stderr, "USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[4]) run_tsp_test(args[0], args[1], args[2]);
+  if (args[5]) run_seq_test(args[0], args[3]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,119 @@
+/**
+   utilities-rdc.c
+
+   Key reduction functions that reduce a key within a contiguous block of
+   memory to a sizeof(size_t)-byte value prior to hashing. The functions
+   process a key in sizeof(size_t)-byte words and mix the bits of each
+   word with multiplications by an odd constant and xor-shifts.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99 with the only requirement that CHAR_BIT * sizeof(size_t) is
+   greater or equal to 16 and is even.
+*/
+
+#include <string.h>
+#include <limits.h>
+#include "utilities-rdc.h"
+
+/**
+   The 16-bit parts of 2**64 divided by the golden ratio and rounded to an
+   odd integer, in the little-endian order. The multiplier on a given
+   system consists of the most significant parts that fit in size_t.
+*/
+static const size_t C_MUL_PARTS[4] = {0x7c15u, 0x7f4au, 0x79b9u, 0x9e37u};
+static const size_t C_MUL_PARTS_COUNT = 4;
+static const size_t C_PART_BIT = 16;
+static const size_t C_FULL_BIT = CHAR_BIT * sizeof(size_t);
+static const size_t C_HALF_BIT = CHAR_BIT * sizeof(size_t) / 2;
+static const size_t C_WORD_SIZE = sizeof(size_t);
+
+static size_t mul_const();
+static size_t mix(size_t h, size_t c);
+
+/**
+   Reduces a key with word-wise folding. Each word is added to the current
+   value that is then multiplied by an odd constant, and the result is
+   mixed with a multiply-xorshift step after the last word. One
+   multiplication is performed per word.
+   key         : pointer to a block of size size
+   size        : size of the key in bytes
+*/
+size_t rdc_fold(const void *key, size_t size){
+  size_t c = mul_const();
+  size_t h = size;
+  size_t w;
+  size_t rem_size = size % C_WORD_SIZE;
+  const unsigned char *k = key;
+  const unsigned char *k_end = k + (size - rem_size);
+  for (; k != k_end; k += C_WORD_SIZE){
+    memcpy(&w, k, C_WORD_SIZE);
+    h = (h + w) * c; /* mod 2**C_FULL_BIT */
+  }
+  if (rem_size > 0){
+    w = 0;
+    memcpy(&w, k, rem_size);
+    h = (h + w) * c;
+  }
+  return mix(h, c);
+}
+
+/**
+   Reduces a key with a multiply-xorshift step per word. Each word is
+   combined with the current value, and the value is multiplied by an odd
+   constant and xor-shifted, followed by a final multiply-xorshift step.
+   The function provides stronger mixing than rdc_fold at the cost of an
+   additional dependent xor-shift per word.
+   key         : pointer to a block of size size
+   size        : size of the key in bytes
+*/
+size_t rdc_mul_xorshift(const void *key, size_t size){
+  size_t c = mul_const();
+  size_t h = size * c;
+  size_t w;
+  size_t rem_size = size % C_WORD_SIZE;
+  const unsigned char *k = key;
+  const unsigned char *k_end = k + (size - rem_size);
+  for (; k != k_end; k += C_WORD_SIZE){
+    memcpy(&w, k, C_WORD_SIZE);
+    h ^= w;
+    h *= c; /* mod 2**C_FULL_BIT */
+    h ^= h >> C_HALF_BIT;
+  }
+  if (rem_size > 0){
+    w = 0;
+    memcpy(&w, k, rem_size);
+    h ^= w;
+    h *= c;
+    h ^= h >> C_HALF_BIT;
+  }
+  return mix(h, c);
+}
+
+/** Auxiliary functions */
+
+/**
+   Builds the odd multiplier from the most significant parts in the
+   C_MUL_PARTS array that fit in size_t. The computation is evaluated at
+   compile time by an optimizing compiler.
+*/
+static size_t mul_const(){
+  size_t i;
+  size_t c = 0;
+  size_t count = C_FULL_BIT / C_PART_BIT;
+  if (count > C_MUL_PARTS_COUNT) count = C_MUL_PARTS_COUNT;
+  for (i = 0; i < count; i++){
+    c |= C_MUL_PARTS[C_MUL_PARTS_COUNT - count + i] << (i * C_PART_BIT);
+  }
+  return c | 1;
+}
+
+/**
+   Mixes the bits of a value with an xorshift-multiply-xorshift step, s.t.
+   each bit of the value affects the high and low bits of the result.
+*/
+static size_t mix(size_t h, size_t c){
+  h ^= h >> C_HALF_BIT;
+  h *= c; /* mod 2**C_FULL_BIT */
+  h ^= h >> C_HALF_BIT;
+  return h;
+}
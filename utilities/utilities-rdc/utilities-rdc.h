@@ -0,0 +1,51 @@
+/**
+   utilities-rdc.h
+
+   Declarations of accessible key reduction functions. A key reduction
+   function reduces a key within a contiguous block of memory to a
+   sizeof(size_t)-byte value prior to hashing, and can be passed as the
+   rdc_key parameter of a hash table.
+
+   The reduction functions process a key in sizeof(size_t)-byte words,
+   with the remaining bytes in a last partial word, and mix the bits of
+   each word with multiplications by an odd constant derived from the
+   golden ratio and xor-shifts. Compared to the default conversion of
+   a key by a hash table, which sums shifted bytes, the functions make
+   fewer memory accesses and do not map keys that differ in few bits,
+   such as sparse bitsets, to reduced values that differ in few bits.
+
+   A reduced value depends on the byte order of a system, because the
+   words of a key are read in the native byte order.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99 with the only requirement that CHAR_BIT * sizeof(size_t) is
+   greater or equal to 16 and is even.
+*/
+
+#ifndef UTILITIES_RDC_H
+#define UTILITIES_RDC_H
+
+#include <stddef.h>
+
+/**
+   Reduces a key with word-wise folding. Each word is added to the current
+   value that is then multiplied by an odd constant, and the result is
+   mixed with a multiply-xorshift step after the last word. One
+   multiplication is performed per word.
+   key         : pointer to a block of size size
+   size        : size of the key in bytes
+*/
+size_t rdc_fold(const void *key, size_t size);
+
+/**
+   Reduces a key with a multiply-xorshift step per word. Each word is
+   combined with the current value, and the value is multiplied by an odd
+   constant and xor-shifted, followed by a final multiply-xorshift step.
+   The function provides stronger mixing than rdc_fold at the cost of an
+   additional dependent xor-shift per word.
+   key         : pointer to a block of size size
+   size        : size of the key in bytes
+*/
+size_t rdc_mul_xorshift(const void *key, size_t size);
+
+#endif